@@ -0,0 +1,178 @@
+// Smart Shabbat Clock - Reference Remote Unit
+// Minimal HC-12 remote: decodes frames from the clock (Hc12Frame library,
+// firmware/libraries/Hc12Frame), acts on the ones addressed to this unit or
+// broadcast to it, and answers with a matching reply (same unit, seq,
+// opcode). Broadcast replies wait for this unit's reply slot.
+// The relay output runs the schedule locally (hc12_schedule.h): the clock
+// pushes the table once and sends time beacons; between beacons the unit
+// keeps time from millis(), corrected for its oscillator drift, so it keeps
+// switching through clock reboots and radio outages.
+// Written for an AVR board (e.g. Nano) with the HC-12 on SoftwareSerial.
+
+#include <SoftwareSerial.h>
+#include <hc12_frame.h>
+#include <hc12_schedule.h>
+
+// CHANGE HERE: this unit's address (1..32 to be reachable by broadcasts);
+// add it to the clock's HC12_SHABBAT_UNITS to follow the Shabbat mode and
+// to HC12_SCHEDULE_UNITS to run the schedule.
+const uint8_t UNIT_ADDRESS = 1;
+
+// CHANGE HERE: pin mapping for your board.
+const uint8_t HC12_RX_PIN = 10;  // to HC-12 TXD
+const uint8_t HC12_TX_PIN = 11;  // to HC-12 RXD
+const uint8_t MODE_OUTPUT = 4;   // HIGH while in Shabbat mode
+const uint8_t RELAY_OUTPUT = 5;  // follows the schedule / the clock's relay mode
+
+// CHANGE HERE: schedule capacity (keep >= the clock's MAX_EVENTS).
+const uint8_t SCHEDULE_CAPACITY = 32;
+
+SoftwareSerial hc12(HC12_RX_PIN, HC12_TX_PIN);
+Hc12FrameDecoder decoder;
+Hc12ScheduleAssembler<SCHEDULE_CAPACITY> schedule;
+Hc12RemoteClock remoteClock;
+
+bool shabbatMode = false;
+uint8_t relayMode = 2;  // from the beacons: 0 off, 1 on, 2 auto
+bool relayOn = false;
+unsigned long lastRelayCheckMs = 0;
+// Last handled request (payload without any target mask), so a retry (our
+// reply was lost) is only re-answered. A retry repeats seq, opcode and
+// payload; the seq alone can repeat after a clock reboot or wraparound.
+Hc12Frame lastRequest;
+bool haveLastRequest = false;
+
+void sendFrame(const Hc12Frame& frame) {
+  uint8_t wire[HC12_MAX_FRAME];
+  size_t length = hc12EncodeFrame(frame, wire);
+  hc12.write(wire, length);
+}
+
+// CHANGE HERE: what the unit does with a new mode.
+void applyMode(bool shabbat) {
+  if (shabbat == shabbatMode) return;
+  shabbatMode = shabbat;
+  digitalWrite(MODE_OUTPUT, shabbat ? HIGH : LOW);
+  Serial.print("Mode: ");
+  Serial.println(shabbat ? "shabbat" : "week");
+}
+
+void setRelay(bool on) {
+  if (on == relayOn) return;
+  relayOn = on;
+  digitalWrite(RELAY_OUTPUT, on ? HIGH : LOW);
+  Serial.print("Relay: ");
+  Serial.println(on ? "ON" : "OFF");
+}
+
+// Forced modes switch right away; AUTO needs the time and a schedule.
+void updateRelay() {
+  if (relayMode == 0 || relayMode == 1) {
+    setRelay(relayMode == 1);
+    return;
+  }
+  if (!remoteClock.valid()) return;
+  bool state;
+  uint16_t minute = hc12MinuteOfWeek(remoteClock.now(millis()));
+  if (hc12ScheduleStateAt(schedule.events, schedule.count, minute, state)) setRelay(state);
+}
+
+void handleBeacon(const uint8_t* payload, uint8_t length) {
+  Hc12Beacon beacon;
+  if (!hc12DecodeBeacon(payload, length, beacon)) return;
+  remoteClock.onBeacon(beacon.localTime, millis());
+  relayMode = beacon.relayMode;
+  applyMode(beacon.shabbat);
+  updateRelay();
+}
+
+bool isRetry(const Hc12Frame& request, const uint8_t* payload, uint8_t length) {
+  return haveLastRequest && request.seq == lastRequest.seq && request.opcode == lastRequest.opcode &&
+         length == lastRequest.length && memcmp(payload, lastRequest.payload, length) == 0;
+}
+
+void rememberRequest(const Hc12Frame& request, const uint8_t* payload, uint8_t length) {
+  lastRequest.seq = request.seq;
+  lastRequest.opcode = request.opcode;
+  lastRequest.length = length;
+  memcpy(lastRequest.payload, payload, length);
+  haveLastRequest = true;
+}
+
+void handleRequest(const Hc12Frame& request) {
+  if (request.opcode & HC12_OP_REPLY) return;  // another unit's reply
+  // Broadcasts carry a target mask ahead of the opcode payload.
+  int8_t slot = 0;
+  const uint8_t* payload = request.payload;
+  uint8_t length = request.length;
+  if (request.unit == HC12_UNIT_BROADCAST) {
+    uint32_t targets;
+    if (!hc12BroadcastTargets(request, targets)) return;
+    slot = hc12ReplySlot(targets, UNIT_ADDRESS);
+    if (slot < 0) return;
+    payload += HC12_TARGETS_SIZE;
+    length -= HC12_TARGETS_SIZE;
+  } else if (request.unit != UNIT_ADDRESS) {
+    return;
+  }
+
+  // Beacons are never answered.
+  if (request.opcode == HC12_OP_TIME_BEACON) {
+    handleBeacon(payload, length);
+    return;
+  }
+
+  Hc12Status status = HC12_STATUS_OK;
+  bool duplicate = isRetry(request, payload, length);
+  switch (request.opcode) {
+    case HC12_OP_PING:
+      break;
+    case HC12_OP_SET_MODE:
+      if (length != 1 || payload[0] > 1) status = HC12_STATUS_BAD_PAYLOAD;
+      else if (!duplicate) applyMode(payload[0] == 1);
+      break;
+    case HC12_OP_SET_SCHEDULE:
+      if (!duplicate) {
+        status = (Hc12Status)schedule.push(payload, length);
+        if (status == HC12_STATUS_OK) updateRelay();
+      }
+      break;
+    default:
+      status = HC12_STATUS_UNSUPPORTED;
+      break;
+  }
+  rememberRequest(request, payload, length);
+
+  // Shabbat mode, then for a PING the schedule we hold (hc12_schedule.h).
+  uint8_t extra[HC12_PING_REPLY_SIZE - 1] = {(uint8_t)shabbatMode, (uint8_t)schedule.valid,
+                                             (uint8_t)(schedule.version >> 8), (uint8_t)schedule.version};
+  uint8_t extraLength = request.opcode == HC12_OP_PING ? sizeof(extra) : 1;
+  delay((unsigned long)slot * HC12_REPLY_SLOT_MS);
+  sendFrame(hc12MakeReply(request, UNIT_ADDRESS, status, extra, extraLength));
+}
+
+void setup() {
+  Serial.begin(115200);
+  hc12.begin(9600);
+  pinMode(MODE_OUTPUT, OUTPUT);
+  pinMode(RELAY_OUTPUT, OUTPUT);
+  digitalWrite(MODE_OUTPUT, LOW);
+  digitalWrite(RELAY_OUTPUT, LOW);
+  Serial.print("Remote unit ");
+  Serial.print(UNIT_ADDRESS);
+  Serial.println(" ready.");
+}
+
+void loop() {
+  Hc12Frame frame;
+  while (hc12.available()) {
+    for (bool got = decoder.push((uint8_t)hc12.read(), frame); got; got = decoder.next(frame)) {
+      handleRequest(frame);
+    }
+  }
+  // Schedule events are whole minutes; checking every second is plenty.
+  if (millis() - lastRelayCheckMs >= 1000) {
+    lastRelayCheckMs = millis();
+    updateRelay();
+  }
+}
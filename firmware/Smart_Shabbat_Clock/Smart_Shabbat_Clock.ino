@@ -7,16 +7,23 @@
 #include <time.h>
 #include <RTClib.h>
 #include <HardwareSerial.h>
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
 #include <ArduinoOTA.h>
 #include <Preferences.h>
 
-#include "index_page.h"
 #include "schedule.h"
 #include "web_api.h"
 #include "peripherals.h"
 #include "time_utils.h"
 #include "cloud_sync.h"
+#include "metrics.h"
+#include "persistence.h"
+#include "boot_state.h"
+#include "task_scheduler.h"
+#include "button.h"
+#include "power_manager.h"
+#include "hc12_comm.h"
+#include "remote_sync.h"
 #include "wifi_config.h"
 
 // ---------------------- WiFi Settings ----------------------
@@ -45,7 +52,7 @@ const uint8_t BUTTON_OVERRIDE = 18;
 LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
 RTC_DS3231 rtc;
 HardwareSerial HC12(1);
-WebServer server(80);
+AsyncWebServer server(80);
 Preferences prefs;
 bool firstBootAfterFlash = false; // set by checkIfNewFlash()
 
@@ -58,23 +65,59 @@ uint8_t relayMode = 2;  // default AUTO
 bool lcdAvailable = false;
 bool rtcAvailable = false;
 
-// Connection/Time-keeping cadences.
-unsigned long lastButtonPress = 0; // debounce for override button
+// CHANGE HERE: loop task periods (ms); see task_scheduler.h. Power-save
+// mode stretches the ones that only affect responsiveness.
+#if POWER_SAVE_MODE
+static const unsigned long OTA_TASK_PERIOD          = 1000;
+static const unsigned long DISPLAY_TASK_PERIOD      = 1000;
+static const unsigned long HOUSEKEEPING_TASK_PERIOD = 5000;
+static const unsigned long CLOUD_TASK_PERIOD        = 2000;
+#else
+static const unsigned long OTA_TASK_PERIOD          = 100;
+static const unsigned long DISPLAY_TASK_PERIOD      = 500;
+static const unsigned long HOUSEKEEPING_TASK_PERIOD = 1000;
+static const unsigned long CLOUD_TASK_PERIOD        = 500;
+#endif
+// Schedule events are whole minutes; check this long after each minute starts.
+static const unsigned long SCHEDULE_TASK_MARGIN     = 100;
+static TaskId scheduleTaskId = NO_TASK;
 
 // New globals
 bool timeValid = false;     // true when system time is trustworthy
-bool hc12Ok    = false;     // updated after last HC-12 command/handshake
+
+// The pin and relay_state only change together, under relayLock: the loop
+// and the button task (button.cpp) both switch the relay.
+static portMUX_TYPE relayLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Flip the relay (any task); returns the new state.
+bool toggleRelay() {
+  portENTER_CRITICAL(&relayLock);
+  bool newState = !relay_state;
+  digitalWrite(RELAY_LOCAL, newState ? HIGH : LOW);
+  relay_state = newState;
+  portEXIT_CRITICAL(&relayLock);
+  return newState;
+}
+
+// Loop thread: RTC snapshot, log and persistence after a change.
+void recordRelayState() {
+  bool state = relay_state;
+  rememberRelaySnapshot(state);
+  Serial.printf("Relay state changed to %s\n", state ? "ON" : "OFF");
+  // Persist relay state (write-behind, coalesced with other toggles).
+  persistRelayState(state);
+}
 
 // Helper to toggle the physical relay and update global state
 void setLocalRelayState(bool newState) {
-  if (relay_state == newState) return;            
-  digitalWrite(RELAY_LOCAL, newState ? HIGH : LOW);  
-  relay_state = newState;                            
-  Serial.printf("Relay state changed to %s\n", newState ? "ON" : "OFF");
-  // Persist relay state so power loss doesn't reset it
-  prefs.begin("state", false);
-  prefs.putBool("relay", relay_state);
-  prefs.end();
+  portENTER_CRITICAL(&relayLock);
+  bool changed = relay_state != newState;
+  if (changed) {
+    digitalWrite(RELAY_LOCAL, newState ? HIGH : LOW);
+    relay_state = newState;
+  }
+  portEXIT_CRITICAL(&relayLock);
+  if (changed) recordRelayState();
 }
 
 // Detects a "new build" by comparing __DATE__/__TIME__ with last saved value.
@@ -89,142 +132,188 @@ bool checkIfNewFlash() {
     return isNew;
 }
 
-// Persisted mode helpers (save/load only)
+// Persisted mode helpers (save/load only). Saves are write-behind; see
+// persistence.h.
 void saveRelayMode(uint8_t mode) {
-  prefs.begin("state", false);
-  prefs.putUChar("relayMode", mode);
-  prefs.end();
+  persistRelayMode(mode);
 }
 
 void saveShabbatMode(bool mode) {
-  prefs.begin("state", false);
-  prefs.putBool("shabbat", mode);
-  prefs.end();
+  persistShabbatMode(mode);
 }
 
 void loadPersistedModes() {
-  prefs.begin("state", true);
-  relayMode = prefs.getUChar("relayMode", relayMode);
-  shabbatMode = prefs.getBool("shabbat", shabbatMode);
-  prefs.end();
+  persistInit();
+  relayMode = persistedRelayMode(relayMode);
+  shabbatMode = persistedShabbatMode(shabbatMode);
+}
+
+
+// ---------------------- Loop Tasks ----------------------
+// Each subsystem runs at its own cadence instead of on every loop pass.
+// "web" (web_api.cpp), "persist" (persistence.cpp) and "button" (button.cpp)
+// register themselves.
+
+static void otaTask() {
+  ArduinoOTA.handle();
 }
 
+static void displayTask() {
+  uint32_t t0 = metricsStart();
+  updateDisplay();
+  metricsRecord(METRIC_DISPLAY, t0);
+}
+
+// Runs once per minute, just after the minute (and so any transition)
+// starts; if it fires a little early it re-checks a second later.
+static void scheduleTask() {
+  rtcCorrectDst();
+  // In AUTO mode, apply an event whose minute just started; a manual tap
+  // holds until then.
+  if (timeValid) applyScheduleLogic();
+  DateTime now = getCurrentDateTime();
+  schedulerDelay(scheduleTaskId, (60 - now.second()) * 1000UL + SCHEDULE_TASK_MARGIN);
+}
+
+// Wi-Fi keepalive, NTP to RTC resync, schedule journal compaction and the
+// fast-boot relay record; each has its own slower interval inside.
+static void housekeepingTask() {
+  handleWiFiReconnect();
+  tickTimeSync();
+  tickScheduleCompaction();
+  tickBootRecord();
+}
+
+// Cloud command/status broker. Local logic remains authoritative.
+static void cloudTask() {
+  uint32_t t0 = metricsStart();
+  tickCloudSync();
+  metricsRecord(METRIC_CLOUD_TICK, t0);
+}
+
+static void registerLoopTasks() {
+  schedulerAddPeriodic("ota", otaTask, OTA_TASK_PERIOD);
+  schedulerAddPeriodic("display", displayTask, DISPLAY_TASK_PERIOD);
+  scheduleTaskId = schedulerAddOneShot("schedule", scheduleTask, 0);
+  schedulerAddPeriodic("housekeeping", housekeepingTask, HOUSEKEEPING_TASK_PERIOD);
+  schedulerAddPeriodic("cloud", cloudTask, CLOUD_TASK_PERIOD);
+}
 
 // ---------------------- Setup ----------------------
+// The relay is restored first, from the fastest trustworthy source (see
+// boot_state.h); LCD, radio, Wi-Fi, OTA, NTP, web and cloud come after.
+// NTP no longer blocks here; tickTimeSync() picks it up from loop().
 void setup() {
   Serial.begin(115200);
   Serial.println();
   Serial.println("\nBooting Smart Shabbat Clock...");
+  bootStage("serial");
 
-  // 1) Start from a SAFE physical state (relay OFF).
+  // 1) Relay pin. Soft resets restore the live state from RTC memory;
+  // otherwise start from a SAFE state (relay OFF).
   pinMode(RELAY_LOCAL, OUTPUT);
-  digitalWrite(RELAY_LOCAL, LOW);
-  pinMode(BUTTON_OVERRIDE, INPUT_PULLUP);
-
-  // 2) Load persisted user modes from NVS.
+  bool snapshotRelay = false;
+  bool haveSnapshot = readRelaySnapshot(snapshotRelay);
+  digitalWrite(RELAY_LOCAL, snapshotRelay ? HIGH : LOW);
+  relay_state = snapshotRelay;
+  rememberRelaySnapshot(relay_state);
+  bootStage(haveSnapshot ? "relay snapshot" : "relay safe off");
+
+  // 2) Load persisted user modes from NVS; a forced mode needs nothing else.
   loadPersistedModes();
+  persistRelayState(relay_state);
+  if (relayMode == 0) setLocalRelayState(false);
+  else if (relayMode == 1) setLocalRelayState(true);
+  bootStage("nvs modes");
 
-  // 3) Init optional peripherals (LCD/RTC auto-detect).
-  Serial.println("Initializing I2C peripherals...");
-  initPeripheralsSafely();
-  Serial.printf("LCD Available: %s\n", lcdAvailable ? "YES" : "NO");
-  Serial.printf("RTC Available: %s\n", rtcAvailable ? "YES" : "NO");
-
-  // 4) Decide whether RTC time is trustworthy.
+  // 3) RTC (optional) and whether its time is trustworthy.
   // If RTC lost power, time stays invalid until NTP/manual set fixes it.
-  if (rtcAvailable && !rtc.lostPower()) timeValid = true;
-  else timeValid = false;
-
-  // 5) Init HC-12 radio UART.
-  HC12.begin(9600, SERIAL_8N1, HC12_RX, HC12_TX);
-
-  // 6) Start Wi-Fi connection (non-blocking at boot).
-  connectToWiFi();
-  lastWiFiAttempt = millis();
-
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.print("WiFi connected quickly. IP: ");
-    Serial.println(WiFi.localIP());
-  } else {
-    Serial.println("WiFi not connected yet (will retry in background).");
+  initRtcSafely();
+  Serial.printf("RTC Available: %s\n", rtcAvailable ? "YES" : "NO");
+  timeValid = rtcAvailable && !rtc.lostPower();
+  bootStage("rtc");
+
+  // 4) On a new firmware build, wipe schedule; otherwise load it.
+  bool newFlash = checkIfNewFlash();
+
+  // 5) AUTO on a cold boot: precomputed boot record, checked against the RTC.
+  bool recordRelay = false;
+  if (relayMode == 2 && !haveSnapshot && !newFlash && timeValid &&
+      bootRecordRelay(getCurrentDateTime().unixtime(), recordRelay)) {
+    setLocalRelayState(recordRelay);
+    bootStage("boot record");
   }
 
-  // 7) Init OTA.
-  ArduinoOTA.setHostname("ShabbatClock");
-  ArduinoOTA.begin();
-  Serial.println("OTA ready.");
-
-  // 8) Attempt time sync at boot.
-  syncTimeAtBoot();
-
-  // 9) On a new firmware build, wipe schedule; otherwise load it.
-  if (checkIfNewFlash()) {
+  if (newFlash) {
     Serial.println("First boot");
     clearScheduleStorage();
   } else {
     loadSchedule();
   }
+  bootStage("schedule");
 
   // Correct the local-time RTC across Israel DST transitions before restoring AUTO state.
-  tickRtcDstCorrection();
+  rtcCorrectDst();
 
-  // 10) Restore relay state from authoritative mode logic.
+  // 6) Restore relay state from authoritative mode logic.
   if (relayMode == 0) {
     setLocalRelayState(false);      // manual force OFF
   } else if (relayMode == 1) {
     setLocalRelayState(true);       // manual force ON
   } else if (timeValid) {           // AUTO
     setRelayToLastEvent();
-  } else {
+  } else if (!haveSnapshot) {
     setLocalRelayState(false);      // AUTO but time invalid => stay safe OFF
   }
+  bootStage("relay correct");
+
+  // Override button: interrupt-driven from here on (see button.h).
+  initButton(BUTTON_OVERRIDE);
+
+  // 7) LCD (optional).
+  initLcdSafely();
+  Serial.printf("LCD Available: %s\n", lcdAvailable ? "YES" : "NO");
+  initPeripheralBus();  // RTC/LCD traffic moves to the i2c task from here
+  bootStage("lcd");
+
+  // 8) Init HC-12 radio UART and its transaction engine.
+  initHc12(HC12_RX, HC12_TX);
+  initRemoteSync();
+
+  // 9) Start Wi-Fi connection (non-blocking at boot).
+  connectToWiFi();
+  lastWiFiAttempt = millis();
+  Serial.println("WiFi connecting (will retry in background).");
+  initPowerManagement(BUTTON_OVERRIDE);
+
+  // 10) Init OTA.
+  ArduinoOTA.setHostname("ShabbatClock");
+  ArduinoOTA.onStart([]() { persistFlush(); });  // don't lose pending writes to the reboot
+  ArduinoOTA.begin();
+  Serial.println("OTA ready.");
 
-  // 11) Start web server.
+  // 11) Time sync: NTP is configured here and completes in the background.
+  syncTimeAtBoot();
+  bootStage("radio/wifi/ota");
+
+  // 12) Start web server.
   initWebServer(); 
   server.begin();
   Serial.println("Web server started.");
   initCloudSync();
+  registerLoopTasks();
+  bootStage("ready");
   Serial.println("Setup complete. System is ready.\n");
-  if (lcdAvailable) {
-    lcd.clear();
-    lcd.print(WiFi.status() == WL_CONNECTED ? WiFi.localIP().toString() : String("No WiFi"));
-    delay(300);
-  }
+  lcdShowMessage("Connecting WiFi");
 }
 
 // ---------------------- Loop ----------------------
-// Main loop is lightweight: handle OTA, HTTP, LCD, schedule,
-// Wi-Fi keepalive, manual override, and periodic NTP to RTC resync.
+// Run whatever is due, then sleep until the next deadline or until a task
+// is notified (e.g. a web request was queued). HTTP requests themselves are
+// served by the async server in the background.
 void loop() {
-  static unsigned long lastDisplayUpdate = 0;
-
-  // Handle background tasks
-  ArduinoOTA.handle();
-  server.handleClient();
-
-  // Update display only every 500ms to avoid I2C congestion, but don't block the loop
-  if (millis() - lastDisplayUpdate > 500) {
-    updateDisplay();
-    lastDisplayUpdate = millis();
-  }
-
-  tickRtcDstCorrection();
-
-  // Apply schedule logic if in AUTO mode and time is valid
-  if (timeValid) applyScheduleLogic();
-  // Check WiFi connection periodically
-  handleWiFiReconnect();
-
-  // Manual toggle with debounce (active-low button).
-  if (digitalRead(BUTTON_OVERRIDE) == LOW && millis() - lastButtonPress > 300) {
-    setLocalRelayState(!relay_state);
-    lastButtonPress = millis();
-    Serial.printf("Manual override: Relay %s\n", relay_state ? "ON" : "OFF");
-  }
-
-  // Periodically sync NTP to RTC
-  tickTimeSync();
-
-  // Cloud command/status broker. Local logic remains authoritative.
-  tickCloudSync();
+  uint32_t loopStart = metricsStart();
+  schedulerRunDue();
+  metricsRecord(METRIC_LOOP, loopStart);
+  schedulerIdle();
 }
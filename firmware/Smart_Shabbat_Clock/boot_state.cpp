@@ -0,0 +1,79 @@
+#include "boot_state.h"
+#include "persistence.h"
+#include "schedule.h"
+#include "time_utils.h"
+#include <esp_system.h>
+#include <esp_timer.h>
+
+extern bool timeValid;
+extern uint8_t relayMode;
+
+// ---------------------- Boot Timing ----------------------
+
+void bootStage(const char* name) {
+  Serial.printf("[boot] %-16s %5lu ms\n", name, (unsigned long)(esp_timer_get_time() / 1000));
+}
+
+// ---------------------- RTC Memory Snapshot ----------------------
+// Survives soft resets but not power loss; check holds the inverted
+// relay byte so stale or random contents are rejected.
+static const uint32_t SNAPSHOT_MAGIC = 0x52454C59;  // "RELY"
+
+struct RelaySnapshot {
+  uint32_t magic;
+  uint8_t relay;
+  uint8_t check;
+};
+
+RTC_NOINIT_ATTR static RelaySnapshot relaySnapshot;
+
+bool readRelaySnapshot(bool& relayOn) {
+  if (esp_reset_reason() == ESP_RST_POWERON) return false;
+  if (relaySnapshot.magic != SNAPSHOT_MAGIC) return false;
+  if ((uint8_t)~relaySnapshot.relay != relaySnapshot.check || relaySnapshot.relay > 1) return false;
+  relayOn = relaySnapshot.relay != 0;
+  return true;
+}
+
+void rememberRelaySnapshot(bool relayOn) {
+  relaySnapshot.magic = SNAPSHOT_MAGIC;
+  relaySnapshot.relay = relayOn ? 1 : 0;
+  relaySnapshot.check = (uint8_t)~relaySnapshot.relay;
+}
+
+// ---------------------- NVS Boot Record ----------------------
+// Recomputed when the schedule revision changes or the current state's
+// validity runs out; persisted write-behind, so it costs one small write
+// per scheduled transition.
+// CHANGE HERE: how often the record is re-checked without a trigger (ms).
+static const unsigned long BOOT_RECORD_CHECK_INTERVAL = 60000;
+
+static uint32_t recordRevision = 0xffffffffUL;
+static unsigned long recordCheckedMs = 0;
+static unsigned long recordValidForMs = 0;
+
+bool bootRecordRelay(uint32_t nowUnix, bool& relayOn) {
+  uint32_t validUntil = 0;
+  if (!persistedBootRecord(relayOn, validUntil)) return false;
+  return nowUnix < validUntil;
+}
+
+void tickBootRecord() {
+  if (!timeValid || relayMode != 2) return;
+  unsigned long nowMs = millis();
+  bool expired = nowMs - recordCheckedMs >= recordValidForMs || nowMs - recordCheckedMs >= BOOT_RECORD_CHECK_INTERVAL;
+  if (scheduleRevision == recordRevision && !expired) return;
+
+  DateTime now = getCurrentDateTime();
+  bool state = false;
+  uint32_t secondsUntilNext = 0;
+  if (scheduleStateAt(now, state, secondsUntilNext)) {
+    persistBootRecord(state, now.unixtime() + secondsUntilNext);
+    recordValidForMs = secondsUntilNext * 1000UL;
+  } else {
+    persistBootRecord(false, 0);  // empty schedule: no fast path
+    recordValidForMs = BOOT_RECORD_CHECK_INTERVAL;
+  }
+  recordRevision = scheduleRevision;
+  recordCheckedMs = nowMs;
+}
@@ -0,0 +1,30 @@
+#ifndef BOOT_STATE_H
+#define BOOT_STATE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// ---------------------- Fast Boot ----------------------
+// setup() restores the relay before any slow init, from the fastest source
+// that is trustworthy:
+//   1) RTC memory snapshot of the live relay (soft resets: panic, WDT, OTA,
+//      brownout), readable before NVS or I2C;
+//   2) forced relay mode from NVS;
+//   3) NVS boot record (AUTO): the schedule state precomputed while running,
+//      valid until the next event, checked against the RTC;
+// then the full schedule logic confirms it once the schedule is loaded.
+
+// Log a boot stage with the time since reset.
+void bootStage(const char* name);
+// Relay state from the RTC memory snapshot; false after power-on or if the
+// snapshot is not intact.
+bool readRelaySnapshot(bool& relayOn);
+// Keep the RTC memory snapshot in step with the relay; call on every change.
+void rememberRelaySnapshot(bool relayOn);
+// Cold-boot AUTO fast path: relay state from the NVS boot record, if still
+// valid at nowUnix (RTC time).
+bool bootRecordRelay(uint32_t nowUnix, bool& relayOn);
+// Keep the NVS boot record current while in AUTO; call from loop().
+void tickBootRecord();
+
+#endif // BOOT_STATE_H
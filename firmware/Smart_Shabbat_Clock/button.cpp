@@ -0,0 +1,171 @@
+#include "button.h"
+#include "control_actions.h"
+#include "task_scheduler.h"
+#include "power_manager.h"
+#include <esp_timer.h>
+#include <driver/gpio.h>
+#include <hal/gpio_ll.h>
+
+extern bool relay_state;
+bool toggleRelay();
+void recordRelayState();
+
+// CHANGE HERE: button timing (ms).
+static const uint32_t BUTTON_DEBOUNCE_MS = 25;      // level must be stable this long
+static const uint32_t BUTTON_DOUBLE_TAP_MS = 400;   // release -> next press
+static const uint32_t BUTTON_LONG_PRESS_MS = 2000;
+// CHANGE HERE: button task priority (loop runs at 1) and stack size.
+static const UBaseType_t BUTTON_TASK_PRIORITY = 3;
+static const uint32_t BUTTON_TASK_STACK = 3072;
+
+enum ButtonGesture : uint8_t {
+  GESTURE_TAP = 0,
+  GESTURE_DOUBLE_TAP,
+  GESTURE_LONG_PRESS
+};
+
+struct ButtonEdge {
+  int64_t atUs;  // esp_timer time of the interrupt
+};
+
+struct GestureEvent {
+  ButtonGesture gesture;
+  bool relayOn;  // tap: state the relay was switched to
+  uint32_t latencyUs;  // deciding edge (tap: the release) -> gesture recognized
+};
+
+static uint8_t buttonPin = 0;
+static QueueHandle_t edgeQueue = nullptr;
+static QueueHandle_t gestureQueue = nullptr;
+static TaskId applyTask = NO_TASK;
+
+static void IRAM_ATTR onButtonEdge() {
+#if POWER_SAVE_MODE
+  // Light sleep only wakes on a level, so the pin is level-triggered. Mask
+  // it until the button task re-arms it for the opposite level (the gpio
+  // driver calls for that aren't IRAM-safe; the LL one is inline).
+  gpio_ll_set_intr_type(&GPIO, buttonPin, GPIO_INTR_DISABLE);
+#endif
+  ButtonEdge edge = {esp_timer_get_time()};
+  BaseType_t woken = pdFALSE;
+  xQueueSendFromISR(edgeQueue, &edge, &woken);
+  if (woken) portYIELD_FROM_ISR(woken);
+}
+
+static void postGesture(ButtonGesture gesture, bool relayOn, int64_t sinceUs) {
+  GestureEvent event = {gesture, relayOn, (uint32_t)(esp_timer_get_time() - sinceUs)};
+  xQueueSend(gestureQueue, &event, 0);
+  schedulerNotify(applyTask);
+}
+
+#if POWER_SAVE_MODE
+// Button task: one interrupt (and light-sleep wakeup) per level change.
+static void rearmButtonWakeup() {
+  bool low = gpio_get_level((gpio_num_t)buttonPin) == 0;
+  gpio_wakeup_enable((gpio_num_t)buttonPin, low ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL);
+}
+#endif
+
+// ---------------------- Button Task ----------------------
+// Debounce: an edge only starts a quiet window; the level read once the
+// window passes without another edge is the new stable level.
+static void buttonTaskMain(void*) {
+  bool pressed = false;
+  bool waitingSecondTap = false;  // last gesture was a tap, within double-tap window
+  bool longReported = false;
+  bool tapPending = false;        // pressed; a tap if released before a long press
+  int64_t edgeUs = 0;             // first edge of the current transition
+  int64_t pressedUs = 0;
+  int64_t releasedUs = 0;
+  bool settling = false;
+
+  for (;;) {
+    TickType_t wait = portMAX_DELAY;
+    int64_t nowUs = esp_timer_get_time();
+    if (settling) {
+      wait = pdMS_TO_TICKS(BUTTON_DEBOUNCE_MS);
+    } else if (pressed && !longReported) {
+      int64_t leftMs = BUTTON_LONG_PRESS_MS - (nowUs - pressedUs) / 1000;
+      wait = leftMs > 0 ? pdMS_TO_TICKS(leftMs) : 0;
+    }
+
+    ButtonEdge edge;
+    if (xQueueReceive(edgeQueue, &edge, wait) == pdTRUE) {
+#if POWER_SAVE_MODE
+      rearmButtonWakeup();
+#endif
+      if (!settling) edgeUs = edge.atUs;
+      settling = true;
+      continue;  // restart the quiet window
+    }
+    nowUs = esp_timer_get_time();
+
+    if (settling) {
+      settling = false;
+      bool level = digitalRead(buttonPin) == LOW;
+      if (level == pressed) continue;  // bounce that settled back
+      pressed = level;
+
+      if (pressed) {
+        pressedUs = edgeUs;
+        longReported = false;
+        if (waitingSecondTap && (edgeUs - releasedUs) / 1000 <= BUTTON_DOUBLE_TAP_MS) {
+          waitingSecondTap = false;
+          postGesture(GESTURE_DOUBLE_TAP, __atomic_load_n(&relay_state, __ATOMIC_RELAXED), edgeUs);
+        } else {
+          // Not known yet: a tap only once released before a long press.
+          tapPending = true;
+        }
+      } else {
+        releasedUs = edgeUs;
+        if (tapPending) {
+          // Tap: switch the relay now, let the loop record it.
+          tapPending = false;
+          waitingSecondTap = true;
+          postGesture(GESTURE_TAP, toggleRelay(), edgeUs);
+        }
+      }
+      continue;
+    }
+
+    if (pressed && !longReported && (nowUs - pressedUs) / 1000 >= BUTTON_LONG_PRESS_MS) {
+      longReported = true;
+      waitingSecondTap = false;
+      tapPending = false;
+      postGesture(GESTURE_LONG_PRESS, false, pressedUs);
+    }
+  }
+}
+
+// ---------------------- Loop Side ----------------------
+// Gestures change modes and persisted state, so they run on the loop thread.
+static void applyGestures() {
+  GestureEvent event;
+  while (xQueueReceive(gestureQueue, &event, 0) == pdTRUE) {
+    switch (event.gesture) {
+      case GESTURE_TAP:
+        recordRelayState();
+        Serial.printf("Manual override: Relay %s (%lu us)\n", event.relayOn ? "ON" : "OFF",
+                      (unsigned long)event.latencyUs);
+        break;
+      case GESTURE_DOUBLE_TAP:
+        applyRelayModeAction(event.relayOn ? "on" : "off");
+        Serial.printf("Button double tap: relay mode forced %s\n", event.relayOn ? "ON" : "OFF");
+        break;
+      case GESTURE_LONG_PRESS:
+        applyRelayModeAction("auto");
+        Serial.println("Button long press: relay mode AUTO");
+        break;
+    }
+  }
+}
+
+void initButton(uint8_t buttonPinIn) {
+  buttonPin = buttonPinIn;
+  edgeQueue = xQueueCreate(16, sizeof(ButtonEdge));
+  gestureQueue = xQueueCreate(8, sizeof(GestureEvent));
+  applyTask = schedulerAddOneShot("button", applyGestures, NOT_SCHEDULED);
+  xTaskCreate(buttonTaskMain, "button", BUTTON_TASK_STACK, nullptr, BUTTON_TASK_PRIORITY, nullptr);
+  pinMode(buttonPin, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(buttonPin), onButtonEdge, CHANGE);
+}
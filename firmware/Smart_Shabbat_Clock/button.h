@@ -0,0 +1,26 @@
+#ifndef BUTTON_H
+#define BUTTON_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// ---------------------- Override Button ----------------------
+// Edge interrupts on the (active-low) button pin feed timestamped events to
+// a small FreeRTOS task that debounces them and recognizes gestures, so
+// presses are handled within a few ms even while the loop is busy in an
+// HTTPS call or an HC-12 exchange:
+//   tap        - toggle the relay (as before), on release: until then the
+//                press may still become a long press. The button task
+//                switches the pin and relay_state together (toggleRelay());
+//                the loop then records the change (snapshot, persistence).
+//   double tap - second press within BUTTON_DOUBLE_TAP_MS of the tap's
+//                release: keep the state of the first tap as forced ON/OFF
+//                mode (survives the schedule).
+//   long press - held for BUTTON_LONG_PRESS_MS: back to AUTO.
+// Holding the button no longer toggles repeatedly.
+
+// Attach the interrupt, start the button task and register the "button"
+// loop task that applies gestures.
+void initButton(uint8_t buttonPin);
+
+#endif // BUTTON_H
@@ -1,6 +1,10 @@
 #include "cloud_sync.h"
 
 #include "control_actions.h"
+#include "hc12_comm.h"
+#include "json_utils.h"
+#include "metrics.h"
+#include "persistence.h"
 #include "schedule.h"
 #include "time_utils.h"
 #include <Arduino.h>
@@ -40,19 +44,26 @@
 #ifndef FIREBASE_ALLOW_INSECURE_TLS
 #define FIREBASE_ALLOW_INSECURE_TLS 1
 #endif
+#ifndef FIREBASE_PUBLISH_METRICS
+#define FIREBASE_PUBLISH_METRICS 0
+#endif
+#ifndef FIREBASE_AUTH_URL
+#define FIREBASE_AUTH_URL "https://identitytoolkit.googleapis.com/v1/accounts:signInWithPassword"
+#endif
 
-extern Preferences prefs;
 extern bool relay_state;
 extern bool shabbatMode;
 extern bool timeValid;
-extern bool hc12Ok;
 extern uint8_t relayMode;
 
 static const unsigned long AUTH_RETRY_INTERVAL = 60000;
+static const unsigned long DATABASE_RETRY_INTERVAL = 10000;
+static const unsigned long MAX_RETRY_BACKOFF = 600000;
 static const unsigned long COMMAND_POLL_INTERVAL = 10000;
 static const unsigned long STATUS_HEARTBEAT_INTERVAL = 60000;
 static const unsigned long STATUS_CHANGE_MIN_INTERVAL = 5000;
 static const uint8_t MAX_COMMAND_BATCH = 5;
+static const uint16_t POLL_STATS_LOG_EVERY = 60;
 
 struct CloudCommand {
   String id;
@@ -62,11 +73,67 @@ struct CloudCommand {
   uint32_t baseScheduleRevision;
   ScheduleEntry events[MAX_EVENTS];
   uint8_t eventCount;
+  bool malformed;  // has a seq but didn't parse; ACKed as failed and skipped
+};
+
+// ---------------------- Circuit Breakers ----------------------
+// One breaker per Firebase endpoint. A failed request (no response, 5xx or
+// 429) opens the breaker for an exponentially growing, jittered backoff so
+// an outage costs one timeout per backoff window instead of one per tick.
+// When the window expires the breaker goes half-open and the next request is
+// a single probe: success closes it, failure reopens it with a doubled
+// backoff. Any other answer means the endpoint is up: a rejected request
+// (4xx) only waits one base backoff before it is repeated, and a 401 drops
+// the token so the next tick signs in again.
+enum BreakerState : uint8_t {
+  BREAKER_CLOSED = 0,
+  BREAKER_OPEN,
+  BREAKER_HALF_OPEN
+};
+
+enum CloudEndpoint : uint8_t {
+  ENDPOINT_AUTH = 0,
+  ENDPOINT_COMMANDS,
+  ENDPOINT_ACKS,
+  ENDPOINT_STATUS,
+  ENDPOINT_SCHEDULE,
+  ENDPOINT_COUNT
 };
 
+struct CloudBreaker {
+  const char* name;
+  unsigned long baseBackoffMs;
+  BreakerState state;
+  uint8_t failures;
+  unsigned long openedAtMs;
+  unsigned long backoffMs;
+  bool rejected;                 // last request got a 4xx answer
+  unsigned long rejectedAtMs;
+};
+
+static CloudBreaker breakers[ENDPOINT_COUNT] = {
+  {"auth", AUTH_RETRY_INTERVAL, BREAKER_CLOSED, 0, 0, 0, false, 0},
+  {"commands", DATABASE_RETRY_INTERVAL, BREAKER_CLOSED, 0, 0, 0, false, 0},
+  {"acks", DATABASE_RETRY_INTERVAL, BREAKER_CLOSED, 0, 0, 0, false, 0},
+  {"status", DATABASE_RETRY_INTERVAL, BREAKER_CLOSED, 0, 0, 0, false, 0},
+  {"schedule", DATABASE_RETRY_INTERVAL, BREAKER_CLOSED, 0, 0, 0, false, 0},
+};
+
+// Command poll accounting: response bytes and parse time, split between
+// idle polls (answered by the nextSeq probe alone) and full fetches.
+struct CommandPollStats {
+  uint32_t polls;
+  uint32_t idlePolls;
+  uint32_t bytes;
+  uint32_t parseUs;
+  uint32_t lastPollBytes;
+  uint32_t lastParseUs;
+};
+
+static CommandPollStats pollStats = {};
+
 static String idToken;
 static unsigned long tokenExpiresAtMs = 0;
-static unsigned long lastAuthAttemptMs = 0;
 static unsigned long lastCommandPollMs = 0;
 static unsigned long lastStatusPublishMs = 0;
 static String lastStatusSignature;
@@ -76,32 +143,75 @@ static String inFlightCommandId;
 static uint32_t inFlightSeq = 0;
 static bool pendingBootRecoveryAck = false;
 static bool forceStatusPublish = true;
+static bool hc12CommandPending = false;  // in-flight shabbat_mode command awaiting the remote
+
+// The last command that ran and its outcome, until progress passes it. It
+// also answers for the commands of its type it superseded (settledFromSeq
+// up to it). A batch fetched again after an ACK write failure or a reboot
+// is acked from here instead of running the command again, or failing the
+// replace_schedule commands it superseded as stale against the revision it
+// bumped.
+static uint32_t settledFromSeq = 0;
+static uint32_t settledSeq = 0;
+static String settledType;
+static ActionResult settledResult;
+
+static const char* breakerStateName(BreakerState state) {
+  if (state == BREAKER_OPEN) return "open";
+  if (state == BREAKER_HALF_OPEN) return "half_open";
+  return "closed";
+}
+
+// True while the endpoint is open and its backoff has not expired yet.
+static bool breakerWaiting(CloudEndpoint endpoint) {
+  const CloudBreaker& breaker = breakers[endpoint];
+  return breaker.state == BREAKER_OPEN && millis() - breaker.openedAtMs < breaker.backoffMs;
+}
+
+// Returns true if a request to the endpoint may be attempted now.
+static bool breakerAllows(CloudEndpoint endpoint) {
+  CloudBreaker& breaker = breakers[endpoint];
+  if (breaker.state != BREAKER_OPEN) return true;
+  if (breakerWaiting(endpoint)) return false;
+
+  breaker.state = BREAKER_HALF_OPEN;
+  Serial.printf("Firebase %s breaker half-open, probing.\n", breaker.name);
+  return true;
+}
 
-static String jsonEscape(const String& value) {
-  String out;
-  out.reserve(value.length() + 8);
-  for (uint16_t i = 0; i < value.length(); i++) {
-    char c = value[i];
-    if (c == '"' || c == '\\') {
-      out += '\\';
-      out += c;
-    } else if (c == '\n') {
-      out += "\\n";
-    } else if (c == '\r') {
-      out += "\\r";
-    } else {
-      out += c;
+// True while a rejected request to the endpoint must not be repeated yet.
+static bool breakerHoldsRejected(CloudEndpoint endpoint) {
+  const CloudBreaker& breaker = breakers[endpoint];
+  return breaker.rejected && millis() - breaker.rejectedAtMs < breaker.baseBackoffMs;
+}
+
+static void breakerRecord(CloudEndpoint endpoint, bool ok) {
+  CloudBreaker& breaker = breakers[endpoint];
+  if (ok) {
+    if (breaker.state != BREAKER_CLOSED) {
+      Serial.printf("Firebase %s breaker closed after %u failures.\n",
+                    breaker.name, breaker.failures);
     }
+    breaker.state = BREAKER_CLOSED;
+    breaker.failures = 0;
+    breaker.backoffMs = 0;
+    return;
   }
-  return out;
-}
 
-static String jsonString(const String& value) {
-  return "\"" + jsonEscape(value) + "\"";
-}
+  if (breaker.failures < 255) breaker.failures++;
 
-static String jsonBool(bool value) {
-  return value ? "true" : "false";
+  // base * 2^(failures-1), capped, then +/-25% jitter so retries of several
+  // endpoints (and several devices) don't line up.
+  unsigned long backoff = breaker.baseBackoffMs;
+  for (uint8_t i = 1; i < breaker.failures && backoff < MAX_RETRY_BACKOFF; i++) backoff *= 2;
+  if (backoff > MAX_RETRY_BACKOFF) backoff = MAX_RETRY_BACKOFF;
+  long jitter = random(-(long)(backoff / 4), (long)(backoff / 4) + 1);
+
+  breaker.state = BREAKER_OPEN;
+  breaker.openedAtMs = millis();
+  breaker.backoffMs = (unsigned long)((long)backoff + jitter);
+  Serial.printf("Firebase %s breaker open for %lu ms (failure %u).\n",
+                breaker.name, breaker.backoffMs, breaker.failures);
 }
 
 static void configureClient(WiFiClientSecure& client) {
@@ -115,8 +225,12 @@ static bool httpRequest(const String& method,
                         const String& body,
                         int& statusCode,
                         String& response) {
-  WiFiClientSecure client;
-  configureClient(client);
+  // Plain http:// is only used against a local stand-in (tools/rtdb-standin.mjs).
+  WiFiClientSecure secureClient;
+  WiFiClient plainClient;
+  bool secure = url.startsWith("https://");
+  if (secure) configureClient(secureClient);
+  WiFiClient& client = secure ? static_cast<WiFiClient&>(secureClient) : plainClient;
 
   HTTPClient http;
   http.setTimeout(6000);
@@ -142,6 +256,25 @@ static bool httpRequest(const String& method,
   return statusCode >= 200 && statusCode < 300;
 }
 
+// httpRequest() guarded by the endpoint's circuit breaker.
+static bool cloudRequest(CloudEndpoint endpoint,
+                         const String& method,
+                         const String& url,
+                         const String& body,
+                         int& statusCode,
+                         String& response) {
+  uint32_t t0 = metricsStart();
+  bool ok = httpRequest(method, url, body, statusCode, response);
+  metricsRecord(METRIC_CLOUD_HTTP, t0);
+  bool failed = statusCode <= 0 || statusCode >= 500 || statusCode == 429;
+  breakerRecord(endpoint, !failed);
+  CloudBreaker& breaker = breakers[endpoint];
+  breaker.rejected = !ok && !failed;
+  breaker.rejectedAtMs = millis();
+  if (statusCode == 401) idToken = "";  // expired or revoked: sign in again next tick
+  return ok;
+}
+
 static String databaseBaseUrl() {
   String base = FIREBASE_DATABASE_URL;
   while (base.endsWith("/")) base.remove(base.length() - 1);
@@ -161,124 +294,6 @@ static String databaseUrl(const String& path, const String& query = "") {
   return url;
 }
 
-static bool parseJsonStringAt(const String& json, int quotePos, String& value, int& nextPos) {
-  if (quotePos < 0 || quotePos >= json.length() || json[quotePos] != '"') return false;
-
-  value = "";
-  bool escaped = false;
-  for (int i = quotePos + 1; i < json.length(); i++) {
-    char c = json[i];
-    if (escaped) {
-      value += c;
-      escaped = false;
-    } else if (c == '\\') {
-      escaped = true;
-    } else if (c == '"') {
-      nextPos = i + 1;
-      return true;
-    } else {
-      value += c;
-    }
-  }
-  return false;
-}
-
-static bool findStringValue(const String& json, const String& key, String& value) {
-  int keyPos = json.indexOf("\"" + key + "\"");
-  if (keyPos < 0) return false;
-
-  int colon = json.indexOf(':', keyPos);
-  if (colon < 0) return false;
-
-  int quote = json.indexOf('"', colon + 1);
-  int next = 0;
-  return parseJsonStringAt(json, quote, value, next);
-}
-
-static bool findNumberValue(const String& json, const String& key, uint32_t& value) {
-  int keyPos = json.indexOf("\"" + key + "\"");
-  if (keyPos < 0) return false;
-
-  int colon = json.indexOf(':', keyPos);
-  if (colon < 0) return false;
-
-  int pos = colon + 1;
-  while (pos < json.length() && (json[pos] == ' ' || json[pos] == '\n' || json[pos] == '\r')) pos++;
-
-  uint32_t parsed = 0;
-  bool foundDigit = false;
-  while (pos < json.length() && json[pos] >= '0' && json[pos] <= '9') {
-    foundDigit = true;
-    parsed = parsed * 10 + (json[pos] - '0');
-    pos++;
-  }
-
-  if (!foundDigit) return false;
-  value = parsed;
-  return true;
-}
-
-static bool extractValueBlock(const String& json, const String& key, String& value) {
-  int keyPos = json.indexOf("\"" + key + "\"");
-  if (keyPos < 0) return false;
-
-  int colon = json.indexOf(':', keyPos);
-  if (colon < 0) return false;
-
-  int pos = colon + 1;
-  while (pos < json.length() && (json[pos] == ' ' || json[pos] == '\n' || json[pos] == '\r')) pos++;
-  if (pos >= json.length()) return false;
-
-  char open = json[pos];
-  char close = (open == '{') ? '}' : ((open == '[') ? ']' : '\0');
-  if (close == '\0') return false;
-
-  int depth = 0;
-  bool inString = false;
-  bool escaped = false;
-  for (int i = pos; i < json.length(); i++) {
-    char c = json[i];
-    if (inString) {
-      if (escaped) escaped = false;
-      else if (c == '\\') escaped = true;
-      else if (c == '"') inString = false;
-      continue;
-    }
-
-    if (c == '"') inString = true;
-    else if (c == open) depth++;
-    else if (c == close) {
-      depth--;
-      if (depth == 0) {
-        value = json.substring(pos, i + 1);
-        return true;
-      }
-    }
-  }
-
-  return false;
-}
-
-static bool parseEventObject(const String& object, ScheduleEntry& event) {
-  uint32_t day = 0;
-  uint32_t hour = 0;
-  uint32_t minute = 0;
-  String state;
-
-  if (!findNumberValue(object, "day", day)) return false;
-  if (!findNumberValue(object, "hour", hour)) return false;
-  if (!findNumberValue(object, "minute", minute)) return false;
-  if (!findStringValue(object, "state", state)) return false;
-  if (day > 6 || hour > 23 || minute > 59) return false;
-  if (state != "on" && state != "off") return false;
-
-  event.day = (uint8_t)day;
-  event.hour = (uint8_t)hour;
-  event.minute = (uint8_t)minute;
-  event.state = (state == "on");
-  return true;
-}
-
 static bool parseEvents(const String& eventsJson, CloudCommand& command) {
   command.eventCount = 0;
 
@@ -287,36 +302,12 @@ static bool parseEvents(const String& eventsJson, CloudCommand& command) {
     int start = eventsJson.indexOf('{', pos);
     if (start < 0) break;
 
-    int depth = 0;
-    bool inString = false;
-    bool escaped = false;
-    int end = -1;
-
-    for (int i = start; i < eventsJson.length(); i++) {
-      char c = eventsJson[i];
-      if (inString) {
-        if (escaped) escaped = false;
-        else if (c == '\\') escaped = true;
-        else if (c == '"') inString = false;
-        continue;
-      }
-
-      if (c == '"') inString = true;
-      else if (c == '{') depth++;
-      else if (c == '}') {
-        depth--;
-        if (depth == 0) {
-          end = i;
-          break;
-        }
-      }
-    }
-
+    int end = findObjectEnd(eventsJson, start);
     if (end < 0) return false;
     if (command.eventCount >= MAX_EVENTS) return false;
 
     ScheduleEntry event;
-    if (!parseEventObject(eventsJson.substring(start, end + 1), event)) return false;
+    if (!parseScheduleEvent(eventsJson.substring(start, end + 1), event)) return false;
     command.events[command.eventCount++] = event;
     pos = end + 1;
   }
@@ -364,38 +355,25 @@ static uint8_t parseCommandList(const String& json, CloudCommand commands[], uin
     int objectStart = json.indexOf('{', colon + 1);
     if (objectStart < 0) break;
 
-    int depth = 0;
-    bool inString = false;
-    bool escaped = false;
-    int objectEnd = -1;
-
-    for (int i = objectStart; i < json.length(); i++) {
-      char c = json[i];
-      if (inString) {
-        if (escaped) escaped = false;
-        else if (c == '\\') escaped = true;
-        else if (c == '"') inString = false;
-        continue;
-      }
-
-      if (c == '"') inString = true;
-      else if (c == '{') depth++;
-      else if (c == '}') {
-        depth--;
-        if (depth == 0) {
-          objectEnd = i;
-          break;
-        }
-      }
-    }
-
+    int objectEnd = findObjectEnd(json, objectStart);
     if (objectEnd < 0) break;
 
     CloudCommand command;
-    if (parseCommandObject(id, json.substring(objectStart, objectEnd + 1), command) &&
-        command.seq > lastProcessedSeq) {
+    bool parsed = parseCommandObject(id, json.substring(objectStart, objectEnd + 1), command);
+    if (command.seq > lastProcessedSeq) {
+      // A bad entry still takes its slot, so the cursor moves past it;
+      // otherwise a malformed last command forces a full fetch every poll.
+      if (!parsed) {
+        Serial.printf("Firebase command %s seq %lu is malformed; skipping it.\n",
+                      id.c_str(), (unsigned long)command.seq);
+        command.malformed = true;
+      }
       commands[count++] = command;
+    } else if (command.seq == 0) {
+      // seq is parsed first and the rules only allow seq > 0: it is missing.
+      Serial.printf("Firebase command %s has no seq; ignoring it.\n", id.c_str());
     }
+    // Anything else at or below lastProcessedSeq was handled already.
     pos = objectEnd + 1;
   }
 
@@ -412,56 +390,53 @@ static uint8_t parseCommandList(const String& json, CloudCommand commands[], uin
   return count;
 }
 
+// Cloud keys live in the persistence shadow (persistence.h). The in-flight
+// marker is a barrier. Around a command that changed state, persistFlush()
+// puts its effect on flash before the ACK and the cleared marker right after
+// it, so a reboot can't follow an "applied" ACK with "unknown_after_reboot".
+// Progress past commands that did nothing is flushed once after the batch.
 static void loadCloudState() {
-  prefs.begin("cloud", true);
-  lastProcessedSeq = prefs.getUInt("lastSeq", 0);
-  inFlightCommandId = prefs.getString("flightId", "");
-  inFlightSeq = prefs.getUInt("flightSeq", 0);
-  prefs.end();
+  lastProcessedSeq = persistedLastSeq();
+  inFlightCommandId = persistedInFlightId();
+  inFlightSeq = persistedInFlightSeq();
   pendingBootRecoveryAck = (inFlightCommandId.length() > 0 && inFlightSeq > 0);
 }
 
 static void saveLastProcessedSeq(uint32_t seq) {
   lastProcessedSeq = seq;
-  prefs.begin("cloud", false);
-  prefs.putUInt("lastSeq", lastProcessedSeq);
-  prefs.end();
+  persistLastSeq(lastProcessedSeq);
+  if (settledSeq != 0 && lastProcessedSeq >= settledSeq) settledSeq = 0;
 }
 
+// Must be on flash before the command runs, so a reboot mid-command is
+// reported instead of silently repeated.
 static void saveInFlightCommand(const CloudCommand& command) {
   inFlightCommandId = command.id;
   inFlightSeq = command.seq;
-  prefs.begin("cloud", false);
-  prefs.putString("flightId", inFlightCommandId);
-  prefs.putUInt("flightSeq", inFlightSeq);
-  prefs.end();
+  persistInFlight(inFlightCommandId, inFlightSeq);
+  persistFlush();
 }
 
 static void clearInFlightCommand() {
   inFlightCommandId = "";
   inFlightSeq = 0;
   pendingBootRecoveryAck = false;
-  prefs.begin("cloud", false);
-  prefs.remove("flightId");
-  prefs.remove("flightSeq");
-  prefs.end();
+  persistClearInFlight();
 }
 
 static bool signInIfNeeded() {
   if (idToken.length() > 0 && millis() < tokenExpiresAtMs) return true;
   if (WiFi.status() != WL_CONNECTED) return false;
-  if (lastAuthAttemptMs != 0 && millis() - lastAuthAttemptMs < AUTH_RETRY_INTERVAL) return false;
-
-  lastAuthAttemptMs = millis();
+  if (breakerHoldsRejected(ENDPOINT_AUTH) || !breakerAllows(ENDPOINT_AUTH)) return false;
 
-  String url = "https://identitytoolkit.googleapis.com/v1/accounts:signInWithPassword?key=" + String(FIREBASE_API_KEY);
+  String url = String(FIREBASE_AUTH_URL) + "?key=" + String(FIREBASE_API_KEY);
   String body = String("{\"email\":") + jsonString(FIREBASE_DEVICE_EMAIL) +
                 ",\"password\":" + jsonString(FIREBASE_DEVICE_PASSWORD) +
                 ",\"returnSecureToken\":true}";
 
   int status = 0;
   String response;
-  if (!httpRequest("POST", url, body, status, response)) {
+  if (!cloudRequest(ENDPOINT_AUTH, "POST", url, body, status, response)) {
     Serial.printf("Firebase auth failed: HTTP %d\n", status);
     return false;
   }
@@ -469,6 +444,7 @@ static bool signInIfNeeded() {
   String token;
   if (!findStringValue(response, "idToken", token)) {
     Serial.println("Firebase auth failed: missing idToken");
+    breakerRecord(ENDPOINT_AUTH, false);
     return false;
   }
 
@@ -481,6 +457,51 @@ static bool signInIfNeeded() {
   return true;
 }
 
+// Compact breaker summary for the status signature; retry timers are left
+// out so only state transitions trigger a publish.
+static String breakerSignature() {
+  String signature;
+  for (uint8_t i = 0; i < ENDPOINT_COUNT; i++) signature += String((int)breakers[i].state);
+  return signature;
+}
+
+static String breakersJson() {
+  unsigned long nowMs = millis();
+  String json = "{";
+  for (uint8_t i = 0; i < ENDPOINT_COUNT; i++) {
+    const CloudBreaker& breaker = breakers[i];
+    unsigned long retryInMs = 0;
+    if (breaker.state == BREAKER_OPEN && nowMs - breaker.openedAtMs < breaker.backoffMs) {
+      retryInMs = breaker.backoffMs - (nowMs - breaker.openedAtMs);
+    }
+    if (i > 0) json += ",";
+    json += jsonString(breaker.name) +
+            ":{\"state\":" + jsonString(breakerStateName(breaker.state)) +
+            ",\"failures\":" + String(breaker.failures) +
+            ",\"retryInMs\":" + String(retryInMs) + "}";
+  }
+  json += "}";
+  return json;
+}
+
+// HC-12 link statistics keyed "unitN" (numeric keys would turn into an
+// array in RTDB); units that were never addressed are left out.
+static String hc12LinksJson() {
+  String json = "{";
+  for (uint8_t unit = 1; unit <= HC12_MAX_BROADCAST_UNIT; unit++) {
+    Hc12LinkSummary link;
+    if (!hc12LinkSummary(unit, link)) continue;
+    if (json.length() > 1) json += ",";
+    json += "\"unit" + String(unit) + "\":{\"ok\":" + jsonBool(link.ok) +
+            ",\"successPct\":" + String(link.successPct) +
+            ",\"rttP50Ms\":" + String(link.rttP50Ms) +
+            ",\"rttP90Ms\":" + String(link.rttP90Ms) +
+            ",\"lastSeen\":" + String(link.lastSeen) + "}";
+  }
+  json += "}";
+  return json;
+}
+
 static String statusSignature() {
   char buf[6] = {0};
   if (timeValid) {
@@ -493,9 +514,23 @@ static String statusSignature() {
          String(shabbatMode ? "1" : "0") + "|" +
          String(buf) + "|" +
          String(timeValid ? "1" : "0") + "|" +
-         String(hc12Ok ? "1" : "0") + "|" +
+         String(hc12LinkRevision()) + "|" +
          String(lastProcessedSeq) + "|" +
-         String(scheduleRevision);
+         String(scheduleRevision) + "|" +
+         breakerSignature();
+}
+
+// Summary of the device metrics, published with the heartbeat status when
+// FIREBASE_PUBLISH_METRICS is set. Not part of the status signature.
+static String metricsJson() {
+  return String("{") +
+         "\"heapFree\":" + String(ESP.getFreeHeap()) +
+         ",\"heapMinFree\":" + String(ESP.getMinFreeHeap()) +
+         ",\"loopMaxUs\":" + String(metricsMaxUs(METRIC_LOOP)) +
+         ",\"loopOverBudget\":" + String(metricsOverBudget(METRIC_LOOP)) +
+         ",\"cloudHttpMaxUs\":" + String(metricsMaxUs(METRIC_CLOUD_HTTP)) +
+         ",\"nvsWrites\":" + String(metricsSamples(METRIC_NVS_WRITE)) +
+         "}";
 }
 
 static String statusJson() {
@@ -511,10 +546,14 @@ static String statusJson() {
          ",\"shabbat\":" + jsonBool(shabbatMode) +
          ",\"time\":\"" + String(buf) + "\"" +
          ",\"timeValid\":" + jsonBool(timeValid) +
-         ",\"hc12Ok\":" + jsonBool(hc12Ok) +
+         ",\"hc12\":" + hc12LinksJson() +
          ",\"lastSeen\":{\".sv\":\"timestamp\"}" +
          ",\"lastProcessedSeq\":" + String(lastProcessedSeq) +
          ",\"scheduleRevision\":" + String(scheduleRevision) +
+         ",\"breakers\":" + breakersJson() +
+#if FIREBASE_PUBLISH_METRICS
+         ",\"metrics\":" + metricsJson() +
+#endif
          "}";
 }
 
@@ -531,10 +570,12 @@ static String scheduleJson() {
   return json;
 }
 
-static bool putDatabaseJson(const String& path, const String& body) {
+static bool putDatabaseJson(CloudEndpoint endpoint, const String& path, const String& body) {
+  if (breakerHoldsRejected(endpoint) || !breakerAllows(endpoint)) return false;
+
   int status = 0;
   String response;
-  bool ok = httpRequest("PUT", databaseUrl(path), body, status, response);
+  bool ok = cloudRequest(endpoint, "PUT", databaseUrl(path), body, status, response);
   if (!ok) {
     Serial.printf("Firebase PUT failed %s: HTTP %d\n", path.c_str(), status);
   }
@@ -553,7 +594,7 @@ static void publishStatusIfDue(bool force) {
 
   if (!force && !heartbeatDue && !changeDue) return;
 
-  if (putDatabaseJson(String("devices/") + FIREBASE_DEVICE_ID + "/state/status", statusJson())) {
+  if (putDatabaseJson(ENDPOINT_STATUS, String("devices/") + FIREBASE_DEVICE_ID + "/state/status", statusJson())) {
     lastStatusSignature = signature;
     lastStatusPublishMs = nowMs;
     forceStatusPublish = false;
@@ -563,7 +604,7 @@ static void publishStatusIfDue(bool force) {
 static void publishScheduleIfNeeded() {
   if (scheduleRevision == lastPublishedScheduleRevision) return;
 
-  if (putDatabaseJson(String("devices/") + FIREBASE_DEVICE_ID + "/state/schedule", scheduleJson())) {
+  if (putDatabaseJson(ENDPOINT_SCHEDULE, String("devices/") + FIREBASE_DEVICE_ID + "/state/schedule", scheduleJson())) {
     lastPublishedScheduleRevision = scheduleRevision;
   }
 }
@@ -577,16 +618,91 @@ static bool writeAckFor(const String& commandId,
                 ",\"message\":" + jsonString(result.message) +
                 ",\"ackedAt\":{\".sv\":\"timestamp\"}}";
 
-  return putDatabaseJson(String("devices/") + FIREBASE_DEVICE_ID + "/acks/" + commandId, body);
+  return putDatabaseJson(ENDPOINT_ACKS, String("devices/") + FIREBASE_DEVICE_ID + "/acks/" + commandId, body);
 }
 
-static ActionResult executeCommand(const CloudCommand& command) {
+static bool isSupportedMode(const CloudCommand& command) {
   if (command.type == "relay_mode") {
-    return applyRelayModeAction(command.mode);
+    return command.mode == "on" || command.mode == "off" || command.mode == "auto";
   }
-
   if (command.type == "shabbat_mode") {
-    return applyShabbatModeAction(command.mode);
+    return command.mode == "shabbat" || command.mode == "week";
+  }
+  return false;
+}
+
+// The ACK of a command superseded by bySeq: that command's outcome.
+static ActionResult supersededResult(uint32_t bySeq, const ActionResult& outcome) {
+  String message = "superseded by seq " + String(bySeq);
+  if (!outcome.ok) return makeActionResult(false, outcome.code, message + ": " + outcome.message);
+  return makeActionResult(true, "superseded", message);
+}
+
+static void settleCommand(uint32_t fromSeq, uint32_t seq, const String& type, const ActionResult& result) {
+  settledFromSeq = fromSeq;
+  settledSeq = seq;
+  settledType = type;
+  settledResult = result;
+}
+
+// True if the command already ran (or was superseded by the one that did)
+// before the batch was fetched again; result is its ACK.
+static bool settledResultFor(const CloudCommand& command, ActionResult& result) {
+  if (settledSeq == 0 || command.seq < settledFromSeq || command.seq > settledSeq) return false;
+  if (command.seq == settledSeq) {
+    result = settledResult;
+    return true;
+  }
+  if (command.malformed || command.type != settledType) return false;
+  result = supersededResult(settledSeq, settledResult);
+  return true;
+}
+
+// Coalesces the pass (sorted by seq) before anything executes.
+// supersededBy[i] is set to the index of the command that runs instead of
+// command i, or -1 if command i must run:
+// - relay_mode: only the last valid command runs.
+// - replace_schedule: commands whose base revision chains from the current
+//   revision (each applied one bumps it by one) are all valid, but only the
+//   last of them runs, rebased onto the current revision. Commands that would
+//   be stale anyway are left to fail as before.
+// A pass ends at its first shabbat_mode command, so shabbat_mode commands
+// are never coalesced. Settled commands take no part.
+static void coalesceCommands(CloudCommand commands[], uint8_t count, int8_t supersededBy[]) {
+  int8_t lastRelay = -1;
+  int8_t lastSchedule = -1;
+  uint32_t expectedRevision = scheduleRevision;
+  ActionResult settled;
+
+  for (int8_t i = count - 1; i >= 0; i--) supersededBy[i] = -1;
+
+  for (uint8_t i = 0; i < count; i++) {
+    const CloudCommand& command = commands[i];
+    if (command.malformed || settledResultFor(command, settled)) continue;
+    if (command.type == "replace_schedule") {
+      if (command.baseScheduleRevision != expectedRevision) continue;
+      expectedRevision++;
+      if (lastSchedule >= 0) supersededBy[lastSchedule] = i;
+      lastSchedule = i;
+    } else if (command.type == "relay_mode" && isSupportedMode(command)) {
+      if (lastRelay >= 0) supersededBy[lastRelay] = i;
+      lastRelay = i;
+    }
+  }
+
+  // Point every superseded command at the one that actually runs.
+  for (int8_t i = count - 1; i >= 0; i--) {
+    if (supersededBy[i] >= 0 && supersededBy[supersededBy[i]] >= 0) supersededBy[i] = supersededBy[supersededBy[i]];
+  }
+
+  if (lastSchedule >= 0) commands[lastSchedule].baseScheduleRevision = scheduleRevision;
+}
+
+// shabbat_mode goes through the HC-12 engine and completes later; see
+// finishPendingCommand().
+static ActionResult executeCommand(const CloudCommand& command) {
+  if (command.type == "relay_mode") {
+    return applyRelayModeAction(command.mode);
   }
 
   if (command.type == "replace_schedule") {
@@ -596,10 +712,78 @@ static ActionResult executeCommand(const CloudCommand& command) {
   return makeActionResult(false, "unsupported_command", "unsupported command type");
 }
 
-static void pollOneCommand() {
+static void recordPoll(uint32_t bytes, uint32_t parseUs, bool idle) {
+  pollStats.polls++;
+  if (idle) pollStats.idlePolls++;
+  pollStats.bytes += bytes;
+  pollStats.parseUs += parseUs;
+  pollStats.lastPollBytes = bytes;
+  pollStats.lastParseUs = parseUs;
+
+  if (pollStats.polls % POLL_STATS_LOG_EVERY == 0) {
+    Serial.printf("Firebase poll stats: %lu polls (%lu idle), avg %lu B and %lu us parse per poll\n",
+                  (unsigned long)pollStats.polls,
+                  (unsigned long)pollStats.idlePolls,
+                  (unsigned long)(pollStats.bytes / pollStats.polls),
+                  (unsigned long)(pollStats.parseUs / pollStats.polls));
+  }
+}
+
+// Reads control/nextSeq, the last sequence number the admin UI handed out.
+// Returns false if the probe failed; latestSeq is left at 0 when the node
+// does not exist yet (then the caller falls back to a full fetch).
+static bool probeLatestCommandSeq(uint32_t& latestSeq, uint32_t& bytes) {
+  String path = String("devices/") + FIREBASE_DEVICE_ID + "/control/nextSeq";
+
+  int status = 0;
+  String response;
+  if (!cloudRequest(ENDPOINT_COMMANDS, "GET", databaseUrl(path), "", status, response)) {
+    Serial.printf("Firebase command probe failed: HTTP %d\n", status);
+    return false;
+  }
+
+  bytes = response.length();
+  latestSeq = 0;
+  for (uint16_t i = 0; i < response.length() && response[i] >= '0' && response[i] <= '9'; i++) {
+    latestSeq = latestSeq * 10 + (response[i] - '0');
+  }
+  return true;
+}
+
+// Completion of the in-flight shabbat_mode command (the in-flight marker
+// identifies it). Same ACK/progress handling as a synchronous command.
+static void finishPendingCommand(const ActionResult& result, void*) {
+  hc12CommandPending = false;
+  persistFlush();
+  settleCommand(inFlightSeq, inFlightSeq, "shabbat_mode", result);
+  if (writeAckFor(inFlightCommandId, inFlightSeq, result)) {
+    saveLastProcessedSeq(inFlightSeq);
+    clearInFlightCommand();
+    persistFlush();
+    forceStatusPublish = true;
+  } else {
+    Serial.println("Firebase ACK write failed; keeping in-flight marker.");
+  }
+  lastCommandPollMs = 0;  // fetch the rest of the batch right away
+}
+
+static void pollCommands() {
+  if (hc12CommandPending) return;
   if (lastCommandPollMs != 0 && millis() - lastCommandPollMs < COMMAND_POLL_INTERVAL) return;
   lastCommandPollMs = millis();
   if (pendingBootRecoveryAck) return;
+  // Don't fetch (and execute) a command whose ACK could not be written yet.
+  if (breakerWaiting(ENDPOINT_ACKS)) return;
+  if (!breakerAllows(ENDPOINT_COMMANDS)) return;
+
+  // Cheap probe first: an idle poll costs a few bytes and no JSON parsing.
+  uint32_t latestSeq = 0;
+  uint32_t probeBytes = 0;
+  if (!probeLatestCommandSeq(latestSeq, probeBytes)) return;
+  if (latestSeq != 0 && latestSeq <= lastProcessedSeq) {
+    recordPoll(probeBytes, 0, true);
+    return;
+  }
 
   String query = "orderBy=%22seq%22&startAt=" + String(lastProcessedSeq + 1) +
                  "&limitToFirst=" + String(MAX_COMMAND_BATCH);
@@ -607,30 +791,113 @@ static void pollOneCommand() {
 
   int status = 0;
   String response;
-  if (!httpRequest("GET", databaseUrl(path, query), "", status, response)) {
+  if (!cloudRequest(ENDPOINT_COMMANDS, "GET", databaseUrl(path, query), "", status, response)) {
     Serial.printf("Firebase command poll failed: HTTP %d\n", status);
     return;
   }
 
   CloudCommand commands[MAX_COMMAND_BATCH];
+  unsigned long parseStartUs = micros();
   uint8_t count = parseCommandList(response, commands, MAX_COMMAND_BATCH);
+  recordPoll(probeBytes + response.length(), micros() - parseStartUs, false);
   if (count == 0) return;
 
-  CloudCommand command = commands[0];
-  Serial.printf("Firebase command %s seq %lu type %s\n",
-                command.id.c_str(),
-                (unsigned long)command.seq,
-                command.type.c_str());
+  // After a reboot the recovered command's type is only known now.
+  for (uint8_t i = 0; i < count; i++) {
+    if (commands[i].seq == settledSeq) settledType = commands[i].type;
+  }
 
-  saveInFlightCommand(command);
-  ActionResult result = executeCommand(command);
-  if (writeAckFor(command.id, command.seq, result)) {
-    saveLastProcessedSeq(command.seq);
-    clearInFlightCommand();
+  // A shabbat_mode command completes after the HC-12 round trip without
+  // blocking the loop, so it ends the pass; the rest of the batch is fetched
+  // again once its ACK is written.
+  ActionResult settled;
+  for (uint8_t i = 0; i < count; i++) {
+    const CloudCommand& command = commands[i];
+    if (command.type == "shabbat_mode" && !command.malformed && !settledResultFor(command, settled)) {
+      count = i + 1;
+      break;
+    }
+  }
+
+  int8_t supersededBy[MAX_COMMAND_BATCH];
+  coalesceCommands(commands, count, supersededBy);
+
+  // A command is done once its ACK is written; progress only moves past a
+  // contiguous run of done commands, so a superseded one whose ACK is still
+  // missing is fetched again.
+  bool done[MAX_COMMAND_BATCH] = {};
+  uint8_t progress = 0;
+  bool ackFailed = false;
+
+  for (uint8_t i = 0; i < count && !ackFailed; i++) {
+    const CloudCommand& command = commands[i];
+    bool superseded = supersededBy[i] >= 0;
+    Serial.printf("Firebase command %s seq %lu type %s%s\n",
+                  command.id.c_str(),
+                  (unsigned long)command.seq,
+                  command.type.c_str(),
+                  superseded ? " (superseded)" : "");
+
+    // Acked below, after the command that superseded it.
+    if (superseded) continue;
+
+    // Settled, superseded and malformed commands have no side effects, so
+    // they need no in-flight marker: if their ACK fails they are simply
+    // fetched again.
+    ActionResult result;
+    bool runs = false;
+    if (settledResultFor(command, result)) {
+      // Ran before this batch was fetched again.
+    } else if (command.malformed) {
+      result = makeActionResult(false, "malformed_command", "command could not be parsed");
+    } else if (command.type == "shabbat_mode") {
+      // Last of the pass; everything before it is done.
+      saveInFlightCommand(command);
+      hc12CommandPending = true;
+      applyShabbatModeAction(command.mode, finishPendingCommand, nullptr);
+      break;
+    } else {
+      runs = true;
+      saveInFlightCommand(command);
+      result = executeCommand(command);
+      persistFlush();
+      uint32_t fromSeq = command.seq;
+      for (uint8_t j = 0; j < i; j++) {
+        if (supersededBy[j] == i && commands[j].seq < fromSeq) fromSeq = commands[j].seq;
+      }
+      settleCommand(fromSeq, command.seq, command.type, result);
+    }
+
+    if (!writeAckFor(command.id, command.seq, result)) {
+      Serial.println(runs ? "Firebase ACK write failed; keeping in-flight marker."
+                          : "Firebase ACK write failed.");
+      break;
+    }
+    done[i] = true;
+    if (command.seq == inFlightSeq) {
+      clearInFlightCommand();
+      persistFlush();
+    }
     forceStatusPublish = true;
-  } else {
-    Serial.println("Firebase ACK write failed; keeping in-flight marker.");
+
+    // Only now, with its outcome, the commands it superseded.
+    ActionResult outcome = supersededResult(command.seq, result);
+    for (uint8_t j = 0; j < i; j++) {
+      if (supersededBy[j] != i) continue;
+      if (!writeAckFor(commands[j].id, commands[j].seq, outcome)) {
+        Serial.println("Firebase ACK write failed.");
+        ackFailed = true;
+        break;
+      }
+      done[j] = true;
+    }
+
+    while (progress < count && done[progress]) saveLastProcessedSeq(commands[progress++].seq);
   }
+
+  // One commit for the progress past settled, superseded and malformed
+  // commands.
+  persistFlush();
 }
 
 static void recoverInFlightAfterBoot() {
@@ -639,9 +906,18 @@ static void recoverInFlightAfterBoot() {
   ActionResult result = makeActionResult(false,
                                          "unknown_after_reboot",
                                          "device rebooted before command completion could be confirmed");
+  if (inFlightSeq > lastProcessedSeq + 1) {
+    // Commands before it may be ones it superseded, still waiting for its
+    // outcome: the next poll acks them and it.
+    settleCommand(lastProcessedSeq + 1, inFlightSeq, "", result);
+    pendingBootRecoveryAck = false;
+    Serial.println("Firebase in-flight command marked unknown after reboot.");
+    return;
+  }
   if (writeAckFor(inFlightCommandId, inFlightSeq, result)) {
     saveLastProcessedSeq(inFlightSeq);
     clearInFlightCommand();
+    persistFlush();
     forceStatusPublish = true;
     Serial.println("Firebase in-flight command marked unknown after reboot.");
   }
@@ -671,7 +947,7 @@ void tickCloudSync() {
   if (!signInIfNeeded()) return;
 
   recoverInFlightAfterBoot();
-  pollOneCommand();
+  pollCommands();
   publishScheduleIfNeeded();
   publishStatusIfDue(forceStatusPublish);
 #endif
@@ -39,18 +39,69 @@ ActionResult applyRelayModeAction(const String& mode) {
   return makeActionResult(false, "invalid_relay_mode", "unsupported relay mode");
 }
 
-ActionResult applyShabbatModeAction(const String& mode) {
-  if (mode != "shabbat" && mode != "week") {
-    return makeActionResult(false, "invalid_shabbat_mode", "unsupported shabbat mode");
+struct PendingShabbatMode {
+  bool shabbat;
+  ActionCallback done;
+  void* context;
+};
+
+// Aggregate: "applied" when every unit applied the mode, otherwise
+// "hc12_partial" (some applied) or "hc12_no_ack" / "hc12_rejected" (none),
+// with the per-unit outcomes in the message. The clock follows (and saves)
+// the mode once at least one unit has it, so a partial result is ok: the
+// state did change, and a retry from the UI targets the rest.
+static void finishShabbatMode(const Hc12BroadcastResult& broadcast, void* context) {
+  PendingShabbatMode* pending = static_cast<PendingShabbatMode*>(context);
+  uint8_t applied = 0, rejected = 0, silent = 0;
+  String details;
+  for (uint8_t unit = 1; unit <= HC12_MAX_BROADCAST_UNIT; unit++) {
+    uint32_t bit = 1UL << (unit - 1);
+    if ((broadcast.targets & bit) == 0) continue;
+    if (details.length() > 0) details += ", ";
+    details += "unit " + String(unit) + ": ";
+    if ((broadcast.acked & bit) == 0) {
+      silent++;
+      details += "no ACK";
+    } else if (broadcast.status[unit - 1] != HC12_STATUS_OK) {
+      rejected++;
+      details += "rejected (status " + String(broadcast.status[unit - 1]) + ")";
+    } else {
+      applied++;
+      details += "applied";
+    }
+  }
+
+  if (applied > 0) {
+    shabbatMode = pending->shabbat;
+    saveShabbatMode(shabbatMode);
+  }
+  String modeName = pending->shabbat ? "shabbat" : "week";
+  ActionResult result;
+  if (rejected == 0 && silent == 0) {
+    result = makeActionResult(true, "applied", "shabbat mode set to " + modeName + " (" + details + ")");
+  } else if (applied > 0) {
+    result = makeActionResult(true, "hc12_partial", "shabbat mode set to " + modeName + ", not on every unit (" + details + ")");
+  } else if (rejected > 0) {
+    result = makeActionResult(false, "hc12_rejected", "HC-12 remotes rejected the command (" + details + ")");
+  } else {
+    result = makeActionResult(false, "hc12_no_ack", "HC-12 no ACK (" + details + ")");
   }
+  pending->done(result, pending->context);
+  delete pending;
+}
 
-  if (!sendHC12AndWaitAck(mode)) {
-    return makeActionResult(false, "hc12_no_ack", "HC-12 no ACK");
+void applyShabbatModeAction(const String& mode, ActionCallback done, void* context) {
+  if (mode != "shabbat" && mode != "week") {
+    done(makeActionResult(false, "invalid_shabbat_mode", "unsupported shabbat mode"), context);
+    return;
   }
 
-  shabbatMode = (mode == "shabbat");
-  saveShabbatMode(shabbatMode);
-  return makeActionResult(true, "applied", "shabbat mode set to " + mode);
+  PendingShabbatMode* pending = new PendingShabbatMode{mode == "shabbat", done, context};
+  uint8_t payload = pending->shabbat ? 1 : 0;
+  if (!hc12SubmitBroadcast(HC12_SHABBAT_UNITS, HC12_OP_SET_MODE, &payload, 1, finishShabbatMode, pending)) {
+    delete pending;
+    done(makeActionResult(false, "hc12_busy", "HC-12 queue full"), context);
+  }
 }
 
 ActionResult replaceScheduleAction(uint32_t baseScheduleRevision,
@@ -86,3 +137,72 @@ ActionResult replaceScheduleAction(uint32_t baseScheduleRevision,
 
   return makeActionResult(true, "applied", "schedule replaced");
 }
+
+static int findScheduleEntry(const ScheduleEntry entries[], uint8_t count, const ScheduleEntry& key) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (entries[i].day == key.day && entries[i].hour == key.hour && entries[i].minute == key.minute) return i;
+  }
+  return -1;
+}
+
+ActionResult applyScheduleBatchAction(uint32_t baseScheduleRevision,
+                                      const ScheduleOp ops[],
+                                      uint16_t opCount) {
+  if (baseScheduleRevision != scheduleRevision) {
+    return makeActionResult(false, "stale_schedule",
+                            "schedule revision does not match device state");
+  }
+
+  ScheduleEntry work[MAX_EVENTS];
+  uint8_t workCount = scheduleCount;
+  for (uint8_t i = 0; i < scheduleCount; i++) work[i] = schedule[i];
+
+  for (uint16_t i = 0; i < opCount; i++) {
+    const ScheduleOp& op = ops[i];
+    if (op.type == SCHEDULE_OP_CLEAR) {
+      workCount = 0;
+      continue;
+    }
+
+    if (op.entry.day > 6 || op.entry.hour > 23 || op.entry.minute > 59) {
+      return makeActionResult(false, "invalid_schedule", "schedule event has invalid values");
+    }
+
+    int idx = findScheduleEntry(work, workCount, op.entry);
+    if (op.type == SCHEDULE_OP_DELETE) {
+      if (idx < 0) return makeActionResult(false, "event_not_found", "event to delete not found");
+      for (uint8_t j = idx + 1; j < workCount; j++) work[j - 1] = work[j];
+      workCount--;
+    } else if (idx >= 0) {
+      work[idx].state = op.entry.state;
+    } else {
+      if (workCount >= MAX_EVENTS) return makeActionResult(false, "schedule_full", "schedule has too many events");
+      work[workCount++] = op.entry;
+    }
+  }
+
+  scheduleCount = workCount;
+  for (uint8_t i = 0; i < workCount; i++) schedule[i] = work[i];
+
+  // Journal small batches op by op; a CLEAR (replace) needs a snapshot.
+  bool clears = false;
+  for (uint16_t i = 0; i < opCount; i++) {
+    if (ops[i].type == SCHEDULE_OP_CLEAR) clears = true;
+  }
+  if (!clears) {
+    for (uint16_t i = 0; i < opCount; i++) {
+      noteScheduleEdit(ops[i].type == SCHEDULE_OP_DELETE ? SCHEDULE_JOURNAL_DELETE : SCHEDULE_JOURNAL_UPSERT,
+                       ops[i].entry);
+    }
+  }
+
+  sortSchedule();
+  normalizeSchedule();
+  saveSchedule();
+
+  if (relayMode == 2 && timeValid) {
+    setRelayToLastEvent();
+  }
+
+  return makeActionResult(true, "applied", "schedule batch applied");
+}
@@ -13,9 +13,39 @@ struct ActionResult {
 
 ActionResult makeActionResult(bool ok, const String& code, const String& message);
 ActionResult applyRelayModeAction(const String& mode);
-ActionResult applyShabbatModeAction(const String& mode);
+
+// Completion for actions that finish later; runs on the loop thread.
+typedef void (*ActionCallback)(const ActionResult& result, void* context);
+// Broadcasts the mode to the remote units (HC12_SHABBAT_UNITS) over HC-12
+// without blocking. done() gets the aggregate once every unit has replied or
+// the attempts run out: "applied" (all units) or "hc12_partial" (some; ok,
+// since the mode is committed), else "hc12_rejected" or "hc12_no_ack", with
+// per-unit outcomes in the message; or right away for an invalid mode or a
+// full HC-12 queue ("hc12_busy").
+void applyShabbatModeAction(const String& mode, ActionCallback done, void* context);
+
 ActionResult replaceScheduleAction(uint32_t baseScheduleRevision,
                                    const ScheduleEntry entries[],
                                    uint8_t entryCount);
 
+// One step of a schedule batch. CLEAR empties the schedule, UPSERT adds the
+// event or changes the state of the one at the same (day,time), DELETE
+// removes the event at (day,time).
+enum ScheduleOpType : uint8_t {
+  SCHEDULE_OP_CLEAR = 0,
+  SCHEDULE_OP_UPSERT,
+  SCHEDULE_OP_DELETE
+};
+
+struct ScheduleOp {
+  ScheduleOpType type;
+  ScheduleEntry entry;
+};
+
+// Apply all ops to a copy of the schedule, then commit once (one sort,
+// normalize and NVS write). Nothing changes if any op fails.
+ActionResult applyScheduleBatchAction(uint32_t baseScheduleRevision,
+                                      const ScheduleOp ops[],
+                                      uint16_t opCount);
+
 #endif // CONTROL_ACTIONS_H
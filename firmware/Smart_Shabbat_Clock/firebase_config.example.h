@@ -14,4 +14,13 @@
 // Set to 0 only if you add and maintain the correct root CA certificate.
 #define FIREBASE_ALLOW_INSECURE_TLS 1
 
+// Set to 1 to add a metrics summary (heap, loop max, NVS writes) to the
+// published status; the full set is always on http://<device>/metrics.
+#define FIREBASE_PUBLISH_METRICS 0
+
+// Local testing against tools/rtdb-standin.mjs: set FIREBASE_DATABASE_URL above
+// to "http://<host>:9000" and add the matching auth URL (plain http:// is
+// accepted for this).
+// #define FIREBASE_AUTH_URL "http://192.168.1.10:9000/v1/accounts:signInWithPassword"
+
 #endif // FIREBASE_CONFIG_H
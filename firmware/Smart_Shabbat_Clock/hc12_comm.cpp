@@ -1,54 +1,460 @@
 #include <HardwareSerial.h>
-#include <ctype.h>
 #include "hc12_comm.h"
+#include "metrics.h"
+#include "power_manager.h"
+#include "task_scheduler.h"
+#include "time_utils.h"
 
-// Send a command to the HC-12 module and wait for an "ACK" reply.
-bool sendHC12AndWaitAck(const String& cmd, uint32_t timeoutMs) {
-  hc12Ok = false;
-  
-  // Clear buffer: remove any stale data or noise before sending.
-  Serial.print("HC-12: Clearing buffer... Content found: ");
-  bool junk_found = false;
+// CHANGE HERE: queued requests and RX ring size (bytes, power of two).
+static const uint8_t HC12_QUEUE_SIZE = 4;
+static const uint16_t HC12_RX_RING_SIZE = 128;
+
+// frame holds the opcode payload without the target mask; broadcasts are
+// encoded per attempt for the units still missing.
+struct Hc12Request {
+  Hc12Frame frame;
+  Hc12Callback done;
+  Hc12BroadcastCallback broadcastDone;  // set for broadcasts
+  bool unacked;                         // broadcast without replies
+  Hc12StampFn stamp;                    // unacked: fill in the payload at send time
+  uint32_t missing;                     // broadcast: targets that have not replied
+  Hc12BroadcastResult result;
+  void* context;
+};
+
+static Hc12Request requests[HC12_QUEUE_SIZE];
+static uint8_t requestHead = 0;
+static uint8_t requestCount = 0;
+
+enum Hc12State : uint8_t {
+  HC12_IDLE = 0,
+  HC12_WAITING_REPLY,  // frame sent, deadline armed
+  HC12_BACKOFF         // no reply yet, waiting to resend
+};
+
+static Hc12State state = HC12_IDLE;
+static uint8_t attempt = 0;
+static unsigned long sentAtMs = 0;
+static unsigned long resendAtMs = 0;
+static uint32_t attemptTimeoutMs = HC12_INITIAL_TIMEOUT_MS;
+static uint32_t sentTargets = 0;  // broadcast: target mask of the last attempt
+static unsigned long firstSentAtMs = 0;
+static unsigned long firstSentAtUs = 0;
+static uint8_t nextSeq = 0;  // random start in initHc12(): remotes must not see a reboot's seqs as retries
+
+static Hc12FrameDecoder decoder;
+static TaskId hc12Task = NO_TASK;
+
+// ---------------------- RX Ring ----------------------
+// Single producer (serial driver task, onReceive) and single consumer (loop
+// thread); indices only grow and are masked on access. Each byte carries
+// its arrival time, so round trips don't include the time the loop was
+// busy elsewhere (e.g. an HTTPS call) before draining the ring.
+static uint8_t rxRing[HC12_RX_RING_SIZE];
+static unsigned long rxArrivalMs[HC12_RX_RING_SIZE];
+static uint32_t rxWrite = 0;
+static uint32_t rxRead = 0;
+static uint32_t rxDropped = 0;
+
+static void onHc12Receive() {
+  unsigned long nowMs = millis();
   while (HC12.available()) {
-    Serial.print((char)HC12.read());
-    junk_found = true;
-  }
-  if (!junk_found) Serial.println("None.");
-  else Serial.println();
-  
-  // Send the command
-  HC12.println(cmd);
-  Serial.printf("HC-12: TX '%s'\n", cmd.c_str());
-
-  // CHANGE HERE: delay to let the remote switch to RX mode.
-  delay(50); // Wait for remote unit to switch to RX mode
-
-  // Wait for ACK: parse incoming stream char-by-char.
-  uint32_t start = millis();
-  String response = "";
-  
-  while (millis() - start < timeoutMs) {
-    if (HC12.available()) {
-      char c = HC12.read();
-      
-      // Only append printable characters to the response string
-      if (isascii(c) && isprint(static_cast<unsigned char>(c))) { 
-        response += c;
-      }
-      
-      // Check for "ACK" immediately after any character is received
-      if (response.length() >= 3) {
-        if (response.endsWith("ACK") || response.endsWith("ack")) { 
-          Serial.println("HC-12: RX ACK SUCCESS");
-          hc12Ok = true;  
-          return true;
-        }
+    int c = HC12.read();
+    uint32_t write = __atomic_load_n(&rxWrite, __ATOMIC_RELAXED);
+    if (write - __atomic_load_n(&rxRead, __ATOMIC_ACQUIRE) >= HC12_RX_RING_SIZE) {
+      rxDropped++;
+      continue;
+    }
+    rxRing[write & (HC12_RX_RING_SIZE - 1)] = (uint8_t)c;
+    rxArrivalMs[write & (HC12_RX_RING_SIZE - 1)] = nowMs;
+    __atomic_store_n(&rxWrite, write + 1, __ATOMIC_RELEASE);
+  }
+  schedulerNotify(hc12Task);
+}
+
+static bool rxPop(uint8_t& c, unsigned long& arrivalMs) {
+  uint32_t read = __atomic_load_n(&rxRead, __ATOMIC_RELAXED);
+  if (read == __atomic_load_n(&rxWrite, __ATOMIC_ACQUIRE)) return false;
+  c = rxRing[read & (HC12_RX_RING_SIZE - 1)];
+  arrivalMs = rxArrivalMs[read & (HC12_RX_RING_SIZE - 1)];
+  __atomic_store_n(&rxRead, read + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+// ---------------------- Link Statistics ----------------------
+// Per unit 1..32, indexed unit - 1; loop thread only.
+
+struct Hc12Link {
+  uint32_t requests;
+  uint32_t acked;
+  uint32_t lastSeen;
+  uint32_t srttMs;    // 0 until the first sample
+  uint32_t rttvarMs;
+  uint32_t rtoMs;
+  uint16_t outcomes;  // newest in bit 0, 1 = replied
+  uint8_t outcomeCount;
+  uint16_t rttHistory[HC12_RTT_HISTORY];
+  uint8_t rttCount;
+  uint8_t rttNext;
+};
+
+static Hc12Link links[HC12_MAX_BROADCAST_UNIT];
+static uint32_t linkRevision = 0;
+
+static Hc12Link* linkFor(uint8_t unit) {
+  if (unit < 1 || unit > HC12_MAX_BROADCAST_UNIT) return nullptr;
+  return &links[unit - 1];
+}
+
+static uint32_t clampTimeout(uint32_t ms) {
+  if (ms < HC12_MIN_TIMEOUT_MS) return HC12_MIN_TIMEOUT_MS;
+  if (ms > HC12_MAX_TIMEOUT_MS) return HC12_MAX_TIMEOUT_MS;
+  return ms;
+}
+
+// Reply timeout for unit on the given attempt (1-based).
+static uint32_t unitTimeoutMs(uint8_t unit, uint8_t forAttempt) {
+  const Hc12Link* link = linkFor(unit);
+  uint32_t rto = (link && link->rtoMs) ? link->rtoMs : HC12_INITIAL_TIMEOUT_MS;
+  return clampTimeout(rto << (forAttempt - 1));
+}
+
+// RFC 6298 update with one round trip.
+static void recordRtt(uint8_t unit, uint32_t rttMs) {
+  Hc12Link* link = linkFor(unit);
+  if (!link) return;
+  if (link->srttMs == 0) {
+    link->srttMs = rttMs > 0 ? rttMs : 1;
+    link->rttvarMs = rttMs / 2;
+  } else {
+    uint32_t error = rttMs > link->srttMs ? rttMs - link->srttMs : link->srttMs - rttMs;
+    link->rttvarMs = (3 * link->rttvarMs + error) / 4;
+    link->srttMs = (7 * link->srttMs + rttMs) / 8;
+  }
+  link->rtoMs = clampTimeout(link->srttMs + 4 * link->rttvarMs);
+  link->rttHistory[link->rttNext] = rttMs > 0xFFFF ? 0xFFFF : (uint16_t)rttMs;
+  link->rttNext = (link->rttNext + 1) % HC12_RTT_HISTORY;
+  if (link->rttCount < HC12_RTT_HISTORY) link->rttCount++;
+}
+
+static void recordOutcome(uint8_t unit, bool replied) {
+  Hc12Link* link = linkFor(unit);
+  if (!link) return;
+  link->requests++;
+  link->outcomes = (link->outcomes << 1) | (replied ? 1 : 0);
+  if (link->outcomeCount < HC12_OUTCOME_HISTORY) link->outcomeCount++;
+  if (replied) {
+    link->acked++;
+    if (timeValid) link->lastSeen = getCurrentDateTime().unixtime();
+  }
+  linkRevision++;
+}
+
+static uint16_t rttPercentile(const Hc12Link& link, uint8_t percent) {
+  if (link.rttCount == 0) return 0;
+  uint16_t sorted[HC12_RTT_HISTORY];
+  memcpy(sorted, link.rttHistory, link.rttCount * sizeof(uint16_t));
+  for (uint8_t i = 1; i < link.rttCount; i++) {
+    uint16_t value = sorted[i];
+    uint8_t j = i;
+    for (; j > 0 && sorted[j - 1] > value; j--) sorted[j] = sorted[j - 1];
+    sorted[j] = value;
+  }
+  return sorted[(link.rttCount - 1) * percent / 100];
+}
+
+bool hc12LinkSummary(uint8_t unit, Hc12LinkSummary& out) {
+  const Hc12Link* link = linkFor(unit);
+  if (!link || link->outcomeCount == 0) return false;
+  uint8_t replied = 0;
+  for (uint8_t i = 0; i < link->outcomeCount; i++) replied += (link->outcomes >> i) & 1;
+  out.ok = (link->outcomes & 1) != 0;
+  out.successPct = (uint8_t)(replied * 100 / link->outcomeCount);
+  out.rttP50Ms = rttPercentile(*link, 50);
+  out.rttP90Ms = rttPercentile(*link, 90);
+  out.srttMs = (uint16_t)link->srttMs;
+  out.rtoMs = (uint16_t)unitTimeoutMs(unit, 1);
+  out.requests = link->requests;
+  out.acked = link->acked;
+  out.lastSeen = link->lastSeen;
+  return true;
+}
+
+uint32_t hc12LinkRevision() {
+  return linkRevision;
+}
+
+void hc12WritePrometheus(Print& out) {
+  out.print("# TYPE shabbat_hc12_requests_total counter\n");
+  out.print("# TYPE shabbat_hc12_acked_total counter\n");
+  out.print("# TYPE shabbat_hc12_srtt_ms gauge\n");
+  out.print("# TYPE shabbat_hc12_rto_ms gauge\n");
+  for (uint8_t unit = 1; unit <= HC12_MAX_BROADCAST_UNIT; unit++) {
+    Hc12LinkSummary link;
+    if (!hc12LinkSummary(unit, link)) continue;
+    out.printf("shabbat_hc12_requests_total{unit=\"%u\"} %lu\n", unit, (unsigned long)link.requests);
+    out.printf("shabbat_hc12_acked_total{unit=\"%u\"} %lu\n", unit, (unsigned long)link.acked);
+    out.printf("shabbat_hc12_srtt_ms{unit=\"%u\"} %u\n", unit, link.srttMs);
+    out.printf("shabbat_hc12_rto_ms{unit=\"%u\"} %u\n", unit, link.rtoMs);
+  }
+  out.print("# TYPE shabbat_hc12_crc_errors_total counter\n");
+  out.printf("shabbat_hc12_crc_errors_total %lu\n", (unsigned long)decoder.crcErrors);
+  out.print("# TYPE shabbat_hc12_rx_dropped_total counter\n");
+  out.printf("shabbat_hc12_rx_dropped_total %lu\n", (unsigned long)rxDropped);
+}
+
+// ---------------------- Transactions ----------------------
+
+static uint8_t unitCount(uint32_t units) {
+  uint8_t count = 0;
+  for (; units != 0; units &= units - 1) count++;
+  return count;
+}
+
+// Reply window of the current request's given attempt: the unit's timeout,
+// or for a broadcast the latest slot start plus that unit's timeout.
+static uint32_t attemptWindowMs(uint8_t forAttempt) {
+  const Hc12Request& request = requests[requestHead];
+  if (!request.broadcastDone) return unitTimeoutMs(request.frame.unit, forAttempt);
+  uint32_t window = 0;
+  uint8_t slot = 0;
+  for (uint8_t unit = 1; unit <= HC12_MAX_BROADCAST_UNIT; unit++) {
+    if ((request.missing & (1UL << (unit - 1))) == 0) continue;
+    uint32_t unitWindow = (uint32_t)slot++ * HC12_REPLY_SLOT_MS + unitTimeoutMs(unit, forAttempt);
+    if (unitWindow > window) window = unitWindow;
+  }
+  return window;
+}
+
+static void startNext();
+
+// Pop an unacked broadcast right after it went out.
+static void finishUnacked() {
+  state = HC12_IDLE;
+  powerHoldAwake(false);
+  requestHead = (requestHead + 1) % HC12_QUEUE_SIZE;
+  requestCount--;
+  if (requestCount > 0) startNext();
+}
+
+static void sendCurrent() {
+  Hc12Request& request = requests[requestHead];
+  if (request.stamp) request.stamp(request.frame.payload, request.frame.length);
+  Hc12Frame frame = request.frame;
+  attemptTimeoutMs = attemptWindowMs(attempt + 1);
+  if (request.broadcastDone || request.unacked) {
+    hc12MakeBroadcast(frame.seq, frame.opcode, request.missing, request.frame.payload, request.frame.length, frame);
+    sentTargets = request.missing;
+  }
+  uint8_t wire[HC12_MAX_FRAME];
+  size_t length = hc12EncodeFrame(frame, wire);
+  HC12.write(wire, length);
+  if (request.unacked) {
+    HC12.flush();  // light sleep would stop the UART mid-frame
+    finishUnacked();
+    return;
+  }
+  attempt++;
+  sentAtMs = millis();
+  state = HC12_WAITING_REPLY;
+  if (request.broadcastDone) {
+    Serial.printf("HC-12: TX broadcast to %u units (0x%08lx) seq %u op 0x%02x (attempt %u, window %lu ms)\n",
+                  unitCount(request.missing), (unsigned long)request.missing, frame.seq, frame.opcode, attempt,
+                  (unsigned long)attemptTimeoutMs);
+  } else {
+    Serial.printf("HC-12: TX unit %u seq %u op 0x%02x (attempt %u, timeout %lu ms)\n", frame.unit, frame.seq,
+                  frame.opcode, attempt, (unsigned long)attemptTimeoutMs);
+  }
+  schedulerDelay(hc12Task, attemptTimeoutMs);
+}
+
+static void startNext() {
+  if (requestCount == 0) return;
+  decoder.reset();
+  attempt = 0;
+  firstSentAtMs = millis();
+  firstSentAtUs = micros();
+  powerHoldAwake(true);  // the reply must not arrive during light sleep
+  sendCurrent();
+}
+
+// reply is the unicast reply, or nullptr.
+static void finishCurrent(bool acked, const Hc12Frame* reply) {
+  Hc12Request& request = requests[requestHead];
+  uint8_t status = reply ? reply->payload[0] : 0;
+  state = HC12_IDLE;
+  powerHoldAwake(false);
+  metricsRecordUs(METRIC_HC12, micros() - firstSentAtUs);
+  if (request.broadcastDone) {
+    Serial.printf("HC-12: broadcast seq %u: %u/%u units replied after %u attempts\n", request.frame.seq,
+                  unitCount(request.result.acked), unitCount(request.result.targets), attempt);
+  } else if (acked) {
+    Serial.printf("HC-12: unit %u seq %u replied status %u after %lu ms\n", request.frame.unit, request.frame.seq,
+                  status, millis() - sentAtMs);
+  } else {
+    Serial.printf("HC-12: unit %u seq %u no reply after %u attempts (crc errors %lu, rx dropped %lu)\n",
+                  request.frame.unit, request.frame.seq, attempt, (unsigned long)decoder.crcErrors,
+                  (unsigned long)rxDropped);
+  }
+  if (request.broadcastDone) {
+    for (uint8_t unit = 1; unit <= HC12_MAX_BROADCAST_UNIT; unit++) {
+      uint32_t bit = 1UL << (unit - 1);
+      if (request.result.targets & bit) recordOutcome(unit, (request.result.acked & bit) != 0);
+    }
+  } else {
+    recordOutcome(request.frame.unit, acked);
+  }
+
+  // Pop before the callback, which may submit the next request.
+  Hc12Callback done = request.done;
+  Hc12BroadcastCallback broadcastDone = request.broadcastDone;
+  Hc12BroadcastResult result = request.result;
+  void* context = request.context;
+  requestHead = (requestHead + 1) % HC12_QUEUE_SIZE;
+  requestCount--;
+  if (broadcastDone) broadcastDone(result, context);
+  else if (done) done(acked, status, reply, context);
+  if (state == HC12_IDLE && requestCount > 0) startNext();
+}
+
+// Record a reply (its last byte received at arrivalMs) to the current
+// request; true once the request is complete.
+static bool takeReply(const Hc12Frame& reply, unsigned long arrivalMs) {
+  Hc12Request& request = requests[requestHead];
+  // Karn's rule: after a resend the reply may answer either attempt.
+  uint32_t rttMs = (long)(arrivalMs - sentAtMs) > 0 ? arrivalMs - sentAtMs : 0;
+  if (!request.broadcastDone) {
+    if (attempt == 1) recordRtt(reply.unit, rttMs);
+    finishCurrent(true, &reply);
+    return true;
+  }
+  uint32_t bit = (reply.unit >= 1 && reply.unit <= HC12_MAX_BROADCAST_UNIT) ? 1UL << (reply.unit - 1) : 0;
+  if ((request.result.targets & bit) == 0) {
+    Serial.printf("HC-12: broadcast reply from untargeted unit %u\n", reply.unit);
+    return false;
+  }
+  // A duplicate (late reply to an earlier attempt) just overwrites the status.
+  if (attempt == 1 && (request.result.acked & bit) == 0) {
+    uint32_t slotMs = (uint32_t)hc12ReplySlot(sentTargets, reply.unit) * HC12_REPLY_SLOT_MS;
+    recordRtt(reply.unit, rttMs > slotMs ? rttMs - slotMs : 0);
+  }
+  request.result.acked |= bit;
+  request.result.status[reply.unit - 1] = reply.payload[0];
+  request.missing &= ~bit;
+  if (request.missing != 0) return false;
+  finishCurrent(true, nullptr);
+  return true;
+}
+
+// Loop task: notified on RX and on submit, re-armed for reply deadlines and
+// retry backoff.
+static void tickHc12() {
+  if (state == HC12_IDLE) {
+    startNext();
+    return;
+  }
+
+  uint8_t c;
+  unsigned long arrivalMs;
+  Hc12Frame frame;
+  while (rxPop(c, arrivalMs)) {
+    for (bool got = decoder.push(c, frame); got; got = decoder.next(frame)) {
+      // Every attempt reuses the seq, so a late reply to an earlier attempt counts.
+      if (hc12IsReplyTo(frame, requests[requestHead].frame)) {
+        if (takeReply(frame, arrivalMs)) return;
+        continue;
       }
+      // Stale reply to an earlier request, or another unit's traffic.
+      Serial.printf("HC-12: ignored frame unit %u seq %u op 0x%02x\n", frame.unit, frame.seq, frame.opcode);
     }
-    delay(1); // Check frequently
   }
-  
-  // Failure handling: ACK was not received in time.
-  Serial.printf("HC-12 command '%s' FAILED ACK. Response: '%s'\n", cmd.c_str(), response.c_str());
-  return false;
+
+  unsigned long elapsedMs = millis() - sentAtMs;
+  if (state == HC12_WAITING_REPLY) {
+    if (elapsedMs < attemptTimeoutMs) {
+      schedulerDelay(hc12Task, attemptTimeoutMs - elapsedMs);
+      return;
+    }
+    uint32_t backoff = HC12_RETRY_BACKOFF_MS << (attempt - 1);
+    backoff += esp_random() % (backoff + 1);  // two clocks retrying together drift apart
+    // Retry budget: another attempt only if it ends within the budget,
+    // which a broadcast extends by its first attempt's reply slots.
+    const Hc12Request& request = requests[requestHead];
+    uint32_t budgetMs = HC12_TRANSACTION_BUDGET_MS;
+    if (request.broadcastDone) budgetMs += (uint32_t)(unitCount(request.result.targets) - 1) * HC12_REPLY_SLOT_MS;
+    uint32_t spentMs = millis() - firstSentAtMs;
+    bool fits = spentMs + backoff + attemptWindowMs(attempt + 1) <= budgetMs;
+    if (attempt >= HC12_MAX_ATTEMPTS || (attempt >= HC12_MIN_ATTEMPTS && !fits)) {
+      finishCurrent(false, nullptr);
+      return;
+    }
+    state = HC12_BACKOFF;
+    resendAtMs = millis() + backoff;
+    schedulerDelay(hc12Task, backoff);
+    return;
+  }
+
+  // HC12_BACKOFF: RX notifications can run the task before the resend is due.
+  long untilResend = (long)(resendAtMs - millis());
+  if (untilResend <= 0) sendCurrent();
+  else schedulerDelay(hc12Task, untilResend);
+}
+
+void initHc12(int8_t rxPin, int8_t txPin) {
+  HC12.begin(9600, SERIAL_8N1, rxPin, txPin);
+  nextSeq = (uint8_t)esp_random();
+  hc12Task = schedulerAddOneShot("hc12", tickHc12, NOT_SCHEDULED);
+  HC12.onReceive(onHc12Receive, false);  // every FIFO chunk, not only on RX timeout
+}
+
+static Hc12Request* queueRequest(uint8_t unit, uint8_t opcode, const uint8_t* payload, uint8_t length,
+                                 uint8_t maxLength) {
+  if (requestCount >= HC12_QUEUE_SIZE || length > maxLength) {
+    Serial.printf("HC-12: request op 0x%02x for unit %u rejected (queue full or payload too long).\n", opcode, unit);
+    return nullptr;
+  }
+  Hc12Request& request = requests[(requestHead + requestCount) % HC12_QUEUE_SIZE];
+  memset(&request, 0, sizeof(request));
+  request.frame.unit = unit;
+  request.frame.seq = nextSeq++;
+  request.frame.opcode = opcode;
+  request.frame.length = length;
+  memcpy(request.frame.payload, payload, length);
+  requestCount++;
+  if (state == HC12_IDLE) schedulerDelay(hc12Task, 0);
+  return &request;
+}
+
+bool hc12Submit(uint8_t unit, uint8_t opcode, const uint8_t* payload, uint8_t length,
+                Hc12Callback done, void* context) {
+  Hc12Request* request = queueRequest(unit, opcode, payload, length, HC12_MAX_PAYLOAD);
+  if (!request) return false;
+  request->done = done;
+  request->context = context;
+  return true;
+}
+
+bool hc12SubmitUnacked(uint32_t targets, uint8_t opcode, const uint8_t* payload, uint8_t length,
+                       Hc12StampFn stamp) {
+  if (targets == 0) return false;
+  Hc12Request* request =
+      queueRequest(HC12_UNIT_BROADCAST, opcode, payload, length, HC12_MAX_PAYLOAD - HC12_TARGETS_SIZE);
+  if (!request) return false;
+  request->unacked = true;
+  request->stamp = stamp;
+  request->missing = targets;
+  return true;
+}
+
+bool hc12SubmitBroadcast(uint32_t targets, uint8_t opcode, const uint8_t* payload, uint8_t length,
+                         Hc12BroadcastCallback done, void* context) {
+  if (targets == 0 || done == nullptr) return false;
+  Hc12Request* request =
+      queueRequest(HC12_UNIT_BROADCAST, opcode, payload, length, HC12_MAX_PAYLOAD - HC12_TARGETS_SIZE);
+  if (!request) return false;
+  request->broadcastDone = done;
+  request->missing = targets;
+  request->result.targets = targets;
+  request->context = context;
+  return true;
 }
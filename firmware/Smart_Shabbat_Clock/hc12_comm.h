@@ -2,15 +2,110 @@
 #define HC12_COMM_H
 
 // HC-12 radio helper interface; implemented in hc12_comm.cpp.
+//
+// Non-blocking transaction engine over the framed protocol in the Hc12Frame
+// library (firmware/libraries/Hc12Frame): hc12Submit() queues a request for
+// one unit and returns at once. The "hc12" loop task sends one request at a
+// time, retries with backoff until the matching reply (same unit, seq and
+// opcode) arrives or the attempts run out, then runs the callback on the
+// loop thread. UART RX is drained into a ring buffer from the serial
+// driver's receive callback, which stamps each byte's arrival time (for
+// round trips) and wakes the loop task.
+//
+// hc12SubmitBroadcast() reaches several units with one frame: the units
+// answer in their reply slots (see hc12_frame.h) within one window (the
+// last slot's start plus that unit's timeout), and each retry only targets
+// the units that have not replied yet.
+//
+// Timeouts adapt per unit (units 1..32) from measured round trips, as TCP
+// does (RFC 6298): SRTT/RTTVAR give the unit's timeout RTO = SRTT + 4 RTTVAR,
+// doubled per retry. Only replies to a first attempt are sampled, since a
+// retry reuses the seq. Retries continue while the next attempt still fits
+// the transaction budget (plus the reply slots for a broadcast), between
+// HC12_MIN_ATTEMPTS and HC12_MAX_ATTEMPTS, so a fast link gets more, quicker
+// tries and a slow one fewer, longer ones.
 
 #include <stdint.h>
+#include <hc12_frame.h>
 
 class String;
 class HardwareSerial;
+class Print;
+
+// Completion: acked is false when no matching reply came back; status is
+// the reply's Hc12Status and reply the whole reply (nullptr without one).
+// Runs on the loop thread.
+typedef void (*Hc12Callback)(bool acked, uint8_t status, const Hc12Frame* reply, void* context);
+
+// Per-unit outcome of a broadcast; masks use bit n-1 for unit n.
+struct Hc12BroadcastResult {
+  uint32_t targets;                           // units asked
+  uint32_t acked;                             // units that replied
+  uint8_t status[HC12_MAX_BROADCAST_UNIT];    // reply Hc12Status, by unit - 1
+};
+typedef void (*Hc12BroadcastCallback)(const Hc12BroadcastResult& result, void* context);
+
+// CHANGE HERE: remote units that follow the Shabbat mode, bit n-1 = unit n
+// (e.g. units 1 and 3: (1UL << 0) | (1UL << 2)).
+static const uint32_t HC12_SHABBAT_UNITS = 1UL << 0;
+// CHANGE HERE: reply timeout before a unit has RTT samples, and the
+// bounds of the adaptive timeout (ms).
+static const uint32_t HC12_INITIAL_TIMEOUT_MS = 300;
+static const uint32_t HC12_MIN_TIMEOUT_MS = 50;
+static const uint32_t HC12_MAX_TIMEOUT_MS = 1500;
+// CHANGE HERE: attempt limits, time budget per transaction (ms) and retry
+// backoff (ms, doubled per retry, plus up to the same again as jitter).
+static const uint8_t HC12_MIN_ATTEMPTS = 2;
+static const uint8_t HC12_MAX_ATTEMPTS = 6;
+static const uint32_t HC12_TRANSACTION_BUDGET_MS = 3000;
+static const uint32_t HC12_RETRY_BACKOFF_MS = 100;
+// RTT samples kept per unit for percentiles, and transaction outcomes (max 16)
+// for the success rate.
+static const uint8_t HC12_RTT_HISTORY = 16;
+static const uint8_t HC12_OUTCOME_HISTORY = 16;
+
+// Link statistics of one unit, for the status JSON and /metrics.
+struct Hc12LinkSummary {
+  bool ok;               // last transaction got a reply
+  uint8_t successPct;    // replies over the last HC12_OUTCOME_HISTORY transactions
+  uint16_t rttP50Ms;     // over the last HC12_RTT_HISTORY samples, 0 = none yet
+  uint16_t rttP90Ms;
+  uint16_t srttMs;
+  uint16_t rtoMs;        // current timeout for a first attempt
+  uint32_t requests;     // transactions since boot
+  uint32_t acked;
+  uint32_t lastSeen;     // local unixtime of the last reply, 0 = never
+};
+
+// Start the UART and register the loop task; call once in setup().
+void initHc12(int8_t rxPin, int8_t txPin);
+// Queue a request (loop thread). Returns false (callback not called) if the
+// queue is full or the payload is too long.
+bool hc12Submit(uint8_t unit, uint8_t opcode, const uint8_t* payload, uint8_t length,
+                Hc12Callback done, void* context);
+// Queue a broadcast to the units in targets (units 1..32). Same rules as
+// hc12Submit(); the payload must leave room for the target mask.
+bool hc12SubmitBroadcast(uint32_t targets, uint8_t opcode, const uint8_t* payload, uint8_t length,
+                         Hc12BroadcastCallback done, void* context);
+// Fills in time-critical payload fields right before the frame is written
+// (loop thread); length is the opcode payload's.
+typedef void (*Hc12StampFn)(uint8_t* payload, uint8_t length);
+
+// Queue a broadcast that nobody answers (time beacons): sent once, in queue
+// order, and not counted in the link statistics. stamp (optional) runs when
+// the frame goes out, which can be seconds after it was queued.
+bool hc12SubmitUnacked(uint32_t targets, uint8_t opcode, const uint8_t* payload, uint8_t length,
+                       Hc12StampFn stamp = nullptr);
+
+// Summary for unit (1..32); false if it has no outcome yet. Loop thread
+// only, like the statistics it reads: the web API serves it from the status
+// snapshot and the deferred /metrics action.
+bool hc12LinkSummary(uint8_t unit, Hc12LinkSummary& out);
+// Bumped whenever a unit's statistics change (status signatures).
+uint32_t hc12LinkRevision();
+// Loop thread only, as hc12LinkSummary().
+void hc12WritePrometheus(Print& out);
 
-// CHANGE HERE: default ACK timeout (ms).
-bool sendHC12AndWaitAck(const String& cmd, uint32_t timeoutMs = 1500);
 extern HardwareSerial HC12;
-extern bool hc12Ok;
 
 #endif // HC12_COMM_H
@@ -0,0 +1,176 @@
+#include "i2c_bus.h"
+#include "task_scheduler.h"
+#include <Wire.h>
+
+// CHANGE HERE: queue depths per priority, i2c task priority (loop runs at
+// 1, button at 3) and stack size.
+static const UBaseType_t I2C_HIGH_QUEUE_DEPTH = 4;
+static const UBaseType_t I2C_LOW_QUEUE_DEPTH = 2;
+static const UBaseType_t I2C_TASK_PRIORITY = 2;
+static const uint32_t I2C_TASK_STACK = 3072;
+
+struct I2cJob {
+  I2cDevice device;
+  I2cJobFn fn;
+  uint8_t data[I2C_JOB_DATA_SIZE];
+};
+
+struct I2cDeviceState {
+  I2cDeviceConfig config;
+  bool registered;
+  bool present;      // i2c task's view; read from any task
+  bool reported;     // loop thread: last value copied to *config.available
+  uint32_t jobs;
+  uint32_t dropped;  // queued while missing, or queue full
+  uint32_t probeFailures;
+  uint32_t maxJobUs;
+};
+
+static I2cDeviceState devices[I2C_DEVICE_COUNT];
+static QueueHandle_t queues[2] = {nullptr, nullptr};  // by I2cPriority
+static TaskHandle_t busTask = nullptr;
+static TaskId presenceTask = NO_TASK;
+
+static bool probe(uint8_t address) {
+  Wire.beginTransmission(address);
+  return Wire.endTransmission() == 0;
+}
+
+static void setPresent(I2cDevice device, bool present) {
+  I2cDeviceState& state = devices[device];
+  __atomic_store_n(&state.present, present, __ATOMIC_RELEASE);
+  Serial.printf("I2C: %s (0x%02x) %s\n", state.config.name, state.config.address,
+                present ? "attached" : "not responding, re-probing");
+  schedulerNotify(presenceTask);
+}
+
+// ---------------------- I2C Task ----------------------
+
+static void runJob(const I2cJob& job) {
+  I2cDeviceState& state = devices[job.device];
+  if (!__atomic_load_n(&state.present, __ATOMIC_ACQUIRE)) {
+    __atomic_fetch_add(&state.dropped, 1, __ATOMIC_RELAXED);
+    return;
+  }
+  Wire.setTimeOut(state.config.timeoutMs);
+  unsigned long startUs = micros();
+  job.fn(job.data);
+  bool acked = probe(state.config.address);
+  uint32_t elapsedUs = micros() - startUs;
+  state.jobs++;
+  if (elapsedUs > state.maxJobUs) state.maxJobUs = elapsedUs;
+  if (!acked) {
+    state.probeFailures++;
+    setPresent(job.device, false);
+  }
+}
+
+// True if any registered device is still missing.
+static bool reprobeMissing() {
+  bool missing = false;
+  for (uint8_t i = 0; i < I2C_DEVICE_COUNT; i++) {
+    I2cDeviceState& state = devices[i];
+    if (!state.registered || __atomic_load_n(&state.present, __ATOMIC_ACQUIRE)) continue;
+    Wire.setTimeOut(state.config.timeoutMs);
+    if (probe(state.config.address) && (!state.config.attach || state.config.attach())) {
+      setPresent((I2cDevice)i, true);
+    } else {
+      missing = true;
+    }
+  }
+  return missing;
+}
+
+static void busTaskMain(void*) {
+  bool missing = reprobeMissing();
+  TickType_t lastProbe = xTaskGetTickCount();
+  for (;;) {
+    if (missing && xTaskGetTickCount() - lastProbe >= pdMS_TO_TICKS(I2C_REPROBE_INTERVAL_MS)) {
+      missing = reprobeMissing();
+      lastProbe = xTaskGetTickCount();
+    }
+    // Every waiting high-priority job goes before the next low-priority one.
+    I2cJob job;
+    if (xQueueReceive(queues[I2C_PRIORITY_HIGH], &job, 0) == pdTRUE ||
+        xQueueReceive(queues[I2C_PRIORITY_LOW], &job, 0) == pdTRUE) {
+      runJob(job);
+      if (!__atomic_load_n(&devices[job.device].present, __ATOMIC_ACQUIRE)) missing = true;
+      continue;
+    }
+    // Idle until a job is queued, or the next re-probe is due.
+    ulTaskNotifyTake(pdTRUE, missing ? pdMS_TO_TICKS(I2C_REPROBE_INTERVAL_MS) : portMAX_DELAY);
+  }
+}
+
+// ---------------------- Loop Side ----------------------
+
+static void applyPresence() {
+  for (uint8_t i = 0; i < I2C_DEVICE_COUNT; i++) {
+    I2cDeviceState& state = devices[i];
+    if (!state.registered) continue;
+    bool present = __atomic_load_n(&state.present, __ATOMIC_ACQUIRE);
+    if (present == state.reported) continue;
+    state.reported = present;
+    if (state.config.available) *state.config.available = present;
+    if (state.config.changed) state.config.changed(present);
+  }
+}
+
+void i2cRegisterDevice(I2cDevice device, const I2cDeviceConfig& config, bool present) {
+  if (device >= I2C_DEVICE_COUNT) return;
+  I2cDeviceState& state = devices[device];
+  state.config = config;
+  state.registered = true;
+  state.present = present;
+  state.reported = present;
+}
+
+void initI2cBus() {
+  queues[I2C_PRIORITY_HIGH] = xQueueCreate(I2C_HIGH_QUEUE_DEPTH, sizeof(I2cJob));
+  queues[I2C_PRIORITY_LOW] = xQueueCreate(I2C_LOW_QUEUE_DEPTH, sizeof(I2cJob));
+  presenceTask = schedulerAddOneShot("i2c", applyPresence, NOT_SCHEDULED);
+  xTaskCreate(busTaskMain, "i2c", I2C_TASK_STACK, nullptr, I2C_TASK_PRIORITY, &busTask);
+}
+
+bool i2cBusStarted() {
+  return busTask != nullptr;
+}
+
+bool i2cSubmit(I2cDevice device, I2cJobFn fn, const void* data, uint8_t length) {
+  if (device >= I2C_DEVICE_COUNT || busTask == nullptr || length > I2C_JOB_DATA_SIZE) return false;
+  I2cDeviceState& state = devices[device];
+  if (!state.registered || !__atomic_load_n(&state.present, __ATOMIC_ACQUIRE)) return false;
+  I2cJob job;
+  job.device = device;
+  job.fn = fn;
+  if (length > 0) memcpy(job.data, data, length);
+  if (xQueueSend(queues[state.config.priority], &job, 0) != pdTRUE) {
+    __atomic_fetch_add(&state.dropped, 1, __ATOMIC_RELAXED);
+    return false;
+  }
+  xTaskNotifyGive(busTask);
+  return true;
+}
+
+bool i2cDevicePresent(I2cDevice device) {
+  if (device >= I2C_DEVICE_COUNT) return false;
+  return __atomic_load_n(&devices[device].present, __ATOMIC_ACQUIRE);
+}
+
+void i2cWritePrometheus(Print& out) {
+  out.print("# TYPE shabbat_i2c_present gauge\n");
+  out.print("# TYPE shabbat_i2c_jobs_total counter\n");
+  out.print("# TYPE shabbat_i2c_dropped_total counter\n");
+  out.print("# TYPE shabbat_i2c_probe_failures_total counter\n");
+  out.print("# TYPE shabbat_i2c_max_job_us gauge\n");
+  for (uint8_t i = 0; i < I2C_DEVICE_COUNT; i++) {
+    const I2cDeviceState& state = devices[i];
+    if (!state.registered) continue;
+    const char* name = state.config.name;
+    out.printf("shabbat_i2c_present{device=\"%s\"} %u\n", name, i2cDevicePresent((I2cDevice)i) ? 1 : 0);
+    out.printf("shabbat_i2c_jobs_total{device=\"%s\"} %lu\n", name, (unsigned long)state.jobs);
+    out.printf("shabbat_i2c_dropped_total{device=\"%s\"} %lu\n", name, (unsigned long)state.dropped);
+    out.printf("shabbat_i2c_probe_failures_total{device=\"%s\"} %lu\n", name, (unsigned long)state.probeFailures);
+    out.printf("shabbat_i2c_max_job_us{device=\"%s\"} %lu\n", name, (unsigned long)state.maxJobUs);
+  }
+}
@@ -0,0 +1,65 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// ---------------------- I2C Bus Manager ----------------------
+// Once initI2cBus() has run, only the "i2c" FreeRTOS task touches Wire:
+// the loop queues jobs and never waits on the bus, so a slow or NACKing
+// device (e.g. a loose LCD connector) only holds up that task. Every RTC
+// and LCD access after boot goes through a job, including the DST
+// correction (rtcCorrectDst() in time_utils.h).
+//   - Priority: jobs of high-priority devices (the RTC) run before any
+//     waiting job of a low-priority one (LCD frames).
+//   - Timeouts: Wire's timeout is set per device before each of its jobs.
+//   - Hot-plug: each job is followed by an address probe; a device that
+//     doesn't ACK is marked missing and its jobs are dropped. Missing
+//     devices are re-probed every I2C_REPROBE_INTERVAL_MS, and attach()
+//     re-initializes one that answers again. The "i2c" loop task then
+//     updates the device's available flag and calls changed().
+// Before initI2cBus() (boot), drivers use Wire directly on the loop thread.
+
+enum I2cDevice : uint8_t {
+  I2C_DEVICE_RTC = 0,
+  I2C_DEVICE_LCD,
+  I2C_DEVICE_COUNT
+};
+
+enum I2cPriority : uint8_t {
+  I2C_PRIORITY_HIGH = 0,
+  I2C_PRIORITY_LOW
+};
+
+// CHANGE HERE: re-probe period for missing devices (ms) and the largest job
+// payload (bytes; an LCD frame is LCD_COLS * LCD_ROWS).
+static const uint32_t I2C_REPROBE_INTERVAL_MS = 2000;
+static const uint8_t I2C_JOB_DATA_SIZE = 80;
+
+// Runs on the i2c task with the job's copy of the data.
+typedef void (*I2cJobFn)(const uint8_t* data);
+
+struct I2cDeviceConfig {
+  const char* name;
+  uint8_t address;
+  uint16_t timeoutMs;         // Wire timeout for this device's jobs
+  I2cPriority priority;
+  bool (*attach)();           // i2c task: re-init after the device reappeared
+  void (*changed)(bool present);  // loop thread, after presence changed (may be nullptr)
+  bool* available;            // loop-thread flag kept in step (e.g. &lcdAvailable)
+};
+
+// Describe a device; present is the result of its boot probe. Call for
+// every device before initI2cBus().
+void i2cRegisterDevice(I2cDevice device, const I2cDeviceConfig& config, bool present);
+// Start the i2c task and the "i2c" loop task; call once in setup().
+void initI2cBus();
+bool i2cBusStarted();
+// Queue a job (any task). Returns false if the device is missing or its
+// queue is full; the caller retries later.
+bool i2cSubmit(I2cDevice device, I2cJobFn fn, const void* data = nullptr, uint8_t length = 0);
+bool i2cDevicePresent(I2cDevice device);
+// Per-device jobs, drops, failed probes and worst job time; appended to /metrics.
+void i2cWritePrometheus(Print& out);
+
+#endif // I2C_BUS_H
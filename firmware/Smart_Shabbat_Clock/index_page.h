@@ -1,424 +1,382 @@
 // ---------------------- index_page.h ----------------------
-#include <pgmspace.h>
-// CHANGE HERE: edit the HTML/CSS/JS below to customize the web UI.
-const char index_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-    <meta charset='UTF-8'>
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>שעון שבת חכם</title>
-    <style>
-        body {
-            font-family: Arial, sans-serif;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            margin: 0;
-            padding: 40px;
-            min-height: 100vh;
-            box-sizing: border-box;
-            direction: rtl; 
-            text-align: right;
-        }
-        .container {
-            max-width: 600px;
-            margin: 0 auto;
-            background: rgba(255, 255, 255, 0.95);
-            border-radius: 20px;
-            padding: 40px;
-            box-shadow: 0 20px 40px rgba(0, 0, 0, 0.1);
-        }
-        h2, .time-display {
-            color: #333;
-            text-align: center;
-        }
-        .time-display {
-            font-size: 32px;
-            margin-bottom: 20px;
-        }
-        .section-group {
-            margin-top: 30px;
-            padding: 20px;
-            background: #f9f9f9;
-            border-radius: 10px;
-            box-shadow: 0 4px 8px rgba(0, 0, 0, 0.05);
-        }
-        .section-header {
-            text-align: center;
-            color: #444;
-            margin-top: 0;
-            margin-bottom: 20px;
-            border-bottom: 2px solid #764ba2;
-            padding-bottom: 10px;
-        }
-        .control-group, .schedule-group {
-            margin: 30px 0;
-            text-align: center;
-        }
-        .control-label {
-            font-size: 18px;
-            font-weight: bold;
-            color: #333;
-            margin-bottom: 15px;
-            display: block;
-        }
-        select, input[type="time"], input[type="number"] {
-            font-size: 16px;
-            padding: 6px;
-            margin: 10px;
-            border: 1px solid #ccc;
-            border-radius: 5px;
-            text-align: right;
-        }
-        .toggle-switch {
-            position: relative;
-            display: inline-block;
-            width: 80px;
-            height: 40px;
-        }
-        .toggle-row {
-            display: flex;
-            align-items: center;
-            justify-content: center;
-            gap: 12px;            
-            margin-top: 6px;
-            direction: rtl;
-        }
-        .toggle-caption {
-            font-size: 14px;
-            font-weight: bold;
-            color: #444;
-            line-height: 1;
-            direction: rtl;
-        }    
-        .toggle-switch input { opacity: 0; width: 0; height: 0; }
-        .slider {
-            position: absolute; cursor: pointer; top: 0; left: 0; right: 0; bottom: 0;
-            background-color: #ccc; transition: .3s; border-radius: 40px;
-            box-shadow: 0 4px 15px rgba(0, 0, 0, 0.2);
-        }
-        .slider:before {
-            position: absolute; content: "";
-            height: 32px; width: 32px; left: 4px; bottom: 4px;
-            background-color: white; transition: .3s; border-radius: 50%;
-            box-shadow: 0 2px 10px rgba(0, 0, 0, 0.3);
-            transform: translateX(40px);
-        }
-        input:checked + .slider { background-color: #4CAF50; }
-        input:checked + .slider:before { transform: translateX(0); }
-        
-        /* כפתורי On/Auto/Off */
-        .three-way-switch {
-            text-align: center;
-        }
-        .three-way-switch button {
-            padding: 10px 20px; margin: 0 5px; border: none; border-radius: 5px;
-            font-size: 14px; cursor: pointer; background-color: #ccc; color: #000;
-        }
-        .three-way-switch button.active { background-color: #4CAF50; color: #fff; }
-        .relay-indicator {
-            display: inline-block; width: 16px; height: 16px; border-radius: 50%;
-            margin-right: 10px; 
-            vertical-align: middle; background-color: #bbb;
-        }
-        .relay-indicator.on { background-color: #00cc44; }
-        
-        table { width: 100%; border-collapse: collapse; margin-top: 10px; }
-        th, td { border: 1px solid #ccc; padding: 8px; text-align: center; }
-        th { background-color: #f2f2f2; }
-        .hint { font-size: 12px; color: #555; margin-top: 6px; text-align: center; }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <div class="time-display" id="clockDisplay">--:--</div>
-        <h2>✨ מערכת שליטה חכמה</h2>
-        <div id="statusBar" class="hint">טוען סטטוס...</div>
-
-        <div id="manualTime" class="control-group" style="display:none">
-          <label class="control-label">קביעת זמן ידנית</label>
-          <div style="display:flex;gap:8px;justify-content:center;flex-wrap:wrap; direction: rtl;">
-            <input id="mt_S" type="number" min="0" max="59"   placeholder="SS">
-            <input id="mt_M" type="number" min="0" max="59"   placeholder="MM">
-            <input id="mt_H" type="number" min="0" max="23"   placeholder="HH">
-            <input id="mt_d" type="number" min="1" max="31"   placeholder="DD">
-            <input id="mt_m" type="number" min="1" max="12"   placeholder="MM">
-            <input id="mt_y" type="number" min="2020" max="2099" placeholder="YYYY">
-            <button id="btnSetTime" onclick="setManualTime()">הגדר</button>
-          </div>
-          <div class="hint">מופיע רק כאשר הזמן של המכשיר אינו תקין.</div>
-        </div>
-
-        <div class="section-group">
-            <h3 class="section-header">🕰️ שעון שבת חכם </h3>
-
-            <div class="control-group">
-                <label class="control-label">מצב הממסר</label>
-                <div class="three-way-switch">
-                    <button onclick="setRelayMode('relay_on')" id="btn_on">On</button>
-                    <button onclick="setRelayMode('relay_auto')" id="btn_auto">Auto</button>
-                    <button onclick="setRelayMode('relay_off')" id="btn_off">Off</button>
-                    <span class="relay-indicator" id="relayLed"></span>
-                </div>
-            </div>
-
-            <div class="schedule-group">
-                <label class="control-label">הוסף אירוע ללו"ז</label>
-
-                <div style="display:flex; gap:10px; justify-content:center; align-items:center; flex-wrap:wrap; direction: rtl;">
-                    
-                    <div style="display:flex; flex-direction:column; align-items:center;">
-                      <span class="schedule-label">דקות</span>
-                      <select id="mm"></select>
-                    </div>
+// GENERATED by tools/build-index-page.mjs from ui/index.html - do not edit.
+// CHANGE HERE: edit ui/index.html, then run: node tools/build-index-page.mjs
+#ifndef INDEX_PAGE_H
+#define INDEX_PAGE_H
 
-                    <div style="display:flex; flex-direction:column; align-items:center;">
-                        <span class="schedule-label">שעה</span>
-                        <select id="hh"></select>
-                    </div>
-
-                    <div style="display:flex; flex-direction:column; align-items:center;">
-                        <span class="schedule-label">יום</span>
-                        <select id="scheduleDay" title="בחר יום(ים)">
-                          <option value="0">א'</option>
-                          <option value="1">ב'</option>
-                          <option value="2">ג'</option>
-                          <option value="3">ד'</option>
-                          <option value="4">ה'</option>
-                          <option value="5">ו'</option>
-                          <option value="6">ש'</option>
-                        </select>
-                    </div>
-
-                    <div style="display:flex; flex-direction:column; align-items:center;">
-                        <span class="schedule-label">מצב</span>
-                        <select id="scheduleState">
-                          <option value="on">הדלקה</option>
-                          <option value="off">כיבוי</option>
-                        </select>
-                    </div>
-                    
-                    <button id="btnAddEvent" onclick="addSchedule()">הוסף</button>
-                </div>
-
-                <h3>לו"ז נוכחי</h3>
-                <table id="scheduleTable">
-                    <thead>
-                        <tr><th>זמן</th><th>יום</th><th>מצב</th><th>פעולות</th></tr>
-                    </thead>
-                    <tbody></tbody>
-                </table>
-            </div>
-        </div>
-
-        <div class="section-group">
-            <h3 class="section-header">🔒 מתג שבת חכם </h3>
-            <div class="control-group">
-                <label class="control-label">מתג הפיזי</label>
-                <div class="toggle-row">
-                    <span class="toggle-caption">פעיל (שבוע)</span>
-                    <label class="toggle-switch">
-                        <input type="checkbox" id="shabbatMode" onchange="toggleMode(this)">
-                        <span class="slider"></span>
-                    </label>
-                    <span class="toggle-caption">נעול (שבת)</span>
-                </div>
-                <div class="hint">
-                  מבטל השפעה של לחיצה על המתג הפיזי ומקפיא את המצב הנוכחי של המכשיר.
-                </div>
-            </div>
-        </div>
+#include <pgmspace.h>
+#include <stddef.h>
+#include <stdint.h>
 
-        <div class="status" id="status">טוען סטטוס...</div>
-    </div>
+// Uncompressed size: 21765 bytes.
+static const size_t index_html_gz_len = 5825;
+static const char index_html_etag[] = "\"50ad3aba676a7c5a\"";
+static const uint8_t index_html_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x5c, 0xeb, 0x72, 0xdc, 0x36,
+  0x96, 0xfe, 0x9f, 0xa7, 0x38, 0xee, 0x38, 0xc3, 0x66, 0xd2, 0x37, 0xdd, 0x3c, 0x71, 0x5f, 0xe4,
+  0x8a, 0x2f, 0x29, 0x67, 0x2b, 0x8a, 0x5d, 0x96, 0xb2, 0xb5, 0x29, 0x97, 0xcb, 0x42, 0x93, 0x68,
+  0x91, 0x11, 0x49, 0x74, 0x08, 0xb4, 0xda, 0x3d, 0x8a, 0x9e, 0x61, 0xe3, 0x44, 0x4a, 0xa2, 0x8a,
+  0xe3, 0x24, 0x9e, 0xd4, 0xf8, 0xf2, 0x6b, 0x7f, 0xee, 0x9b, 0xe0, 0xff, 0xbe, 0xc0, 0xee, 0x23,
+  0x6c, 0x1d, 0x80, 0x64, 0xf3, 0xae, 0x96, 0x67, 0xb2, 0xb5, 0xa3, 0xa4, 0xe4, 0x6e, 0x10, 0x38,
+  0xc0, 0xb9, 0xe0, 0x9c, 0xef, 0x1c, 0x80, 0x1a, 0x5e, 0xb9, 0x7d, 0xef, 0xd6, 0xde, 0x17, 0xf7,
+  0xef, 0x80, 0x23, 0x7c, 0x6f, 0xfb, 0x9d, 0x61, 0xfc, 0x0f, 0x25, 0xf6, 0xf6, 0x3b, 0x00, 0x00,
+  0x43, 0x9f, 0x0a, 0x02, 0x96, 0x43, 0x42, 0x4e, 0xc5, 0xc8, 0xf8, 0x7c, 0xef, 0xe3, 0xf6, 0x87,
+  0x46, 0xfa, 0x51, 0x40, 0x7c, 0x3a, 0x6a, 0x1c, 0xb9, 0x74, 0x3e, 0x65, 0xa1, 0x68, 0x80, 0xc5,
+  0x02, 0x41, 0x03, 0x31, 0x6a, 0xcc, 0x5d, 0x5b, 0x38, 0x23, 0x9b, 0x1e, 0xb9, 0x16, 0x6d, 0xab,
+  0x2f, 0x2d, 0x70, 0x03, 0x57, 0xb8, 0xc4, 0x6b, 0x73, 0x8b, 0x78, 0x74, 0xb4, 0xd6, 0xe9, 0x35,
+  0x22, 0x52, 0xc2, 0x15, 0x1e, 0xdd, 0x96, 0xaf, 0xe5, 0x0b, 0x79, 0x26, 0x7f, 0x01, 0xf9, 0x5a,
+  0x3e, 0x95, 0x6f, 0x40, 0xfe, 0x20, 0x7f, 0x92, 0x3f, 0x0f, 0xbb, 0xfa, 0xa9, 0xee, 0xc9, 0xc5,
+  0x22, 0xfe, 0x8c, 0x3f, 0x63, 0x66, 0x2f, 0xe0, 0x38, 0xf9, 0x8a, 0x3f, 0x13, 0x16, 0x88, 0xf6,
+  0x84, 0xf8, 0xae, 0xb7, 0xe8, 0xc3, 0x47, 0xa1, 0x4b, 0xbc, 0x16, 0x70, 0x12, 0xf0, 0x36, 0xa7,
+  0xa1, 0x3b, 0x19, 0x64, 0xfa, 0x8e, 0x89, 0x75, 0x78, 0x10, 0xb2, 0x59, 0x60, 0xf7, 0xc1, 0x73,
+  0x03, 0x4a, 0xc2, 0xf6, 0x41, 0x48, 0x6c, 0x97, 0x06, 0xa2, 0xb9, 0xb6, 0xb1, 0x65, 0xd3, 0x83,
+  0x16, 0xbc, 0x7b, 0xed, 0xda, 0x9f, 0x29, 0x25, 0xd0, 0x7b, 0xaf, 0x05, 0xef, 0xfe, 0xf9, 0xda,
+  0xe6, 0x98, 0xac, 0xc3, 0x5a, 0xaf, 0xf7, 0x9e, 0x99, 0x25, 0xe5, 0x93, 0xf0, 0xc0, 0x0d, 0xfa,
+  0xd0, 0xcb, 0x36, 0x4f, 0x89, 0x6d, 0xbb, 0xc1, 0x41, 0x1f, 0x36, 0x7b, 0xd3, 0x27, 0xb9, 0x11,
+  0x6e, 0xd0, 0x76, 0xa8, 0x7b, 0xe0, 0x88, 0x3e, 0x12, 0x3c, 0x72, 0x72, 0x6b, 0x63, 0x4f, 0xda,
+  0xdc, 0xfd, 0x8b, 0x1a, 0x3c, 0x66, 0xa1, 0x4d, 0xc3, 0xf6, 0x98, 0xe5, 0x48, 0xd8, 0x6e, 0x48,
+  0x2d, 0xe1, 0xb2, 0xa0, 0x0f, 0xa1, 0xf0, 0x06, 0x90, 0x79, 0x28, 0xe8, 0x13, 0xd1, 0x26, 0x9e,
+  0x7b, 0x80, 0x4f, 0x71, 0x9a, 0xe5, 0xd8, 0x93, 0xe4, 0x53, 0x07, 0x15, 0x46, 0xdc, 0x80, 0x86,
+  0x39, 0x31, 0xfa, 0xe4, 0x89, 0x56, 0x5b, 0x1f, 0xae, 0xf5, 0x8a, 0x6b, 0x8f, 0xb9, 0x05, 0x32,
+  0x13, 0xac, 0x5a, 0xa8, 0xe1, 0xc1, 0x98, 0x34, 0xd7, 0xb7, 0xb6, 0x5a, 0xb0, 0xfc, 0xd5, 0xeb,
+  0x5c, 0xdf, 0x32, 0xf3, 0xbc, 0x2a, 0xfe, 0x50, 0xf4, 0x33, 0xde, 0x87, 0xf5, 0xc2, 0x7c, 0x35,
+  0x62, 0x54, 0x72, 0x72, 0x88, 0xcd, 0xe6, 0xb8, 0x1c, 0x1c, 0xaa, 0x3a, 0xe9, 0xa9, 0x7b, 0x2d,
+  0x88, 0xfe, 0xef, 0xac, 0x99, 0x65, 0xfc, 0x3b, 0xeb, 0x2d, 0xe8, 0x08, 0xd7, 0xa7, 0x6d, 0xdb,
+  0xe5, 0x53, 0x8f, 0xe4, 0xad, 0xc9, 0x62, 0x1e, 0x0b, 0xfb, 0xf0, 0xee, 0xc6, 0xc6, 0xc6, 0xa0,
+  0x52, 0xba, 0x16, 0x0d, 0x04, 0x0d, 0x4b, 0xc5, 0x5b, 0x43, 0x5a, 0x19, 0x2a, 0x77, 0xff, 0x42,
+  0xfb, 0xb0, 0xb1, 0x5e, 0x2e, 0xe0, 0xf6, 0x98, 0x09, 0xc1, 0xfc, 0xbc, 0x44, 0x52, 0xf4, 0xb9,
+  0xd6, 0x7f, 0x1b, 0x05, 0x3e, 0x2d, 0xa8, 0x50, 0xd1, 0x10, 0x6c, 0xda, 0x87, 0x8d, 0x6a, 0x91,
+  0x16, 0xa5, 0x9d, 0xd6, 0xe0, 0xbb, 0x93, 0xeb, 0xf8, 0x5f, 0xad, 0xbe, 0xd6, 0x2e, 0x50, 0xca,
+  0xe6, 0xf4, 0x09, 0x7c, 0x58, 0xa2, 0x92, 0xde, 0x96, 0x59, 0xcb, 0x14, 0xfa, 0xa1, 0x82, 0x61,
+  0xd6, 0x09, 0x3e, 0xad, 0xb1, 0xcd, 0xcd, 0xcd, 0x41, 0xa5, 0x38, 0x7a, 0x97, 0x90, 0x76, 0x8a,
+  0xe1, 0xa4, 0xc3, 0xf4, 0x09, 0x70, 0xe6, 0xb9, 0x76, 0xec, 0x11, 0x4a, 0x45, 0x9b, 0x74, 0x5f,
+  0xab, 0xd2, 0x1e, 0x6e, 0xbe, 0x90, 0x79, 0x5a, 0x7b, 0x2d, 0xe8, 0x70, 0xcb, 0xa1, 0xf6, 0xcc,
+  0xa3, 0x35, 0xea, 0xd4, 0xaa, 0xcc, 0x33, 0xb0, 0xa2, 0x35, 0xc6, 0xf3, 0x79, 0x64, 0x4c, 0xbd,
+  0x6a, 0x73, 0x5c, 0xfb, 0x30, 0xcf, 0xbf, 0x7a, 0x38, 0x8f, 0x9c, 0xd5, 0x98, 0x79, 0xf6, 0x60,
+  0xb5, 0x5d, 0x92, 0x13, 0xec, 0xda, 0xd6, 0xb4, 0xe0, 0xc1, 0xd4, 0xd6, 0xe8, 0xc3, 0xd8, 0x63,
+  0xd6, 0x61, 0xd9, 0xa2, 0x39, 0xf5, 0xa8, 0x25, 0x30, 0x78, 0x4c, 0x67, 0xe2, 0xa1, 0x58, 0x4c,
+  0xe9, 0xa8, 0x81, 0xbb, 0xaa, 0xf1, 0x28, 0xdb, 0x16, 0xcc, 0xfc, 0x31, 0x0d, 0x1b, 0x8f, 0x6a,
+  0xd8, 0xba, 0x56, 0xb9, 0x07, 0xae, 0x55, 0x39, 0xb8, 0xb5, 0x0a, 0x53, 0xe8, 0xc3, 0xda, 0xd2,
+  0x06, 0x2c, 0xcb, 0xaa, 0xdd, 0x1f, 0x05, 0xae, 0x57, 0x73, 0xcd, 0x82, 0x1d, 0x1c, 0x78, 0xb4,
+  0xcd, 0xe7, 0xae, 0xb0, 0x9c, 0x1c, 0x5b, 0x53, 0xc6, 0xdd, 0xc8, 0xf1, 0x53, 0x8f, 0x08, 0xf7,
+  0x88, 0x56, 0xc8, 0xd5, 0x0d, 0x30, 0xb0, 0xb5, 0x73, 0xe2, 0xc5, 0x9f, 0xc8, 0xbb, 0x7f, 0x58,
+  0xe0, 0x30, 0x0e, 0x4a, 0x9b, 0x55, 0x66, 0x1b, 0x2d, 0x2c, 0x64, 0xf3, 0xdc, 0xaa, 0x92, 0x59,
+  0x27, 0x1e, 0xcd, 0x11, 0x55, 0xdc, 0xb6, 0x5d, 0x41, 0x7d, 0x5e, 0xbe, 0x6f, 0xbf, 0x9c, 0x71,
+  0xe1, 0x4e, 0x16, 0xed, 0x08, 0x41, 0x94, 0x77, 0x3a, 0x20, 0xd3, 0x3e, 0xac, 0xa1, 0xb7, 0x4c,
+  0xb7, 0x56, 0x6e, 0xf3, 0x6b, 0xd3, 0xfa, 0x80, 0x59, 0xc3, 0x9c, 0x45, 0xa6, 0xd8, 0xaf, 0xc6,
+  0x9a, 0x36, 0xdf, 0x72, 0x93, 0x14, 0x1c, 0x93, 0x52, 0x50, 0x82, 0x04, 0x56, 0x5c, 0x70, 0x86,
+  0xef, 0x9c, 0xa9, 0xa8, 0x6d, 0x01, 0xc7, 0xc0, 0xa6, 0xc4, 0x72, 0xc5, 0x02, 0xdd, 0x5d, 0xac,
+  0xed, 0xde, 0x20, 0x51, 0x6f, 0x6f, 0x90, 0xf1, 0xb9, 0x9e, 0x5b, 0xf4, 0xb5, 0x4b, 0x2b, 0x23,
+  0x63, 0xce, 0xbc, 0x99, 0xa0, 0x03, 0xb0, 0x66, 0x21, 0x47, 0x3e, 0xa6, 0xcc, 0x55, 0xfa, 0x81,
+  0xc8, 0xa1, 0x82, 0x47, 0x27, 0x9a, 0x6a, 0x98, 0xd0, 0x8f, 0xf7, 0x7d, 0xaf, 0x2a, 0xbe, 0xb4,
+  0x63, 0xa1, 0xe0, 0x16, 0x02, 0x11, 0x92, 0x20, 0x9e, 0xb0, 0xb3, 0xc1, 0x07, 0xf9, 0x7d, 0xb4,
+  0xb9, 0x42, 0x9c, 0x41, 0x17, 0x53, 0x08, 0x34, 0xeb, 0x15, 0x71, 0x46, 0xf1, 0xdc, 0x1f, 0xd3,
+  0x09, 0x0b, 0xe9, 0x2a, 0xac, 0xc7, 0xa6, 0xd9, 0x68, 0x94, 0xef, 0x18, 0x15, 0xc7, 0x63, 0x51,
+  0xeb, 0x2f, 0x5a, 0x2a, 0x68, 0x2b, 0x89, 0x34, 0x36, 0xab, 0xe3, 0x6d, 0x2c, 0x8f, 0xb9, 0xe3,
+  0xe2, 0x84, 0x17, 0x09, 0x64, 0xab, 0xf7, 0x5e, 0x2d, 0x18, 0x42, 0x79, 0x94, 0x61, 0xa1, 0x8d,
+  0x1c, 0xfe, 0x52, 0xf3, 0x4c, 0x58, 0xe8, 0xf7, 0xf5, 0x47, 0x8f, 0x08, 0xfa, 0x6f, 0x4d, 0x14,
+  0x77, 0xa9, 0xe0, 0x94, 0x7d, 0xf5, 0x2d, 0x87, 0x5a, 0x87, 0xd4, 0x86, 0x0f, 0x96, 0xc6, 0x53,
+  0xa6, 0xd9, 0xcd, 0x5b, 0x1f, 0x7d, 0xbc, 0x95, 0xb1, 0xb5, 0x8a, 0xe1, 0x89, 0x1e, 0x2a, 0x96,
+  0xd3, 0x33, 0xd3, 0x44, 0x92, 0x0f, 0xdd, 0xf7, 0x41, 0xfe, 0x24, 0x7f, 0x97, 0x6f, 0xe4, 0x99,
+  0x7c, 0x25, 0xcf, 0xe1, 0x5e, 0xd0, 0xfd, 0x68, 0x26, 0x58, 0xf7, 0xde, 0x64, 0x02, 0xef, 0x77,
+  0x53, 0x5b, 0xc4, 0x09, 0x29, 0x6d, 0xcf, 0xc9, 0xa2, 0xdc, 0xa1, 0xae, 0x8a, 0xe7, 0xf2, 0x54,
+  0xc6, 0x33, 0x21, 0x0a, 0x6e, 0x22, 0x89, 0x2b, 0x4a, 0xfa, 0x0a, 0x4e, 0xa4, 0x20, 0xf3, 0x96,
+  0x36, 0x06, 0x1d, 0x46, 0x02, 0x16, 0xd0, 0xc1, 0x85, 0x01, 0x23, 0xef, 0x77, 0x8a, 0xbb, 0xb0,
+  0x6a, 0x4f, 0xc5, 0x5f, 0x7a, 0xbd, 0xde, 0x65, 0x18, 0xea, 0x10, 0x0b, 0x83, 0x4a, 0xbd, 0x4a,
+  0xe3, 0xef, 0x93, 0xc9, 0x24, 0xe3, 0x4b, 0x30, 0x24, 0x2d, 0xda, 0x6e, 0x60, 0xbb, 0x16, 0x11,
+  0x2c, 0xac, 0x0a, 0x12, 0x99, 0xd0, 0x14, 0xef, 0x1a, 0x15, 0xa4, 0x93, 0x0d, 0xa5, 0xbf, 0x5d,
+  0x64, 0xf5, 0x91, 0xcb, 0x0f, 0xe3, 0x5c, 0x0a, 0xc7, 0x64, 0x3a, 0x1c, 0xd1, 0x50, 0xb8, 0x16,
+  0xf1, 0x62, 0x05, 0xfb, 0xae, 0x6d, 0x7b, 0xb4, 0x54, 0x68, 0xe3, 0xf1, 0xb8, 0x54, 0x4e, 0x39,
+  0x9e, 0x3a, 0xa8, 0xf3, 0xb2, 0xf1, 0xbd, 0x9e, 0x65, 0x6d, 0x6e, 0x96, 0x5a, 0xaa, 0x20, 0x63,
+  0x0f, 0x25, 0x1a, 0x73, 0xda, 0xeb, 0xbd, 0x97, 0xf0, 0x66, 0x31, 0xcf, 0x23, 0x53, 0x4e, 0xfb,
+  0x10, 0x7f, 0x1a, 0x64, 0x22, 0x99, 0x66, 0x6a, 0x49, 0x14, 0xd3, 0x69, 0x61, 0xe3, 0x12, 0xca,
+  0xe1, 0xc8, 0xd2, 0x04, 0x11, 0xcb, 0x95, 0x59, 0x77, 0x86, 0x58, 0x39, 0x2f, 0x93, 0x75, 0xfc,
+  0x2f, 0xa3, 0x5a, 0xc7, 0x0d, 0x30, 0xb2, 0xa4, 0xed, 0x51, 0xb9, 0xb9, 0x78, 0xc8, 0xd6, 0xd6,
+  0xd6, 0xa0, 0x10, 0x82, 0x6b, 0xa6, 0x1f, 0x76, 0xa3, 0x8c, 0x7e, 0xd8, 0xd5, 0x55, 0x87, 0x21,
+  0xa6, 0xf4, 0x51, 0xb2, 0x6f, 0xbb, 0x47, 0x60, 0x79, 0x84, 0xf3, 0x51, 0x23, 0x49, 0x53, 0x1b,
+  0xcb, 0xe4, 0x3f, 0xfd, 0x3c, 0x9d, 0x67, 0x35, 0xc0, 0xb5, 0x47, 0x0d, 0x0b, 0xcd, 0xea, 0x76,
+  0xd4, 0xb2, 0xdd, 0x6e, 0xf7, 0xdb, 0xed, 0x61, 0xd7, 0x76, 0x8f, 0x52, 0xe3, 0x9d, 0xf5, 0xed,
+  0xff, 0x7a, 0xf6, 0x0a, 0xe4, 0x73, 0xf9, 0x42, 0xbe, 0x92, 0x3f, 0x61, 0xc9, 0xe1, 0xb5, 0x7c,
+  0x26, 0xcf, 0xe5, 0x8f, 0xf2, 0x54, 0x57, 0x1f, 0x9e, 0xcb, 0xd3, 0x61, 0xd7, 0x59, 0xcf, 0xcd,
+  0x89, 0xe4, 0xb9, 0x20, 0x62, 0xc6, 0x6f, 0x92, 0xb0, 0x11, 0x2f, 0x01, 0x45, 0xd3, 0xd8, 0x96,
+  0x3f, 0xca, 0x33, 0xf9, 0x02, 0x8b, 0x18, 0xbf, 0xc9, 0x1f, 0xd5, 0x97, 0xdf, 0x3a, 0x9d, 0x4e,
+  0x34, 0x73, 0x91, 0x8c, 0x4f, 0x82, 0x19, 0xf1, 0xf6, 0x10, 0xcf, 0xa6, 0x59, 0x4d, 0x92, 0x82,
+  0x06, 0x28, 0xf9, 0x8c, 0x1a, 0xf1, 0xae, 0x41, 0x7f, 0x91, 0x92, 0x01, 0xc0, 0x50, 0x83, 0xf9,
+  0xdc, 0x60, 0xd5, 0xd8, 0xd8, 0x96, 0x2f, 0xe5, 0x53, 0x79, 0x2e, 0x5f, 0x20, 0x6b, 0xdf, 0xcb,
+  0xe7, 0xb8, 0xac, 0x73, 0xf9, 0x9d, 0xfc, 0x55, 0x9e, 0xcb, 0x37, 0xc3, 0xae, 0xea, 0x94, 0xa1,
+  0x85, 0xcb, 0xca, 0x4d, 0xa8, 0xa0, 0x1c, 0xe2, 0x2e, 0x34, 0xa4, 0x3c, 0x48, 0x8b, 0x94, 0x89,
+  0x7d, 0xda, 0xf3, 0x90, 0x4c, 0xfb, 0xf8, 0x6b, 0x90, 0x47, 0x2d, 0x99, 0xf5, 0x02, 0x0c, 0x35,
+  0x3e, 0x51, 0xec, 0x8b, 0xc7, 0xbb, 0x0d, 0xc8, 0x00, 0x78, 0xac, 0x8b, 0x8c, 0x1a, 0xbd, 0x06,
+  0x56, 0x20, 0x46, 0x8d, 0xad, 0xeb, 0x0d, 0xf4, 0xa7, 0x1e, 0xb1, 0xa8, 0xc3, 0x3c, 0x9b, 0x86,
+  0xa3, 0xc6, 0xee, 0x6e, 0x2d, 0xbd, 0x9d, 0xcb, 0xd2, 0xdb, 0xd9, 0xa9, 0xa5, 0x77, 0xb7, 0x96,
+  0xde, 0xfa, 0x46, 0x81, 0xde, 0xdd, 0xbb, 0xb5, 0xf4, 0xec, 0x52, 0x7a, 0x6b, 0x11, 0xbd, 0x8d,
+  0xb5, 0x02, 0xbd, 0xdb, 0xb7, 0x6b, 0xe9, 0xf9, 0xb5, 0xf4, 0xd6, 0xd6, 0x2f, 0xcb, 0xef, 0xa2,
+  0x94, 0xde, 0x7a, 0x6f, 0x3d, 0x61, 0xb9, 0x77, 0xfd, 0x7a, 0x23, 0x4b, 0xf2, 0x8b, 0x2f, 0xbe,
+  0xf8, 0x22, 0x4f, 0x34, 0x0a, 0x8c, 0x48, 0x75, 0x2c, 0x82, 0x5d, 0x2a, 0xb4, 0x91, 0xb3, 0xc0,
+  0xf2, 0x5c, 0xeb, 0x70, 0xd4, 0xe0, 0x54, 0xec, 0x24, 0xc6, 0xdf, 0x34, 0x1b, 0xdb, 0xf2, 0x54,
+  0x7e, 0x2b, 0xbf, 0x93, 0xaf, 0x86, 0x5d, 0x3d, 0x34, 0x63, 0x98, 0xd9, 0x9d, 0x9b, 0xdd, 0xfb,
+  0xd1, 0xc6, 0x7b, 0x2e, 0xcf, 0xe4, 0xef, 0x68, 0xec, 0x20, 0x5f, 0xc9, 0x97, 0x08, 0x0a, 0xbe,
+  0x91, 0xaf, 0xe5, 0x2b, 0x90, 0xa7, 0xb1, 0xe9, 0xbf, 0x96, 0xcf, 0xf0, 0xdb, 0x73, 0xf9, 0x93,
+  0x7c, 0x2d, 0xcf, 0xf1, 0xd1, 0x37, 0xf2, 0x5c, 0xfe, 0x2a, 0xcf, 0x40, 0xbe, 0x91, 0x2f, 0xe5,
+  0xb9, 0xfc, 0xa5, 0x93, 0x77, 0x11, 0x65, 0xfb, 0x36, 0x9a, 0x36, 0x53, 0x7a, 0xc9, 0x73, 0xef,
+  0x6c, 0xe4, 0xbb, 0xe9, 0x62, 0x46, 0x63, 0xfb, 0x7f, 0x7e, 0x39, 0xfb, 0x8f, 0xff, 0xfe, 0xcf,
+  0x7f, 0x87, 0xf2, 0x6a, 0x27, 0x0c, 0xbb, 0xce, 0x46, 0x6a, 0xc2, 0x32, 0x3f, 0xb8, 0x74, 0x0e,
+  0xd9, 0x49, 0x2f, 0xf6, 0x06, 0xcf, 0xe5, 0xdf, 0xe4, 0x53, 0x2d, 0x82, 0xe7, 0xf2, 0x37, 0x14,
+  0x75, 0xc1, 0x05, 0x94, 0xb8, 0xd6, 0x1c, 0x42, 0x28, 0x99, 0x35, 0xad, 0xf0, 0xb4, 0x82, 0x1f,
+  0x60, 0xd0, 0xdc, 0x61, 0x36, 0x6d, 0x1a, 0x2a, 0x7e, 0x3e, 0x66, 0x81, 0x61, 0x36, 0x62, 0x9b,
+  0x78, 0xcc, 0x82, 0xc6, 0xf6, 0xbd, 0xa0, 0x4c, 0xdf, 0x97, 0x24, 0x8b, 0x45, 0xc8, 0x34, 0x61,
+  0xfc, 0xde, 0xd8, 0x46, 0x18, 0xf8, 0x0f, 0x20, 0xce, 0x26, 0x93, 0xcc, 0xa2, 0x27, 0x93, 0xc6,
+  0xf6, 0xbd, 0xc9, 0xe4, 0x02, 0xca, 0x7c, 0x4a, 0x82, 0x58, 0x82, 0x39, 0xec, 0xa0, 0x69, 0xa9,
+  0xc6, 0x4f, 0xa9, 0xdd, 0xd8, 0x1e, 0x76, 0xb1, 0x73, 0x89, 0x12, 0xf2, 0x46, 0x5f, 0xb4, 0xc7,
+  0x82, 0x4d, 0x66, 0x0a, 0x48, 0x97, 0xb6, 0x8f, 0x53, 0x0c, 0x57, 0xf2, 0xaf, 0x7a, 0x5f, 0xbc,
+  0xc2, 0x40, 0x06, 0xf2, 0x99, 0x7c, 0x26, 0xcf, 0x1a, 0xf2, 0xfb, 0xc4, 0x56, 0xca, 0x8d, 0xa5,
+  0x2c, 0x6a, 0xa8, 0x74, 0x5d, 0x23, 0x97, 0x8a, 0xc0, 0x91, 0x29, 0x0b, 0xc4, 0x6d, 0x97, 0x8b,
+  0x26, 0xa5, 0x45, 0x80, 0x8b, 0x97, 0xa6, 0x26, 0x59, 0x52, 0xb6, 0x98, 0x37, 0xf3, 0x83, 0xd2,
+  0xf5, 0x54, 0xcc, 0x97, 0xd3, 0x71, 0x22, 0xf9, 0x58, 0x96, 0xdf, 0xc9, 0x97, 0xf2, 0x0c, 0xa3,
+  0x6c, 0xb9, 0x72, 0x63, 0x12, 0xaa, 0xba, 0xa5, 0x7d, 0xaf, 0xaf, 0x4c, 0x41, 0x35, 0x54, 0x18,
+  0x55, 0x89, 0xf6, 0xff, 0x4f, 0x38, 0xbd, 0x88, 0x57, 0x74, 0x65, 0xa7, 0xf5, 0x9c, 0x66, 0x79,
+  0x75, 0x9c, 0x7f, 0x5a, 0x5e, 0xcf, 0xe5, 0x19, 0x1e, 0x4a, 0xad, 0xce, 0x6b, 0x4c, 0xe1, 0x36,
+  0x22, 0x53, 0x75, 0x96, 0x35, 0x6a, 0xc8, 0xa7, 0xf2, 0x07, 0x8c, 0x3f, 0x8a, 0x58, 0x53, 0x9e,
+  0xcb, 0x9f, 0xcd, 0x06, 0xf8, 0x33, 0x4f, 0xb8, 0x53, 0x8f, 0x02, 0x02, 0xeb, 0x51, 0x63, 0xbd,
+  0x66, 0x89, 0x00, 0x43, 0xa6, 0xeb, 0x53, 0x47, 0xc4, 0x9b, 0x51, 0xc4, 0x23, 0xdb, 0xf2, 0x1b,
+  0x63, 0xd8, 0xd5, 0xad, 0x97, 0x18, 0xb8, 0xd6, 0xd8, 0x96, 0x4f, 0xdf, 0x66, 0xe0, 0x7a, 0x63,
+  0x5b, 0x7e, 0xfb, 0x36, 0x03, 0x37, 0x70, 0x73, 0xbc, 0xcd, 0xc0, 0x4d, 0xf4, 0x50, 0x6f, 0x33,
+  0x70, 0xab, 0xb1, 0x2d, 0xcf, 0xde, 0x66, 0xe0, 0x35, 0xb4, 0xed, 0x15, 0x06, 0xfe, 0x93, 0x9a,
+  0xb2, 0x82, 0x03, 0x6f, 0x63, 0xca, 0xbb, 0x82, 0x08, 0x7a, 0x19, 0xf3, 0xc4, 0x48, 0x2f, 0x4f,
+  0xe5, 0x77, 0xf2, 0x99, 0x7c, 0x89, 0x9e, 0xe2, 0xd2, 0x9a, 0x50, 0x51, 0x57, 0xfe, 0x24, 0xcf,
+  0xe5, 0x53, 0x79, 0x26, 0xcf, 0xff, 0x41, 0x2a, 0x59, 0x3d, 0x8e, 0x64, 0xd1, 0xec, 0x47, 0xb6,
+  0x7d, 0xe7, 0x88, 0x06, 0x22, 0x05, 0x67, 0x89, 0x6d, 0xef, 0x46, 0xd2, 0x89, 0xc0, 0xac, 0x0a,
+  0xa5, 0xd5, 0x28, 0xa1, 0xca, 0x2a, 0x86, 0xce, 0xc6, 0x76, 0x14, 0x72, 0x01, 0xb1, 0xa9, 0xfc,
+  0x49, 0xfe, 0x80, 0x0c, 0x23, 0x2c, 0x2c, 0xf4, 0xd5, 0x25, 0x85, 0xb4, 0x6a, 0xf6, 0xb0, 0xa5,
+  0x0a, 0xa2, 0x89, 0xe5, 0xc9, 0x7e, 0xf9, 0xf3, 0x70, 0x7b, 0x28, 0x9c, 0x6d, 0x8d, 0x97, 0x87,
+  0x5d, 0xe1, 0xe8, 0xaf, 0x91, 0xcb, 0x8b, 0xbf, 0x46, 0x66, 0x13, 0x7f, 0xfd, 0x5d, 0xe1, 0xd8,
+  0x67, 0x3a, 0xd8, 0x61, 0x63, 0x57, 0x84, 0x55, 0x52, 0xaf, 0x59, 0xc0, 0x50, 0xa8, 0xcc, 0x7f,
+  0xd8, 0x15, 0xcb, 0x0a, 0x40, 0x6e, 0x30, 0xb2, 0x56, 0x8a, 0x87, 0xfe, 0x50, 0xb8, 0x7e, 0xfa,
+  0x2d, 0x56, 0x08, 0xde, 0xc8, 0x6f, 0x4b, 0x91, 0xfa, 0x1f, 0x05, 0xd4, 0xd5, 0x7c, 0xa7, 0x2a,
+  0xa1, 0xf9, 0x1e, 0xd5, 0xbf, 0x0a, 0x50, 0x4f, 0x8e, 0x65, 0x1a, 0x2b, 0x80, 0xd2, 0xec, 0x39,
+  0x47, 0x43, 0xeb, 0xf1, 0x5c, 0x3e, 0x83, 0xa6, 0x62, 0xf3, 0x4c, 0xbe, 0x30, 0xeb, 0x5c, 0x43,
+  0x76, 0xfd, 0x99, 0xf3, 0x87, 0x3a, 0x7f, 0xa4, 0x53, 0x4d, 0x9d, 0x60, 0xaa, 0x0a, 0xf0, 0x98,
+  0x3d, 0xd1, 0x78, 0x98, 0x3b, 0x64, 0x3c, 0x26, 0x02, 0x91, 0xb7, 0xda, 0x56, 0x0e, 0x09, 0x0e,
+  0x68, 0x4c, 0x59, 0xe1, 0x71, 0xe1, 0xb8, 0xdc, 0x5c, 0xd9, 0xd9, 0xa9, 0x9a, 0x72, 0x35, 0xb8,
+  0xd6, 0xe6, 0x52, 0x21, 0xd5, 0x8b, 0x85, 0xf5, 0xab, 0x36, 0xfa, 0x48, 0x58, 0x6f, 0xcc, 0x4b,
+  0x60, 0xf8, 0xf2, 0xf4, 0xb5, 0x64, 0x0d, 0xf2, 0xb9, 0x7c, 0x2a, 0x7f, 0xd4, 0x39, 0xeb, 0x6b,
+  0xa5, 0x9e, 0xd3, 0x28, 0x87, 0x7d, 0x86, 0x2e, 0x41, 0xfe, 0x0d, 0xbf, 0xbf, 0x88, 0x73, 0xda,
+  0xac, 0xc1, 0x80, 0x3c, 0x93, 0xcf, 0xe5, 0x4b, 0xf5, 0xf5, 0x1b, 0xc4, 0xf3, 0x6f, 0x74, 0xaf,
+  0x28, 0xff, 0x4b, 0xfc, 0x4a, 0x31, 0x29, 0xee, 0x5c, 0x22, 0x0f, 0x59, 0x69, 0xdf, 0xa9, 0x42,
+  0x59, 0x23, 0x55, 0x34, 0xbb, 0xa0, 0x48, 0x96, 0x27, 0x38, 0xe4, 0x56, 0xe8, 0x4e, 0x53, 0x8e,
+  0xdc, 0xa3, 0x02, 0xeb, 0xdf, 0x21, 0x0d, 0x96, 0xc9, 0x1a, 0x8c, 0x20, 0x9d, 0x0b, 0x0e, 0xca,
+  0x3a, 0xc7, 0xfe, 0x19, 0x46, 0xf0, 0xf0, 0x51, 0xb6, 0x87, 0x47, 0x78, 0xf2, 0xf8, 0x01, 0x3d,
+  0x72, 0x39, 0x86, 0x9e, 0x11, 0x04, 0x33, 0x2f, 0x75, 0xe6, 0x96, 0x7c, 0x20, 0x7c, 0x11, 0x58,
+  0x30, 0x99, 0x05, 0xca, 0x55, 0x40, 0xae, 0x92, 0x91, 0x29, 0x77, 0x5b, 0x2c, 0xe0, 0x02, 0x16,
+  0x30, 0x82, 0x29, 0xde, 0xa1, 0xfa, 0x24, 0x10, 0x4d, 0x9b, 0x59, 0x33, 0x9f, 0x06, 0xa2, 0x73,
+  0x40, 0xc5, 0x1d, 0x8f, 0xe2, 0xc7, 0x9b, 0x8b, 0x4f, 0xec, 0xa6, 0x81, 0xc5, 0x17, 0xc3, 0xec,
+  0xa8, 0x88, 0xd7, 0x82, 0xb5, 0x5e, 0xe6, 0x90, 0x46, 0x13, 0xf2, 0x57, 0x25, 0xe4, 0x5f, 0x40,
+  0xc8, 0x5e, 0x95, 0x90, 0x7d, 0x01, 0xa1, 0xbb, 0xab, 0x12, 0xba, 0x7b, 0x01, 0xa1, 0x9d, 0x55,
+  0x09, 0xed, 0x5c, 0x40, 0x68, 0x77, 0x55, 0x42, 0xbb, 0x15, 0x84, 0x52, 0x14, 0xdd, 0x09, 0x34,
+  0xaf, 0x34, 0x17, 0xb0, 0x3d, 0x02, 0xac, 0x80, 0xc1, 0x9f, 0xfe, 0x04, 0x3e, 0x7e, 0x59, 0xd3,
+  0x9f, 0x86, 0x23, 0x58, 0x5b, 0xc7, 0x8f, 0x76, 0xd2, 0x68, 0x63, 0xe3, 0x86, 0xfa, 0x78, 0x17,
+  0x1b, 0x7b, 0xfa, 0xd3, 0x70, 0x04, 0xeb, 0x1b, 0xf8, 0x71, 0x27, 0x69, 0xdc, 0xc1, 0xc6, 0xad,
+  0xeb, 0xf8, 0x71, 0x37, 0x69, 0xdc, 0xd5, 0x8d, 0xa6, 0x99, 0x3b, 0x34, 0x21, 0x1e, 0x0d, 0x45,
+  0xd3, 0xf8, 0xd8, 0xf5, 0x3c, 0x20, 0x9e, 0x07, 0x13, 0x97, 0x7a, 0x36, 0x87, 0xb9, 0x2b, 0x1c,
+  0x84, 0x48, 0xae, 0xad, 0x81, 0x12, 0x37, 0x72, 0x27, 0x7b, 0x21, 0x15, 0xb3, 0x30, 0x48, 0xb7,
+  0x9d, 0x14, 0x04, 0xf6, 0x15, 0x47, 0x53, 0xa7, 0x73, 0xf8, 0xfc, 0xc1, 0xa7, 0xbb, 0x94, 0x84,
+  0x96, 0x73, 0x9f, 0x84, 0xc4, 0xe7, 0xcd, 0x63, 0x58, 0xb4, 0xc0, 0x6f, 0x81, 0xdd, 0x82, 0xbb,
+  0x2d, 0xd8, 0x69, 0xc1, 0x2e, 0x9c, 0x98, 0x1d, 0xc1, 0x76, 0x45, 0xe8, 0x06, 0x07, 0xcd, 0xcc,
+  0x54, 0x22, 0x2c, 0x5e, 0x9d, 0x42, 0xe2, 0x21, 0x45, 0xea, 0x64, 0x4e, 0x5c, 0x01, 0x13, 0x2a,
+  0x2c, 0xa7, 0xb9, 0xdf, 0xe5, 0x54, 0x3c, 0xc6, 0x82, 0xfd, 0x8d, 0xab, 0xc7, 0x5f, 0xf1, 0x93,
+  0x7d, 0x73, 0x50, 0x32, 0x0e, 0x8f, 0x0c, 0x92, 0x81, 0x21, 0xe5, 0x1d, 0x6c, 0x68, 0xe6, 0xba,
+  0x2a, 0xf5, 0xe0, 0x43, 0x76, 0x68, 0xc2, 0x71, 0x24, 0x24, 0x35, 0xf2, 0xeb, 0xaf, 0xc1, 0xd8,
+  0xa5, 0x02, 0x70, 0x1a, 0x98, 0x10, 0xd7, 0xa3, 0xb6, 0x61, 0x0e, 0x62, 0x71, 0x64, 0x84, 0x00,
+  0x30, 0x9b, 0xda, 0x44, 0x28, 0x50, 0x3b, 0xe3, 0xd9, 0x29, 0x4e, 0xc0, 0x22, 0x78, 0x28, 0xd6,
+  0xa4, 0x4b, 0xfa, 0xc6, 0x67, 0x54, 0xcc, 0x59, 0x78, 0x08, 0x34, 0x0c, 0xf1, 0xcc, 0xc3, 0x80,
+  0x0f, 0x80, 0x76, 0x7c, 0xca, 0x39, 0x39, 0xa0, 0x99, 0x33, 0xca, 0x93, 0x15, 0x5c, 0x47, 0x60,
+  0xdf, 0xf2, 0xed, 0xa6, 0xe5, 0xdb, 0x59, 0x8d, 0x5f, 0x46, 0x9c, 0x96, 0x6f, 0xdf, 0xb0, 0x46,
+  0x57, 0x8f, 0x69, 0x60, 0x31, 0x9b, 0x7e, 0xfe, 0xe0, 0x93, 0x5b, 0xcc, 0x9f, 0xb2, 0x00, 0x2f,
+  0x31, 0x22, 0xdd, 0x3f, 0x4e, 0xc0, 0xb7, 0x98, 0xef, 0x93, 0xc0, 0x2e, 0xc8, 0x17, 0x26, 0xc4,
+  0xc3, 0x03, 0xac, 0x93, 0x02, 0x2d, 0x1c, 0x6a, 0xa6, 0xc8, 0x98, 0x03, 0x80, 0x6e, 0x17, 0xc8,
+  0x74, 0xea, 0xb9, 0xd4, 0x6e, 0xe1, 0xe1, 0x23, 0x04, 0x4c, 0x00, 0x0b, 0x80, 0x1e, 0xd1, 0x70,
+  0x01, 0x21, 0xf5, 0x99, 0xa0, 0x30, 0x0b, 0x5c, 0xb1, 0xa2, 0xca, 0x62, 0x9b, 0x07, 0x11, 0xce,
+  0xe8, 0xdf, 0xab, 0xcb, 0x2a, 0x7e, 0x56, 0xd1, 0x6c, 0xaa, 0x92, 0xe8, 0x33, 0x9b, 0x96, 0xc5,
+  0x05, 0x76, 0x98, 0x68, 0x20, 0xb6, 0x04, 0xd5, 0x75, 0x90, 0x73, 0x41, 0x5a, 0xfa, 0x25, 0x31,
+  0x0f, 0x7b, 0x0f, 0xc0, 0x71, 0x0f, 0x1c, 0x0f, 0x0f, 0x3f, 0xd5, 0xa3, 0x9b, 0x2a, 0xe1, 0x40,
+  0xa9, 0xd4, 0x2f, 0x38, 0x59, 0x6a, 0xc5, 0xf0, 0xcc, 0x7a, 0x13, 0x3f, 0xfa, 0xd5, 0x8c, 0x86,
+  0x8b, 0x5d, 0x95, 0x5a, 0xb1, 0xf0, 0x23, 0xcf, 0x6b, 0x1a, 0x55, 0x47, 0xc8, 0x86, 0xd9, 0x99,
+  0xb0, 0xf0, 0x0e, 0xb1, 0x9c, 0xe6, 0x58, 0x04, 0x30, 0xda, 0x86, 0xb1, 0x08, 0x3a, 0x0a, 0x15,
+  0x7c, 0xea, 0x72, 0xd1, 0x41, 0xd5, 0x1e, 0xd1, 0xa6, 0xa1, 0x4f, 0x9a, 0x0d, 0xb3, 0xc0, 0x75,
+  0x91, 0xdf, 0x51, 0x12, 0xe5, 0x91, 0x3c, 0x54, 0x3a, 0x77, 0x5d, 0x5c, 0x36, 0xcc, 0xd4, 0x6c,
+  0xc4, 0xb6, 0x97, 0x53, 0xa5, 0x67, 0xa2, 0x1e, 0xa7, 0x17, 0x4f, 0x87, 0x35, 0xe0, 0x0b, 0xe6,
+  0xc3, 0x2e, 0x2b, 0x4f, 0x58, 0x4b, 0x4a, 0x97, 0xb3, 0x2f, 0xa6, 0x75, 0xb1, 0x15, 0xa6, 0xd1,
+  0xb3, 0xfa, 0x58, 0x66, 0x85, 0x96, 0x8f, 0x68, 0x40, 0x3f, 0xef, 0xc4, 0xd7, 0x32, 0x6e, 0x80,
+  0x11, 0x21, 0x72, 0x03, 0xfa, 0x60, 0xcc, 0x29, 0x3d, 0x34, 0x06, 0xab, 0x18, 0x30, 0xba, 0x9c,
+  0xbc, 0x26, 0xaf, 0x68, 0x03, 0xce, 0x4d, 0x31, 0x82, 0x2b, 0xd9, 0x96, 0x55, 0x0d, 0x76, 0xe2,
+  0x7a, 0x0a, 0x6b, 0x69, 0x33, 0xe4, 0xa5, 0x90, 0xcb, 0x71, 0x60, 0x54, 0x2d, 0x65, 0xc7, 0x31,
+  0xca, 0xd0, 0x95, 0x5f, 0x37, 0xc6, 0xf7, 0x8d, 0x22, 0x63, 0x8e, 0x83, 0x9e, 0xf0, 0x8a, 0xef,
+  0x9b, 0x25, 0xa1, 0xd6, 0x71, 0x3a, 0x6e, 0x10, 0xd0, 0xf0, 0xee, 0xde, 0xce, 0xa7, 0x08, 0x50,
+  0x8d, 0x01, 0xf8, 0x7e, 0xbe, 0xe9, 0x9d, 0xf4, 0x2d, 0x8f, 0x10, 0x9a, 0x08, 0x47, 0x71, 0xed,
+  0x78, 0x53, 0x0b, 0x86, 0xb0, 0xbe, 0x39, 0x00, 0xe7, 0x83, 0x0f, 0xcc, 0xd2, 0x68, 0xc0, 0xd2,
+  0xeb, 0xb5, 0x42, 0x4a, 0x04, 0x8d, 0x96, 0xdc, 0x34, 0x74, 0x81, 0x24, 0x8f, 0x07, 0x98, 0x46,
+  0x3c, 0x30, 0x02, 0x67, 0x00, 0x4c, 0xf9, 0xfc, 0x5b, 0xba, 0x24, 0x0f, 0x23, 0x88, 0xe2, 0xba,
+  0x63, 0x76, 0xa6, 0xc4, 0xde, 0x15, 0x24, 0x14, 0xcd, 0xf5, 0x16, 0x18, 0xbd, 0x3c, 0x11, 0xc7,
+  0xe9, 0x90, 0xe9, 0x14, 0xf5, 0xed, 0xb8, 0x9e, 0xdd, 0x64, 0x66, 0x15, 0xbe, 0x48, 0x18, 0xf2,
+  0x35, 0x43, 0x3e, 0x0c, 0xe1, 0x1a, 0xfe, 0xfb, 0x47, 0x30, 0xe4, 0x57, 0x32, 0xe4, 0x5f, 0xc4,
+  0x90, 0xef, 0xaf, 0xc4, 0x50, 0xd9, 0xed, 0xa3, 0x2e, 0xec, 0xd2, 0xc0, 0x06, 0x62, 0xdb, 0x5d,
+  0x9b, 0x7a, 0x54, 0x50, 0x60, 0x53, 0x0e, 0x84, 0x03, 0x0b, 0x28, 0x74, 0xe3, 0xaa, 0xcc, 0xe3,
+  0xb1, 0x0a, 0x3d, 0x21, 0xfd, 0x6a, 0x46, 0xb9, 0x00, 0x72, 0x40, 0x5c, 0x15, 0x83, 0x1d, 0x9a,
+  0xa6, 0x14, 0xf7, 0x86, 0x30, 0x4e, 0x41, 0xe6, 0x54, 0xa5, 0x26, 0xc0, 0xc9, 0xbc, 0x05, 0x18,
+  0x6a, 0x43, 0x1a, 0xe0, 0x4d, 0x2b, 0xe1, 0xd0, 0x65, 0x6f, 0x15, 0xbf, 0xd1, 0xf6, 0x78, 0x27,
+  0x4d, 0xed, 0xa6, 0xbe, 0x4e, 0x85, 0x5d, 0x27, 0x6e, 0xc8, 0x05, 0x74, 0x31, 0xfd, 0x42, 0xe2,
+  0x53, 0x6f, 0x01, 0xc2, 0x21, 0x62, 0x39, 0x8f, 0xcb, 0x61, 0x16, 0x1c, 0x06, 0x6c, 0x1e, 0xb4,
+  0x80, 0x33, 0x8d, 0x2c, 0x20, 0x15, 0x72, 0xbb, 0xdd, 0x88, 0x06, 0x2e, 0x9b, 0x12, 0x1b, 0xd8,
+  0x44, 0x6d, 0x78, 0x37, 0x38, 0x00, 0x02, 0x07, 0x33, 0xca, 0xb9, 0x9a, 0x48, 0xbf, 0xef, 0x01,
+  0x73, 0x36, 0xf3, 0x70, 0xad, 0x5f, 0x62, 0xe1, 0x90, 0x70, 0xe0, 0x82, 0x78, 0xb4, 0x53, 0x07,
+  0x82, 0xe2, 0xe4, 0xeb, 0x26, 0xca, 0xa9, 0xc9, 0xa6, 0xfc, 0x22, 0x38, 0x84, 0xbb, 0xaf, 0x3c,
+  0x6b, 0x1b, 0xe9, 0xbc, 0xcd, 0x8c, 0xfc, 0x52, 0x1d, 0x52, 0x58, 0x81, 0xc8, 0x71, 0x2e, 0x1d,
+  0x8e, 0x70, 0xc3, 0x5e, 0x5a, 0x01, 0x0e, 0xe1, 0x0a, 0xb5, 0x78, 0x8c, 0xd8, 0xd4, 0x86, 0x05,
+  0x15, 0xd0, 0x86, 0xa9, 0x47, 0x09, 0xa7, 0x6a, 0xe5, 0x4a, 0xdd, 0x9d, 0xbc, 0xd1, 0x41, 0x16,
+  0x5d, 0x64, 0x9e, 0x9d, 0xac, 0x04, 0xfd, 0x8c, 0x9c, 0x7d, 0x19, 0xad, 0xc2, 0x72, 0x7d, 0x2a,
+  0x1c, 0x66, 0xf7, 0xc1, 0xb8, 0x7f, 0x6f, 0x77, 0xcf, 0x68, 0xe5, 0x9e, 0xea, 0x22, 0x17, 0xef,
+  0xc3, 0x31, 0x82, 0x39, 0xb5, 0x6b, 0xda, 0x7b, 0x8b, 0x29, 0x35, 0xfa, 0x60, 0x28, 0x4c, 0x66,
+  0x11, 0xd4, 0x50, 0xf7, 0x4b, 0xce, 0x02, 0x03, 0x4e, 0xf2, 0xc3, 0xb1, 0x50, 0xd7, 0x87, 0x7f,
+  0xd9, 0xbd, 0xf7, 0x59, 0x87, 0xab, 0x9d, 0xe6, 0x4e, 0x16, 0x4d, 0xbc, 0x49, 0xc4, 0x13, 0x49,
+  0xf6, 0x4b, 0x53, 0xeb, 0x96, 0xda, 0x24, 0x27, 0x66, 0x96, 0xe7, 0xb7, 0x87, 0xa9, 0xe8, 0x62,
+  0x6c, 0x22, 0x48, 0x21, 0x65, 0x4f, 0x6c, 0x27, 0x7e, 0xac, 0x16, 0xab, 0xb2, 0xc3, 0x18, 0x7f,
+  0x26, 0xb0, 0xf0, 0xb1, 0x09, 0xc7, 0x27, 0x35, 0xe8, 0x37, 0xc7, 0x3c, 0x3e, 0x54, 0x44, 0x31,
+  0xe9, 0x23, 0x82, 0x74, 0xac, 0x04, 0x33, 0x28, 0x73, 0x7f, 0x1c, 0xeb, 0xc6, 0x28, 0x8e, 0x2d,
+  0x37, 0xa3, 0x39, 0xe1, 0xa0, 0xcb, 0x5e, 0xb6, 0x02, 0x09, 0x73, 0x87, 0x86, 0x74, 0x69, 0x49,
+  0xb8, 0x59, 0xe9, 0x5c, 0x79, 0x81, 0x3a, 0xa3, 0x82, 0xaa, 0x62, 0x86, 0x5a, 0x64, 0xbc, 0xe3,
+  0x4b, 0x46, 0x31, 0x92, 0xaa, 0x60, 0xe7, 0x9f, 0x9f, 0x68, 0xd8, 0x52, 0xc5, 0x48, 0x56, 0x12,
+  0x31, 0x7e, 0xc6, 0xd0, 0xb8, 0xcc, 0xc6, 0x62, 0x36, 0xf5, 0x86, 0x5c, 0x26, 0x0d, 0xf9, 0x99,
+  0xde, 0x72, 0x93, 0x5c, 0x9e, 0x6b, 0xed, 0x4b, 0x13, 0x9e, 0x55, 0x4f, 0x8a, 0x65, 0x7d, 0xfe,
+  0xff, 0x31, 0xa1, 0xc8, 0x1c, 0x30, 0x94, 0x02, 0x9e, 0x3b, 0xde, 0xdb, 0x40, 0x9e, 0xfa, 0x51,
+  0x79, 0xd0, 0xa3, 0x47, 0xe9, 0x40, 0x52, 0x33, 0x2c, 0x73, 0x50, 0x14, 0x97, 0x59, 0x4a, 0xaa,
+  0x50, 0x64, 0xc1, 0x01, 0x46, 0xf0, 0x51, 0x18, 0x92, 0x45, 0x67, 0x12, 0x32, 0xbf, 0x79, 0x21,
+  0xc9, 0xdb, 0x04, 0x8b, 0x64, 0xfa, 0x70, 0x87, 0xda, 0xf7, 0x14, 0x28, 0xe0, 0x2d, 0x44, 0x0e,
+  0xdb, 0xcb, 0xb2, 0x0f, 0x4b, 0x15, 0x76, 0x6a, 0x2a, 0x3b, 0x4a, 0x66, 0x1a, 0xbf, 0xe9, 0x0f,
+  0xb8, 0xa0, 0x8e, 0x47, 0x83, 0x03, 0xe1, 0xa8, 0xad, 0xdc, 0x4b, 0x69, 0xf6, 0xbe, 0xde, 0x86,
+  0xd1, 0x71, 0x18, 0xd1, 0xa5, 0x05, 0xdc, 0x8d, 0x36, 0x59, 0x74, 0xca, 0x8b, 0x0b, 0x45, 0x25,
+  0xb1, 0x59, 0x08, 0x90, 0x2e, 0x50, 0xe1, 0x12, 0xea, 0x4b, 0x7e, 0x6e, 0x30, 0x53, 0xc2, 0x4e,
+  0x86, 0xe0, 0x62, 0x6b, 0x87, 0xd0, 0x27, 0x2e, 0x17, 0x18, 0x9a, 0x47, 0x8a, 0xa1, 0x8c, 0x2d,
+  0x77, 0x7c, 0x32, 0x6d, 0xda, 0x64, 0x81, 0xe2, 0xca, 0xd5, 0x45, 0x3b, 0x13, 0x37, 0xb0, 0x9b,
+  0x14, 0x9f, 0xd0, 0x8e, 0xea, 0x32, 0x52, 0x04, 0x70, 0x5f, 0xd3, 0x8e, 0x5a, 0x3a, 0xb6, 0xa8,
+  0x0f, 0xaa, 0x29, 0x5e, 0xda, 0x68, 0x14, 0xad, 0xd2, 0xcc, 0x7a, 0xf4, 0xce, 0xc4, 0xf5, 0x04,
+  0x0d, 0x9b, 0x37, 0x19, 0xf3, 0x28, 0x09, 0xaa, 0x15, 0x11, 0x2f, 0x38, 0x2d, 0xfa, 0xb4, 0x2a,
+  0x70, 0xb6, 0xb8, 0x8b, 0xaa, 0x0b, 0xc4, 0xab, 0x8c, 0x0c, 0x71, 0x34, 0xd2, 0x26, 0x59, 0x51,
+  0x36, 0x6b, 0xa0, 0x9b, 0xc5, 0x02, 0x97, 0xda, 0xdd, 0x08, 0x76, 0x5c, 0x9b, 0x06, 0xea, 0x46,
+  0x30, 0x08, 0xa6, 0x80, 0x4b, 0x22, 0x32, 0x16, 0xd0, 0x0e, 0x7c, 0xc6, 0x22, 0x47, 0xcc, 0xc1,
+  0x27, 0x36, 0xed, 0x34, 0x2e, 0x55, 0x55, 0xcb, 0x70, 0xc4, 0x99, 0x4f, 0xb3, 0xab, 0xbd, 0x52,
+  0xb9, 0xda, 0x28, 0x1d, 0x63, 0xc1, 0xc4, 0x0d, 0xfd, 0x7b, 0x47, 0x34, 0x9c, 0x87, 0xae, 0x52,
+  0x7d, 0xd4, 0xd4, 0xdc, 0x97, 0xcf, 0xe4, 0x73, 0xf9, 0x83, 0x3c, 0x93, 0x2f, 0xe1, 0xea, 0x71,
+  0x0c, 0xd7, 0xd9, 0x2c, 0xcc, 0x00, 0x5c, 0xc4, 0xb7, 0x27, 0xfd, 0xe4, 0x79, 0xa4, 0x9a, 0x42,
+  0x0f, 0x50, 0xa7, 0x76, 0xa7, 0xf2, 0x07, 0x75, 0xe5, 0xf5, 0xaf, 0x20, 0x9f, 0xc6, 0xe7, 0x03,
+  0x3f, 0xc8, 0xef, 0xe4, 0xeb, 0x1b, 0xfb, 0x65, 0xb5, 0xa0, 0xfc, 0xe2, 0xcc, 0x5a, 0x59, 0xa4,
+  0x1a, 0x97, 0x49, 0x62, 0x16, 0xea, 0x29, 0x35, 0xa7, 0x6c, 0xb2, 0x89, 0xaf, 0xad, 0x20, 0xfc,
+  0xb0, 0x6d, 0xa3, 0x85, 0x46, 0xd0, 0x52, 0x06, 0xd7, 0x8a, 0x2c, 0xac, 0x15, 0xf9, 0x9e, 0x13,
+  0xd3, 0xac, 0x4f, 0x84, 0x97, 0xc9, 0x22, 0x0b, 0x7d, 0x22, 0x6e, 0x93, 0x05, 0xdf, 0x43, 0xe4,
+  0x40, 0x03, 0x11, 0x2e, 0xca, 0xfc, 0xa7, 0x8d, 0xaf, 0x32, 0x23, 0xc2, 0x7a, 0x68, 0xc8, 0x6f,
+  0x8c, 0x96, 0x21, 0x9f, 0xe2, 0xaf, 0x6f, 0xf1, 0xd7, 0x77, 0xf8, 0xeb, 0x14, 0x7f, 0x9d, 0xe1,
+  0xaf, 0xd7, 0xc6, 0xa3, 0x7c, 0x1e, 0xa8, 0xa8, 0xaa, 0x3d, 0x13, 0x17, 0x72, 0x97, 0x2d, 0xc3,
+  0x11, 0x5c, 0x8b, 0xc5, 0x14, 0xcd, 0xf2, 0x30, 0x79, 0xfa, 0x08, 0x3e, 0x80, 0x86, 0x91, 0x79,
+  0x9d, 0x24, 0xea, 0x99, 0x4e, 0x0d, 0xeb, 0xf8, 0x2b, 0x89, 0x62, 0x39, 0xf6, 0x0a, 0xa7, 0x1f,
+  0xd8, 0xa7, 0xe8, 0x35, 0xd4, 0xb9, 0xeb, 0x2a, 0x4e, 0x5d, 0x1d, 0x31, 0x1b, 0x66, 0xea, 0x39,
+  0xbf, 0xb9, 0xd8, 0x23, 0x07, 0x9f, 0x11, 0x9f, 0x36, 0x0d, 0x45, 0xc6, 0x30, 0x1f, 0xf6, 0x32,
+  0x42, 0x52, 0xad, 0x35, 0xa9, 0xaf, 0x0a, 0xbe, 0x71, 0xb9, 0x48, 0x49, 0x07, 0x8d, 0xa1, 0xb4,
+  0x02, 0xca, 0xe6, 0x58, 0xad, 0x88, 0xe8, 0x71, 0x1a, 0x8a, 0x07, 0x6c, 0x5e, 0x28, 0x01, 0xb2,
+  0x79, 0xf4, 0xf0, 0x16, 0xf5, 0xbc, 0x66, 0xcf, 0xcc, 0x25, 0x86, 0xfb, 0xc9, 0xee, 0xd0, 0x9a,
+  0xb8, 0x68, 0x0f, 0xe9, 0x5e, 0x55, 0x3b, 0x69, 0xbf, 0x76, 0xf2, 0xb5, 0xfc, 0xe4, 0x9a, 0xd8,
+  0xd2, 0x75, 0x19, 0x08, 0xae, 0x6f, 0x80, 0xb1, 0xbc, 0x20, 0xa1, 0x4a, 0x2e, 0xcb, 0xdb, 0x0e,
+  0x46, 0x2d, 0xfd, 0xf5, 0x3c, 0xfd, 0x52, 0x8b, 0x2f, 0xc3, 0xd6, 0x44, 0x59, 0x10, 0xda, 0x7c,
+  0x8e, 0xe4, 0x46, 0x69, 0x77, 0x55, 0xc5, 0xab, 0x4c, 0xcf, 0xe3, 0xa2, 0x5f, 0xee, 0x85, 0x24,
+  0x11, 0xe4, 0x56, 0x67, 0x28, 0x0f, 0xf6, 0xd2, 0x28, 0xf6, 0x8b, 0xee, 0x52, 0xc0, 0x08, 0x9a,
+  0x26, 0x6a, 0x5f, 0xe7, 0xd3, 0x89, 0x65, 0x27, 0x7b, 0xa6, 0x05, 0x4b, 0xa5, 0xc5, 0x9f, 0x23,
+  0xd5, 0xe4, 0xde, 0x39, 0xd4, 0xfc, 0x65, 0x72, 0xfb, 0xb1, 0x08, 0xb2, 0xd9, 0xfd, 0x8a, 0x6e,
+  0x24, 0x0b, 0x8f, 0x33, 0x96, 0x59, 0x48, 0xc6, 0x3c, 0x97, 0x0b, 0x23, 0x17, 0x0a, 0x85, 0x43,
+  0x83, 0x66, 0x88, 0x6c, 0x85, 0x1d, 0x4c, 0xa7, 0x9a, 0x66, 0x69, 0x87, 0xcc, 0x66, 0x5e, 0x71,
+  0x69, 0x39, 0x39, 0x15, 0x7c, 0x66, 0xa9, 0xb7, 0x23, 0x8b, 0x3d, 0x9d, 0x59, 0xe5, 0xac, 0x05,
+  0x33, 0xa5, 0x45, 0x1f, 0x3e, 0x53, 0x97, 0xbf, 0x91, 0x96, 0x99, 0x4b, 0xcc, 0x52, 0xe5, 0xb5,
+  0xba, 0x00, 0x54, 0x51, 0x5d, 0xab, 0x8f, 0x49, 0xd5, 0x48, 0xad, 0x3c, 0x02, 0x3a, 0x0e, 0xee,
+  0x51, 0xdf, 0x3f, 0x01, 0xf5, 0x9a, 0xc3, 0x99, 0xfc, 0x19, 0xae, 0x1e, 0x47, 0xac, 0x9d, 0xdc,
+  0xd8, 0x37, 0x8b, 0xd1, 0x29, 0x45, 0xb7, 0x18, 0x8b, 0x1e, 0x46, 0xb1, 0x47, 0x0b, 0x54, 0x87,
+  0x9f, 0x8c, 0x28, 0xb4, 0x5c, 0x93, 0x26, 0xc5, 0x78, 0x2c, 0xe5, 0xa4, 0x35, 0x16, 0xfa, 0xc9,
+  0xa3, 0x7a, 0xfd, 0x75, 0xbb, 0x70, 0x9f, 0x79, 0x5e, 0x54, 0x96, 0xe9, 0xc3, 0x27, 0x93, 0xf6,
+  0x67, 0x2c, 0xa0, 0xed, 0x1d, 0x95, 0x54, 0xa8, 0x7a, 0x0e, 0x90, 0x00, 0x66, 0x41, 0x9c, 0x13,
+  0x4e, 0xb1, 0xb7, 0x1b, 0x08, 0x06, 0x44, 0xa5, 0xde, 0x1e, 0xe5, 0x3c, 0x4d, 0x6d, 0xa3, 0xb7,
+  0xa9, 0x8b, 0x44, 0xdc, 0x0d, 0x2c, 0x3a, 0x02, 0x8f, 0x92, 0x23, 0xca, 0x81, 0xcd, 0x10, 0xad,
+  0x2e, 0xb3, 0x4c, 0x0a, 0xc4, 0x0b, 0x29, 0xb1, 0x17, 0xe0, 0x90, 0xa3, 0x54, 0x55, 0x26, 0x39,
+  0x07, 0xc7, 0xe5, 0xdc, 0x11, 0xe4, 0xa0, 0x90, 0x4d, 0x27, 0x16, 0x97, 0xad, 0xa9, 0x94, 0x25,
+  0x23, 0xba, 0xb0, 0x00, 0xa3, 0x1c, 0xc5, 0x1b, 0x58, 0x69, 0xc8, 0x30, 0x6a, 0xf4, 0x73, 0x5d,
+  0x4e, 0xa0, 0x0f, 0xc7, 0x27, 0x83, 0xf2, 0x53, 0xca, 0xda, 0x62, 0x0d, 0xfa, 0x50, 0xf4, 0x9c,
+  0xfb, 0x37, 0xb4, 0x00, 0xae, 0x1e, 0x97, 0x75, 0xcf, 0x7a, 0xeb, 0x38, 0x1f, 0x8b, 0x4f, 0x26,
+  0x71, 0x19, 0xfa, 0x54, 0xb2, 0x85, 0x27, 0x2e, 0xc4, 0x72, 0x68, 0x1f, 0x8c, 0x80, 0xb5, 0xb9,
+  0x60, 0x21, 0x9a, 0x44, 0xcc, 0xd9, 0x49, 0xe5, 0xfe, 0x2e, 0x2b, 0x14, 0x84, 0x1d, 0x7d, 0xf5,
+  0x41, 0xad, 0x75, 0xa3, 0xb7, 0x59, 0x06, 0x9b, 0x96, 0x15, 0x07, 0x55, 0x6f, 0x10, 0x0e, 0x46,
+  0x3a, 0x44, 0xad, 0x77, 0x30, 0x95, 0x6c, 0xee, 0xdf, 0xdd, 0xdb, 0xbb, 0x0f, 0x57, 0x8f, 0x63,
+  0x52, 0x85, 0x63, 0x3d, 0x28, 0x68, 0x2f, 0xec, 0x44, 0xab, 0xc5, 0x50, 0xdd, 0x34, 0xee, 0xec,
+  0x91, 0x83, 0xca, 0x22, 0x54, 0xec, 0x95, 0x34, 0x23, 0xba, 0x5a, 0xb2, 0x5d, 0x92, 0xef, 0xc7,
+  0x65, 0x8f, 0xe4, 0x6f, 0x15, 0x94, 0x55, 0x37, 0xea, 0xb3, 0xf1, 0x78, 0x64, 0x4d, 0x31, 0xa2,
+  0x3c, 0x39, 0x4f, 0x06, 0x96, 0x66, 0xe9, 0x65, 0xc5, 0x03, 0x50, 0x47, 0x8b, 0x8b, 0xc8, 0x52,
+  0x35, 0x11, 0xf5, 0xb9, 0x58, 0x76, 0xc8, 0xb5, 0xe4, 0xf5, 0xab, 0x52, 0xfd, 0xe6, 0xe3, 0x32,
+  0xa1, 0x44, 0x39, 0xf1, 0xb8, 0x16, 0x3b, 0xc5, 0xaf, 0x8b, 0x15, 0x15, 0x80, 0x12, 0xe5, 0x63,
+  0x4c, 0x34, 0xf9, 0xb8, 0x10, 0x2b, 0x5f, 0xcb, 0x6f, 0xf1, 0x06, 0x0f, 0x5e, 0xdf, 0x49, 0xae,
+  0xca, 0x18, 0x03, 0xec, 0xa9, 0x2e, 0x8d, 0x76, 0xd4, 0x7b, 0x77, 0xd8, 0xf3, 0xdd, 0x71, 0xaf,
+  0xd7, 0x5b, 0xef, 0x19, 0xf9, 0x53, 0xd7, 0x93, 0x0b, 0x9d, 0xd0, 0x83, 0xe5, 0x11, 0x2b, 0xbe,
+  0x8a, 0x7e, 0xd8, 0x07, 0x3e, 0xb3, 0x2c, 0xac, 0xe8, 0x86, 0x04, 0x01, 0xf7, 0x83, 0xbd, 0x3d,
+  0x98, 0x6e, 0xf5, 0xba, 0xd3, 0xeb, 0x3d, 0xe5, 0x5d, 0x54, 0x41, 0x3a, 0x2a, 0x22, 0xbb, 0x7e,
+  0xa6, 0x80, 0xdd, 0x8c, 0xfe, 0xde, 0x8f, 0xc7, 0x30, 0xb5, 0x9a, 0x05, 0xee, 0x13, 0xec, 0xa1,
+  0x4a, 0xca, 0xe8, 0x71, 0xd4, 0x3b, 0x86, 0xfa, 0xce, 0xc2, 0xe7, 0x7b, 0xb7, 0xe0, 0x80, 0x0a,
+  0x41, 0x43, 0x6e, 0x76, 0xaa, 0x40, 0xfb, 0x5d, 0x6b, 0x6d, 0xfd, 0x53, 0x37, 0x38, 0x6c, 0xe2,
+  0xb2, 0xb2, 0x76, 0xa6, 0x2a, 0xb7, 0x6e, 0x70, 0xd8, 0xc1, 0x13, 0xa8, 0xd1, 0x08, 0x66, 0x81,
+  0x4d, 0x27, 0x6e, 0x40, 0xed, 0x04, 0x69, 0xef, 0xdf, 0xbd, 0xd5, 0x5e, 0x5b, 0x87, 0xab, 0xc7,
+  0xaa, 0x1b, 0x72, 0x77, 0xd2, 0xc7, 0x9b, 0x53, 0xdf, 0xe8, 0x57, 0xe0, 0xce, 0xe4, 0x8b, 0x8c,
+  0x23, 0x40, 0xef, 0x17, 0xd5, 0x1a, 0x4b, 0x47, 0x46, 0xdf, 0xd8, 0xa1, 0x42, 0x6a, 0xd1, 0xeb,
+  0x42, 0x1a, 0xa7, 0xe1, 0xcb, 0x12, 0xbf, 0xe8, 0xb7, 0x08, 0x7f, 0x95, 0xa7, 0xc6, 0x49, 0xdc,
+  0x37, 0x12, 0xe3, 0x7d, 0x4b, 0x9c, 0xbc, 0x17, 0xb7, 0x85, 0x42, 0xdc, 0xdf, 0xea, 0xed, 0xf0,
+  0x93, 0x6e, 0xaa, 0xe1, 0x3a, 0x36, 0xf8, 0x7c, 0x7f, 0x50, 0xc6, 0xa0, 0xda, 0x49, 0x94, 0x06,
+  0xe5, 0xc9, 0x22, 0xa7, 0x34, 0x88, 0x6e, 0x6f, 0xdc, 0x26, 0x82, 0x66, 0x87, 0xc0, 0xfb, 0xf8,
+  0x92, 0x69, 0xcf, 0x2c, 0xfe, 0xf1, 0x09, 0xf8, 0x60, 0x04, 0xfb, 0xd0, 0x4c, 0xf0, 0x2d, 0x92,
+  0x41, 0x9b, 0xfd, 0x7c, 0xef, 0xd6, 0x5d, 0x36, 0x0b, 0x79, 0xd3, 0x2c, 0x1e, 0x99, 0xa4, 0xe0,
+  0x70, 0xaa, 0xfb, 0x8e, 0x8a, 0x76, 0xe5, 0x03, 0xcc, 0xfd, 0xaa, 0x14, 0x39, 0xae, 0xa8, 0xd1,
+  0x27, 0x99, 0x3f, 0x7d, 0x51, 0x34, 0x84, 0xfc, 0xf6, 0x2d, 0xb1, 0x82, 0x32, 0x4f, 0x73, 0x25,
+  0x0e, 0x09, 0x71, 0x49, 0x92, 0x97, 0xf5, 0x28, 0x1b, 0x6a, 0xd6, 0x14, 0x42, 0x57, 0x71, 0x6a,
+  0x0f, 0x4a, 0x7c, 0x5a, 0xa5, 0x57, 0x48, 0xbf, 0xa3, 0x6a, 0xe4, 0x61, 0xbc, 0x22, 0xab, 0x8a,
+  0x4c, 0x58, 0x3e, 0x55, 0x2f, 0xb0, 0x96, 0x9c, 0xc0, 0xea, 0x13, 0xd4, 0x5a, 0xd7, 0xb3, 0xbc,
+  0x58, 0x59, 0x3c, 0xc0, 0x8c, 0x4f, 0x85, 0x8b, 0x47, 0xb3, 0x57, 0x34, 0x5b, 0x7a, 0x70, 0x7a,
+  0x98, 0x0e, 0xfe, 0x0f, 0xa2, 0xd7, 0x97, 0x9a, 0x51, 0x47, 0x75, 0x4e, 0x5e, 0x20, 0xbf, 0x7c,
+  0x94, 0x9c, 0xa8, 0xaf, 0x99, 0x99, 0xb4, 0xb4, 0xe4, 0x06, 0x1f, 0x0b, 0x8c, 0xd2, 0x03, 0xfa,
+  0x12, 0x62, 0x3d, 0xb3, 0x8e, 0xce, 0x64, 0x52, 0x24, 0x54, 0xfd, 0xb3, 0xf2, 0x95, 0x42, 0xa8,
+  0xbc, 0x70, 0xf1, 0x4e, 0xe9, 0x35, 0xf2, 0xbf, 0x23, 0x3e, 0x24, 0xb1, 0xa1, 0x64, 0xeb, 0x4f,
+  0x49, 0x28, 0x78, 0xee, 0x2e, 0xa3, 0xfe, 0xe3, 0x03, 0xa1, 0xe0, 0x9d, 0xe9, 0x8c, 0x3b, 0xcd,
+  0x7d, 0x7d, 0x93, 0xbb, 0xaf, 0x50, 0x71, 0x64, 0x4d, 0xff, 0xaa, 0x6e, 0x8b, 0x15, 0x9c, 0x98,
+  0x72, 0x8c, 0x71, 0x4b, 0x01, 0x5b, 0x68, 0xd9, 0x3b, 0xd6, 0xda, 0x3a, 0x1a, 0xe3, 0xc3, 0x47,
+  0xcb, 0xab, 0x1d, 0xe8, 0x70, 0xa2, 0xd2, 0x6b, 0x3c, 0x6b, 0x99, 0xf3, 0x36, 0x73, 0x04, 0x0b,
+  0xa1, 0x4e, 0x8f, 0xff, 0x92, 0xb9, 0x41, 0xd3, 0x80, 0xaf, 0xc1, 0x28, 0xf6, 0xcf, 0x06, 0xbc,
+  0x22, 0x3f, 0x8a, 0x8f, 0x24, 0x0c, 0xd6, 0xde, 0x78, 0xf3, 0x45, 0x6d, 0xcd, 0x3b, 0xb9, 0xcc,
+  0x59, 0x54, 0x86, 0x2f, 0x4c, 0xf0, 0x45, 0xb4, 0x96, 0xf8, 0xef, 0x7a, 0x95, 0xad, 0x06, 0xdf,
+  0xd3, 0x56, 0x2b, 0xca, 0x2c, 0xe5, 0x21, 0x96, 0xe1, 0x5b, 0x58, 0x55, 0x6f, 0x65, 0x0a, 0xda,
+  0xad, 0x5c, 0xc5, 0xbc, 0x65, 0xa4, 0xde, 0x32, 0x30, 0x1e, 0x25, 0xd2, 0x76, 0xed, 0xaa, 0xb2,
+  0x08, 0xad, 0x2b, 0xe3, 0xbb, 0x76, 0x49, 0x2d, 0x8f, 0x7a, 0x26, 0x50, 0x0f, 0x99, 0xc0, 0x7a,
+  0x8e, 0xda, 0xf3, 0x59, 0x36, 0x2e, 0x91, 0x26, 0x77, 0xbb, 0xf0, 0x29, 0xfe, 0xb9, 0x88, 0x08,
+  0xe5, 0xb2, 0x23, 0x1a, 0x42, 0x57, 0xa3, 0xb4, 0x01, 0x1e, 0x76, 0x78, 0x5c, 0xc7, 0x7e, 0xc1,
+  0x54, 0x16, 0x83, 0x85, 0xd6, 0x6e, 0xd4, 0x77, 0xee, 0xd0, 0x20, 0x7f, 0x10, 0x3e, 0x0e, 0xd9,
+  0x9c, 0xd3, 0x30, 0x3a, 0x58, 0x05, 0x25, 0x85, 0x5d, 0x36, 0x0b, 0x2d, 0x0a, 0x2c, 0x4c, 0x1f,
+  0x34, 0x87, 0x74, 0x32, 0xe3, 0x54, 0x9f, 0x3d, 0x73, 0x11, 0x52, 0xe2, 0x67, 0xf3, 0x19, 0x9c,
+  0x0c, 0x15, 0x19, 0x56, 0xe7, 0x32, 0x1c, 0x43, 0xd6, 0x7d, 0xbd, 0xa8, 0x66, 0x31, 0xbc, 0x24,
+  0x14, 0xca, 0x20, 0x7b, 0xf5, 0xd9, 0x72, 0x7a, 0x62, 0x4e, 0xc5, 0x27, 0xf8, 0xa2, 0xce, 0x11,
+  0xf1, 0x9a, 0xe9, 0x11, 0x2d, 0x15, 0x9d, 0x7b, 0x2b, 0x66, 0xf9, 0x6a, 0x9d, 0x28, 0xe4, 0xd2,
+  0xb4, 0x4b, 0x25, 0x0e, 0x73, 0x37, 0xb0, 0xd9, 0xbc, 0x93, 0x12, 0x97, 0x42, 0x95, 0x19, 0x06,
+  0xcb, 0xef, 0x40, 0x46, 0x2e, 0x4a, 0x8b, 0x58, 0xc3, 0x89, 0x14, 0x95, 0xa6, 0x11, 0xe9, 0x32,
+  0xbb, 0x1f, 0x74, 0x77, 0xbc, 0x9c, 0xa4, 0xfa, 0xe2, 0x4d, 0x25, 0x1a, 0xd0, 0x30, 0x76, 0x66,
+  0x46, 0x0b, 0x68, 0xd1, 0x5a, 0x73, 0x32, 0x3d, 0x06, 0xcb, 0xa3, 0x24, 0x4c, 0xe4, 0xb3, 0x7c,
+  0x34, 0x28, 0x2a, 0x2f, 0x07, 0x6d, 0xd3, 0xd8, 0x20, 0x75, 0xae, 0x8b, 0x67, 0x17, 0x82, 0x98,
+  0x95, 0x55, 0x9e, 0x64, 0xe1, 0x2c, 0x50, 0x87, 0x74, 0x49, 0xbd, 0x29, 0xbb, 0xd0, 0x6e, 0x37,
+  0x63, 0x77, 0x21, 0x15, 0xa1, 0x4b, 0x39, 0x8c, 0x17, 0xe0, 0x0a, 0x4e, 0xbd, 0x89, 0x5e, 0x1f,
+  0xcc, 0x02, 0xe1, 0x7a, 0xfa, 0x0a, 0x86, 0xc5, 0x82, 0x00, 0xef, 0x23, 0x65, 0x6f, 0xd0, 0xe7,
+  0xc4, 0x9f, 0x5e, 0xd4, 0x6a, 0x8a, 0xcf, 0xc5, 0x5b, 0x97, 0xdf, 0x0b, 0xca, 0x52, 0x6e, 0xbd,
+  0x85, 0x2b, 0x9d, 0x5a, 0xfc, 0xba, 0x71, 0xd1, 0xa5, 0x69, 0x82, 0x1e, 0xb5, 0xf3, 0x17, 0xce,
+  0xf2, 0xd5, 0x3c, 0x15, 0x3f, 0xb3, 0xfd, 0xe2, 0x3b, 0x7c, 0xd9, 0xae, 0x25, 0xdc, 0x44, 0xa6,
+  0xc9, 0x02, 0x44, 0x57, 0x58, 0x75, 0x8a, 0xb8, 0xcb, 0x97, 0xd2, 0xf2, 0x37, 0xbb, 0x6a, 0x76,
+  0x5b, 0xa6, 0x96, 0x93, 0xdf, 0x1c, 0xf9, 0xc5, 0x0c, 0xbb, 0xf1, 0x5b, 0x04, 0xc3, 0xae, 0x7e,
+  0xbf, 0x68, 0xd8, 0xd5, 0x7f, 0xed, 0xf4, 0x7f, 0x01, 0x9a, 0xeb, 0xf5, 0x18, 0x05, 0x55, 0x00,
+  0x00,
+};
 
-    <script>
-        let currentRelayMode = 'relay_auto';
-        let currentSchedule = [];
-        
-        async function setManualTime() {
-          const y = parseInt(document.getElementById('mt_y').value, 10);
-          const m = parseInt(document.getElementById('mt_m').value, 10);
-          const d = parseInt(document.getElementById('mt_d').value, 10);
-          const H = parseInt(document.getElementById('mt_H').value, 10);
-          const M = parseInt(document.getElementById('mt_M').value, 10);
-          const S = parseInt(document.getElementById('mt_S').value, 10);
-        
-          if (!(y >= 2020 && m >= 1 && m <= 12 && d >= 1 && d <= 31 && H >= 0 && H <= 23 && M >= 0 && M <= 59 && S >= 0 && S <= 59)) {
-            alert('Fill all fields with valid values');
-            return;
-          }
-          const qs = new URLSearchParams({ y, m, d, H, M, S }).toString();
-          try {
-            const res = await fetch(`/set_time?${qs}`);
-            const text = await res.text();
-            if (!res.ok) { alert(text || 'Set time failed'); return; }
-            updateStatus();
-          } catch (e) { alert('Network error: ' + e.message); }
-        }
-        
-        async function sendCmd(cmd) {
-          try {
-            const res = await fetch(`/cmd?c=${encodeURIComponent(cmd)}`);
-            const text = await res.text();
-            if (!res.ok) { alert(text || 'Command failed'); return false; }
-            updateStatus();
-            return true;
-          } catch (e) { alert('Network error: ' + e.message); return false; }
-        }
-        
-        async function setRelayMode(mode) {
-          const ok = await sendCmd(mode);
-          if (ok) { currentRelayMode = mode; highlightRelayButtons(); }
-        }
-        
-        function highlightRelayButtons() {
-          document.querySelectorAll('.three-way-switch button').forEach(btn => btn.classList.remove('active'));
-          if (currentRelayMode === 'relay_on') document.getElementById('btn_on').classList.add('active');
-          else if (currentRelayMode === 'relay_off') document.getElementById('btn_off').classList.add('active');
-          else document.getElementById('btn_auto').classList.add('active');
-        }
-        
-        async function toggleMode(toggle) {
-          const cmd = toggle.checked ? 'shabbat' : 'week';
-          const ok = await sendCmd(cmd);
-          if (!ok) { toggle.checked = !toggle.checked; }
-        }
-        
-        function fillTimeSelects() {
-          const hh = document.getElementById('hh');
-          const mm = document.getElementById('mm');
-          if (!hh || !mm) return;
-          hh.innerHTML = ''; mm.innerHTML = '';
-          for (let h = 0; h < 24; h++) {
-            const o = document.createElement('option');
-            o.value = h; o.textContent = String(h).padStart(2, '0');
-            hh.appendChild(o);
-          }
-          for (let m = 0; m < 60; m++) {
-            const o = document.createElement('option');
-            o.value = m; o.textContent = String(m).padStart(2, '0');
-            mm.appendChild(o);
-          }
-        }
-        
-        async function addSchedule() {
-          const hhEl = document.getElementById('hh');
-          const mmEl = document.getElementById('mm');
-          const state = document.getElementById('scheduleState').value;
-          const day   = parseInt(document.getElementById('scheduleDay').value, 10);
-        
-          if (!hhEl || !mmEl || isNaN(day)) { alert('Please select a time and day.'); return; }
-        
-          const hour   = parseInt(hhEl.value, 10);
-          const minute = parseInt(mmEl.value, 10);
-          const existing = currentSchedule.find(e => e.day === day && e.hour === hour && e.minute === minute);
-        
-          if (existing) {
-            if (existing.state === state) { alert("The new event is identical to the existing one. No changes made."); return; } 
-            else {
-              const confirmOverwrite = confirm(`למחוק ${String(hour).padStart(2,'0')}:${String(minute).padStart(2,'0')} ולהחליף במצב חדש?`);
-              if (!confirmOverwrite) return;
-            }
-          }
-        
-          try {
-            const res = await fetch(`/schedule?hour=${hour}&minute=${minute}&state=${state}&day=${day}`);
-            const text = await res.text();
-            if (!res.ok) { alert(text || 'Failed to add/update event'); return; }
-            loadSchedule();
-          } catch (e) { alert('Network error: ' + e.message); }
-        }
-        
-        function formatDaysText(entry) {
-          const dnames = ['א','ב','ג','ד','ה','ו','ש'];
-          if (entry.day >= 0 && entry.day <= 6) return dnames[entry.day] + "'";
-          return '';
-        }
-        
-        function loadSchedule() {
-          fetch('/schedule_list')
-            .then(r => r.json())
-            .then(data => {
-              currentSchedule = data;
-              const tbody = document.getElementById('scheduleTable').getElementsByTagName('tbody')[0];
-              tbody.innerHTML = '';
-              data.forEach(entry => {
-                const row = tbody.insertRow();
-                row.insertCell(0).textContent = `${String(entry.hour).padStart(2,'0')}:${String(entry.minute).padStart(2,'0')}`;
-                row.insertCell(1).textContent = entry.state === 'on' ? 'הדלקה' : 'כיבוי';
-                row.insertCell(2).textContent = formatDaysText(entry);
-                const actions = row.insertCell(3);
-                const btn = document.createElement('button');
-                btn.textContent = 'מחק';
-                btn.onclick = () => deleteSchedule(entry.day, entry.hour, entry.minute);
-                actions.appendChild(btn);
-              });
-            });
-        }
-        
-        function deleteSchedule(day, hour, minute) {
-          const dayText = formatDaysText({ day: Number(day) });
-          const hh = String(hour).padStart(2,'0');
-          const mm = String(minute).padStart(2,'0');
-        
-          if (!confirm(`למחוק ${hh}:${mm} ביום ${dayText}?`)) return;
-        
-          fetch(`/schedule_delete?day=${day}&hour=${hour}&minute=${minute}`)
-            .then(async r => {
-              const t = await r.text();
-              if (!r.ok) { alert(t); return; }
-              loadSchedule();
-            })
-            .catch(err => alert('Network error: ' + err));
-        }
-        
-        function updateStatus() {
-          fetch('/status', { cache: 'no-store' })
-            .then(r => r.json())
-            .then(data => {
-              document.getElementById('clockDisplay').textContent = data.time || '--:--';
-              const toggle = document.getElementById('shabbatMode');
-              if (toggle) toggle.checked = !!data.shabbat;
-              updateRelayLed(!!data.relay);
-              if (data.relayMode === 1)      currentRelayMode = 'relay_on';
-              else if (data.relayMode === 0) currentRelayMode = 'relay_off';
-              else                           currentRelayMode = 'relay_auto';
-              highlightRelayButtons();
-        
-              const sb = document.getElementById('statusBar');
-              if (sb) {
-                const parts = [];
-                parts.push(`זמן: ${data.timeValid ? 'תקין' : 'לא תקין'}`);
-                parts.push(`HC-12: ${data.hc12Ok ? 'תקין' : 'לא ידוע'}`);
-                sb.textContent = parts.join(' | ');
-                sb.style.color = data.timeValid ? '' : '#b00020';
-              }
-              const mt = document.getElementById('manualTime');
-              if (mt) mt.style.display = data.timeValid ? 'none' : '';
-              ['hh','mm','scheduleDay','scheduleState','btnAddEvent'].forEach(id => {
-                const el = document.getElementById(id);
-                if (el) el.disabled = !data.timeValid;
-              });
-            })
-            .catch(_ => {
-              const sb = document.getElementById('statusBar');
-              if (sb) { sb.textContent = 'שגיאת סטטוס'; sb.style.color = '#b00020'; }
-            });
-        }
-        
-        function updateRelayLed(isOn) {
-          const led = document.getElementById('relayLed');
-          if (isOn) led.classList.add('on');
-          else led.classList.remove('on');
-        }
-        
-        window.onload = function() {
-          fillTimeSelects();
-          updateStatus(); 
-          loadSchedule(); 
-          setInterval(updateStatus, 10000);
-        }
-    </script>
-</body>
-</html>
-)rawliteral";
+#endif // INDEX_PAGE_H
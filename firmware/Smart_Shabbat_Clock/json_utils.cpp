@@ -0,0 +1,169 @@
+#include "json_utils.h"
+
+String jsonEscape(const String& value) {
+  String out;
+  out.reserve(value.length() + 8);
+  for (uint16_t i = 0; i < value.length(); i++) {
+    char c = value[i];
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (c == '\n') {
+      out += "\\n";
+    } else if (c == '\r') {
+      out += "\\r";
+    } else {
+      out += c;
+    }
+  }
+  return out;
+}
+
+String jsonString(const String& value) {
+  return "\"" + jsonEscape(value) + "\"";
+}
+
+String jsonBool(bool value) {
+  return value ? "true" : "false";
+}
+
+bool parseJsonStringAt(const String& json, int quotePos, String& value, int& nextPos) {
+  if (quotePos < 0 || quotePos >= json.length() || json[quotePos] != '"') return false;
+
+  value = "";
+  bool escaped = false;
+  for (int i = quotePos + 1; i < json.length(); i++) {
+    char c = json[i];
+    if (escaped) {
+      value += c;
+      escaped = false;
+    } else if (c == '\\') {
+      escaped = true;
+    } else if (c == '"') {
+      nextPos = i + 1;
+      return true;
+    } else {
+      value += c;
+    }
+  }
+  return false;
+}
+
+bool findStringValue(const String& json, const String& key, String& value) {
+  int keyPos = json.indexOf("\"" + key + "\"");
+  if (keyPos < 0) return false;
+
+  int colon = json.indexOf(':', keyPos);
+  if (colon < 0) return false;
+
+  int quote = json.indexOf('"', colon + 1);
+  int next = 0;
+  return parseJsonStringAt(json, quote, value, next);
+}
+
+bool findNumberValue(const String& json, const String& key, uint32_t& value) {
+  int keyPos = json.indexOf("\"" + key + "\"");
+  if (keyPos < 0) return false;
+
+  int colon = json.indexOf(':', keyPos);
+  if (colon < 0) return false;
+
+  int pos = colon + 1;
+  while (pos < json.length() && (json[pos] == ' ' || json[pos] == '\n' || json[pos] == '\r')) pos++;
+
+  uint32_t parsed = 0;
+  bool foundDigit = false;
+  while (pos < json.length() && json[pos] >= '0' && json[pos] <= '9') {
+    foundDigit = true;
+    parsed = parsed * 10 + (json[pos] - '0');
+    pos++;
+  }
+
+  if (!foundDigit) return false;
+  value = parsed;
+  return true;
+}
+
+bool extractValueBlock(const String& json, const String& key, String& value) {
+  int keyPos = json.indexOf("\"" + key + "\"");
+  if (keyPos < 0) return false;
+
+  int colon = json.indexOf(':', keyPos);
+  if (colon < 0) return false;
+
+  int pos = colon + 1;
+  while (pos < json.length() && (json[pos] == ' ' || json[pos] == '\n' || json[pos] == '\r')) pos++;
+  if (pos >= json.length()) return false;
+
+  char open = json[pos];
+  char close = (open == '{') ? '}' : ((open == '[') ? ']' : '\0');
+  if (close == '\0') return false;
+
+  int depth = 0;
+  bool inString = false;
+  bool escaped = false;
+  for (int i = pos; i < json.length(); i++) {
+    char c = json[i];
+    if (inString) {
+      if (escaped) escaped = false;
+      else if (c == '\\') escaped = true;
+      else if (c == '"') inString = false;
+      continue;
+    }
+
+    if (c == '"') inString = true;
+    else if (c == open) depth++;
+    else if (c == close) {
+      depth--;
+      if (depth == 0) {
+        value = json.substring(pos, i + 1);
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+int findObjectEnd(const String& json, int start) {
+  int depth = 0;
+  bool inString = false;
+  bool escaped = false;
+  for (int i = start; i < json.length(); i++) {
+    char c = json[i];
+    if (inString) {
+      if (escaped) escaped = false;
+      else if (c == '\\') escaped = true;
+      else if (c == '"') inString = false;
+      continue;
+    }
+
+    if (c == '"') inString = true;
+    else if (c == '{') depth++;
+    else if (c == '}') {
+      depth--;
+      if (depth == 0) return i;
+    }
+  }
+  return -1;
+}
+
+bool parseScheduleEvent(const String& object, ScheduleEntry& event) {
+  uint32_t day = 0;
+  uint32_t hour = 0;
+  uint32_t minute = 0;
+  String state;
+
+  if (!findNumberValue(object, "day", day)) return false;
+  if (!findNumberValue(object, "hour", hour)) return false;
+  if (!findNumberValue(object, "minute", minute)) return false;
+  if (!findStringValue(object, "state", state)) return false;
+  if (day > 6 || hour > 23 || minute > 59) return false;
+  if (state != "on" && state != "off") return false;
+
+  event.day = (uint8_t)day;
+  event.hour = (uint8_t)hour;
+  event.minute = (uint8_t)minute;
+  event.state = (state == "on");
+  return true;
+}
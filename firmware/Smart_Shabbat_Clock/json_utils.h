@@ -0,0 +1,28 @@
+#ifndef JSON_UTILS_H
+#define JSON_UTILS_H
+
+#include "schedule.h"
+#include <Arduino.h>
+#include <stdint.h>
+
+// ---------------------- Minimal JSON Helpers ----------------------
+// Just enough JSON for the small, known documents we exchange with the cloud
+// and the local UI. Lookups are by key anywhere in the given text, so pass the
+// innermost object that holds the key.
+
+String jsonEscape(const String& value);
+String jsonString(const String& value);
+String jsonBool(bool value);
+
+bool parseJsonStringAt(const String& json, int quotePos, String& value, int& nextPos);
+bool findStringValue(const String& json, const String& key, String& value);
+bool findNumberValue(const String& json, const String& key, uint32_t& value);
+// Copy the raw {...} or [...] value of key into value.
+bool extractValueBlock(const String& json, const String& key, String& value);
+// Index of the '}' closing the object that starts at json[start], or -1.
+int findObjectEnd(const String& json, int start);
+
+// {"day":0-6,"hour":0-23,"minute":0-59,"state":"on"|"off"}
+bool parseScheduleEvent(const String& object, ScheduleEntry& event);
+
+#endif // JSON_UTILS_H
@@ -0,0 +1,119 @@
+#include "metrics.h"
+
+// CHANGE HERE: histogram bucket upper bounds (microseconds); +Inf is implicit.
+static const uint8_t METRIC_BUCKET_COUNT = 10;
+static const uint32_t BUCKET_BOUNDS_US[METRIC_BUCKET_COUNT] = {
+  100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000
+};
+
+struct MetricTimerInfo {
+  const char* name;
+  uint32_t budgetUs;  // CHANGE HERE: samples above this count as over budget
+};
+
+static const MetricTimerInfo TIMER_INFO[METRIC_TIMER_COUNT] = {
+  {"loop", 100000},
+  {"web_tick", 20000},
+  {"http_deferred", 100000},
+  {"cloud_tick", 100000},
+  {"cloud_http", 2000000},
+  {"display", 20000},
+  {"hc12", 600000},
+  {"nvs_write", 20000},
+};
+
+static const char* const COUNTER_NAMES[METRIC_COUNTER_COUNT] = {
+  "http_requests",
+  "i2c_lcd_writes",
+  "i2c_rtc_reads",
+};
+
+// Timers are written from the loop thread only; counters may also be bumped
+// from the AsyncTCP task, so those use atomic adds. Readers tolerate a torn
+// snapshot (a sample counted in one field but not yet in another).
+struct MetricHistogram {
+  uint32_t buckets[METRIC_BUCKET_COUNT + 1];
+  uint32_t count;
+  uint64_t sumUs;
+  uint32_t maxUs;
+  uint32_t overBudget;
+};
+
+static MetricHistogram histograms[METRIC_TIMER_COUNT] = {};
+static uint32_t counters[METRIC_COUNTER_COUNT] = {};
+
+void metricsRecordUs(MetricTimer timer, uint32_t elapsedUs) {
+  MetricHistogram& h = histograms[timer];
+  uint8_t bucket = 0;
+  while (bucket < METRIC_BUCKET_COUNT && elapsedUs > BUCKET_BOUNDS_US[bucket]) bucket++;
+  h.buckets[bucket]++;
+  h.count++;
+  h.sumUs += elapsedUs;
+  if (elapsedUs > h.maxUs) h.maxUs = elapsedUs;
+  if (elapsedUs > TIMER_INFO[timer].budgetUs) h.overBudget++;
+}
+
+void metricsRecord(MetricTimer timer, uint32_t startUs) {
+  metricsRecordUs(timer, (uint32_t)esp_timer_get_time() - startUs);
+}
+
+void metricsCount(MetricCounter counter, uint32_t amount) {
+  __atomic_fetch_add(&counters[counter], amount, __ATOMIC_RELAXED);
+}
+
+uint32_t metricsSamples(MetricTimer timer) {
+  return histograms[timer].count;
+}
+
+uint32_t metricsOverBudget(MetricTimer timer) {
+  return histograms[timer].overBudget;
+}
+
+uint32_t metricsMaxUs(MetricTimer timer) {
+  return histograms[timer].maxUs;
+}
+
+void metricsWritePrometheus(Print& out) {
+  out.print("# HELP shabbat_duration_us Time spent per subsystem, microseconds.\n"
+            "# TYPE shabbat_duration_us histogram\n");
+  for (uint8_t t = 0; t < METRIC_TIMER_COUNT; t++) {
+    const MetricHistogram& h = histograms[t];
+    const char* name = TIMER_INFO[t].name;
+    uint32_t cumulative = 0;
+    for (uint8_t b = 0; b < METRIC_BUCKET_COUNT; b++) {
+      cumulative += h.buckets[b];
+      out.printf("shabbat_duration_us_bucket{subsystem=\"%s\",le=\"%lu\"} %lu\n",
+                 name, (unsigned long)BUCKET_BOUNDS_US[b], (unsigned long)cumulative);
+    }
+    cumulative += h.buckets[METRIC_BUCKET_COUNT];
+    out.printf("shabbat_duration_us_bucket{subsystem=\"%s\",le=\"+Inf\"} %lu\n", name, (unsigned long)cumulative);
+    out.printf("shabbat_duration_us_sum{subsystem=\"%s\"} %llu\n", name, (unsigned long long)h.sumUs);
+    out.printf("shabbat_duration_us_count{subsystem=\"%s\"} %lu\n", name, (unsigned long)h.count);
+  }
+
+  out.print("# HELP shabbat_duration_max_us Longest sample since boot, microseconds.\n"
+            "# TYPE shabbat_duration_max_us gauge\n");
+  for (uint8_t t = 0; t < METRIC_TIMER_COUNT; t++) {
+    out.printf("shabbat_duration_max_us{subsystem=\"%s\"} %lu\n", TIMER_INFO[t].name, (unsigned long)histograms[t].maxUs);
+  }
+
+  out.print("# HELP shabbat_over_budget_total Samples above the subsystem budget.\n"
+            "# TYPE shabbat_over_budget_total counter\n");
+  for (uint8_t t = 0; t < METRIC_TIMER_COUNT; t++) {
+    out.printf("shabbat_over_budget_total{subsystem=\"%s\",budget_us=\"%lu\"} %lu\n", TIMER_INFO[t].name,
+               (unsigned long)TIMER_INFO[t].budgetUs, (unsigned long)histograms[t].overBudget);
+  }
+
+  out.print("# TYPE shabbat_events_total counter\n");
+  for (uint8_t c = 0; c < METRIC_COUNTER_COUNT; c++) {
+    out.printf("shabbat_events_total{event=\"%s\"} %lu\n", COUNTER_NAMES[c],
+               (unsigned long)__atomic_load_n(&counters[c], __ATOMIC_RELAXED));
+  }
+
+  out.print("# TYPE shabbat_heap_free_bytes gauge\n");
+  out.printf("shabbat_heap_free_bytes %lu\n", (unsigned long)ESP.getFreeHeap());
+  out.print("# TYPE shabbat_heap_min_free_bytes gauge\n");
+  out.printf("shabbat_heap_min_free_bytes %lu\n", (unsigned long)ESP.getMinFreeHeap());
+  out.print("# TYPE shabbat_uptime_seconds counter\n");
+  out.printf("shabbat_uptime_seconds %lu\n", millis() / 1000UL);
+}
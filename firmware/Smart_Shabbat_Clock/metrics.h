@@ -0,0 +1,56 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <stdint.h>
+
+// ---------------------- Device Metrics ----------------------
+// Always-on instrumentation: per-subsystem timings from esp_timer, kept in
+// fixed-bucket histograms, plus a few plain counters.
+// Recording is a handful of integer ops; nothing allocates.
+// Exposed as Prometheus text on GET /metrics (web_api.cpp).
+//
+// Usage:
+//   uint32_t t0 = metricsStart();
+//   ...work...
+//   metricsRecord(METRIC_NVS_WRITE, t0);
+//
+// esp_timer keeps counting across CPU frequency changes and light sleep
+// (power_manager.h), unlike the cycle counter, and is shared by all tasks.
+// Starts are truncated to 32 bits, so spans up to ~71 min.
+
+enum MetricTimer : uint8_t {
+  METRIC_LOOP = 0,        // one loop() iteration
+  METRIC_WEB_TICK,        // tickWebApi(): deferred web actions + status push
+  METRIC_HTTP_DEFERRED,   // deferred web request, queued -> response sent
+  METRIC_CLOUD_TICK,      // tickCloudSync()
+  METRIC_CLOUD_HTTP,      // one Firebase HTTP request
+  METRIC_DISPLAY,         // updateDisplay()
+  METRIC_HC12,            // one HC-12 transaction, TX -> ACK or timeout
+  METRIC_NVS_WRITE,       // one Preferences open/write/commit
+  METRIC_TIMER_COUNT
+};
+
+enum MetricCounter : uint8_t {
+  COUNTER_HTTP_REQUESTS = 0,  // local web requests received
+  COUNTER_I2C_LCD_WRITES,     // LCD expander writes (one I2C transaction each) drawing frames
+  COUNTER_I2C_RTC,            // RTC time reads
+  METRIC_COUNTER_COUNT
+};
+
+inline uint32_t metricsStart() {
+  return (uint32_t)esp_timer_get_time();
+}
+
+void metricsRecord(MetricTimer timer, uint32_t startUs);
+void metricsRecordUs(MetricTimer timer, uint32_t elapsedUs);
+void metricsCount(MetricCounter counter, uint32_t amount = 1);
+
+// Whole-snapshot readers for /metrics and the cloud status.
+void metricsWritePrometheus(Print& out);
+uint32_t metricsSamples(MetricTimer timer);
+uint32_t metricsOverBudget(MetricTimer timer);
+uint32_t metricsMaxUs(MetricTimer timer);
+
+#endif // METRICS_H
@@ -1,5 +1,7 @@
 #include "peripherals.h"
+#include "i2c_bus.h"
 #include "time_utils.h"
+#include "metrics.h"
 #include <Wire.h>
 #include <LiquidCrystal_I2C.h>
 #include <WiFi.h>
@@ -32,61 +34,111 @@ static byte wifiIcon[8] = {
 // ---------------------- LCD Pages ----------------------
 // CHANGE HERE: number of pages (update PAGE_INTERVALS to match).
 static const uint8_t PAGE_COUNT = 2;
-static LcdPage pages[PAGE_COUNT];
+static DisplayPage pages[PAGE_COUNT];
 static uint8_t currentPage = 0;
 // CHANGE HERE: page timing (ms). one interval per page (must match PAGE_COUNT).
 static const unsigned long PAGE_INTERVALS[] = { 5000, 5000 };
 static unsigned long lastPageSwitch = 0;
 static bool pagesInitialized = false;
 
-void LcdPage::init(uint8_t colsIn, uint8_t rowsIn, unsigned long intervalMsIn) {
-  cols = colsIn;
-  rows = rowsIn;
-  intervalMs = intervalMsIn;
-  clear();
+// Loop side: what was last handed to the i2c task, so an unchanged page
+// (same page, generation and Wi-Fi icon) isn't sent again.
+static uint8_t renderedPage = 0;
+static uint32_t renderedGeneration = 0;
+static bool renderedWifi = false;
+static bool displayDirty = true;  // force the next page out (message shown, LCD re-attached)
+
+// ---------------------- LCD Frames ----------------------
+// The LCD is drawn from whole frames on the i2c task (i2c_bus.h), which
+// keeps a shadow of the LCD contents and only sends the runs of cells
+// that differ.
+struct LcdFrame {
+  char cells[LCD_ROWS][LCD_COLS];
+};
+static_assert(sizeof(LcdFrame) <= I2C_JOB_DATA_SIZE, "LCD frame doesn't fit an I2C job");
+
+// LiquidCrystal_I2C sends every command or character as two nibbles, each
+// one expander write plus two for the enable pulse.
+static const uint8_t LCD_EXPANDER_WRITES_PER_BYTE = 6;
+
+// i2c task only (setup() before initPeripheralBus()).
+static char lcdShadow[LCD_ROWS][LCD_COLS];
+static bool lcdShadowValid = false;
+static LcdFrame lastFrame;
+static bool haveLastFrame = false;
+
+// Write text at (col, row), one setCursor per run of changed cells.
+static void lcdWriteChanged(uint8_t row, uint8_t col, const char* text, uint8_t length) {
+  char* shadow = &lcdShadow[row][col];
+  uint8_t i = 0;
+  while (i < length) {
+    if (lcdShadowValid && shadow[i] == text[i]) {
+      i++;
+      continue;
+    }
+    uint8_t start = i;
+    while (i < length && !(lcdShadowValid && shadow[i] == text[i])) {
+      shadow[i] = text[i];
+      i++;
+    }
+    lcd.setCursor(col + start, row);
+    for (uint8_t c = start; c < i; c++) lcd.write((uint8_t)text[c]);
+    metricsCount(COUNTER_I2C_LCD_WRITES, LCD_EXPANDER_WRITES_PER_BYTE * (1 + i - start));
+  }
 }
 
-void LcdPage::setLine(uint8_t row, const String& text) {
-  if (row >= rows || row >= MAX_LCD_ROWS) return;
-  uint8_t allowedCols = cols;
-  if (row == 0 && cols > 0) allowedCols = cols - 1; // reserve top-right for icon
-  String clipped = text;
-  if (clipped.length() > allowedCols) clipped = clipped.substring(0, allowedCols);
-  while (clipped.length() < allowedCols) clipped += ' ';
-  lines[row] = clipped;
+static void drawFrameJob(const uint8_t* data) {
+  memcpy(&lastFrame, data, sizeof(lastFrame));
+  haveLastFrame = true;
+  for (uint8_t r = 0; r < LCD_ROWS; ++r) lcdWriteChanged(r, 0, lastFrame.cells[r], LCD_COLS);
+  lcdShadowValid = true;
 }
 
-void LcdPage::clear() {
-  for (uint8_t i = 0; i < MAX_LCD_ROWS; ++i) {
-    uint8_t allowedCols = cols;
-    if (i == 0 && cols > 0) allowedCols = cols - 1;
-    String blank = "";
-    for (uint8_t c = 0; c < allowedCols; ++c) blank += ' ';
-    lines[i] = blank;
-  }
+// Queue a frame (drawn directly before the i2c task runs). False if the
+// queue is full or the LCD is missing.
+static bool showFrame(const LcdFrame& frame) {
+  if (i2cBusStarted()) return i2cSubmit(I2C_DEVICE_LCD, drawFrameJob, &frame, sizeof(frame));
+  drawFrameJob((const uint8_t*)&frame);
+  return true;
 }
 
-void LcdPage::render(LiquidCrystal_I2C& lcdRef) const {
-  for (uint8_t r = 0; r < rows && r < MAX_LCD_ROWS; ++r) {
-    lcdRef.setCursor(0, r);
-    lcdRef.print(lines[r]);
-  }
+void lcdShowMessage(const char* text) {
+  if (!lcdAvailable) return;
+  LcdFrame frame;
+  memset(&frame, ' ', sizeof(frame));
+  size_t length = strlen(text);
+  memcpy(frame.cells[0], text, length < LCD_COLS ? length : LCD_COLS);
+  showFrame(frame);
+  displayDirty = true;  // pages come back on the next update
+}
+
+// i2c task: the LCD answers again (or for the first time).
+static bool attachLcd() {
+  lcd.init();
+  lcd.createChar(0, wifiIcon);
+  lcd.backlight();
+  lcdShadowValid = false;
+  if (haveLastFrame) drawFrameJob((const uint8_t*)&lastFrame);
+  return true;
+}
+
+static void onLcdChanged(bool present) {
+  if (present) displayDirty = true;
+}
+
+static bool attachRtc() {
+  return rtc.begin();
 }
 
 void initLcdPages() {
   if (pagesInitialized) return;
   // Change LCD size and page timing above.
   for (uint8_t i = 0; i < PAGE_COUNT; ++i) {
-    pages[i].init(LCD_COLS, LCD_ROWS, PAGE_INTERVALS[i]);
+    pages[i].init(PAGE_INTERVALS[i]);
   }
   pagesInitialized = true;
 }
 
-void setPageLine(uint8_t pageIndex, uint8_t row, const String& text) {
-  if (pageIndex >= PAGE_COUNT) return;
-  pages[pageIndex].setLine(row, text);
-}
-
 // ---------------------- I2C Helpers ----------------------
 // Safe I2C probe so the code can run without soldered peripherals.
 bool isI2CDeviceConnected(uint8_t address) {
@@ -95,9 +147,19 @@ bool isI2CDeviceConnected(uint8_t address) {
 }
 
 // Initialize LCD and RTC only if they are physically connected
-void initPeripheralsSafely() {
+// RTC first: boot only needs it to check the fast-path relay record, so the
+// (slower) LCD init is left until after the relay is restored.
+void initRtcSafely() {
   Wire.begin(SDA_PIN, SCL_PIN);
 
+  // RTC (optional) - CHANGE HERE: I2C address if needed.
+  if (isI2CDeviceConnected(0x68)) {
+    rtcAvailable = rtc.begin();
+    Serial.println("RTC connected.");
+  }
+}
+
+void initLcdSafely() {
   // LCD (optional) - CHANGE HERE: I2C address if needed.
   if (isI2CDeviceConnected(0x27)) {
     lcd.init();
@@ -111,20 +173,20 @@ void initPeripheralsSafely() {
     initLcdPages();
     Serial.println("LCD connected.");
   }
-  
-  // RTC (optional) - CHANGE HERE: I2C address if needed.
-  if (isI2CDeviceConnected(0x68)) {
-    rtcAvailable = rtc.begin();
-    Serial.println("RTC connected.");
-  }
+}
+
+void initPeripheralBus() {
+  // CHANGE HERE: I2C addresses and per-device timeouts (ms).
+  i2cRegisterDevice(I2C_DEVICE_RTC, {"rtc", 0x68, 20, I2C_PRIORITY_HIGH, attachRtc, nullptr, &rtcAvailable},
+                    rtcAvailable);
+  i2cRegisterDevice(I2C_DEVICE_LCD, {"lcd", 0x27, 50, I2C_PRIORITY_LOW, attachLcd, onLcdChanged, &lcdAvailable},
+                    lcdAvailable);
+  initI2cBus();
 }
 
 // ---------------------- Wi-Fi Helpers ----------------------
 void connectToWiFi() {
-  if (lcdAvailable) {
-    lcd.clear();
-    lcd.print("WiFi: Trying");
-  }
+  lcdShowMessage("WiFi: Trying");
   WiFi.begin(ssid, password);
   Serial.printf("Connecting to WiFi SSID: %s...\n", ssid);
 }
@@ -146,16 +208,18 @@ void updateDisplay() {
   DateTime now = getCurrentDateTime();
   const char* dayNames[] = {"SUN","MON","TUE","WED","THU","FRI","SAT"};
 
-  char lineBuffer[LCD_COLS + 1];
-  snprintf(lineBuffer, sizeof(lineBuffer), "%s   %02d:%02d",
-           dayNames[now.dayOfTheWeek()], now.hour(), now.minute());
-
-  // CHANGE HERE: page content (page index, row index, text).
+  // CHANGE HERE: page content (page index, row index, format).
   // Page 0 uses the previous default content:
-  setPageLine(0, 0, lineBuffer);
-  setPageLine(0, 1, "IP:" + (WiFi.status() == WL_CONNECTED ? WiFi.localIP().toString() : String("--")));
-  setPageLine(1, 0, "Mode: " + String(shabbatMode ? "Shabbat " : "Week    "));
-  setPageLine(1, 1, "Clock Status:" + String(relay_state ? " ON" : "OFF"));
+  pages[0].printLine(0, "%s   %02d:%02d", dayNames[now.dayOfTheWeek()], now.hour(), now.minute());
+  bool wifiConnected = (WiFi.status() == WL_CONNECTED);
+  if (wifiConnected) {
+    IPAddress ip = WiFi.localIP();
+    pages[0].printLine(1, "IP:%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+  } else {
+    pages[0].setLine(1, "IP:--");
+  }
+  pages[1].printLine(0, "Mode: %s", shabbatMode ? "Shabbat" : "Week");
+  pages[1].printLine(1, "Clock Status:%s", relay_state ? " ON" : "OFF");
 
   // Timed page rotation.
   unsigned long nowMs = millis();
@@ -165,11 +229,20 @@ void updateDisplay() {
     lastPageSwitch = nowMs;
   }
 
-  // Render the active page.
-  pages[currentPage].render(lcd);
-
+  // Send the active page, unless the LCD already shows it.
+  const DisplayPage& page = pages[currentPage];
+  if (!displayDirty && renderedPage == currentPage && renderedGeneration == page.generation &&
+      renderedWifi == wifiConnected) {
+    return;
+  }
+  LcdFrame frame;
+  for (uint8_t r = 0; r < LCD_ROWS; ++r) memcpy(frame.cells[r], page.lines[r], LCD_COLS);
   // Wi-Fi indicator (custom char 0) at top right corner.
-  lcd.setCursor(pages[currentPage].cols - 1, 0);
-  if (WiFi.status() == WL_CONNECTED) lcd.write((byte)0);
-  else lcd.print("X");
+  frame.cells[0][LCD_COLS - 1] = wifiConnected ? 0 : 'X';
+  if (!showFrame(frame)) return;  // queue full: next update
+
+  displayDirty = false;
+  renderedPage = currentPage;
+  renderedGeneration = page.generation;
+  renderedWifi = wifiConnected;
 }
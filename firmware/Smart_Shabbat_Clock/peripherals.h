@@ -2,6 +2,9 @@
 #define PERIPHERALS_H
 
 #include <Arduino.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
 
 class LiquidCrystal_I2C;
 class RTC_DS3231;
@@ -10,36 +13,78 @@ class RTC_DS3231;
 // CHANGE HERE: LCD size used by the page system and LCD object.
 static const uint8_t LCD_COLS = 16;
 static const uint8_t LCD_ROWS = 2;
-// CHANGE HERE: add page-related helpers if you expand the system.
+// Largest LCD the page system supports.
 static const uint8_t MAX_LCD_ROWS = 4;
 static const uint8_t MAX_LCD_COLS = 20;
 
+// One screen of text in fixed row buffers (no heap): rows are formatted in
+// place, clipped and padded to the width. Row 0 leaves the top-right cell
+// for the Wi-Fi icon.
+template <uint8_t COLS, uint8_t ROWS>
 struct LcdPage {
-  uint8_t cols = 0;
-  uint8_t rows = 0;
+  static_assert(COLS >= 2 && COLS <= MAX_LCD_COLS && ROWS >= 1 && ROWS <= MAX_LCD_ROWS, "unsupported LCD size");
+  static const uint8_t cols = COLS;
+  static const uint8_t rows = ROWS;
+
   unsigned long intervalMs = 0;
-  String lines[MAX_LCD_ROWS];
+  char lines[ROWS][COLS + 1] = {};
+  // Bumped whenever a row's text changes; an unchanged page isn't redrawn.
+  uint32_t generation = 0;
 
-  // Set up size + rotation interval (ms).
-  void init(uint8_t colsIn, uint8_t rowsIn, unsigned long intervalMsIn);
-  // Store text for one row (row starts at 0). Text is clipped/padded to fit.
-  void setLine(uint8_t row, const String& text);
+  // Blank rows + rotation interval (ms).
+  void init(unsigned long intervalMsIn) {
+    intervalMs = intervalMsIn;
+    clear();
+  }
+  // printf into one row (row starts at 0).
+  void printLine(uint8_t row, const char* format, ...) __attribute__((format(printf, 3, 4)));
+  void setLine(uint8_t row, const char* text) { printLine(row, "%s", text); }
   // Clear all rows to spaces.
-  void clear();
-  // Print stored rows to the LCD.
-  void render(LiquidCrystal_I2C& lcd) const;
+  void clear() {
+    for (uint8_t r = 0; r < ROWS; ++r) setLine(r, "");
+  }
+
+ private:
+  static uint8_t width(uint8_t row) { return row == 0 ? COLS - 1 : COLS; }
 };
 
+template <uint8_t COLS, uint8_t ROWS>
+void LcdPage<COLS, ROWS>::printLine(uint8_t row, const char* format, ...) {
+  if (row >= ROWS) return;
+  uint8_t allowedCols = width(row);
+  char text[COLS + 1];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(text, allowedCols + 1, format, args);
+  va_end(args);
+  if (length < 0) length = 0;
+  if (length > allowedCols) length = allowedCols;
+  memset(text + length, ' ', allowedCols - length);
+  text[allowedCols] = '\0';
+  if (memcmp(lines[row], text, allowedCols + 1) == 0) return;
+  memcpy(lines[row], text, allowedCols + 1);
+  generation++;
+}
+
+// The clock's pages.
+typedef LcdPage<LCD_COLS, LCD_ROWS> DisplayPage;
+
 // Create pages and set default sizes/intervals.
 void initLcdPages();
-// Write a line into a specific page (page index starts at 0).
-void setPageLine(uint8_t pageIndex, uint8_t row, const String& text);
 
 // Optional hardware (LCD/RTC) and Wi-Fi helpers.
 // CHANGE HERE: add new helper declarations if you add features.
 bool isI2CDeviceConnected(uint8_t address);
-void initPeripheralsSafely();
+// Wire + RTC, then LCD; separate so the relay can be restored in between.
+void initRtcSafely();
+void initLcdSafely();
+// Hand the RTC and LCD over to the I2C bus manager (i2c_bus.h), which
+// re-probes them if they go missing or weren't fitted at boot. From here
+// on, LCD output goes through updateDisplay() and lcdShowMessage().
+void initPeripheralBus();
 void updateDisplay();
+// Show text on the first row until the next page update.
+void lcdShowMessage(const char* text);
 void connectToWiFi();
 void handleWiFiReconnect();
 
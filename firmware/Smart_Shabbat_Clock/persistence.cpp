@@ -0,0 +1,201 @@
+#include "persistence.h"
+#include "metrics.h"
+#include "task_scheduler.h"
+#include <Preferences.h>
+
+extern Preferences prefs;
+
+// CHANGE HERE: write-behind timing (ms).
+static const unsigned long PERSIST_DEBOUNCE_MS = 5000;
+static const unsigned long PERSIST_MAX_DELAY_MS = 30000;
+
+// Stored as u8; NOT_STORED marks a key that was never written.
+static const uint8_t NOT_STORED = 0xFF;
+
+enum PersistKey : uint8_t {
+  KEY_RELAY       = 1 << 0,
+  KEY_RELAY_MODE  = 1 << 1,
+  KEY_SHABBAT     = 1 << 2,
+  KEY_LAST_SEQ    = 1 << 3,
+  KEY_IN_FLIGHT   = 1 << 4,  // flightId + flightSeq, always written together
+  KEY_BOOT_RECORD = 1 << 5,  // bootRelay + bootUntil
+};
+static const uint8_t STATE_KEYS = KEY_RELAY | KEY_RELAY_MODE | KEY_SHABBAT | KEY_BOOT_RECORD;
+static const uint8_t CLOUD_KEYS = KEY_LAST_SEQ | KEY_IN_FLIGHT;
+
+struct PersistShadow {
+  uint8_t relay;
+  uint8_t relayMode;
+  uint8_t shabbat;
+  uint8_t bootRelay;
+  uint32_t bootUntil;
+  uint32_t lastSeq;
+  String inFlightId;
+  uint32_t inFlightSeq;
+};
+
+static PersistShadow shadow = {NOT_STORED, NOT_STORED, NOT_STORED, NOT_STORED, 0, 0, "", 0};
+static uint8_t dirtyKeys = 0;
+static unsigned long firstDirtyMs = 0;
+static unsigned long lastDirtyMs = 0;
+// One-shot loop task, armed for the flush deadline whenever a key changes.
+static TaskId flushTask = NO_TASK;
+
+// ms until the dirty keys are due: debounce window, capped by the max delay.
+static unsigned long msUntilFlush(unsigned long nowMs) {
+  unsigned long quietFor = nowMs - lastDirtyMs;
+  unsigned long dirtyFor = nowMs - firstDirtyMs;
+  if (quietFor >= PERSIST_DEBOUNCE_MS || dirtyFor >= PERSIST_MAX_DELAY_MS) return 0;
+  unsigned long untilQuiet = PERSIST_DEBOUNCE_MS - quietFor;
+  unsigned long untilMax = PERSIST_MAX_DELAY_MS - dirtyFor;
+  return untilQuiet < untilMax ? untilQuiet : untilMax;
+}
+
+static void markDirty(uint8_t key) {
+  unsigned long nowMs = millis();
+  if (dirtyKeys == 0) firstDirtyMs = nowMs;
+  lastDirtyMs = nowMs;
+  dirtyKeys |= key;
+  schedulerDelay(flushTask, msUntilFlush(nowMs));
+}
+
+// ---------------------- Load / Flush ----------------------
+
+void persistInit() {
+  prefs.begin("state", true);
+  shadow.relay = prefs.getUChar("relay", NOT_STORED);
+  shadow.relayMode = prefs.getUChar("relayMode", NOT_STORED);
+  shadow.shabbat = prefs.getUChar("shabbat", NOT_STORED);
+  shadow.bootRelay = prefs.getUChar("bootRelay", NOT_STORED);
+  shadow.bootUntil = prefs.getUInt("bootUntil", 0);
+  prefs.end();
+
+  prefs.begin("cloud", true);
+  shadow.lastSeq = prefs.getUInt("lastSeq", 0);
+  shadow.inFlightId = prefs.getString("flightId", "");
+  shadow.inFlightSeq = prefs.getUInt("flightSeq", 0);
+  prefs.end();
+  dirtyKeys = 0;
+  if (flushTask == NO_TASK) flushTask = schedulerAddOneShot("persist", tickPersistence, NOT_SCHEDULED);
+}
+
+void persistFlush() {
+  if (dirtyKeys == 0) return;
+
+  if (dirtyKeys & STATE_KEYS) {
+    uint32_t t0 = metricsStart();
+    prefs.begin("state", false);
+    if (dirtyKeys & KEY_RELAY) prefs.putBool("relay", shadow.relay != 0);
+    if (dirtyKeys & KEY_RELAY_MODE) prefs.putUChar("relayMode", shadow.relayMode);
+    if (dirtyKeys & KEY_SHABBAT) prefs.putBool("shabbat", shadow.shabbat != 0);
+    if (dirtyKeys & KEY_BOOT_RECORD) {
+      prefs.putUChar("bootRelay", shadow.bootRelay);
+      prefs.putUInt("bootUntil", shadow.bootUntil);
+    }
+    prefs.end();
+    metricsRecord(METRIC_NVS_WRITE, t0);
+  }
+
+  if (dirtyKeys & CLOUD_KEYS) {
+    uint32_t t0 = metricsStart();
+    prefs.begin("cloud", false);
+    if (dirtyKeys & KEY_LAST_SEQ) prefs.putUInt("lastSeq", shadow.lastSeq);
+    if (dirtyKeys & KEY_IN_FLIGHT) {
+      if (shadow.inFlightId.length() > 0) {
+        prefs.putString("flightId", shadow.inFlightId);
+        prefs.putUInt("flightSeq", shadow.inFlightSeq);
+      } else {
+        prefs.remove("flightId");
+        prefs.remove("flightSeq");
+      }
+    }
+    prefs.end();
+    metricsRecord(METRIC_NVS_WRITE, t0);
+  }
+
+  dirtyKeys = 0;
+}
+
+void tickPersistence() {
+  if (dirtyKeys == 0) return;
+  unsigned long waitMs = msUntilFlush(millis());
+  if (waitMs == 0) persistFlush();
+  else schedulerDelay(flushTask, waitMs);
+}
+
+// ---------------------- "state" namespace ----------------------
+
+bool persistedRelayState() {
+  return shadow.relay != NOT_STORED && shadow.relay != 0;
+}
+
+uint8_t persistedRelayMode(uint8_t fallback) {
+  return shadow.relayMode != NOT_STORED ? shadow.relayMode : fallback;
+}
+
+bool persistedShabbatMode(bool fallback) {
+  return shadow.shabbat != NOT_STORED ? shadow.shabbat != 0 : fallback;
+}
+
+void persistRelayState(bool on) {
+  if (shadow.relay == (on ? 1 : 0)) return;
+  shadow.relay = on ? 1 : 0;
+  markDirty(KEY_RELAY);
+}
+
+void persistRelayMode(uint8_t mode) {
+  if (shadow.relayMode == mode) return;
+  shadow.relayMode = mode;
+  markDirty(KEY_RELAY_MODE);
+}
+
+void persistShabbatMode(bool shabbat) {
+  if (shadow.shabbat == (shabbat ? 1 : 0)) return;
+  shadow.shabbat = shabbat ? 1 : 0;
+  markDirty(KEY_SHABBAT);
+}
+
+bool persistedBootRecord(bool& relayOn, uint32_t& validUntil) {
+  if (shadow.bootRelay == NOT_STORED) return false;
+  relayOn = shadow.bootRelay != 0;
+  validUntil = shadow.bootUntil;
+  return true;
+}
+
+void persistBootRecord(bool relayOn, uint32_t validUntil) {
+  if (shadow.bootRelay == (relayOn ? 1 : 0) && shadow.bootUntil == validUntil) return;
+  shadow.bootRelay = relayOn ? 1 : 0;
+  shadow.bootUntil = validUntil;
+  markDirty(KEY_BOOT_RECORD);
+}
+
+// ---------------------- "cloud" namespace ----------------------
+
+uint32_t persistedLastSeq() {
+  return shadow.lastSeq;
+}
+
+String persistedInFlightId() {
+  return shadow.inFlightId;
+}
+
+uint32_t persistedInFlightSeq() {
+  return shadow.inFlightSeq;
+}
+
+void persistLastSeq(uint32_t seq) {
+  if (shadow.lastSeq == seq) return;
+  shadow.lastSeq = seq;
+  markDirty(KEY_LAST_SEQ);
+}
+
+void persistInFlight(const String& commandId, uint32_t seq) {
+  if (shadow.inFlightId == commandId && shadow.inFlightSeq == seq) return;
+  shadow.inFlightId = commandId;
+  shadow.inFlightSeq = seq;
+  markDirty(KEY_IN_FLIGHT);
+}
+
+void persistClearInFlight() {
+  persistInFlight("", 0);
+}
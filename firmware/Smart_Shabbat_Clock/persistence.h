@@ -0,0 +1,47 @@
+#ifndef PERSISTENCE_H
+#define PERSISTENCE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// ---------------------- Write-behind Persistence ----------------------
+// RAM shadow of the small NVS keys in the "state" and "cloud" namespaces.
+// Setters only update the shadow and mark the key dirty (writing the value
+// it already has is a no-op). tickPersistence() flushes dirty keys once they
+// have been quiet for PERSIST_DEBOUNCE_MS, or at the latest PERSIST_MAX_DELAY_MS
+// after the first change, with one open/commit per namespace. It runs as the
+// "persist" one-shot loop task, armed for that deadline by every change.
+// persistFlush() is the barrier: call it where a value must be on flash
+// before the next step (e.g. the cloud in-flight marker before executing).
+// Each commit is recorded as a nvs_write sample in /metrics.
+// The schedule table is not handled here; it has its own storage in schedule.cpp.
+
+// Load every key into the shadow and register the flush task; call once at
+// boot before any getter.
+void persistInit();
+// Flush dirty keys when the debounce window has passed.
+void tickPersistence();
+// Barrier: write all dirty keys now.
+void persistFlush();
+
+// "state" namespace
+bool persistedRelayState();
+uint8_t persistedRelayMode(uint8_t fallback);
+bool persistedShabbatMode(bool fallback);
+void persistRelayState(bool on);
+void persistRelayMode(uint8_t mode);
+void persistShabbatMode(bool shabbat);
+// Precomputed relay state for cold boots in AUTO (see boot_state.h):
+// valid while the RTC time is before validUntil (RTC unixtime, local).
+bool persistedBootRecord(bool& relayOn, uint32_t& validUntil);
+void persistBootRecord(bool relayOn, uint32_t validUntil);
+
+// "cloud" namespace
+uint32_t persistedLastSeq();
+String persistedInFlightId();
+uint32_t persistedInFlightSeq();
+void persistLastSeq(uint32_t seq);
+void persistInFlight(const String& commandId, uint32_t seq);
+void persistClearInFlight();
+
+#endif // PERSISTENCE_H
@@ -0,0 +1,86 @@
+#include "power_manager.h"
+#include "task_scheduler.h"
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <esp_wifi.h>
+#include <driver/gpio.h>
+#include <driver/uart.h>
+
+#if POWER_SAVE_MODE && !CONFIG_FREERTOS_USE_TICKLESS_IDLE
+#warning "POWER_SAVE_MODE: core built without tickless idle, no automatic light sleep (frequency scaling only)"
+#endif
+
+// CHANGE HERE: frequency range (MHz) for dynamic frequency scaling.
+static const int PM_MAX_FREQ_MHZ = 160;
+static const int PM_MIN_FREQ_MHZ = 40;
+// CHANGE HERE: HC-12 UART RX edges needed to wake from light sleep (the
+// first bytes of that message are lost; the remote repeats until ACKed).
+static const int HC12_WAKE_THRESHOLD = 3;
+
+// CHANGE HERE: rough supply-current figures (mA) for the estimate, from the
+// chip datasheet with Wi-Fi associated: busy, idle awake (CPU halted in the
+// idle task, modem sleep) and idle in automatic light sleep (incl. DTIM wakes).
+static const float CURRENT_BUSY_MA = 95.0f;
+static const float CURRENT_IDLE_AWAKE_MA = 25.0f;
+static const float CURRENT_IDLE_LIGHT_SLEEP_MA = 3.0f;
+
+static esp_pm_lock_handle_t awakeLock = nullptr;
+static bool lightSleepActive = false;
+
+void initPowerManagement(uint8_t buttonPin) {
+#if POWER_SAVE_MODE
+  esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+
+  esp_pm_config_t config = {PM_MAX_FREQ_MHZ, PM_MIN_FREQ_MHZ, true};
+  esp_err_t err = esp_pm_configure(&config);
+  if (err == ESP_ERR_NOT_SUPPORTED) {
+    config.light_sleep_enable = false;
+    err = esp_pm_configure(&config);
+    Serial.println("Power: light sleep not supported by this core, frequency scaling only.");
+  }
+  if (err != ESP_OK) {
+    Serial.printf("Power: esp_pm_configure failed (%s).\n", esp_err_to_name(err));
+    return;
+  }
+  lightSleepActive = config.light_sleep_enable;
+
+  // Button: level wakeup (edges can't wake light sleep); button.cpp flips
+  // the level after each change.
+  gpio_wakeup_enable((gpio_num_t)buttonPin, GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+  // HC-12 on UART1.
+  uart_set_wakeup_threshold(UART_NUM_1, HC12_WAKE_THRESHOLD);
+  esp_sleep_enable_uart_wakeup(UART_NUM_1);
+
+  esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "hc12", &awakeLock);
+  Serial.printf("Power: %d-%d MHz, light sleep %s.\n", PM_MIN_FREQ_MHZ, PM_MAX_FREQ_MHZ,
+                lightSleepActive ? "on" : "off");
+#else
+  (void)buttonPin;
+#endif
+}
+
+void powerHoldAwake(bool hold) {
+  if (awakeLock == nullptr) return;
+  if (hold) esp_pm_lock_acquire(awakeLock);
+  else esp_pm_lock_release(awakeLock);
+}
+
+// ---------------------- Estimate ----------------------
+// Only the loop thread's idle time is measured; Wi-Fi and AsyncTCP work is
+// assumed to fit in the loop's busy share, so the figure is a lower bound.
+
+void powerWritePrometheus(Print& out) {
+  uint64_t uptimeUs = (uint64_t)millis() * 1000ULL;
+  float idle = uptimeUs > 0 ? (float)schedulerIdleUs() / (float)uptimeUs : 0.0f;
+  if (idle > 1.0f) idle = 1.0f;
+  float idleMa = lightSleepActive ? CURRENT_IDLE_LIGHT_SLEEP_MA : CURRENT_IDLE_AWAKE_MA;
+  float currentMa = idle * idleMa + (1.0f - idle) * CURRENT_BUSY_MA;
+
+  out.print("# HELP shabbat_power_idle_ratio Share of uptime the loop spent blocked (light sleep when enabled).\n"
+            "# TYPE shabbat_power_idle_ratio gauge\n");
+  out.printf("shabbat_power_idle_ratio %.4f\n", idle);
+  out.print("# HELP shabbat_power_estimated_ma Estimated average supply current from the idle ratio.\n"
+            "# TYPE shabbat_power_estimated_ma gauge\n");
+  out.printf("shabbat_power_estimated_ma{light_sleep=\"%s\"} %.1f\n", lightSleepActive ? "on" : "off", currentMa);
+}
@@ -0,0 +1,35 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// ---------------------- Power Management ----------------------
+// For battery/UPS installs. With POWER_SAVE_MODE 1 the chip uses dynamic
+// frequency scaling and automatic light sleep whenever every task is
+// blocked, with Wi-Fi in modem sleep (wakes for DTIM beacons). The loop
+// already blocks until the next task deadline (task_scheduler.h), so sleep
+// lasts until then, or until the override button (GPIO level wakeup),
+// HC-12 RX (UART1 wakeup) or a network event wakes it.
+// Light sleep is held off while an HC-12 exchange is waiting for its ACK.
+// Light sleep needs a core built with CONFIG_PM_ENABLE and
+// CONFIG_FREERTOS_USE_TICKLESS_IDLE. Stock Arduino-ESP32 cores enable
+// neither, so they only get frequency scaling (the build warns, the boot
+// log says so, and the current estimate uses the idle-awake figure).
+
+// CHANGE HERE: 1 = power-save mode (light sleep between deadlines).
+#ifndef POWER_SAVE_MODE
+#define POWER_SAVE_MODE 0
+#endif
+
+// Configure power management and wakeup sources; call once in setup()
+// after Wi-Fi has started.
+void initPowerManagement(uint8_t buttonPin);
+// Keep the chip out of light sleep while true (e.g. a UART reply is due).
+void powerHoldAwake(bool hold);
+
+// Idle share of the loop thread and the resulting estimated supply current;
+// appended to /metrics.
+void powerWritePrometheus(Print& out);
+
+#endif // POWER_MANAGER_H
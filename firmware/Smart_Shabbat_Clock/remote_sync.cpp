@@ -0,0 +1,182 @@
+#include "remote_sync.h"
+#include "hc12_comm.h"
+#include "schedule.h"
+#include "task_scheduler.h"
+#include "time_utils.h"
+#include <hc12_schedule.h>
+
+extern bool shabbatMode;
+extern uint8_t relayMode;
+
+// CHANGE HERE: how often the task checks for due beacons and pushes (ms).
+static const unsigned long REMOTE_SYNC_TASK_PERIOD = 5000;
+
+struct RemotePush {
+  uint32_t revision;        // scheduleRevision the unit confirmed
+  bool confirmed;
+  bool retryPending;
+  unsigned long retryAtMs;
+  unsigned long verifiedAtMs;
+};
+
+static RemotePush pushes[HC12_MAX_BROADCAST_UNIT];
+
+// One push at a time, from a copy of the table taken when it started.
+static uint8_t pushUnit = 0;  // 0 = idle
+static uint8_t pushChunk = 0;
+static uint32_t pushRevision = 0;
+static Hc12ScheduleEvent pushEvents[MAX_EVENTS];
+static uint8_t pushCount = 0;
+static uint8_t verifyUnit = 0;  // PING in flight, 0 = none
+
+static TaskId remoteTask = NO_TASK;
+static bool beaconSent = false;
+static unsigned long lastBeaconMs = 0;  // when the last beacon went out
+static uint32_t lastBeaconTime = 0;     // the local time it carried
+static uint8_t beaconModes = 0;  // relayMode | shabbat << 2 of the last beacon
+
+// ---------------------- Schedule Push ----------------------
+
+static void sendChunk();
+
+static void retryPushLater(unsigned long delayMs) {
+  RemotePush& push = pushes[pushUnit - 1];
+  push.retryPending = true;
+  push.retryAtMs = millis() + delayMs;
+  pushUnit = 0;
+}
+
+static void onChunkDone(bool acked, uint8_t status, const Hc12Frame*, void*) {
+  if (!acked || status != HC12_STATUS_OK) {
+    Serial.printf("Remotes: schedule push to unit %u failed at chunk %u (%s)\n", pushUnit, pushChunk,
+                  acked ? "rejected" : "no ACK");
+    retryPushLater(REMOTE_PUSH_RETRY_MS);
+    return;
+  }
+  if (++pushChunk < hc12ScheduleChunkCount(pushCount)) {
+    sendChunk();
+    return;
+  }
+
+  RemotePush& push = pushes[pushUnit - 1];
+  push.revision = pushRevision;
+  push.confirmed = true;
+  push.retryPending = false;
+  push.verifiedAtMs = millis();
+  Serial.printf("Remotes: unit %u has schedule revision %lu (%u events)\n", pushUnit, (unsigned long)pushRevision,
+                pushCount);
+  pushUnit = 0;
+  schedulerNotify(remoteTask);  // next unit, if any
+}
+
+static void sendChunk() {
+  uint8_t payload[HC12_MAX_PAYLOAD];
+  uint8_t length = hc12EncodeScheduleChunk((uint16_t)pushRevision, pushEvents, pushCount, pushChunk, payload);
+  if (!hc12Submit(pushUnit, HC12_OP_SET_SCHEDULE, payload, length, onChunkDone, nullptr)) {
+    retryPushLater(REMOTE_SYNC_TASK_PERIOD);  // queue full
+  }
+}
+
+static void startPush(uint8_t unit) {
+  pushUnit = unit;
+  pushChunk = 0;
+  pushRevision = scheduleRevision;
+  pushCount = scheduleCount;
+  for (uint8_t i = 0; i < scheduleCount; i++) {
+    pushEvents[i] = hc12MakeScheduleEvent(schedule[i].day, schedule[i].hour, schedule[i].minute, schedule[i].state);
+  }
+  sendChunk();
+}
+
+// ---------------------- Schedule Check ----------------------
+
+static void onPingDone(bool acked, uint8_t status, const Hc12Frame* reply, void*) {
+  RemotePush& push = pushes[verifyUnit - 1];
+  push.verifiedAtMs = millis();
+  // No reply: the unit is unreachable, a push wouldn't get through either.
+  if (acked && status == HC12_STATUS_OK && reply->length >= HC12_PING_REPLY_SIZE) {
+    bool valid = reply->payload[2] != 0;
+    uint16_t version = (uint16_t)(reply->payload[3] << 8 | reply->payload[4]);
+    if (!valid || version != (uint16_t)push.revision) {
+      Serial.printf("Remotes: unit %u lost its schedule, pushing again\n", verifyUnit);
+      push.confirmed = false;
+      schedulerNotify(remoteTask);
+    }
+  }
+  verifyUnit = 0;
+}
+
+static void startVerify(uint8_t unit) {
+  verifyUnit = unit;
+  if (!hc12Submit(unit, HC12_OP_PING, nullptr, 0, onPingDone, nullptr)) verifyUnit = 0;
+}
+
+// ---------------------- Loop Task ----------------------
+
+// Beacons can wait in the HC-12 queue behind acked transactions, so the
+// time is filled in as the frame is written.
+static void stampBeacon(uint8_t* payload, uint8_t length) {
+  Hc12Beacon beacon;
+  if (!hc12DecodeBeacon(payload, length, beacon)) return;
+  beacon.localTime = getCurrentDateTime().unixtime();
+  hc12EncodeBeacon(beacon, payload);
+  lastBeaconTime = beacon.localTime;
+  lastBeaconMs = millis();
+}
+
+// True if the clock's time moved by more than REMOTE_TIME_STEP_S since the
+// last beacon (NTP or manual set, DST transition).
+static bool timeStepped() {
+  uint32_t expected = lastBeaconTime + (millis() - lastBeaconMs) / 1000;
+  int32_t step = (int32_t)(getCurrentDateTime().unixtime() - expected);
+  return step > REMOTE_TIME_STEP_S || step < -REMOTE_TIME_STEP_S;
+}
+
+static void sendBeaconIfDue() {
+  if (!timeValid) return;
+  uint8_t modes = relayMode | (shabbatMode ? 0x04 : 0);
+  unsigned long nowMs = millis();
+  if (beaconSent && modes == beaconModes && nowMs - lastBeaconMs < REMOTE_BEACON_INTERVAL_MS && !timeStepped()) {
+    return;
+  }
+
+  Hc12Beacon beacon = {0, relayMode, shabbatMode};  // time: stampBeacon()
+  uint8_t payload[HC12_BEACON_SIZE];
+  uint8_t length = hc12EncodeBeacon(beacon, payload);
+  if (!hc12SubmitUnacked(HC12_SCHEDULE_UNITS | HC12_SHABBAT_UNITS, HC12_OP_TIME_BEACON, payload, length,
+                         stampBeacon)) {
+    return;
+  }
+  beaconSent = true;
+  beaconModes = modes;
+  // Until it goes out: no second beacon, and no false time step.
+  lastBeaconTime = getCurrentDateTime().unixtime();
+  lastBeaconMs = nowMs;
+}
+
+static void tickRemoteSync() {
+  sendBeaconIfDue();
+  if (pushUnit != 0 || verifyUnit != 0) return;
+
+  unsigned long nowMs = millis();
+  for (uint8_t unit = 1; unit <= HC12_MAX_BROADCAST_UNIT; unit++) {
+    if ((HC12_SCHEDULE_UNITS & (1UL << (unit - 1))) == 0) continue;
+    const RemotePush& push = pushes[unit - 1];
+    if (push.confirmed && push.revision == scheduleRevision) {
+      if (nowMs - push.verifiedAtMs < REMOTE_VERIFY_INTERVAL_MS) continue;
+      startVerify(unit);
+      return;
+    }
+    if (push.retryPending && (long)(push.retryAtMs - nowMs) > 0) continue;
+    startPush(unit);
+    return;
+  }
+}
+
+void initRemoteSync() {
+  remoteTask = schedulerAddPeriodic("remotes", tickRemoteSync, REMOTE_SYNC_TASK_PERIOD);
+}
+
+void remoteSyncTimeChanged() {
+  schedulerNotify(remoteTask);
+}
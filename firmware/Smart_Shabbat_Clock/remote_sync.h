@@ -0,0 +1,36 @@
+#ifndef REMOTE_SYNC_H
+#define REMOTE_SYNC_H
+
+#include <stdint.h>
+
+// ---------------------- Remote Schedule Sync ----------------------
+// Remote units in HC12_SCHEDULE_UNITS switch their relay on their own
+// (payload formats in hc12_schedule.h): each gets the schedule pushed once
+// per revision (chunked SET_SCHEDULE, acked), and every unit hears a time
+// beacon with the relay and Shabbat mode every REMOTE_BEACON_INTERVAL_MS,
+// and right after either mode or the clock's time changes (a step of more
+// than REMOTE_TIME_STEP_S: NTP or manual set, DST). The beacon's time is
+// taken when it is transmitted, not when it is queued. A remote then runs
+// through clock reboots and radio outages from its own clock. The schedule
+// is re-pushed after a clock reboot, and whenever the PING sent to each
+// unit every REMOTE_VERIFY_INTERVAL_MS shows the unit lost it (remote power
+// cut).
+
+// CHANGE HERE: remote units that run the schedule locally, bit n-1 = unit n.
+static const uint32_t HC12_SCHEDULE_UNITS = 1UL << 0;
+// CHANGE HERE: beacon period, schedule check period per unit, and the wait
+// before retrying a failed push (ms). See
+// tools/host-tests/remote-clock-sim for the beacon period vs. remote clock
+// error.
+static const uint32_t REMOTE_BEACON_INTERVAL_MS = 300000;
+static const uint32_t REMOTE_VERIFY_INTERVAL_MS = 600000;
+static const uint32_t REMOTE_PUSH_RETRY_MS = 60000;
+// CHANGE HERE: time step (s) that triggers a beacon right away.
+static const int32_t REMOTE_TIME_STEP_S = 2;
+
+// Register the "remotes" loop task; call once in setup() after initHc12().
+void initRemoteSync();
+// Check for a time step now instead of at the next task period (any task).
+void remoteSyncTimeChanged();
+
+#endif // REMOTE_SYNC_H
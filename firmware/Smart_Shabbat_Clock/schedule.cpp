@@ -1,5 +1,6 @@
 #include "schedule.h"
 #include "time_utils.h"
+#include "metrics.h"
 #include <RTClib.h>
 #include <Preferences.h>
 #include <algorithm> // For std::sort
@@ -17,48 +18,257 @@ uint32_t scheduleRevision = 0;
 // ---------------------- Storage ----------------------
 // saveSchedule/loadSchedule/clearSchedule operate on NVS.
 // After any modification we sort and (optionally) normalize.
+//
+// Journal: each committed edit appends one record per noted op, all carrying
+// the edit's new revision; the last one is flagged COMMIT. Replay applies a
+// revision's records, then sorts and normalizes once, exactly like the live
+// edit did. Records whose revision is not snapshot+1, +2, ... (left over from
+// an interrupted compaction) and a trailing edit without its COMMIT record
+// (interrupted append) are ignored; the next edit is appended over the
+// latter, so its records never join the next edit's group.
+// Snapshot: one "snap" blob (revision, then the events), so a power cut
+// leaves the old snapshot or the new one. Older firmware wrote "count",
+// "revision" and "table"; those are read if there is no "snap" and removed
+// by the first snapshot written.
+// CHANGE HERE: journal compaction threshold and hard cap (records).
+static const uint8_t JOURNAL_COMPACT_AT = 16;
+static const uint8_t JOURNAL_MAX = 48;
+// Ops a single edit may journal; larger edits are written as a snapshot.
+static const uint8_t JOURNAL_PENDING_MAX = 8;
+// CHANGE HERE: set to 1 to time journal replay at boot (see benchmarkJournalReplay).
+// tools/host-tests/schedule-journal checks and times the journal on the host.
+#ifndef SCHEDULE_JOURNAL_BENCH
+#define SCHEDULE_JOURNAL_BENCH 0
+#endif
+
+static const uint8_t JOURNAL_FLAG_COMMIT = 0x01;
+
+struct ScheduleJournalRecord {
+  uint32_t revision;
+  uint8_t op;
+  uint8_t flags;
+  ScheduleEntry entry;
+};
+
+static ScheduleJournalRecord pendingRecords[JOURNAL_PENDING_MAX];
+static uint8_t pendingCount = 0;
+static bool pendingOverflow = false;
+static uint8_t journalLength = 0;
+static bool legacySnapshot = false;
+
+struct ScheduleSnapshot {
+  uint32_t revision;
+  ScheduleEntry entries[MAX_EVENTS];
+};
+static const size_t SNAPSHOT_HEADER_SIZE = sizeof(uint32_t);
+
+static void journalKey(uint8_t index, char* key) {
+  snprintf(key, 6, "j%u", index);
+}
+
+void noteScheduleEdit(ScheduleJournalOp op, const ScheduleEntry& entry) {
+  if (pendingCount >= JOURNAL_PENDING_MAX) {
+    pendingOverflow = true;
+    return;
+  }
+  pendingRecords[pendingCount].op = op;
+  pendingRecords[pendingCount].flags = 0;
+  pendingRecords[pendingCount].entry = entry;
+  pendingCount++;
+}
+
+static int findEntry(const ScheduleEntry& key) {
+  for (int i = 0; i < scheduleCount; i++) {
+    if (schedule[i].day == key.day && schedule[i].hour == key.hour && schedule[i].minute == key.minute) return i;
+  }
+  return -1;
+}
+
+static void applyJournalRecord(const ScheduleJournalRecord& record) {
+  int idx = findEntry(record.entry);
+  if (record.op == SCHEDULE_JOURNAL_DELETE) {
+    if (idx < 0) return;
+    for (int j = idx + 1; j < scheduleCount; j++) schedule[j - 1] = schedule[j];
+    scheduleCount--;
+  } else if (idx >= 0) {
+    schedule[idx].state = record.entry.state;
+  } else if (scheduleCount < MAX_EVENTS) {
+    schedule[scheduleCount++] = record.entry;
+  }
+}
+
+// Snapshot the table and drop the journal. The snapshot is written first, so
+// a crash in between leaves records the revision guard will skip.
+static void writeSnapshot() {
+  ScheduleSnapshot snapshot;
+  snapshot.revision = scheduleRevision;
+  memcpy(snapshot.entries, schedule, sizeof(ScheduleEntry) * scheduleCount);
+  prefs.putBytes("snap", &snapshot, SNAPSHOT_HEADER_SIZE + sizeof(ScheduleEntry) * scheduleCount);
+  if (legacySnapshot) {
+    prefs.remove("count");
+    prefs.remove("revision");
+    prefs.remove("table");
+    legacySnapshot = false;
+  }
+  char key[6];
+  for (uint8_t i = 0; i < journalLength; i++) {
+    journalKey(i, key);
+    prefs.remove(key);
+  }
+  journalLength = 0;
+}
 
 void saveSchedule() {
-  Serial.println("Saving schedule to Preferences...");
+  uint32_t t0 = metricsStart();
   prefs.begin("sched", false);
   scheduleRevision++;
-  prefs.putUChar("count", scheduleCount);
-  prefs.putUInt("revision", scheduleRevision);
-  if (scheduleCount > 0) {
-    prefs.putBytes("table", schedule, sizeof(ScheduleEntry) * scheduleCount);
+  bool journaled = pendingCount > 0 && !pendingOverflow && journalLength + pendingCount <= JOURNAL_MAX;
+  if (journaled) {
+    char key[6];
+    for (uint8_t i = 0; i < pendingCount; i++) {
+      pendingRecords[i].revision = scheduleRevision;
+      if (i == pendingCount - 1) pendingRecords[i].flags |= JOURNAL_FLAG_COMMIT;
+      journalKey(journalLength++, key);
+      prefs.putBytes(key, &pendingRecords[i], sizeof(ScheduleJournalRecord));
+    }
+  } else {
+    writeSnapshot();
   }
   prefs.end();
-  Serial.println("Schedule saved.");
+  metricsRecord(METRIC_NVS_WRITE, t0);
+  Serial.printf("Schedule saved (rev %lu, %s, journal %u).\n",
+                (unsigned long)scheduleRevision, journaled ? "journal" : "snapshot", journalLength);
+  pendingCount = 0;
+  pendingOverflow = false;
+}
+
+// Replay the journal of the open namespace on top of the loaded snapshot.
+// Returns where the next record goes: after the last one read, less a
+// trailing edit without its COMMIT record.
+static uint8_t replayJournal() {
+  ScheduleJournalRecord group[JOURNAL_PENDING_MAX];
+  uint8_t groupCount = 0;
+  uint8_t read = 0;
+  char key[6];
+
+  for (uint8_t i = 0; i < JOURNAL_MAX; i++) {
+    ScheduleJournalRecord record;
+    journalKey(i, key);
+    if (prefs.getBytes(key, &record, sizeof(record)) != sizeof(record)) break;
+    read = i + 1;
+    if (record.revision != scheduleRevision + 1 || groupCount >= JOURNAL_PENDING_MAX) {
+      groupCount = 0;  // stale record or broken group
+      continue;
+    }
+    group[groupCount++] = record;
+    if (!(record.flags & JOURNAL_FLAG_COMMIT)) continue;
+
+    for (uint8_t g = 0; g < groupCount; g++) applyJournalRecord(group[g]);
+    sortSchedule();
+    normalizeSchedule();
+    scheduleRevision = record.revision;
+    groupCount = 0;
+  }
+  return read - groupCount;
+}
+
+static void loadSnapshotAndJournal() {
+  ScheduleSnapshot snapshot;
+  size_t length = prefs.getBytes("snap", &snapshot, sizeof(snapshot));
+  bool haveSnapshot = length >= SNAPSHOT_HEADER_SIZE && (length - SNAPSHOT_HEADER_SIZE) % sizeof(ScheduleEntry) == 0;
+  legacySnapshot = !haveSnapshot && prefs.isKey("revision");
+  if (haveSnapshot) {
+    scheduleRevision = snapshot.revision;
+    scheduleCount = (length - SNAPSHOT_HEADER_SIZE) / sizeof(ScheduleEntry);
+    memcpy(schedule, snapshot.entries, sizeof(ScheduleEntry) * scheduleCount);
+  } else {
+    scheduleRevision = prefs.getUInt("revision", 0);
+    uint8_t cnt = prefs.getUChar("count", 0);
+    if (cnt > MAX_EVENTS) cnt = MAX_EVENTS;
+    if (cnt > 0 && prefs.getBytes("table", schedule, sizeof(ScheduleEntry) * cnt) == sizeof(ScheduleEntry) * cnt) {
+      scheduleCount = cnt;
+    } else {
+      scheduleCount = 0;
+    }
+  }
+  journalLength = replayJournal();
 }
 
+#if SCHEDULE_JOURNAL_BENCH
+// Time snapshot load + replay for growing journal lengths. Runs in a scratch
+// namespace; the real "sched" data is loaded normally afterwards.
+static void benchmarkJournalReplay() {
+  static const uint8_t LENGTHS[] = {0, 4, 8, 16, 32, JOURNAL_MAX};
+  Serial.println("Journal replay benchmark (records -> us):");
+  for (uint8_t l = 0; l < sizeof(LENGTHS); l++) {
+    prefs.begin("schedbench", false);
+    prefs.clear();
+    scheduleCount = MAX_EVENTS / 2;
+    for (uint8_t i = 0; i < scheduleCount; i++) schedule[i] = ScheduleEntry{(uint8_t)(i % 24), 0, (i % 2) == 0, (uint8_t)(i % 7)};
+    scheduleRevision = 1;
+    journalLength = 0;
+    writeSnapshot();
+    char key[6];
+    for (uint8_t i = 0; i < LENGTHS[l]; i++) {
+      ScheduleJournalRecord record = {(uint32_t)(2 + i), (uint8_t)(i % 3 == 2 ? SCHEDULE_JOURNAL_DELETE : SCHEDULE_JOURNAL_UPSERT),
+                                      JOURNAL_FLAG_COMMIT, ScheduleEntry{(uint8_t)(i % 24), (uint8_t)(i % 60), (i % 2) == 1, (uint8_t)(i % 7)}};
+      journalKey(i, key);
+      prefs.putBytes(key, &record, sizeof(record));
+    }
+    unsigned long startUs = micros();
+    loadSnapshotAndJournal();
+    unsigned long elapsedUs = micros() - startUs;
+    prefs.clear();
+    prefs.end();
+    Serial.printf("  %2u -> %lu\n", LENGTHS[l], elapsedUs);
+  }
+  scheduleCount = 0;
+  scheduleRevision = 0;
+  journalLength = 0;
+}
+#endif
+
 void loadSchedule() {
+#if SCHEDULE_JOURNAL_BENCH
+  benchmarkJournalReplay();
+#endif
   Serial.println("Loading schedule from Preferences...");
+  unsigned long startUs = micros();
   prefs.begin("sched", true);
-  scheduleRevision = prefs.getUInt("revision", 0);
-  uint8_t cnt = prefs.getUChar("count", 0);
-  if (cnt > MAX_EVENTS) cnt = MAX_EVENTS;
-  if (cnt > 0 && prefs.getBytes("table", schedule, sizeof(ScheduleEntry) * cnt) == sizeof(ScheduleEntry) * cnt) {
-    scheduleCount = cnt;
+  loadSnapshotAndJournal();
+  prefs.end();
+  if (scheduleCount > 0) {
     sortSchedule();
-    Serial.printf("Loaded %d schedule entries.\n", scheduleCount);
+    Serial.printf("Loaded %d schedule entries (rev %lu, %u journal records, %lu us).\n",
+                  scheduleCount, (unsigned long)scheduleRevision, journalLength, micros() - startUs);
   } else {
-    scheduleCount = 0;
     Serial.println("No saved schedule found.");
   }
-  prefs.end();
 }
 
 void clearScheduleStorage() {
   Serial.println("Clearing schedule...");
   prefs.begin("sched", false);
-  prefs.clear(); // wipe namespace "sched"
-  prefs.putUInt("revision", 0);
-  prefs.end();
+  prefs.clear(); // wipe namespace "sched" (snapshot + journal)
   scheduleCount = 0;
   scheduleRevision = 0;
+  journalLength = 0;
+  legacySnapshot = false;
+  writeSnapshot();
+  prefs.end();
   Serial.println("Schedule cleared.");
 }
 
+void tickScheduleCompaction() {
+  if (journalLength < JOURNAL_COMPACT_AT) return;
+  uint32_t t0 = metricsStart();
+  prefs.begin("sched", false);
+  writeSnapshot();
+  prefs.end();
+  metricsRecord(METRIC_NVS_WRITE, t0);
+  Serial.printf("Schedule journal compacted into snapshot (rev %lu).\n", (unsigned long)scheduleRevision);
+}
+
 // ---------------------- Schedule Logic ----------------------
 // sortSchedule orders by (day, hour, minute) ascending.
 // normalizeSchedule compresses consecutive same-state events per day
@@ -106,34 +316,39 @@ void normalizeSchedule() {
   scheduleCount = out;
 }
 
-// AUTO mode: find the latest event (<= now) for today and apply it.
+// AUTO mode: apply the latest event crossed since the previous check, and
+// nothing otherwise, so a manual tap holds until the next event. Entering
+// AUTO, a new schedule or a newly valid clock set the relay from the
+// schedule itself (setRelayOppositeToNextEvent() / setRelayToLastEvent()).
 // CHANGE HERE: adjust schedule behavior in AUTO mode.
-// If nothing yet today, relay remains as-is; "setRelayToLastEvent()" at boot
-// handles continuity across days.
 void applyScheduleLogic() {
-  if (!timeValid) return; 
-  if (relayMode != 2 || scheduleCount == 0) return;
+  static const uint16_t WEEK_MINUTES = 7 * 24 * 60;
+  static int32_t lastCheckMow = -1;  // minute of the week of the previous check
+  if (!timeValid) return;
 
   DateTime now = getCurrentDateTime();
-  uint8_t currentDay = now.dayOfTheWeek();
-  uint8_t currentHour = now.hour();
-  uint8_t currentMinute = now.minute();
-  int lastIdx = -1;
+  uint16_t nowMow = now.dayOfTheWeek() * 1440 + now.hour() * 60 + now.minute();
+  int32_t sinceMow = lastCheckMow;
+  lastCheckMow = nowMow;
+  if (sinceMow < 0) return;
+  // Minutes crossed; a clock stepped back looks like most of a week and
+  // crosses nothing.
+  uint16_t elapsed = (nowMow + WEEK_MINUTES - sinceMow) % WEEK_MINUTES;
+  if (elapsed == 0 || elapsed > WEEK_MINUTES / 2) return;
+  if (relayMode != 2 || scheduleCount == 0) return;
 
+  int lastIdx = -1;
+  uint16_t lastOffset = 0;
   for (int i = 0; i < scheduleCount; i++) {
-    const auto &e = schedule[i];
-    if (e.day != currentDay) continue;
-    if (e.hour < currentHour || (e.hour == currentHour && e.minute <= currentMinute)) {
-      if (lastIdx < 0 ||
-          e.hour > schedule[lastIdx].hour ||
-          (e.hour == schedule[lastIdx].hour && e.minute > schedule[lastIdx].minute)) {
-        lastIdx = i;
-      }
-    }
+    uint16_t mow = schedule[i].day * 1440 + schedule[i].hour * 60 + schedule[i].minute;
+    uint16_t offset = (mow + WEEK_MINUTES - sinceMow) % WEEK_MINUTES;
+    if (offset == 0 || offset > elapsed || offset < lastOffset) continue;
+    lastIdx = i;
+    lastOffset = offset;
   }
   if (lastIdx >= 0) {
     setLocalRelayState(schedule[lastIdx].state);
-  } 
+  }
 }
 
 // ---------------------- Relay Logic ----------------------
@@ -207,3 +422,25 @@ void setRelayToLastEvent() {
   }
 }
 
+bool scheduleStateAt(const DateTime& now, bool& state, uint32_t& secondsUntilNext) {
+  if (scheduleCount == 0) return false;
+
+  // Minutes since Sunday 00:00; schedule[] is sorted the same way.
+  const uint16_t WEEK_MINUTES = 7 * 24 * 60;
+  uint16_t nowMow = now.dayOfTheWeek() * 1440 + now.hour() * 60 + now.minute();
+  int lastIdx = scheduleCount - 1;  // wraps to last week's final event
+  int nextIdx = 0;                  // wraps to next week's first event
+  for (int i = 0; i < scheduleCount; i++) {
+    uint16_t mow = schedule[i].day * 1440 + schedule[i].hour * 60 + schedule[i].minute;
+    if (mow <= nowMow) {
+      lastIdx = i;
+      nextIdx = (i + 1) % scheduleCount;
+    }
+  }
+
+  uint16_t nextMow = schedule[nextIdx].day * 1440 + schedule[nextIdx].hour * 60 + schedule[nextIdx].minute;
+  uint16_t minutesUntil = (nextMow > nowMow) ? nextMow - nowMow : nextMow + WEEK_MINUTES - nowMow;
+  state = schedule[lastIdx].state;
+  secondsUntilNext = (uint32_t)minutesUntil * 60 - now.second();
+  return true;
+}
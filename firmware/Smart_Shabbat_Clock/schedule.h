@@ -3,9 +3,13 @@
 
 #include <stdint.h>
 
+class DateTime;
+
 // ---------------------- Schedule Storage ----------------------
 // We store a flat list of events (time + day + ON/OFF).
-// Persistence: ESP32 NVS (Preferences) namespace "sched".
+// Persistence: ESP32 NVS (Preferences) namespace "sched": a snapshot
+// ("snap": revision and table in one blob) plus an append-only journal of
+// small fixed-size records ("j0", "j1", ...) replayed on top of it at boot.
 // CHANGE HERE: max number of schedule events stored.
 #define MAX_EVENTS 32
 
@@ -19,13 +23,31 @@ extern ScheduleEntry schedule[MAX_EVENTS];
 extern uint8_t scheduleCount;
 extern uint32_t scheduleRevision;
 
+// Journal ops. An edit notes what it changed right before saveSchedule();
+// saveSchedule() then appends those records (O(1) bytes per op) instead of
+// rewriting the table. Edits that note nothing (or CLEAR everything) get a
+// full snapshot.
+enum ScheduleJournalOp : uint8_t {
+  SCHEDULE_JOURNAL_UPSERT = 1,  // add, or set the state of the event at (day,time)
+  SCHEDULE_JOURNAL_DELETE = 2   // remove the event at (day,time)
+};
+void noteScheduleEdit(ScheduleJournalOp op, const ScheduleEntry& entry);
+
 void saveSchedule();
 void loadSchedule();
 void clearScheduleStorage();
+// Background compaction: fold the journal into a fresh snapshot once it
+// passes its threshold. Call from loop().
+void tickScheduleCompaction();
 void sortSchedule();
 void normalizeSchedule();
+// AUTO mode: apply the event crossed since the last call (once a minute).
 void applyScheduleLogic();
 void setRelayOppositeToNextEvent();
 void setRelayToLastEvent();
+// State the schedule puts the relay in at "now" (same rule as
+// setRelayToLastEvent) and the seconds until the next event changes it.
+// Returns false for an empty schedule.
+bool scheduleStateAt(const DateTime& now, bool& state, uint32_t& secondsUntilNext);
 
 #endif // SCHEDULE_H
@@ -0,0 +1,220 @@
+#include "task_scheduler.h"
+
+// CHANGE HERE: maximum number of registered tasks (notify mask is 32 bits).
+static const uint8_t MAX_TASKS = 16;
+// Upper bound on one idle wait, so a missed notify costs at most this (ms).
+static const unsigned long MAX_IDLE_MS = 1000;
+
+struct LoopTask {
+  const char* name;
+  TaskFn fn;
+  unsigned long periodMs;  // 0 = one-shot
+  unsigned long dueMs;
+  // Accounting
+  uint32_t runs;
+  uint64_t runUs;
+  uint32_t maxRunUs;
+  uint32_t maxLateMs;
+};
+
+static LoopTask tasks[MAX_TASKS];
+static uint8_t taskCount = 0;
+
+// Min-heap of armed task ids ordered by dueMs; heapPos[id] is the id's index
+// in the heap or NOT_IN_HEAP.
+static const uint8_t NOT_IN_HEAP = 0xFF;
+static uint8_t heap[MAX_TASKS];
+static uint8_t heapPos[MAX_TASKS];
+static uint8_t heapSize = 0;
+
+static SemaphoreHandle_t wakeSignal = nullptr;
+static uint32_t notifyMask = 0;  // ids notified from other tasks/ISRs
+
+static uint32_t wakeups = 0;
+static uint64_t idleUs = 0;
+
+// millis() wraps; compare by signed difference.
+static bool dueBefore(uint8_t a, uint8_t b) {
+  return (long)(tasks[a].dueMs - tasks[b].dueMs) < 0;
+}
+
+// ---------------------- Heap ----------------------
+
+static void heapSwap(uint8_t i, uint8_t j) {
+  uint8_t t = heap[i];
+  heap[i] = heap[j];
+  heap[j] = t;
+  heapPos[heap[i]] = i;
+  heapPos[heap[j]] = j;
+}
+
+static void heapSiftUp(uint8_t i) {
+  while (i > 0) {
+    uint8_t parent = (i - 1) / 2;
+    if (!dueBefore(heap[i], heap[parent])) break;
+    heapSwap(i, parent);
+    i = parent;
+  }
+}
+
+static void heapSiftDown(uint8_t i) {
+  for (;;) {
+    uint8_t smallest = i;
+    uint8_t left = 2 * i + 1;
+    uint8_t right = left + 1;
+    if (left < heapSize && dueBefore(heap[left], heap[smallest])) smallest = left;
+    if (right < heapSize && dueBefore(heap[right], heap[smallest])) smallest = right;
+    if (smallest == i) break;
+    heapSwap(i, smallest);
+    i = smallest;
+  }
+}
+
+static void heapRemove(uint8_t id) {
+  uint8_t i = heapPos[id];
+  if (i == NOT_IN_HEAP) return;
+  heapSwap(i, heapSize - 1);
+  heapSize--;
+  heapPos[id] = NOT_IN_HEAP;
+  if (i < heapSize) {
+    heapSiftUp(i);
+    heapSiftDown(i);
+  }
+}
+
+// (Re)arm a task at dueMs, keeping the heap ordered.
+static void armTask(uint8_t id, unsigned long dueMs) {
+  tasks[id].dueMs = dueMs;
+  uint8_t i = heapPos[id];
+  if (i == NOT_IN_HEAP) {
+    i = heapSize++;
+    heap[i] = id;
+    heapPos[id] = i;
+  }
+  heapSiftUp(i);
+  heapSiftDown(heapPos[id]);
+}
+
+// ---------------------- Registration ----------------------
+
+static TaskId addTask(const char* name, TaskFn fn, unsigned long periodMs, unsigned long delayMs) {
+  if (taskCount >= MAX_TASKS) {
+    Serial.printf("Scheduler full, task %s not added.\n", name);
+    return NO_TASK;
+  }
+  if (wakeSignal == nullptr) wakeSignal = xSemaphoreCreateBinary();
+  TaskId id = taskCount++;
+  tasks[id] = {name, fn, periodMs, 0, 0, 0, 0, 0};
+  heapPos[id] = NOT_IN_HEAP;
+  if (delayMs != NOT_SCHEDULED) armTask(id, millis() + delayMs);
+  return id;
+}
+
+TaskId schedulerAddPeriodic(const char* name, TaskFn fn, unsigned long periodMs, unsigned long firstDelayMs) {
+  return addTask(name, fn, periodMs, firstDelayMs);
+}
+
+TaskId schedulerAddOneShot(const char* name, TaskFn fn, unsigned long delayMs) {
+  return addTask(name, fn, 0, delayMs);
+}
+
+void schedulerDelay(TaskId id, unsigned long delayMs) {
+  if (id >= taskCount) return;
+  armTask(id, millis() + delayMs);
+}
+
+void schedulerNotify(TaskId id) {
+  if (id >= taskCount) return;
+  __atomic_fetch_or(&notifyMask, 1UL << id, __ATOMIC_RELAXED);
+  xSemaphoreGive(wakeSignal);
+}
+
+void schedulerNotifyFromISR(TaskId id) {
+  if (id >= taskCount) return;
+  __atomic_fetch_or(&notifyMask, 1UL << id, __ATOMIC_RELAXED);
+  BaseType_t woken = pdFALSE;
+  xSemaphoreGiveFromISR(wakeSignal, &woken);
+  if (woken) portYIELD_FROM_ISR(woken);
+}
+
+// ---------------------- Run / Idle ----------------------
+
+void schedulerRunDue() {
+  wakeups++;
+  uint32_t notified = __atomic_exchange_n(&notifyMask, 0, __ATOMIC_RELAXED);
+  unsigned long nowMs = millis();
+  for (uint8_t id = 0; notified != 0 && id < taskCount; id++) {
+    if (notified & (1UL << id)) armTask(id, nowMs);
+  }
+
+  // Only tasks due at entry run in this pass; a task that re-arms itself
+  // for "now" waits for the next pass, so one task can't starve the loop.
+  while (heapSize > 0 && (long)(tasks[heap[0]].dueMs - nowMs) <= 0) {
+    uint8_t id = heap[0];
+    LoopTask& task = tasks[id];
+    unsigned long lateMs = millis() - task.dueMs;
+
+    // Re-arm before running so the task may reschedule itself.
+    if (task.periodMs > 0) {
+      unsigned long next = task.dueMs + task.periodMs;
+      if ((long)(next - nowMs) <= 0) next = nowMs + task.periodMs;  // overrun: skip missed runs
+      armTask(id, next);
+    } else {
+      heapRemove(id);
+    }
+
+    unsigned long startUs = micros();
+    task.fn();
+    uint32_t elapsedUs = micros() - startUs;
+    task.runs++;
+    task.runUs += elapsedUs;
+    if (elapsedUs > task.maxRunUs) task.maxRunUs = elapsedUs;
+    if (lateMs > task.maxLateMs) task.maxLateMs = lateMs;
+  }
+}
+
+void schedulerIdle() {
+  if (__atomic_load_n(&notifyMask, __ATOMIC_RELAXED) != 0) return;
+  unsigned long waitMs = MAX_IDLE_MS;
+  if (heapSize > 0) {
+    long untilDue = (long)(tasks[heap[0]].dueMs - millis());
+    if (untilDue <= 0) return;
+    if ((unsigned long)untilDue < waitMs) waitMs = untilDue;
+  }
+  unsigned long startUs = micros();
+  xSemaphoreTake(wakeSignal, pdMS_TO_TICKS(waitMs));
+  idleUs += micros() - startUs;
+}
+
+// ---------------------- Metrics ----------------------
+
+uint64_t schedulerIdleUs() {
+  return idleUs;
+}
+
+void schedulerWritePrometheus(Print& out) {
+  out.print("# HELP shabbat_task_runs_total Loop task runs.\n"
+            "# TYPE shabbat_task_runs_total counter\n");
+  for (uint8_t id = 0; id < taskCount; id++) {
+    out.printf("shabbat_task_runs_total{task=\"%s\"} %lu\n", tasks[id].name, (unsigned long)tasks[id].runs);
+  }
+  out.print("# TYPE shabbat_task_run_us_total counter\n");
+  for (uint8_t id = 0; id < taskCount; id++) {
+    out.printf("shabbat_task_run_us_total{task=\"%s\"} %llu\n", tasks[id].name, (unsigned long long)tasks[id].runUs);
+  }
+  out.print("# TYPE shabbat_task_max_run_us gauge\n");
+  for (uint8_t id = 0; id < taskCount; id++) {
+    out.printf("shabbat_task_max_run_us{task=\"%s\"} %lu\n", tasks[id].name, (unsigned long)tasks[id].maxRunUs);
+  }
+  out.print("# HELP shabbat_task_max_late_ms Worst delay between a task's deadline and its start.\n"
+            "# TYPE shabbat_task_max_late_ms gauge\n");
+  for (uint8_t id = 0; id < taskCount; id++) {
+    out.printf("shabbat_task_max_late_ms{task=\"%s\"} %lu\n", tasks[id].name, (unsigned long)tasks[id].maxLateMs);
+  }
+  out.print("# HELP shabbat_scheduler_wakeups_total Loop passes (each runs every due task).\n"
+            "# TYPE shabbat_scheduler_wakeups_total counter\n");
+  out.printf("shabbat_scheduler_wakeups_total %lu\n", (unsigned long)wakeups);
+  out.print("# HELP shabbat_scheduler_idle_us_total Time the loop spent blocked waiting for work.\n"
+            "# TYPE shabbat_scheduler_idle_us_total counter\n");
+  out.printf("shabbat_scheduler_idle_us_total %llu\n", (unsigned long long)idleUs);
+}
@@ -0,0 +1,46 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// ---------------------- Loop Task Scheduler ----------------------
+// Cooperative, deadline-driven replacement for "call everything every spin".
+// Subsystems register periodic or one-shot tasks; loop() runs the ones that
+// are due (earliest deadline first, from a small min-heap) and then sleeps
+// on a semaphore until the next deadline or until something calls
+// schedulerNotify() (web request queued, button ISR, ...).
+// All task functions run on the loop thread, one at a time.
+//
+// Per-task accounting (runs, run time, worst run, worst lateness) plus loop
+// wakeups and idle time are exposed on /metrics as shabbat_task_* and
+// shabbat_scheduler_*.
+
+typedef void (*TaskFn)();
+typedef uint8_t TaskId;
+static const TaskId NO_TASK = 0xFF;
+// One-shot delay for tasks that only run when notified or re-armed.
+static const unsigned long NOT_SCHEDULED = 0xFFFFFFFFUL;
+
+// Run fn every periodMs, first after firstDelayMs. Returns NO_TASK when the
+// table is full.
+TaskId schedulerAddPeriodic(const char* name, TaskFn fn, unsigned long periodMs, unsigned long firstDelayMs = 0);
+// Run fn once, delayMs from now (or when notified); re-arm with schedulerDelay().
+// Pass NOT_SCHEDULED to leave it idle until then.
+TaskId schedulerAddOneShot(const char* name, TaskFn fn, unsigned long delayMs);
+// Move a task's next run to delayMs from now. Loop thread only; NO_TASK is ignored.
+void schedulerDelay(TaskId id, unsigned long delayMs);
+// Make a task due now and wake the loop. Safe from any task; use the
+// FromISR variant in interrupt handlers.
+void schedulerNotify(TaskId id);
+void schedulerNotifyFromISR(TaskId id);
+
+// loop(): run every due task, then block until there is more to do.
+void schedulerRunDue();
+void schedulerIdle();
+
+void schedulerWritePrometheus(Print& out);
+// Total time loop() has spent blocked in schedulerIdle().
+uint64_t schedulerIdleUs();
+
+#endif // TASK_SCHEDULER_H
@@ -1,4 +1,7 @@
 #include "time_utils.h"
+#include "i2c_bus.h"
+#include "metrics.h"
+#include "remote_sync.h"
 #include <WiFi.h>
 #include <time.h>
 
@@ -6,15 +9,133 @@
 extern bool timeValid;
 extern uint8_t relayMode;
 void setRelayToLastEvent();
+void tickRtcDstCorrection();
 extern struct tm timeinfo;
 extern bool rtcAvailable;
 extern RTC_DS3231 rtc;
 
 // CHANGE HERE: NTP resync intervals (ms).
 static const unsigned long NTP_SYNC_INTERVAL = 3600000; // 1h when time is valid
-static const unsigned long NTP_RETRY_INTERVAL = 15000;  // 15s while time is invalid
+static const unsigned long NTP_RETRY_INTERVAL = 1000;   // 1s until the first NTP sync
 static unsigned long lastNTPSyncTime = 0;
 static bool ntpConfigured = false;
+static bool ntpSynced = false;
+
+// CHANGE HERE: how often the RTC is re-read while time is asked for (ms).
+static const unsigned long RTC_REFRESH_INTERVAL = 1000;
+
+// ---------------------- RTC Cache ----------------------
+// Once the i2c task runs, reads are queued and the loop answers from the
+// last reading plus the millis() elapsed since, so it never waits on I2C.
+// Every rtcSetTime() bumps the generation; a read queued before it (and so
+// run before the write) carries the old generation and is dropped.
+static portMUX_TYPE rtcCacheMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t rtcCacheUnix = 0;
+static unsigned long rtcCacheMs = 0;
+static bool rtcCacheValid = false;
+static uint32_t rtcCacheGeneration = 0;
+static unsigned long rtcReadQueuedMs = 0;  // loop side: at most one read per interval
+
+static uint32_t rtcGeneration() {
+  portENTER_CRITICAL(&rtcCacheMux);
+  uint32_t generation = rtcCacheGeneration;
+  portEXIT_CRITICAL(&rtcCacheMux);
+  return generation;
+}
+
+static void storeRtcCache(uint32_t unixtime, uint32_t generation) {
+  portENTER_CRITICAL(&rtcCacheMux);
+  if (generation == rtcCacheGeneration) {
+    rtcCacheUnix = unixtime;
+    rtcCacheMs = millis();
+    rtcCacheValid = true;
+  }
+  portEXIT_CRITICAL(&rtcCacheMux);
+}
+
+// i2c task: read the RTC into the cache. A garbage reading (bus glitch)
+// keeps the previous one.
+static void readRtcInto(uint32_t generation) {
+  DateTime now = rtc.now();
+  metricsCount(COUNTER_I2C_RTC);
+  if (now.month() >= 1 && now.month() <= 12 && now.day() >= 1 && now.day() <= 31 && now.hour() < 24) {
+    storeRtcCache(now.unixtime(), generation);
+  }
+}
+
+// data: the cache generation when the read was queued.
+static void readRtcJob(const uint8_t* data) {
+  uint32_t generation;
+  memcpy(&generation, data, sizeof(generation));
+  readRtcInto(generation);
+}
+
+static void writeRtcJob(const uint8_t* data) {
+  uint32_t unixtime;
+  memcpy(&unixtime, data, sizeof(unixtime));
+  rtc.adjust(DateTime(unixtime));
+  metricsCount(COUNTER_I2C_RTC);
+}
+
+// The DST correction (tickRtcDstCorrection) reads and adjusts the RTC
+// itself, so it runs on the i2c task too; the cache is re-read after it.
+static void dstCorrectionJob(const uint8_t* data) {
+  uint32_t generation;
+  memcpy(&generation, data, sizeof(generation));
+  tickRtcDstCorrection();
+  readRtcInto(generation);
+  remoteSyncTimeChanged();  // a DST jump goes out in a beacon right away
+}
+
+static bool queueRtcJob(I2cJobFn job) {
+  uint32_t generation = rtcGeneration();
+  return i2cSubmit(I2C_DEVICE_RTC, job, &generation, sizeof(generation));
+}
+
+static bool readRtcCache(DateTime& out) {
+  if (!i2cBusStarted()) {
+    metricsCount(COUNTER_I2C_RTC);
+    out = rtc.now();
+    storeRtcCache(out.unixtime(), rtcGeneration());
+    return true;
+  }
+  portENTER_CRITICAL(&rtcCacheMux);
+  bool valid = rtcCacheValid;
+  uint32_t unixtime = rtcCacheUnix;
+  unsigned long ageMs = millis() - rtcCacheMs;
+  portEXIT_CRITICAL(&rtcCacheMux);
+  if ((!valid || ageMs >= RTC_REFRESH_INTERVAL) && millis() - rtcReadQueuedMs >= RTC_REFRESH_INTERVAL) {
+    if (queueRtcJob(readRtcJob)) rtcReadQueuedMs = millis();
+  }
+  if (!valid) return false;
+  out = DateTime(unixtime + ageMs / 1000);
+  return true;
+}
+
+void rtcSetTime(const DateTime& time) {
+  portENTER_CRITICAL(&rtcCacheMux);
+  rtcCacheGeneration++;
+  portEXIT_CRITICAL(&rtcCacheMux);
+  storeRtcCache(time.unixtime(), rtcGeneration());
+  remoteSyncTimeChanged();
+  if (!i2cBusStarted()) {
+    rtc.adjust(time);
+    metricsCount(COUNTER_I2C_RTC);
+    return;
+  }
+  uint32_t unixtime = time.unixtime();
+  if (!i2cSubmit(I2C_DEVICE_RTC, writeRtcJob, &unixtime, sizeof(unixtime))) {
+    Serial.println("RTC: write not queued (bus busy or RTC missing)");
+  }
+}
+
+void rtcCorrectDst() {
+  if (!i2cBusStarted()) {
+    tickRtcDstCorrection();
+    return;
+  }
+  if (rtcAvailable) queueRtcJob(dstCorrectionJob);
+}
 
 static void configureNtpIfNeeded() {
   if (ntpConfigured) return;
@@ -25,8 +146,9 @@ static void configureNtpIfNeeded() {
 
 // Get current time, preferring RTC, falling back to System/NTP
 DateTime getCurrentDateTime() {
-  if (rtcAvailable) {
-    return rtc.now();
+  DateTime now;
+  if (rtcAvailable && readRtcCache(now)) {
+    return now;
   } else if (WiFi.status() == WL_CONNECTED && getLocalTime(&timeinfo, 200)) {
     return DateTime(timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
                     timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
@@ -34,54 +156,28 @@ DateTime getCurrentDateTime() {
   return DateTime(2000, 1, 1, 0, 0, 0);
 }
 
-// Initial time sync sequence at boot
+// Boot-time sync: never blocks. The RTC provides time if it didn't lose
+// power (checked in setup()); NTP is configured now and tickTimeSync()
+// polls for it, retrying every NTP_RETRY_INTERVAL until the first
+// successful sync.
 void syncTimeAtBoot() {
-  // If there is no WiFi connection, don't block on NTP at boot.
-  if (WiFi.status() != WL_CONNECTED) {
-    // RTC can still provide valid time even without WiFi (if it didn't lose power).
-    timeValid = rtcAvailable && !rtc.lostPower();
-    Serial.println("Skip NTP at boot: no WiFi. Using RTC if reliable.");
-    return;
-  }
-
   configureNtpIfNeeded();
-  Serial.println("Waiting for time sync...");
-
-  int retry = 0;
-  const int retryCount = 20;
-  while (!getLocalTime(&timeinfo) && retry++ < retryCount) {
-    Serial.print(".");
-    delay(200);
-  }
-  Serial.println();
-
-  if (retry < retryCount) {
-    timeValid = true;
-    Serial.printf("Time synced: %02d:%02d:%02d\n",
-                  timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
-
-    if (rtcAvailable) {
-      rtc.adjust(DateTime(timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
-                          timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec));
-    }
-  } else {
-    timeValid = rtcAvailable && !rtc.lostPower();
-    Serial.println("Failed to get time from NTP");
-  }
+  Serial.printf("Time at boot from %s; NTP in background.\n", timeValid ? "RTC" : "nothing (invalid)");
 }
 
 // Periodic check to keep RTC in sync with NTP
 void tickTimeSync() {
   if (WiFi.status() != WL_CONNECTED) return;
   configureNtpIfNeeded();
-  const unsigned long interval = timeValid ? NTP_SYNC_INTERVAL : NTP_RETRY_INTERVAL;
+  const unsigned long interval = ntpSynced ? NTP_SYNC_INTERVAL : NTP_RETRY_INTERVAL;
   if (lastNTPSyncTime != 0 && (millis() - lastNTPSyncTime <= interval)) return;
 
   bool wasValid = timeValid;
-  if (getLocalTime(&timeinfo)) {
+  if (getLocalTime(&timeinfo, 0)) {  // no wait: SNTP fills it in when ready
     timeValid = true;
+    ntpSynced = true;
     if (rtcAvailable) {
-      rtc.adjust(DateTime(timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
+      rtcSetTime(DateTime(timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
                           timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec));
     }
     if (!wasValid && relayMode == 2) {
@@ -8,6 +8,12 @@
 DateTime getCurrentDateTime();
 void syncTimeAtBoot();
 void tickTimeSync();
+// Set the RTC; after boot the write is queued on the i2c task, and
+// getCurrentDateTime() returns the new time right away.
+void rtcSetTime(const DateTime& time);
+// Correct the local-time RTC across DST transitions; after boot it runs as
+// an RTC job on the i2c task.
+void rtcCorrectDst();
 
 extern bool timeValid;
 extern struct tm timeinfo;
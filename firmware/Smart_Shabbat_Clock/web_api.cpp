@@ -2,14 +2,20 @@
 #include "control_actions.h"
 #include "schedule.h"
 #include "hc12_comm.h"
+#include "i2c_bus.h"
+#include "json_utils.h"
+#include "metrics.h"
+#include "task_scheduler.h"
+#include "power_manager.h"
 #include "index_page.h"
 #include "time_utils.h"
 #include <RTClib.h>
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
 #include <time.h>
+#include <new>
 
-extern WebServer server;
-extern bool relay_state, shabbatMode, timeValid, hc12Ok;
+extern AsyncWebServer server;
+extern bool relay_state, shabbatMode, timeValid;
 extern uint8_t relayMode;
 extern struct tm timeinfo;
 extern bool rtcAvailable;
@@ -20,83 +26,448 @@ void normalizeSchedule();
 void sortSchedule();
 extern ScheduleEntry schedule[];
 extern uint8_t scheduleCount;
+extern uint32_t scheduleRevision;
+
+// ---------------------- Status Snapshot ----------------------
+// The loop thread renders the status JSON at most once per
+// STATUS_REFRESH_INTERVAL (and right after every web action) and bumps
+// statusGeneration whenever a UI-visible field changed. /status, /state and
+// /events serve this copy, so the async handlers never touch the RTC.
+// CHANGE HERE: status refresh interval (ms).
+static const unsigned long STATUS_REFRESH_INTERVAL = 1000;
+// Base fields plus one HC-12 link entry per Shabbat unit.
+static const size_t STATUS_LINK_JSON_SIZE = 100;
+static const size_t STATUS_JSON_SIZE = 160 + STATUS_LINK_JSON_SIZE * __builtin_popcount(HC12_SHABBAT_UNITS);
+
+struct StatusSnapshot {
+  char json[STATUS_JSON_SIZE];
+  uint32_t generation;
+};
+static StatusSnapshot statusSnapshot = {};  // guarded by webActionLock
+static unsigned long lastStatusRefreshMs = 0;
+// Random per boot: the generation and schedule revision restart after a
+// reboot, so without it a stale ETag could match the new state.
+static uint32_t bootNonce = 0;
+
+// ---------------------- Live Status Push ----------------------
+// Server-Sent Events on /events. tickWebApi() pushes a "status" event when the
+// status generation changes and a keep-alive copy otherwise, so open tabs
+// don't have to poll /status.
+// CHANGE HERE: subscriber limit and keep-alive interval (ms).
+static const uint8_t MAX_STATUS_SUBSCRIBERS = 4;
+static const unsigned long STATUS_KEEPALIVE_INTERVAL = 30000;
+
+static AsyncEventSource statusEvents("/events");
+static uint32_t lastPushedGeneration = 0;
+static unsigned long lastStatusPushMs = 0;
+
+// ---------------------- Deferred Actions ----------------------
+// Request handlers run on the AsyncTCP task, not on loop(). Routes that touch
+// the relay, schedule, NVS or HC-12, or read loop-thread state (/metrics),
+// only validate their arguments there and queue a WebAction; tickWebApi() runs it on the loop thread and sends the
+// response. Read-only routes (/, /status, and /state when unchanged) answer
+// directly.
+// CHANGE HERE: max number of queued state-changing requests.
+static const uint8_t MAX_PENDING_WEB_ACTIONS = 8;
+
+enum WebRoute : uint8_t {
+  ROUTE_CMD = 0,
+  ROUTE_SCHEDULE_UPDATE,
+  ROUTE_SCHEDULE_LIST,
+  ROUTE_SCHEDULE_DELETE,
+  ROUTE_SCHEDULE_BATCH,
+  ROUTE_SET_TIME,
+  ROUTE_STATE,
+  ROUTE_METRICS
+};
+
+enum WebCommand : uint8_t {
+  CMD_RELAY_ON = 0,
+  CMD_RELAY_OFF,
+  CMD_RELAY_AUTO,
+  CMD_SHABBAT,
+  CMD_WEEK
+};
+
+// POST /schedule_batch body, parsed on the AsyncTCP task.
+// CHANGE HERE: max body size (bytes) and ops per batch ("replace" counts
+// one op per event plus one).
+static const size_t MAX_SCHEDULE_BATCH_BODY = 4096;
+static const uint16_t MAX_SCHEDULE_BATCH_OPS = 64;
+
+struct ScheduleBatch {
+  uint32_t baseRevision;
+  uint16_t opCount;
+  ScheduleOp ops[MAX_SCHEDULE_BATCH_OPS];
+};
+
+struct WebAction {
+  AsyncWebServerRequest* request;  // cleared if the client disconnects first
+  WebRoute route;
+  int32_t args[6];
+  ScheduleBatch* batch;            // owned; ROUTE_SCHEDULE_BATCH only
+  uint32_t queuedAtUs;             // esp_timer, for the http_deferred timing
+};
+
+// FIFO of pending actions, guarded by webActionLock. The lock is also held
+// while a response is sent, so a disconnect cannot free the request under us.
+// It is recursive because a failed send may run the disconnect callback
+// synchronously on the sending thread.
+static WebAction webActions[MAX_PENDING_WEB_ACTIONS];
+static uint8_t webActionHead = 0;
+static uint8_t webActionCount = 0;
+static SemaphoreHandle_t webActionLock = nullptr;
+
+// Loop task that runs tickWebApi(); notified whenever an action is queued.
+static TaskId webTask = NO_TASK;
+
+static void forgetRequest(AsyncWebServerRequest* request);
+
+static bool queueWebAction(AsyncWebServerRequest* request, WebRoute route, const int32_t* args, uint8_t argCount,
+                           ScheduleBatch* batch) {
+  xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+  if (webActionCount >= MAX_PENDING_WEB_ACTIONS) {
+    xSemaphoreGiveRecursive(webActionLock);
+    return false;
+  }
+
+  uint8_t slot = (webActionHead + webActionCount) % MAX_PENDING_WEB_ACTIONS;
+  WebAction& action = webActions[slot];
+  action.request = request;
+  action.route = route;
+  for (uint8_t i = 0; i < argCount && i < 6; i++) action.args[i] = args[i];
+  action.batch = batch;
+  action.queuedAtUs = metricsStart();
+  webActionCount++;
+  xSemaphoreGiveRecursive(webActionLock);
+
+  // Registered here, on the AsyncTCP task, and nowhere else: the library
+  // doesn't guard the handler against being replaced from another task.
+  request->onDisconnect([request]() { forgetRequest(request); });
+  schedulerNotify(webTask);
+  return true;
+}
+
+static void queueOrReject(AsyncWebServerRequest* request, WebRoute route, const int32_t* args, uint8_t argCount,
+                          ScheduleBatch* batch = nullptr) {
+  if (!queueWebAction(request, route, args, argCount, batch)) {
+    delete batch;
+    request->send(503, "text/plain", "Busy - try again");
+  }
+}
+
+// Send the response for a finished action, unless its client already left.
+static void respond(WebAction& action, int code, const char* contentType, const String& body) {
+  xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+  if (action.request) {
+    action.request->send(code, contentType, body);
+    action.request = nullptr;
+  }
+  xSemaphoreGiveRecursive(webActionLock);
+}
+
+// ---------------------- Argument Helpers ----------------------
+// Query values are read through the parameter's own String (no copies).
+
+static bool intParam(AsyncWebServerRequest* request, const char* name, int32_t& value) {
+  const AsyncWebParameter* param = request->getParam(name);
+  if (!param) return false;
+  value = param->value().toInt();
+  return true;
+}
+
+static bool paramEquals(AsyncWebServerRequest* request, const char* name, const char* expected) {
+  const AsyncWebParameter* param = request->getParam(name);
+  return param && param->value() == expected;
+}
+
+// Count every request before handing it to its handler.
+static ArRequestHandlerFunction counted(ArRequestHandlerFunction handler) {
+  return [handler](AsyncWebServerRequest* request) {
+    metricsCount(COUNTER_HTTP_REQUESTS);
+    handler(request);
+  };
+}
 
 // ---------------------- Route Handlers ----------------------
 
-// Serve the main HTML page
-void handleRoot() { server.send(200, "text/html", index_html); }
+// Serve the main HTML page: gzip blob streamed from flash, revalidated by ETag.
+static void handleRoot(AsyncWebServerRequest* request) {
+  const AsyncWebHeader* ifNoneMatch = request->getHeader("If-None-Match");
+  if (ifNoneMatch && ifNoneMatch->value() == index_html_etag) {
+    AsyncWebServerResponse* response = request->beginResponse(304);
+    response->addHeader("ETag", index_html_etag);
+    request->send(response);
+    return;
+  }
 
-// Return system status as JSON (for UI polling)
-void handleStatus() {
+  AsyncWebServerResponse* response =
+      request->beginResponse_P(200, "text/html", index_html_gz, index_html_gz_len);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", index_html_etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+// "hc12" array: link statistics of every Shabbat unit; a unit that was
+// never addressed has only its number.
+static void formatLinksJson(char* out, size_t outLen) {
+    size_t used = snprintf(out, outLen, "[");
+    for (uint8_t unit = 1; unit <= HC12_MAX_BROADCAST_UNIT && used < outLen; unit++) {
+      if ((HC12_SHABBAT_UNITS & (1UL << (unit - 1))) == 0) continue;
+      const char* comma = used > 1 ? "," : "";
+      Hc12LinkSummary link;
+      if (!hc12LinkSummary(unit, link)) {
+        used += snprintf(out + used, outLen - used, "%s{\"unit\":%u}", comma, unit);
+        continue;
+      }
+      used += snprintf(out + used, outLen - used,
+                       "%s{\"unit\":%u,\"ok\":%s,\"successPct\":%u,\"rttP50Ms\":%u,\"rttP90Ms\":%u,\"lastSeen\":%lu}",
+                       comma, unit, link.ok ? "true" : "false", link.successPct, link.rttP50Ms, link.rttP90Ms,
+                       (unsigned long)link.lastSeen);
+    }
+    if (used < outLen) snprintf(out + used, outLen - used, "]");
+}
+
+// Status JSON shared by /status and the /events push.
+static void formatStatusJson(char* out, size_t outLen) {
     char buf[6] = {0};
     if (timeValid) {
       DateTime now = getCurrentDateTime();
-      sprintf(buf, "%02d:%02d", now.hour(), now.minute());
+      snprintf(buf, sizeof(buf), "%02d:%02d", now.hour(), now.minute());
+    }
+
+    char links[STATUS_LINK_JSON_SIZE * __builtin_popcount(HC12_SHABBAT_UNITS) + 3];
+    formatLinksJson(links, sizeof(links));
+
+    snprintf(out, outLen,
+             "{\"relay\":%s,\"shabbat\":%s,\"relayMode\":%u,\"time\":\"%s\",\"timeValid\":%s,\"hc12\":%s,\"scheduleRevision\":%lu}",
+             relay_state ? "true" : "false",
+             shabbatMode ? "true" : "false",
+             relayMode,
+             buf,
+             timeValid ? "true" : "false",
+             links,
+             (unsigned long)scheduleRevision);
+}
+
+// Loop thread only (reads the RTC). The JSON holds every field the UI
+// shows, so comparing it with the snapshot is the change test.
+static void refreshStatusSnapshot(bool force) {
+    unsigned long nowMs = millis();
+    if (!force && nowMs - lastStatusRefreshMs < STATUS_REFRESH_INTERVAL) return;
+    lastStatusRefreshMs = nowMs;
+
+    char json[STATUS_JSON_SIZE];
+    formatStatusJson(json, sizeof(json));
+
+    xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+    if (strcmp(json, statusSnapshot.json) != 0 || statusSnapshot.generation == 0) {
+      memcpy(statusSnapshot.json, json, sizeof(json));
+      statusSnapshot.generation++;
     }
+    xSemaphoreGiveRecursive(webActionLock);
+}
 
-    String json = String("{") +
-      "\"relay\":"     + String(relay_state ? "true" : "false") +
-      ",\"shabbat\":"  + String(shabbatMode ? "true" : "false") +
-      ",\"relayMode\":"+ String(relayMode) +
-      ",\"time\":\""   + String(buf) + "\"" +        
-      ",\"timeValid\":"+ String(timeValid ? "true" : "false") +
-      ",\"hc12Ok\":"   + String(hc12Ok ? "true" : "false") +
-    "}";
+// Copy the snapshot out; returns its generation.
+static uint32_t copyStatusSnapshot(char* out) {
+    xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+    memcpy(out, statusSnapshot.json, STATUS_JSON_SIZE);
+    uint32_t generation = statusSnapshot.generation;
+    xSemaphoreGiveRecursive(webActionLock);
+    return generation;
+}
 
-    server.send(200, "application/json", json);
+// Return system status as JSON (for UI polling)
+static void handleStatus(AsyncWebServerRequest* request) {
+    char json[STATUS_JSON_SIZE];
+    copyStatusSnapshot(json);
+    request->send(200, "application/json", json);
+}
+
+static void pushStatusIfChanged() {
+    if (statusEvents.count() == 0) return;
+
+    char json[STATUS_JSON_SIZE];
+    uint32_t generation = copyStatusSnapshot(json);
+    unsigned long nowMs = millis();
+    if (generation == lastPushedGeneration && nowMs - lastStatusPushMs < STATUS_KEEPALIVE_INTERVAL) return;
+
+    statusEvents.send(json, "status", generation);
+    lastPushedGeneration = generation;
+    lastStatusPushMs = nowMs;
+}
+
+// Prometheus text exposition of the device metrics (see metrics.h). The
+// writers read loop-thread state, so it is rendered on the loop thread.
+static void handleMetrics(AsyncWebServerRequest* request) {
+    queueOrReject(request, ROUTE_METRICS, nullptr, 0);
+}
+
+static void runMetrics(WebAction& action) {
+    xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+    if (action.request) {
+      AsyncResponseStream* response = action.request->beginResponseStream("text/plain; version=0.0.4", 4096);
+      metricsWritePrometheus(*response);
+      schedulerWritePrometheus(*response);
+      powerWritePrometheus(*response);
+      hc12WritePrometheus(*response);
+      i2cWritePrometheus(*response);
+      action.request->send(response);
+      action.request = nullptr;
+    }
+    xSemaphoreGiveRecursive(webActionLock);
 }
 
 // Handle commands: relay_on, relay_off, relay_auto, shabbat, week
-void handleCommand() {
-    if (!server.hasArg("c")) { server.send(400, "text/plain", "Missing cmd"); return; }
-    String c = server.arg("c");
+static void handleCommand(AsyncWebServerRequest* request) {
+    const AsyncWebParameter* param = request->getParam("c");
+    if (!param) { request->send(400, "text/plain", "Missing cmd"); return; }
+
+    const String& c = param->value();
+    int32_t cmd;
+    if (c == "relay_on") cmd = CMD_RELAY_ON;
+    else if (c == "relay_off") cmd = CMD_RELAY_OFF;
+    else if (c == "relay_auto") cmd = CMD_RELAY_AUTO;
+    else if (c == "shabbat") cmd = CMD_SHABBAT;
+    else if (c == "week") cmd = CMD_WEEK;
+    else { request->send(400, "text/plain", "Unsupported command"); return; }
+
+    queueOrReject(request, ROUTE_CMD, &cmd, 1);
+}
 
-    if (c == "relay_on" || c == "relay_off" || c == "relay_auto") {
-      String mode = (c == "relay_on") ? "on" : ((c == "relay_off") ? "off" : "auto");
+// ---------------------- Held Replies ----------------------
+// Requests whose result arrives after their WebAction is done (HC-12
+// commands). A slot stays taken until the callback runs, even if the client
+// leaves first, so a late callback can never answer someone else's request.
+// Guarded by webActionLock.
+// CHANGE HERE: max requests waiting on the radio at once, and the
+// Retry-After (s) sent when the radio is busy (~one HC-12 transaction).
+static const uint8_t MAX_HELD_REPLIES = 4;
+static const uint32_t RADIO_RETRY_AFTER_S = (HC12_TRANSACTION_BUDGET_MS + 999) / 1000;
+
+struct HeldReply {
+  AsyncWebServerRequest* request;  // nullptr once the client disconnected
+  bool inUse;
+};
+
+static HeldReply heldReplies[MAX_HELD_REPLIES];
+
+// The client left: its queued action and held reply still run, but nothing
+// is sent on the request any more.
+static void forgetRequest(AsyncWebServerRequest* request) {
+  xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+  for (uint8_t i = 0; i < MAX_PENDING_WEB_ACTIONS; i++) {
+    if (webActions[i].request == request) webActions[i].request = nullptr;
+  }
+  for (uint8_t i = 0; i < MAX_HELD_REPLIES; i++) {
+    if (heldReplies[i].request == request) heldReplies[i].request = nullptr;
+  }
+  xSemaphoreGiveRecursive(webActionLock);
+}
+
+// Move the action's request into a held slot; -1 if none is free.
+static int8_t holdReply(WebAction& action) {
+  xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+  int8_t slot = -1;
+  for (uint8_t i = 0; i < MAX_HELD_REPLIES; i++) {
+    if (!heldReplies[i].inUse) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot >= 0) {
+    heldReplies[slot] = {action.request, true};
+    action.request = nullptr;
+  }
+  xSemaphoreGiveRecursive(webActionLock);
+  return slot;
+}
+
+// 503 + Retry-After: the request was fine, the radio queue is full for now.
+static void sendRadioBusy(AsyncWebServerRequest* request, const String& message) {
+  AsyncWebServerResponse* response = request->beginResponse(503, "text/plain", message);
+  response->addHeader("Retry-After", String(RADIO_RETRY_AFTER_S));
+  request->send(response);
+}
+
+static void finishShabbatCommand(const ActionResult& result, void* context) {
+  int8_t slot = (int8_t)reinterpret_cast<intptr_t>(context);
+  xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+  HeldReply& held = heldReplies[slot];
+  if (held.request) {
+    if (result.code == "hc12_partial") held.request->send(200, "text/plain", result.message);  // per-unit detail
+    else if (result.ok) held.request->send(204, "text/plain", "");
+    else if (result.code == "hc12_no_ack") held.request->send(504, "text/plain", result.message);
+    else if (result.code == "hc12_rejected") held.request->send(502, "text/plain", result.message);
+    else if (result.code == "hc12_busy") sendRadioBusy(held.request, result.message);
+    else held.request->send(400, "text/plain", result.message);
+  }
+  held = {nullptr, false};
+  xSemaphoreGiveRecursive(webActionLock);
+  refreshStatusSnapshot(true);
+}
+
+static void runCommand(WebAction& action) {
+    int32_t cmd = action.args[0];
+
+    if (cmd == CMD_RELAY_ON || cmd == CMD_RELAY_OFF || cmd == CMD_RELAY_AUTO) {
+      const char* mode = (cmd == CMD_RELAY_ON) ? "on" : ((cmd == CMD_RELAY_OFF) ? "off" : "auto");
       ActionResult result = applyRelayModeAction(mode);
-      if (result.ok) server.send(204, "text/plain", "");
-      else server.send(400, "text/plain", result.message);
+      if (result.ok) respond(action, 204, "text/plain", "");
+      else respond(action, 400, "text/plain", result.message);
       return;
     }
 
-    if (c == "shabbat" || c == "week") {
-      ActionResult result = applyShabbatModeAction(c);
-      if (result.ok) server.send(204, "text/plain", "");
-      else server.send(result.code == "hc12_no_ack" ? 504 : 400, "text/plain", result.message);
+    // The HC-12 exchange finishes later; the response waits for it.
+    int8_t slot = holdReply(action);
+    if (slot < 0) {
+      xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+      if (action.request) sendRadioBusy(action.request, "Too many pending radio commands");
+      action.request = nullptr;
+      xSemaphoreGiveRecursive(webActionLock);
       return;
     }
-
-    server.send(400, "text/plain", "Unsupported command");
+    applyShabbatModeAction(cmd == CMD_SHABBAT ? "shabbat" : "week", finishShabbatCommand,
+                           reinterpret_cast<void*>((intptr_t)slot));
 }
 
 // Add or update a schedule event
-void handleScheduleUpdate() {
-    if (!server.hasArg("hour") || !server.hasArg("minute") || !server.hasArg("state") || !server.hasArg("day")) {
-      server.send(400, "Missing args");
+static void handleScheduleUpdate(AsyncWebServerRequest* request) {
+    int32_t args[4];  // hour, minute, state, day
+    if (!intParam(request, "hour", args[0]) || !intParam(request, "minute", args[1]) ||
+        !request->hasParam("state") || !intParam(request, "day", args[3])) {
+      request->send(400, "text/plain", "Missing args");
       return;
     }
+    args[2] = paramEquals(request, "state", "on") ? 1 : 0;
 
-    if (!timeValid) {
-      server.send(409, "text/plain", "Time invalid - scheduling disabled");
+    if (args[0] < 0 || args[0] > 23 || args[1] < 0 || args[1] > 59 || args[3] < 0 || args[3] > 6) {
+      request->send(400, "text/plain", "Invalid values");
       return;
     }
 
-    uint8_t hour = server.arg("hour").toInt();
-    uint8_t minute = server.arg("minute").toInt();
-    bool state = (server.arg("state") == "on");
-    uint8_t day = server.arg("day").toInt();
-    if (hour > 23 || minute > 59 || day > 6) {
-      server.send(400, "Invalid values");
+    queueOrReject(request, ROUTE_SCHEDULE_UPDATE, args, 4);
+}
+
+static void runScheduleUpdate(WebAction& action) {
+    if (!timeValid) {
+      respond(action, 409, "text/plain", "Time invalid - scheduling disabled");
       return;
     }
 
+    uint8_t hour = action.args[0];
+    uint8_t minute = action.args[1];
+    bool state = action.args[2] != 0;
+    uint8_t day = action.args[3];
+
     // If an event already exists at the same (day,time):
     for (int i = 0; i < scheduleCount; i++) {
       if (schedule[i].day == day && schedule[i].hour == hour && schedule[i].minute == minute) {
 
         // Case 2: Same state — nothing to change
         if (schedule[i].state == state) {
-          server.send(409, "No change - identical event already exists");
+          respond(action, 409, "text/plain", "No change - identical event already exists");
           return;
         }
 
@@ -104,15 +475,16 @@ void handleScheduleUpdate() {
         schedule[i].state = state;
         sortSchedule();
         normalizeSchedule(); // keep only transitions
+        noteScheduleEdit(SCHEDULE_JOURNAL_UPSERT, ScheduleEntry{hour, minute, state, day});
         saveSchedule();
-        server.send(200, "Schedule updated");
+        respond(action, 200, "text/plain", "Schedule updated");
         return;
       }
     }
 
     // Otherwise add new entry (if there is capacity).
     if (scheduleCount >= MAX_EVENTS) {
-      server.send(400, "Schedule full");
+      respond(action, 400, "text/plain", "Schedule full");
       return;
     }
 
@@ -120,62 +492,275 @@ void handleScheduleUpdate() {
     schedule[scheduleCount++] = e;
     sortSchedule();
     normalizeSchedule();     // compress consecutive duplicates
+    noteScheduleEdit(SCHEDULE_JOURNAL_UPSERT, e);
     saveSchedule();
-    server.send(200, "Schedule added");
+    respond(action, 200, "text/plain", "Schedule added");
 }
 
 // Return the full schedule as JSON
-void handleScheduleList() {
-    String json = "[";
+static void handleScheduleList(AsyncWebServerRequest* request) {
+    queueOrReject(request, ROUTE_SCHEDULE_LIST, nullptr, 0);
+}
+
+// Append the schedule as a JSON array of events.
+static void appendScheduleJson(String& json) {
+    json += "[";
+    char entry[64];
     for (int i = 0; i < scheduleCount; i++) {
-      if (i > 0) json += ",";
-      json += "{\"hour\":" + String(schedule[i].hour) +
-              ",\"minute\":" + String(schedule[i].minute) +
-              ",\"state\":\"" + String(schedule[i].state ? "on" : "off") + "\"" +
-              ",\"day\":" + String(schedule[i].day) + "}";
+      snprintf(entry, sizeof(entry), "%s{\"hour\":%u,\"minute\":%u,\"state\":\"%s\",\"day\":%u}",
+               i > 0 ? "," : "",
+               schedule[i].hour, schedule[i].minute,
+               schedule[i].state ? "on" : "off",
+               schedule[i].day);
+      json += entry;
     }
     json += "]";
-    server.send(200, "application/json", json);
+}
+
+static void runScheduleList(WebAction& action) {
+    String json;
+    json.reserve(2 + scheduleCount * 48);
+    appendScheduleJson(json);
+    respond(action, 200, "application/json", json);
+}
+
+// Bulk schedule edit:
+//   POST /schedule_batch
+//   {"baseRevision":N,"ops":[{"op":"add","day":0,"hour":8,"minute":0,"state":"on"},
+//                            {"op":"delete","day":0,"hour":9,"minute":30},
+//                            {"op":"replace","events":[{...}, ...]}]}
+// Ops run in order on a copy of the schedule and are committed together with
+// one sort, normalize and NVS write. A stale baseRevision or any failing op
+// leaves the schedule untouched. Replies {"revision":N,"events":[...]}.
+static bool addBatchOp(ScheduleBatch& batch, ScheduleOpType type, const ScheduleEntry& entry) {
+    if (batch.opCount >= MAX_SCHEDULE_BATCH_OPS) return false;
+    batch.ops[batch.opCount].type = type;
+    batch.ops[batch.opCount].entry = entry;
+    batch.opCount++;
+    return true;
+}
+
+static bool parseScheduleBatch(const String& body, ScheduleBatch& batch, const char*& error) {
+    batch.opCount = 0;
+    String opsJson;
+    if (!findNumberValue(body, "baseRevision", batch.baseRevision) || !extractValueBlock(body, "ops", opsJson)) {
+      error = "Missing baseRevision or ops";
+      return false;
+    }
+
+    int pos = 0;
+    while (pos < opsJson.length()) {
+      int start = opsJson.indexOf('{', pos);
+      if (start < 0) break;
+      int end = findObjectEnd(opsJson, start);
+      if (end < 0) { error = "Malformed ops"; return false; }
+      String object = opsJson.substring(start, end + 1);
+      pos = end + 1;
+
+      String op;
+      if (!findStringValue(object, "op", op)) { error = "Missing op"; return false; }
+
+      ScheduleEntry entry = {};
+      if (op == "add") {
+        if (!parseScheduleEvent(object, entry)) { error = "Invalid event"; return false; }
+        if (!addBatchOp(batch, SCHEDULE_OP_UPSERT, entry)) { error = "Too many ops"; return false; }
+      } else if (op == "delete") {
+        uint32_t day, hour, minute;
+        if (!findNumberValue(object, "day", day) || !findNumberValue(object, "hour", hour) ||
+            !findNumberValue(object, "minute", minute) || day > 6 || hour > 23 || minute > 59) {
+          error = "Invalid event";
+          return false;
+        }
+        entry.day = day;
+        entry.hour = hour;
+        entry.minute = minute;
+        if (!addBatchOp(batch, SCHEDULE_OP_DELETE, entry)) { error = "Too many ops"; return false; }
+      } else if (op == "replace") {
+        String eventsJson;
+        if (!extractValueBlock(object, "events", eventsJson)) { error = "Missing events"; return false; }
+        if (!addBatchOp(batch, SCHEDULE_OP_CLEAR, entry)) { error = "Too many ops"; return false; }
+        int eventPos = 0;
+        while (eventPos < eventsJson.length()) {
+          int eventStart = eventsJson.indexOf('{', eventPos);
+          if (eventStart < 0) break;
+          int eventEnd = findObjectEnd(eventsJson, eventStart);
+          if (eventEnd < 0 || !parseScheduleEvent(eventsJson.substring(eventStart, eventEnd + 1), entry)) {
+            error = "Invalid event";
+            return false;
+          }
+          if (!addBatchOp(batch, SCHEDULE_OP_UPSERT, entry)) { error = "Too many ops"; return false; }
+          eventPos = eventEnd + 1;
+        }
+      } else {
+        error = "Unsupported op";
+        return false;
+      }
+    }
+    return true;
+}
+
+// Collect the body into request->_tempObject (freed by the request).
+static void handleScheduleBatchBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+    if (total > MAX_SCHEDULE_BATCH_BODY) return;
+    if (index == 0 && !request->_tempObject) request->_tempObject = calloc(total + 1, 1);
+    if (!request->_tempObject || index + len > total) return;
+    memcpy((char*)request->_tempObject + index, data, len);
+}
+
+static void handleScheduleBatch(AsyncWebServerRequest* request) {
+    if (request->contentLength() > MAX_SCHEDULE_BATCH_BODY) {
+      request->send(413, "text/plain", "Batch too large");
+      return;
+    }
+    if (!request->_tempObject) {
+      request->send(400, "text/plain", "Missing body");
+      return;
+    }
+
+    ScheduleBatch* batch = new (std::nothrow) ScheduleBatch();
+    if (!batch) {
+      request->send(503, "text/plain", "Busy - try again");
+      return;
+    }
+    const char* error = "";
+    if (!parseScheduleBatch(String((const char*)request->_tempObject), *batch, error)) {
+      delete batch;
+      request->send(400, "text/plain", error);
+      return;
+    }
+
+    queueOrReject(request, ROUTE_SCHEDULE_BATCH, nullptr, 0, batch);
+}
+
+static void runScheduleBatch(WebAction& action) {
+    // Like /schedule, adding events needs valid time; deletes are always allowed.
+    bool addsEvents = false;
+    for (uint16_t i = 0; i < action.batch->opCount; i++) {
+      if (action.batch->ops[i].type == SCHEDULE_OP_UPSERT) addsEvents = true;
+    }
+    if (addsEvents && !timeValid) {
+      respond(action, 409, "text/plain", "Time invalid - scheduling disabled");
+      return;
+    }
+
+    ActionResult result = applyScheduleBatchAction(action.batch->baseRevision, action.batch->ops, action.batch->opCount);
+    String json;
+    if (!result.ok) {
+      json = "{\"code\":" + jsonString(result.code) + ",\"message\":" + jsonString(result.message) +
+             ",\"revision\":" + String(scheduleRevision) + "}";
+      respond(action, result.code == "stale_schedule" ? 409 : 400, "application/json", json);
+      return;
+    }
+
+    json.reserve(32 + scheduleCount * 48);
+    json += "{\"revision\":";
+    json += scheduleRevision;
+    json += ",\"events\":";
+    appendScheduleJson(json);
+    json += "}";
+    respond(action, 200, "application/json", json);
+}
+
+// Combined status + schedule:
+//   GET /state[?since=<scheduleRevision>]
+// The ETag "<bootNonce>-s<scheduleRevision>-g<statusGeneration>" changes
+// whenever either part does or the clock rebooted, so an unchanged poll with
+// If-None-Match gets a bodyless 304 straight from the AsyncTCP task. With since= matching the current schedule
+// revision the schedule is left out of the body.
+static String stateEtag(uint32_t generation) {
+    return "\"" + String(bootNonce, HEX) + "-s" + String(scheduleRevision) + "-g" + String(generation) + "\"";
+}
+
+static void handleState(AsyncWebServerRequest* request) {
+    const AsyncWebHeader* ifNoneMatch = request->getHeader("If-None-Match");
+    if (ifNoneMatch) {
+      xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+      String etag = stateEtag(statusSnapshot.generation);
+      xSemaphoreGiveRecursive(webActionLock);
+      if (ifNoneMatch->value() == etag) {
+        AsyncWebServerResponse* response = request->beginResponse(304);
+        response->addHeader("ETag", etag);
+        request->send(response);
+        return;
+      }
+    }
+
+    int32_t since = -1;
+    const AsyncWebParameter* param = request->getParam("since");
+    if (param) since = param->value().toInt();
+    queueOrReject(request, ROUTE_STATE, &since, 1);
+}
+
+static void runState(WebAction& action) {
+    refreshStatusSnapshot(true);
+    char status[STATUS_JSON_SIZE];
+    uint32_t generation = copyStatusSnapshot(status);
+    String etag = stateEtag(generation);
+
+    String json;
+    json.reserve(64 + STATUS_JSON_SIZE + scheduleCount * 48);
+    json += "{\"revision\":";
+    json += etag;
+    json += ",\"status\":";
+    json += status;
+    if (action.args[0] < 0 || (uint32_t)action.args[0] != scheduleRevision) {
+      json += ",\"schedule\":{\"revision\":";
+      json += scheduleRevision;
+      json += ",\"events\":";
+      appendScheduleJson(json);
+      json += "}";
+    }
+    json += "}";
+
+    xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+    if (action.request) {
+      AsyncWebServerResponse* response = action.request->beginResponse(200, "application/json", json);
+      response->addHeader("ETag", etag);
+      response->addHeader("Cache-Control", "no-cache");
+      action.request->send(response);
+      action.request = nullptr;
+    }
+    xSemaphoreGiveRecursive(webActionLock);
 }
 
 // Manually set the system time (if NTP fails)
-void handleSetTime() {
-    if (!server.hasArg("y") || !server.hasArg("m") || !server.hasArg("d") ||
-        !server.hasArg("H") || !server.hasArg("M") || !server.hasArg("S")) {
-      server.send(400, "Missing args y,m,d,H,M,S");
+static void handleSetTime(AsyncWebServerRequest* request) {
+    int32_t args[6];  // y, m, d, H, M, S
+    if (!intParam(request, "y", args[0]) || !intParam(request, "m", args[1]) || !intParam(request, "d", args[2]) ||
+        !intParam(request, "H", args[3]) || !intParam(request, "M", args[4]) || !intParam(request, "S", args[5])) {
+      request->send(400, "text/plain", "Missing args y,m,d,H,M,S");
       return;
     }
-    int y = server.arg("y").toInt();
-    int m = server.arg("m").toInt();
-    int d = server.arg("d").toInt();
-    int H = server.arg("H").toInt();
-    int M = server.arg("M").toInt();
-    int S = server.arg("S").toInt();
+    int y = args[0], m = args[1], d = args[2], H = args[3], M = args[4], S = args[5];
     if (y < 2020 || m < 1 || m > 12 || d < 1 || d > 31 || H < 0 || H > 23 || M < 0 || M > 59 || S < 0 || S > 59) {
-      server.send(400, "Invalid values");
+      request->send(400, "text/plain", "Invalid values");
       return;
     }
 
+    queueOrReject(request, ROUTE_SET_TIME, args, 6);
+}
+
+static void runSetTime(WebAction& action) {
     // set system time
     struct tm t = {};
-    t.tm_year = y - 1900;
-    t.tm_mon  = m - 1;
-    t.tm_mday = d;
-    t.tm_hour = H;
-    t.tm_min  = M;
-    t.tm_sec  = S;
+    t.tm_year = action.args[0] - 1900;
+    t.tm_mon  = action.args[1] - 1;
+    t.tm_mday = action.args[2];
+    t.tm_hour = action.args[3];
+    t.tm_min  = action.args[4];
+    t.tm_sec  = action.args[5];
     t.tm_isdst = -1;
     ensureLocalTimezoneConfigured();
     time_t epoch = mktime(&t);
     if (epoch == (time_t)-1) {
-      server.send(400, "Invalid local time");
+      respond(action, 400, "text/plain", "Invalid local time");
       return;
     }
     struct timeval now = { .tv_sec = epoch, .tv_usec = 0 };
     settimeofday(&now, nullptr);
 
     if (rtcAvailable) {
-      rtc.adjust(DateTime(t.tm_year + 1900, t.tm_mon + 1, t.tm_mday,
+      rtcSetTime(DateTime(t.tm_year + 1900, t.tm_mon + 1, t.tm_mday,
                           t.tm_hour, t.tm_min, t.tm_sec));
     }
     updateRtcDstStateFromLocalTime(t);
@@ -183,61 +768,141 @@ void handleSetTime() {
 
     if (relayMode == 2) setRelayToLastEvent();
 
-    server.send(200, "Time set");
+    respond(action, 200, "text/plain", "Time set");
 }
 
 // Delete a specific event
-void handleScheduleDelete() {
-    if (!server.hasArg("day") || !server.hasArg("hour") || !server.hasArg("minute")) {
-      server.send(400, "Missing args"); return;
+static void handleScheduleDelete(AsyncWebServerRequest* request) {
+    int32_t args[3];  // day, hour, minute
+    if (!intParam(request, "day", args[0]) || !intParam(request, "hour", args[1]) || !intParam(request, "minute", args[2])) {
+      request->send(400, "text/plain", "Missing args"); return;
     }
-    uint8_t day = server.arg("day").toInt();
-    uint8_t hour = server.arg("hour").toInt();
-    uint8_t minute = server.arg("minute").toInt();
-    if (day > 6 || hour > 23 || minute > 59) {
-      server.send(400, "Invalid values"); return;
+    if (args[0] < 0 || args[0] > 6 || args[1] < 0 || args[1] > 23 || args[2] < 0 || args[2] > 59) {
+      request->send(400, "text/plain", "Invalid values"); return;
     }
-  
+
+    queueOrReject(request, ROUTE_SCHEDULE_DELETE, args, 3);
+}
+
+static void runScheduleDelete(WebAction& action) {
+    uint8_t day = action.args[0];
+    uint8_t hour = action.args[1];
+    uint8_t minute = action.args[2];
+
     int idx = -1;
     for (int i = 0; i < scheduleCount; i++) {
       if (schedule[i].day == day && schedule[i].hour == hour && schedule[i].minute == minute) {
         idx = i; break;
       }
     }
-    if (idx < 0) { server.send(404, "Event not found"); return; }
-  
+    if (idx < 0) { respond(action, 404, "text/plain", "Event not found"); return; }
+    noteScheduleEdit(SCHEDULE_JOURNAL_DELETE, schedule[idx]);
+
     // Compact array (stable order after removal).
     for (int j = idx + 1; j < scheduleCount; j++) {
       schedule[j - 1] = schedule[j];
     }
     scheduleCount--;
-  
+
     sortSchedule();
     normalizeSchedule();
     saveSchedule();
-  
-    server.send(200, "Event deleted");
+
+    respond(action, 200, "text/plain", "Event deleted");
 }
 
 // ---------------------- Web Server Init ----------------------
 
 void initWebServer() {
   Serial.println("Starting web server...");
-  
+  webActionLock = xSemaphoreCreateRecursiveMutex();
+  bootNonce = esp_random();
+  refreshStatusSnapshot(true);
+  webTask = schedulerAddPeriodic("web", tickWebApi, STATUS_REFRESH_INTERVAL);
+
   // Root serves the embedded HTML UI.
-  server.on("/", handleRoot);
+  server.on("/", HTTP_GET, counted(handleRoot));
 
   // Lightweight JSON status for the UI polling.
-  server.on("/status", handleStatus);
+  server.on("/status", HTTP_GET, counted(handleStatus));
+
+  // Status + schedule in one conditional request.
+  server.on("/state", HTTP_GET, counted(handleState));
+
+  // Device metrics, Prometheus text format.
+  server.on("/metrics", HTTP_GET, counted(handleMetrics));
+
+  // Live status push; new subscribers get the current status right away.
+  // Over the limit the request gets a 403 instead of the stream upgrade:
+  // EventSource does not retry a refused stream, and the UI falls back to
+  // polling /status.
+  statusEvents.authorizeConnect([](AsyncWebServerRequest* request) {
+    return statusEvents.count() < MAX_STATUS_SUBSCRIBERS;
+  });
+  statusEvents.onConnect([](AsyncEventSourceClient* client) {
+    char json[STATUS_JSON_SIZE];
+    uint32_t generation = copyStatusSnapshot(json);
+    client->send(json, "status", generation);
+  });
+  server.addHandler(&statusEvents);
 
   // Command endpoint for relay mode + Shabbat/Week broadcast to HC-12.
-  server.on("/cmd", handleCommand);
+  server.on("/cmd", HTTP_GET, counted(handleCommand));
 
   // Schedule management
-  server.on("/schedule", handleScheduleUpdate);
-  server.on("/schedule_list", handleScheduleList);
-  server.on("/schedule_delete", handleScheduleDelete);
-  
+  server.on("/schedule", HTTP_GET, counted(handleScheduleUpdate));
+  server.on("/schedule_list", HTTP_GET, counted(handleScheduleList));
+  server.on("/schedule_delete", HTTP_GET, counted(handleScheduleDelete));
+  server.on("/schedule_batch", HTTP_POST, counted(handleScheduleBatch), nullptr, handleScheduleBatchBody);
+
   // Manual time set
-  server.on("/set_time", handleSetTime);
+  server.on("/set_time", HTTP_GET, counted(handleSetTime));
+
+  server.onNotFound([](AsyncWebServerRequest* request) {
+    request->send(404, "text/plain", "Not found");
+  });
+}
+
+// Run queued state-changing requests on the loop thread, oldest first,
+// then refresh the status snapshot and push it to live subscribers.
+void tickWebApi() {
+  uint32_t t0 = metricsStart();
+  bool ranActions = false;
+  for (;;) {
+    xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+    if (webActionCount == 0) {
+      xSemaphoreGiveRecursive(webActionLock);
+      break;
+    }
+    WebAction& action = webActions[webActionHead];
+    bool abandoned = (action.request == nullptr);
+    xSemaphoreGiveRecursive(webActionLock);
+    ranActions = true;
+
+    // Actions from clients that already left are still applied, as with the
+    // synchronous server; only the read-only routes are skipped.
+    switch (action.route) {
+      case ROUTE_CMD:             runCommand(action); break;
+      case ROUTE_SCHEDULE_UPDATE: runScheduleUpdate(action); break;
+      case ROUTE_SCHEDULE_LIST:   if (!abandoned) runScheduleList(action); break;
+      case ROUTE_SCHEDULE_DELETE: runScheduleDelete(action); break;
+      case ROUTE_SCHEDULE_BATCH:  runScheduleBatch(action); break;
+      case ROUTE_SET_TIME:        runSetTime(action); break;
+      case ROUTE_STATE:           if (!abandoned) runState(action); break;
+      case ROUTE_METRICS:         if (!abandoned) runMetrics(action); break;
+    }
+
+    delete action.batch;
+    metricsRecord(METRIC_HTTP_DEFERRED, action.queuedAtUs);
+    xSemaphoreTakeRecursive(webActionLock, portMAX_DELAY);
+    action.request = nullptr;
+    action.batch = nullptr;
+    webActionHead = (webActionHead + 1) % MAX_PENDING_WEB_ACTIONS;
+    webActionCount--;
+    xSemaphoreGiveRecursive(webActionLock);
+  }
+
+  refreshStatusSnapshot(ranActions);
+  pushStatusIfChanged();
+  metricsRecord(METRIC_WEB_TICK, t0);
 }
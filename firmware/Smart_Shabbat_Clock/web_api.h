@@ -1,13 +1,14 @@
-class WebServer;
-
 #ifndef WEB_API_H
 #define WEB_API_H
 
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
 
-// Web server setup/handlers.
+// Web server setup/handlers (ESPAsyncWebServer, served from the AsyncTCP task).
 void initWebServer();
-extern WebServer server;
+// Run queued state-changing requests on the loop thread. initWebServer()
+// registers it as the "web" loop task, woken whenever a request is queued.
+void tickWebApi();
+extern AsyncWebServer server;
 void saveRelayMode(uint8_t mode);
 void saveShabbatMode(bool mode);
 
@@ -0,0 +1,143 @@
+// Hc12Frame loopback check: runs the encoder and decoder back to back on the
+// board (no radio needed) and prints PASS/FAIL per case to Serial. The same
+// sketch runs on Linux as tools/host-tests/loopback.
+// Covers a clean round trip, leading noise and a fake "ACK", a corrupted
+// byte (CRC error, then resync), truncated frames followed by good ones,
+// reply matching, broadcast target masks and reply slots, an oversized
+// length, and the remote schedule payloads (schedule chunks, time beacon,
+// beacon-disciplined clock).
+
+#include <hc12_frame.h>
+#include <hc12_schedule.h>
+
+static uint8_t failures = 0;
+
+static void check(const char* name, bool ok) {
+  Serial.print(ok ? "PASS " : "FAIL ");
+  Serial.println(name);
+  if (!ok) failures++;
+}
+
+// Push bytes through a decoder; returns the number of frames decoded and
+// keeps the last one.
+static uint8_t feed(Hc12FrameDecoder& decoder, const uint8_t* bytes, size_t length, Hc12Frame& last) {
+  uint8_t frames = 0;
+  for (size_t i = 0; i < length; i++) {
+    for (bool got = decoder.push(bytes[i], last); got; got = decoder.next(last)) frames++;
+  }
+  return frames;
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {}
+
+  Hc12Frame request = {3, 42, HC12_OP_SET_MODE, 1, {1}};
+  uint8_t wire[HC12_MAX_FRAME * 2 + 8];
+  uint8_t n = hc12EncodeFrame(request, wire);  // at most HC12_MAX_FRAME
+  check("encode size", n == HC12_FRAME_OVERHEAD + 1);
+
+  Hc12FrameDecoder decoder;
+  Hc12Frame out;
+  check("round trip", feed(decoder, wire, n, out) == 1 && out.unit == 3 && out.seq == 42 &&
+                          out.opcode == HC12_OP_SET_MODE && out.length == 1 && out.payload[0] == 1);
+
+  // Noise (including a stray preamble byte and the text "ACK") before the frame.
+  const uint8_t noise[] = {'A', 'C', 'K', 0xAA, 0x13, 0x00, 'x'};
+  uint8_t noisy[sizeof(noise) + HC12_MAX_FRAME];
+  memcpy(noisy, noise, sizeof(noise));
+  memcpy(noisy + sizeof(noise), wire, n);
+  check("noise then frame", feed(decoder, noisy, sizeof(noise) + n, out) == 1 && out.seq == 42);
+
+  // Corrupted copy followed by a good one: one CRC error, one frame.
+  uint8_t twice[HC12_MAX_FRAME * 2];
+  memcpy(twice, wire, n);
+  twice[5] ^= 0x01;
+  memcpy(twice + n, wire, n);
+  uint32_t crcErrorsBefore = decoder.crcErrors;
+  check("crc error then resync", feed(decoder, twice, 2 * n, out) == 1 && decoder.crcErrors == crcErrorsBefore + 1);
+
+  // A frame cut off in its header, then a good one: the decoder rescans
+  // from the bytes it had taken as the first frame's header and payload.
+  uint8_t truncated[HC12_MAX_FRAME * 2];
+  memcpy(truncated, wire, 4);
+  memcpy(truncated + 4, wire, n);
+  check("truncated header then frame", feed(decoder, truncated, 4 + n, out) == 1 && out.seq == 42);
+  // Two frames behind a cut-off header whose length byte claims a payload:
+  // both are decoded.
+  const uint8_t cut[] = {0xAA, 0x55, 3, 40, HC12_OP_PING, HC12_MAX_PAYLOAD};
+  memcpy(truncated, cut, sizeof(cut));
+  memcpy(truncated + sizeof(cut), wire, n);
+  memcpy(truncated + sizeof(cut) + n, wire, n);
+  check("cut-off frame then two frames", feed(decoder, truncated, sizeof(cut) + 2 * n, out) == 2 && out.seq == 42);
+
+  // Reply matching: same unit/seq/opcode only.
+  Hc12Frame reply = hc12MakeReply(request, 3, HC12_STATUS_OK);
+  Hc12Frame otherUnit = hc12MakeReply(request, 4, HC12_STATUS_OK);
+  Hc12Frame staleReply = reply;
+  staleReply.seq = 41;
+  check("reply matches", hc12IsReplyTo(reply, request));
+  check("other unit rejected", !hc12IsReplyTo(otherUnit, request));
+  check("stale seq rejected", !hc12IsReplyTo(staleReply, request));
+  check("request is not a reply", !hc12IsReplyTo(request, request));
+
+  // Broadcast: target mask round trip and reply slots by rank.
+  const uint8_t mode = 1;
+  Hc12Frame broadcast;
+  uint32_t targets = 0;
+  check("broadcast encode", hc12MakeBroadcast(7, HC12_OP_SET_MODE, 0x80000015UL, &mode, 1, broadcast));
+  n = hc12EncodeFrame(broadcast, wire);
+  check("broadcast targets", feed(decoder, wire, n, out) == 1 && hc12BroadcastTargets(out, targets) &&
+                                 targets == 0x80000015UL && out.payload[HC12_TARGETS_SIZE] == 1);
+  check("reply slots", hc12ReplySlot(targets, 1) == 0 && hc12ReplySlot(targets, 3) == 1 &&
+                           hc12ReplySlot(targets, 5) == 2 && hc12ReplySlot(targets, 32) == 3 &&
+                           hc12ReplySlot(targets, 2) == -1);
+  check("broadcast reply from any unit", hc12IsReplyTo(hc12MakeReply(broadcast, 5, HC12_STATUS_OK), broadcast));
+
+  // Schedule: 8 events in two chunks, reassembled in order.
+  Hc12ScheduleEvent events[8];
+  for (uint8_t i = 0; i < 8; i++) events[i] = hc12MakeScheduleEvent(i / 2, 6 + i, 30, i % 2 == 0);
+  Hc12ScheduleAssembler<16> assembler;
+  uint8_t chunk[HC12_MAX_PAYLOAD];
+  uint8_t chunks = hc12ScheduleChunkCount(8);
+  bool assembled = chunks == 2;
+  for (uint8_t c = 0; c < chunks; c++) {
+    uint8_t length = hc12EncodeScheduleChunk(0x1234, events, 8, c, chunk);
+    assembled = assembled && length <= HC12_MAX_PAYLOAD && assembler.push(chunk, length) == HC12_STATUS_OK;
+  }
+  check("schedule chunks", assembled && assembler.valid && assembler.count == 8 && assembler.version == 0x1234 &&
+                               assembler.events[7] == events[7]);
+  uint8_t length = hc12EncodeScheduleChunk(0x1235, events, 8, 1, chunk);
+  check("schedule chunk out of order", assembler.push(chunk, length) == HC12_STATUS_BAD_PAYLOAD &&
+                                           assembler.version == 0x1234);
+
+  // 2024-01-07 00:00 was a Sunday; Saturday 23:59 wraps to the week's end.
+  bool on = false;
+  check("minute of week", hc12MinuteOfWeek(1704585600UL) == 0 && hc12MinuteOfWeek(1704585600UL + 86400UL + 90) == 1441);
+  check("schedule state", hc12ScheduleStateAt(events, 8, hc12EventMinute(events[1]), on) && !on &&
+                              hc12ScheduleStateAt(events, 8, 0, on) && on == hc12EventState(events[7]));
+
+  Hc12Beacon beacon = {1704585600UL, 2, true};
+  Hc12Beacon decoded;
+  length = hc12EncodeBeacon(beacon, chunk);
+  check("beacon", hc12DecodeBeacon(chunk, length, decoded) && decoded.localTime == beacon.localTime &&
+                      decoded.relayMode == 2 && decoded.shabbat);
+
+  // A remote whose millis() runs 1000 ppm fast, beacons every minute for
+  // half an hour, then an hour without beacons.
+  Hc12RemoteClock clock;
+  for (uint32_t minute = 0; minute <= 30; minute++) clock.onBeacon(1704585600UL + minute * 60, minute * 60060UL);
+  uint32_t later = clock.now(30 * 60060UL + 3600UL * 1001UL);
+  check("remote clock drift", clock.driftPpm() > 900 && clock.driftPpm() < 1100 &&
+                                  later >= 1704585600UL + 1800 + 3599 && later <= 1704585600UL + 1800 + 3601);
+
+  // A header claiming a payload larger than the maximum is dropped.
+  const uint8_t oversized[] = {0xAA, 0x55, 3, 1, HC12_OP_PING, HC12_MAX_PAYLOAD + 1};
+  uint32_t framingBefore = decoder.framingErrors;
+  check("oversized length", feed(decoder, oversized, sizeof(oversized), out) == 0 &&
+                                decoder.framingErrors == framingBefore + 1);
+
+  Serial.println(failures == 0 ? "Loopback OK" : "Loopback FAILED");
+}
+
+void loop() {}
@@ -0,0 +1,136 @@
+#include "hc12_frame.h"
+
+#include <string.h>
+
+uint16_t hc12Crc16(const uint8_t* data, size_t length, uint16_t crc) {
+  for (size_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+size_t hc12EncodeFrame(const Hc12Frame& frame, uint8_t* out) {
+  if (frame.length > HC12_MAX_PAYLOAD) return 0;
+  size_t n = 0;
+  out[n++] = HC12_PREAMBLE_0;
+  out[n++] = HC12_PREAMBLE_1;
+  out[n++] = frame.unit;
+  out[n++] = frame.seq;
+  out[n++] = frame.opcode;
+  out[n++] = frame.length;
+  memcpy(out + n, frame.payload, frame.length);
+  n += frame.length;
+  uint16_t crc = hc12Crc16(out + 2, n - 2);
+  out[n++] = (uint8_t)(crc >> 8);
+  out[n++] = (uint8_t)crc;
+  return n;
+}
+
+Hc12Frame hc12MakeReply(const Hc12Frame& request, uint8_t unit, Hc12Status status,
+                        const uint8_t* extra, uint8_t extraLength) {
+  Hc12Frame reply;
+  reply.unit = unit;
+  reply.seq = request.seq;
+  reply.opcode = request.opcode | HC12_OP_REPLY;
+  if (extraLength > HC12_MAX_PAYLOAD - 1) extraLength = HC12_MAX_PAYLOAD - 1;
+  reply.length = 1 + extraLength;
+  reply.payload[0] = status;
+  if (extraLength > 0) memcpy(reply.payload + 1, extra, extraLength);
+  return reply;
+}
+
+bool hc12IsReplyTo(const Hc12Frame& reply, const Hc12Frame& request) {
+  if ((reply.opcode & HC12_OP_REPLY) == 0) return false;
+  if ((uint8_t)(reply.opcode & ~HC12_OP_REPLY) != request.opcode) return false;
+  if (reply.seq != request.seq || reply.length < 1) return false;
+  return request.unit == HC12_UNIT_BROADCAST || reply.unit == request.unit;
+}
+
+// ---------------------- Broadcast ----------------------
+
+bool hc12MakeBroadcast(uint8_t seq, uint8_t opcode, uint32_t targets, const uint8_t* payload,
+                       uint8_t length, Hc12Frame& out) {
+  if (length > HC12_MAX_PAYLOAD - HC12_TARGETS_SIZE) return false;
+  out.unit = HC12_UNIT_BROADCAST;
+  out.seq = seq;
+  out.opcode = opcode;
+  out.length = HC12_TARGETS_SIZE + length;
+  for (uint8_t i = 0; i < HC12_TARGETS_SIZE; i++) {
+    out.payload[i] = (uint8_t)(targets >> (8 * (HC12_TARGETS_SIZE - 1 - i)));
+  }
+  if (length > 0) memcpy(out.payload + HC12_TARGETS_SIZE, payload, length);
+  return true;
+}
+
+bool hc12BroadcastTargets(const Hc12Frame& frame, uint32_t& targets) {
+  if (frame.unit != HC12_UNIT_BROADCAST || frame.length < HC12_TARGETS_SIZE) return false;
+  targets = 0;
+  for (uint8_t i = 0; i < HC12_TARGETS_SIZE; i++) targets = (targets << 8) | frame.payload[i];
+  return true;
+}
+
+int8_t hc12ReplySlot(uint32_t targets, uint8_t unit) {
+  if (unit < 1 || unit > HC12_MAX_BROADCAST_UNIT) return -1;
+  uint32_t bit = 1UL << (unit - 1);
+  if ((targets & bit) == 0) return -1;
+  int8_t slot = 0;
+  for (uint32_t lower = targets & (bit - 1); lower != 0; lower &= lower - 1) slot++;
+  return slot;
+}
+
+// ---------------------- Decoder ----------------------
+
+void Hc12FrameDecoder::reset() {
+  length = 0;
+}
+
+void Hc12FrameDecoder::drop(uint8_t count) {
+  length -= count;
+  memmove(buffer, buffer + count, length);
+}
+
+bool Hc12FrameDecoder::push(uint8_t byte, Hc12Frame& out) {
+  // A full buffer always holds a complete candidate, so this never drops
+  // anything unchecked; it only keeps the write in bounds.
+  if (length == sizeof(buffer)) drop(1);
+  buffer[length++] = byte;
+  return next(out);
+}
+
+bool Hc12FrameDecoder::next(Hc12Frame& out) {
+  for (;;) {
+    // Skip to the next preamble (or a trailing first preamble byte).
+    uint8_t start = 0;
+    while (start < length && !(buffer[start] == HC12_PREAMBLE_0 &&
+                               (start + 1 == length || buffer[start + 1] == HC12_PREAMBLE_1))) {
+      start++;
+    }
+    drop(start);
+    if (length < HC12_FRAME_OVERHEAD - 2) return false;  // header incomplete
+
+    uint8_t payloadLength = buffer[5];
+    if (payloadLength > HC12_MAX_PAYLOAD) {
+      framingErrors++;
+      drop(1);  // rescan after this preamble
+      continue;
+    }
+    uint8_t frameSize = HC12_FRAME_OVERHEAD + payloadLength;
+    if (length < frameSize) return false;
+    uint16_t crc = (uint16_t)(buffer[frameSize - 2] << 8 | buffer[frameSize - 1]);
+    if (crc != hc12Crc16(buffer + 2, frameSize - 4)) {
+      crcErrors++;
+      drop(1);
+      continue;
+    }
+    out.unit = buffer[2];
+    out.seq = buffer[3];
+    out.opcode = buffer[4];
+    out.length = payloadLength;
+    memcpy(out.payload, buffer + 6, payloadLength);
+    drop(frameSize);
+    return true;
+  }
+}
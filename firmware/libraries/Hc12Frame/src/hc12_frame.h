@@ -0,0 +1,110 @@
+#ifndef HC12_FRAME_H
+#define HC12_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------- HC-12 Frame Protocol ----------------------
+// Shared by the main clock (firmware/Smart_Shabbat_Clock) and the remote
+// units (firmware/Remote_Unit). Plain C++, no Arduino dependencies.
+//
+// Frame (all multi-byte fields big-endian):
+//   0xAA 0x55 | unit | seq | opcode | len | payload[len] | crc16
+// unit:   remote unit address; requests carry the target, replies the
+//         sender. HC12_UNIT_BROADCAST addresses every unit.
+// seq:    chosen by the main unit per request, echoed in the reply.
+// opcode: request opcode, or (request | HC12_OP_REPLY) for the reply, whose
+//         payload[0] is an Hc12Status.
+// crc16:  CRC-16/CCITT-FALSE over unit..payload.
+// A reply matches a request only with the same unit, seq and opcode.
+//
+// Broadcast (unit == HC12_UNIT_BROADCAST): the payload starts with a 4-byte
+// target mask (bit n-1 = unit n, units 1..32), then the opcode's payload.
+// Each targeted unit replies in its own slot, so replies don't collide:
+// slot = rank among the targeted units (0 for the lowest address), starting
+// slot * HC12_REPLY_SLOT_MS after the request has been received. Retries
+// target only the units that have not replied, so the window shrinks.
+
+static const uint8_t HC12_PREAMBLE_0 = 0xAA;
+static const uint8_t HC12_PREAMBLE_1 = 0x55;
+static const uint8_t HC12_UNIT_BROADCAST = 0xFF;
+// CHANGE HERE: largest payload (bytes); both ends must agree.
+static const uint8_t HC12_MAX_PAYLOAD = 16;
+static const uint8_t HC12_FRAME_OVERHEAD = 8;  // preamble + header + crc
+static const uint8_t HC12_MAX_FRAME = HC12_FRAME_OVERHEAD + HC12_MAX_PAYLOAD;
+static const uint8_t HC12_MAX_BROADCAST_UNIT = 32;
+static const uint8_t HC12_TARGETS_SIZE = 4;
+// CHANGE HERE: reply slot length (ms): a reply's airtime (~10 ms at 9600
+// baud) plus HC-12 latency jitter. Both ends must agree.
+static const uint16_t HC12_REPLY_SLOT_MS = 30;
+
+enum Hc12Opcode : uint8_t {
+  HC12_OP_PING = 0x01,      // no payload
+  HC12_OP_SET_MODE = 0x02,  // payload[0]: 0 = week, 1 = shabbat
+  HC12_OP_TIME_BEACON = 0x03,   // broadcast, never answered; see hc12_schedule.h
+  HC12_OP_SET_SCHEDULE = 0x04,  // one chunk of the unit's schedule; see hc12_schedule.h
+  HC12_OP_REPLY = 0x80      // or-ed into the opcode of a reply
+};
+
+enum Hc12Status : uint8_t {
+  HC12_STATUS_OK = 0,
+  HC12_STATUS_BAD_PAYLOAD = 1,
+  HC12_STATUS_UNSUPPORTED = 2
+};
+
+struct Hc12Frame {
+  uint8_t unit;
+  uint8_t seq;
+  uint8_t opcode;
+  uint8_t length;
+  uint8_t payload[HC12_MAX_PAYLOAD];
+};
+
+uint16_t hc12Crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+
+// Encode frame into out (at least HC12_MAX_FRAME bytes). Returns the frame
+// size, or 0 if the payload is too long.
+size_t hc12EncodeFrame(const Hc12Frame& frame, uint8_t* out);
+
+// Reply to request with a one-byte status (plus optional extra payload).
+Hc12Frame hc12MakeReply(const Hc12Frame& request, uint8_t unit, Hc12Status status,
+                        const uint8_t* extra = nullptr, uint8_t extraLength = 0);
+// Broadcast request to the units in targets. False if the payload doesn't
+// fit next to the target mask.
+bool hc12MakeBroadcast(uint8_t seq, uint8_t opcode, uint32_t targets, const uint8_t* payload,
+                       uint8_t length, Hc12Frame& out);
+// Target mask of a broadcast frame; false if frame isn't a valid broadcast.
+// The opcode's own payload starts at payload[HC12_TARGETS_SIZE].
+bool hc12BroadcastTargets(const Hc12Frame& frame, uint32_t& targets);
+// Reply slot of unit within targets, or -1 if it isn't targeted.
+int8_t hc12ReplySlot(uint32_t targets, uint8_t unit);
+
+// True if reply answers request (unit, seq and opcode all match). A reply to
+// a broadcast request matches from any unit.
+bool hc12IsReplyTo(const Hc12Frame& reply, const Hc12Frame& request);
+
+// Streaming decoder: feed received bytes one at a time. The bytes of a
+// candidate frame are kept until it checks out; after a framing or CRC
+// error the decoder rescans them from the byte after the failed preamble,
+// so a valid frame that started inside a truncated or corrupted one is
+// still found.
+class Hc12FrameDecoder {
+ public:
+  // True when byte completes a valid frame, which is copied to out. A
+  // rescan can find more than one: after true, call next() until false.
+  bool push(uint8_t byte, Hc12Frame& out);
+  // Next valid frame among the bytes already pushed.
+  bool next(Hc12Frame& out);
+  void reset();
+
+  uint32_t crcErrors = 0;
+  uint32_t framingErrors = 0;
+
+ private:
+  void drop(uint8_t count);
+
+  uint8_t buffer[HC12_MAX_FRAME];  // candidate frame, from its preamble on
+  uint8_t length = 0;
+};
+
+#endif // HC12_FRAME_H
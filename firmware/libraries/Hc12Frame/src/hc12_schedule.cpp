@@ -0,0 +1,95 @@
+#include "hc12_schedule.h"
+
+// ---------------------- Schedule ----------------------
+
+uint16_t hc12MinuteOfWeek(uint32_t localTime) {
+  uint32_t days = localTime / 86400UL;
+  uint16_t weekday = (uint16_t)((days + 4) % 7);  // 0 = Sunday
+  return weekday * 1440U + (uint16_t)((localTime % 86400UL) / 60);
+}
+
+bool hc12ScheduleStateAt(const Hc12ScheduleEvent* events, uint8_t count, uint16_t minuteOfWeek, bool& state) {
+  if (count == 0) return false;
+  uint8_t last = count - 1;  // wraps to last week's final event
+  for (uint8_t i = 0; i < count; i++) {
+    if (hc12EventMinute(events[i]) <= minuteOfWeek) last = i;
+  }
+  state = hc12EventState(events[last]);
+  return true;
+}
+
+uint8_t hc12ScheduleChunkCount(uint8_t eventCount) {
+  if (eventCount == 0) return 1;
+  return (eventCount + HC12_SCHEDULE_CHUNK_EVENTS - 1) / HC12_SCHEDULE_CHUNK_EVENTS;
+}
+
+uint8_t hc12EncodeScheduleChunk(uint16_t version, const Hc12ScheduleEvent* events, uint8_t eventCount,
+                                uint8_t chunk, uint8_t* payload) {
+  uint8_t chunks = hc12ScheduleChunkCount(eventCount);
+  uint8_t first = chunk * HC12_SCHEDULE_CHUNK_EVENTS;
+  uint8_t n = 0;
+  if (first < eventCount) n = eventCount - first;
+  if (n > HC12_SCHEDULE_CHUNK_EVENTS) n = HC12_SCHEDULE_CHUNK_EVENTS;
+  payload[0] = (uint8_t)(version >> 8);
+  payload[1] = (uint8_t)version;
+  payload[2] = (uint8_t)(chunk << 4 | chunks);
+  for (uint8_t i = 0; i < n; i++) {
+    payload[HC12_SCHEDULE_HEADER_SIZE + 2 * i] = (uint8_t)(events[first + i] >> 8);
+    payload[HC12_SCHEDULE_HEADER_SIZE + 2 * i + 1] = (uint8_t)events[first + i];
+  }
+  return HC12_SCHEDULE_HEADER_SIZE + 2 * n;
+}
+
+// ---------------------- Time Beacon ----------------------
+
+uint8_t hc12EncodeBeacon(const Hc12Beacon& beacon, uint8_t* payload) {
+  for (uint8_t i = 0; i < 4; i++) payload[i] = (uint8_t)(beacon.localTime >> (8 * (3 - i)));
+  payload[4] = (uint8_t)((beacon.relayMode & 0x03) | (beacon.shabbat ? 0x04 : 0));
+  return HC12_BEACON_SIZE;
+}
+
+bool hc12DecodeBeacon(const uint8_t* payload, uint8_t length, Hc12Beacon& out) {
+  if (length != HC12_BEACON_SIZE || (payload[4] & 0x03) > 2) return false;
+  out.localTime = 0;
+  for (uint8_t i = 0; i < 4; i++) out.localTime = (out.localTime << 8) | payload[i];
+  out.relayMode = payload[4] & 0x03;
+  out.shabbat = (payload[4] & 0x04) != 0;
+  return true;
+}
+
+// ---------------------- Remote Clock ----------------------
+
+void Hc12RemoteClock::onBeacon(uint32_t localTime, uint32_t nowMs) {
+  if (haveTime) {
+    int32_t step = (int32_t)(localTime - now(nowMs));
+    if (step > MAX_STEP_S || step < -MAX_STEP_S) {
+      haveTime = false;
+      drift = 0;
+      driftBaselineMs = 0;
+    }
+  }
+  if (!haveTime || nowMs - anchorMs >= MAX_DRIFT_BASELINE_MS) {
+    anchorTime = localTime;
+    anchorMs = nowMs;
+    haveTime = true;
+  } else if (nowMs - anchorMs >= MIN_DRIFT_BASELINE_MS &&
+             (nowMs - anchorMs >= driftBaselineMs || nowMs - anchorMs >= REFRESH_DRIFT_BASELINE_MS)) {
+    // Local ms counted vs. true ms over the baseline; whole-second beacons
+    // make this good to about 1e6 / baseline_s ppm.
+    int64_t trueMs = (int64_t)(localTime - anchorTime) * 1000;
+    int64_t localMs = (int64_t)(uint32_t)(nowMs - anchorMs);
+    if (trueMs > 0) {
+      drift = (int32_t)((localMs - trueMs) * 1000000 / trueMs);
+      driftBaselineMs = nowMs - anchorMs;
+    }
+  }
+  lastTime = localTime;
+  lastMs = nowMs;
+}
+
+uint32_t Hc12RemoteClock::now(uint32_t nowMs) const {
+  int64_t elapsedMs = (uint32_t)(nowMs - lastMs);
+  // A fast oscillator (positive drift) counts too many ms.
+  elapsedMs -= elapsedMs * drift / 1000000;
+  return lastTime + (uint32_t)(elapsedMs / 1000);
+}
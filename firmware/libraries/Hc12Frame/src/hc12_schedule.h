@@ -0,0 +1,151 @@
+#ifndef HC12_SCHEDULE_H
+#define HC12_SCHEDULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hc12_frame.h"
+
+// ---------------------- Remote Schedule Payloads ----------------------
+// Lets a remote unit switch on its own: the main clock pushes the schedule
+// once (HC12_OP_SET_SCHEDULE) and broadcasts its time periodically
+// (HC12_OP_TIME_BEACON); the remote keeps time from its own millis() between
+// beacons. Plain C++, shared by the clock and the remote units.
+//
+// Event (2 bytes, big-endian): minute of week << 1 | state, where minute of
+// week counts from Sunday 00:00 (0..10079) and state 1 = ON.
+//
+// SET_SCHEDULE payload: version (2) | chunk index << 4 | chunk count (1) |
+// up to HC12_SCHEDULE_CHUNK_EVENTS events. Chunks go in order; the remote
+// switches to the new table when the last one arrives. An empty schedule is
+// one chunk with no events.
+//
+// TIME_BEACON payload (after the broadcast target mask): local unixtime (4) |
+// flags (1): bits 0-1 relay mode (0 off, 1 on, 2 auto), bit 2 Shabbat mode.
+//
+// PING reply payload from a remote: status (1) | Shabbat mode (1) |
+// schedule valid (1) | schedule version (2), so the clock can re-push a
+// table the remote lost (e.g. to a power cut).
+
+typedef uint16_t Hc12ScheduleEvent;
+
+static const uint16_t HC12_WEEK_MINUTES = 7 * 24 * 60;
+static const uint8_t HC12_SCHEDULE_CHUNK_EVENTS = 6;
+static const uint8_t HC12_SCHEDULE_HEADER_SIZE = 3;
+static const uint8_t HC12_SCHEDULE_MAX_CHUNKS = 15;
+static const uint8_t HC12_BEACON_SIZE = 5;
+static const uint8_t HC12_PING_REPLY_SIZE = 5;
+
+inline Hc12ScheduleEvent hc12MakeScheduleEvent(uint8_t day, uint8_t hour, uint8_t minute, bool state) {
+  return (Hc12ScheduleEvent)(((day * 1440U + hour * 60U + minute) << 1) | (state ? 1 : 0));
+}
+inline uint16_t hc12EventMinute(Hc12ScheduleEvent event) { return event >> 1; }
+inline bool hc12EventState(Hc12ScheduleEvent event) { return (event & 1) != 0; }
+
+// Minute of week of a local unixtime (1970-01-01 was a Thursday).
+uint16_t hc12MinuteOfWeek(uint32_t localTime);
+
+// State at minuteOfWeek for events sorted by minute: the last event at or
+// before it, wrapping to last week's final event. False if count is 0.
+bool hc12ScheduleStateAt(const Hc12ScheduleEvent* events, uint8_t count, uint16_t minuteOfWeek, bool& state);
+
+uint8_t hc12ScheduleChunkCount(uint8_t eventCount);
+// Payload of chunk (0-based) of events; returns its length.
+uint8_t hc12EncodeScheduleChunk(uint16_t version, const Hc12ScheduleEvent* events, uint8_t eventCount,
+                                uint8_t chunk, uint8_t* payload);
+
+struct Hc12Beacon {
+  uint32_t localTime;
+  uint8_t relayMode;
+  bool shabbat;
+};
+
+uint8_t hc12EncodeBeacon(const Hc12Beacon& beacon, uint8_t* payload);
+bool hc12DecodeBeacon(const uint8_t* payload, uint8_t length, Hc12Beacon& out);
+
+// Remote side: collects SET_SCHEDULE chunks into a staging table and
+// publishes it as events/count once complete.
+template <uint8_t CAPACITY>
+class Hc12ScheduleAssembler {
+ public:
+  // Returns the Hc12Status to reply with.
+  uint8_t push(const uint8_t* payload, uint8_t length);
+
+  Hc12ScheduleEvent events[CAPACITY];
+  uint8_t count = 0;
+  uint16_t version = 0;
+  bool valid = false;
+
+ private:
+  Hc12ScheduleEvent staging[CAPACITY];
+  uint8_t stagingCount = 0;
+  uint16_t stagingVersion = 0;
+  uint8_t nextChunk = 0;
+};
+
+// Remote side: local time from the last beacon plus elapsed millis(),
+// corrected by the oscillator drift measured over a long baseline of
+// beacons. The baseline restarts when the clock's time jumps, and weekly
+// (millis() wraps after 49 days), keeping the last estimate until the new
+// baseline is a day long.
+class Hc12RemoteClock {
+ public:
+  // CHANGE HERE: a beacon this far (s) from the local estimate is a time
+  // change on the clock (DST, manual set), not drift.
+  static const int32_t MAX_STEP_S = 120;
+  // Baseline (ms) before the first drift estimate, before a restarted
+  // baseline may replace a longer one's estimate, and before it restarts.
+  static const uint32_t MIN_DRIFT_BASELINE_MS = 600000UL;
+  static const uint32_t REFRESH_DRIFT_BASELINE_MS = 86400000UL;
+  static const uint32_t MAX_DRIFT_BASELINE_MS = 7 * 86400000UL;
+
+  void onBeacon(uint32_t localTime, uint32_t nowMs);
+  bool valid() const { return haveTime; }
+  uint32_t now(uint32_t nowMs) const;
+  int32_t driftPpm() const { return drift; }
+
+ private:
+  bool haveTime = false;
+  uint32_t anchorTime = 0;   // first beacon of the baseline
+  uint32_t anchorMs = 0;
+  uint32_t lastTime = 0;     // latest beacon
+  uint32_t lastMs = 0;
+  int32_t drift = 0;         // local oscillator error, ppm (positive = fast)
+  uint32_t driftBaselineMs = 0;  // baseline of the estimate, 0 = none
+};
+
+template <uint8_t CAPACITY>
+uint8_t Hc12ScheduleAssembler<CAPACITY>::push(const uint8_t* payload, uint8_t length) {
+  if (length < HC12_SCHEDULE_HEADER_SIZE || (length - HC12_SCHEDULE_HEADER_SIZE) % 2 != 0) {
+    return HC12_STATUS_BAD_PAYLOAD;
+  }
+  uint16_t chunkVersion = (uint16_t)(payload[0] << 8 | payload[1]);
+  uint8_t index = payload[2] >> 4;
+  uint8_t chunks = payload[2] & 0x0F;
+  uint8_t n = (length - HC12_SCHEDULE_HEADER_SIZE) / 2;
+  if (chunks == 0 || index >= chunks) return HC12_STATUS_BAD_PAYLOAD;
+  if (index == 0) {
+    stagingVersion = chunkVersion;
+    stagingCount = 0;
+    nextChunk = 0;
+  }
+  // Out of order or from another version: the clock restarts at chunk 0.
+  if (chunkVersion != stagingVersion || index != nextChunk) return HC12_STATUS_BAD_PAYLOAD;
+  if (stagingCount + n > CAPACITY) return HC12_STATUS_BAD_PAYLOAD;
+  for (uint8_t i = 0; i < n; i++) {
+    const uint8_t* e = payload + HC12_SCHEDULE_HEADER_SIZE + 2 * i;
+    Hc12ScheduleEvent event = (Hc12ScheduleEvent)(e[0] << 8 | e[1]);
+    if (hc12EventMinute(event) >= HC12_WEEK_MINUTES) return HC12_STATUS_BAD_PAYLOAD;
+    staging[stagingCount++] = event;
+  }
+  nextChunk++;
+  if (nextChunk == chunks) {
+    for (uint8_t i = 0; i < stagingCount; i++) events[i] = staging[i];
+    count = stagingCount;
+    version = stagingVersion;
+    valid = true;
+    nextChunk = 0;
+  }
+  return HC12_STATUS_OK;
+}
+
+#endif // HC12_SCHEDULE_H
@@ -0,0 +1,61 @@
+// Generates firmware/Smart_Shabbat_Clock/index_page.h from ui/index.html.
+//
+// The page is gzip-compressed into a PROGMEM byte array that the web server
+// streams straight from flash, together with a content-hash ETag used for
+// If-None-Match revalidation.
+//
+// Usage (run after every edit of ui/index.html):
+//   node tools/build-index-page.mjs
+
+import fs from 'node:fs';
+import path from 'node:path';
+import crypto from 'node:crypto';
+import zlib from 'node:zlib';
+import { fileURLToPath } from 'node:url';
+
+const sketchDir = path.resolve(path.dirname(fileURLToPath(import.meta.url)), '../firmware/Smart_Shabbat_Clock');
+const sourcePath = path.join(sketchDir, 'ui/index.html');
+const outputPath = path.join(sketchDir, 'index_page.h');
+const BYTES_PER_LINE = 16;
+
+function toCArray(buffer) {
+  const lines = [];
+  for (let i = 0; i < buffer.length; i += BYTES_PER_LINE) {
+    const chunk = [...buffer.subarray(i, i + BYTES_PER_LINE)].map((b) => `0x${b.toString(16).padStart(2, '0')}`);
+    lines.push(`  ${chunk.join(', ')},`);
+  }
+  return lines.join('\n');
+}
+
+function main() {
+  const html = fs.readFileSync(sourcePath);
+  // mtime is zeroed so the output only changes when the page does.
+  const gz = zlib.gzipSync(html, { level: zlib.constants.Z_BEST_COMPRESSION });
+  gz.writeUInt32LE(0, 4);
+  const etag = crypto.createHash('sha256').update(html).digest('hex').slice(0, 16);
+
+  const header = `// ---------------------- index_page.h ----------------------
+// GENERATED by tools/build-index-page.mjs from ui/index.html - do not edit.
+// CHANGE HERE: edit ui/index.html, then run: node tools/build-index-page.mjs
+#ifndef INDEX_PAGE_H
+#define INDEX_PAGE_H
+
+#include <pgmspace.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Uncompressed size: ${html.length} bytes.
+static const size_t index_html_gz_len = ${gz.length};
+static const char index_html_etag[] = "\\"${etag}\\"";
+static const uint8_t index_html_gz[] PROGMEM = {
+${toCArray(gz)}
+};
+
+#endif // INDEX_PAGE_H
+`;
+
+  fs.writeFileSync(outputPath, header);
+  console.log(`index.html: ${html.length} bytes -> ${gz.length} bytes gzip (${((gz.length / html.length) * 100).toFixed(1)}%), ETag ${etag}`);
+}
+
+main();
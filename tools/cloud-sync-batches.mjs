@@ -0,0 +1,153 @@
+// Command batch scenarios for cloud_sync.cpp against the local RTDB stand-in.
+//
+// Starts tools/rtdb-standin.mjs in-process and a host build of the cloud
+// sync against it, queues each scenario's commands at once so the device
+// fetches them in one poll, waits for their ACKs and checks the ACKs and the
+// schedule the device publishes. Exits non-zero if any check fails.
+//
+// Usage:
+//   node tools/cloud-sync-batches.mjs --device "<command>"
+//
+// The device is tools/host-tests/cloud-sync-device (make cloud-sync-batches
+// there).
+
+import { spawn } from 'node:child_process';
+import { createStandin } from './rtdb-standin.mjs';
+
+const ACK_LIMIT_MS = 60000;
+
+let failures = 0;
+
+function check(name, ok) {
+  console.log(`${ok ? 'PASS' : 'FAIL'} ${name}`);
+  if (!ok) failures++;
+}
+
+function parseArgs(argv) {
+  const options = { device: null };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg === '--device' && i + 1 < argv.length) options.device = argv[++i];
+    else throw new Error(`Unknown argument ${arg}`);
+  }
+  if (!options.device) throw new Error('usage: cloud-sync-batches.mjs --device "<command>"');
+  return options;
+}
+
+function sleep(ms) {
+  return new Promise((resolve) => setTimeout(resolve, ms));
+}
+
+function startDevice(commandLine, url) {
+  const [command, ...args] = commandLine.split(' ').filter(Boolean);
+  const device = spawn(command, [...args, '--url', url], { stdio: ['ignore', 'inherit', 'inherit'] });
+  device.on('exit', (code, signal) => {
+    if (device.stopping) return;
+    console.error(`Device exited early (${signal || code})`);
+    process.exit(1);
+  });
+  return device;
+}
+
+function stopDevice(device) {
+  device.stopping = true;
+  return new Promise((resolve) => {
+    device.once('exit', resolve);
+    device.kill('SIGTERM');
+  });
+}
+
+async function waitFor(read, limitMs) {
+  const limit = Date.now() + limitMs;
+  for (;;) {
+    const value = read();
+    if (value || Date.now() >= limit) return value;
+    await sleep(200);
+  }
+}
+
+function schedule(standin, deviceId) {
+  const node = standin.readNode(['devices', deviceId, 'state', 'schedule']) || {};
+  const events = node.events ? Object.values(node.events).filter(Boolean) : [];
+  return { revision: Number(node.revision || 0), events };
+}
+
+function scheduleCommand(baseScheduleRevision, hour) {
+  return {
+    type: 'replace_schedule',
+    payload: { baseScheduleRevision, events: [{ day: 0, hour, minute: 0, state: 'on' }] },
+  };
+}
+
+// Queues the commands in one go and returns their ACKs in order, null for
+// any missing after ACK_LIMIT_MS.
+async function runBatch(standin, deviceId, commands) {
+  const ids = commands.map(({ type, payload }) => standin.queueCommand(type, payload)[0].commandId);
+  const ackOf = (id) => standin.readNode(['devices', deviceId, 'acks', id]);
+  await waitFor(() => ids.every(ackOf), ACK_LIMIT_MS);
+  return ids.map(ackOf);
+}
+
+// The schedule as published once it reaches the revision.
+async function scheduleAt(standin, deviceId, revision) {
+  await waitFor(() => schedule(standin, deviceId).revision >= revision, ACK_LIMIT_MS);
+  return schedule(standin, deviceId);
+}
+
+// replace_schedule, shabbat_mode, replace_schedule chained on the first:
+// the Shabbat mode command ends the device's pass, so the second schedule
+// is fetched again after it and must still apply.
+async function splitBatch(standin, deviceId) {
+  const base = schedule(standin, deviceId).revision;
+  const acks = await runBatch(standin, deviceId, [
+    scheduleCommand(base, 7),
+    { type: 'shabbat_mode', payload: { mode: 'shabbat' } },
+    scheduleCommand(base + 1, 9),
+  ]);
+  check('split batch: every command acked', acks.every(Boolean));
+  check('split batch: first schedule applied', acks[0]?.ok === true && acks[0]?.code === 'applied');
+  check('split batch: shabbat mode applied', acks[1]?.ok === true);
+  check('split batch: second schedule applied after the split', acks[2]?.ok === true && acks[2]?.code === 'applied');
+  const published = await scheduleAt(standin, deviceId, base + 2);
+  check('split batch: schedule at the second revision',
+        published.revision === base + 2 && published.events.length === 1 && published.events[0].hour === 9);
+}
+
+// Two chained replace_schedule commands in one pass: only the second runs,
+// and the first is acked with its outcome after it.
+async function coalescedBatch(standin, deviceId) {
+  const base = schedule(standin, deviceId).revision;
+  const acks = await runBatch(standin, deviceId, [scheduleCommand(base, 10), scheduleCommand(base + 1, 11)]);
+  check('coalesced batch: every command acked', acks.every(Boolean));
+  check('coalesced batch: second schedule applied', acks[1]?.ok === true && acks[1]?.code === 'applied');
+  check('coalesced batch: first acked as superseded by the second',
+        acks[0]?.ok === true && acks[0]?.code === 'superseded' && acks[0]?.message === `superseded by seq ${acks[1]?.seq}`);
+  check('coalesced batch: first acked after the second', acks[0]?.ackedAt >= acks[1]?.ackedAt);
+  const published = await scheduleAt(standin, deviceId, base + 1);
+  check('coalesced batch: schedule applied once',
+        published.revision === base + 1 && published.events.length === 1 && published.events[0].hour === 11);
+}
+
+async function main() {
+  const options = parseArgs(process.argv.slice(2));
+  const standin = createStandin();
+  const address = await standin.listen(0, '127.0.0.1');
+  const device = startDevice(options.device, `http://127.0.0.1:${address.port}`);
+
+  const deviceId = await waitFor(() => standin.devices().find((id) =>
+    standin.readNode(['devices', id, 'state', 'schedule'])), ACK_LIMIT_MS);
+  if (!deviceId) throw new Error('Device never published its schedule');
+
+  await splitBatch(standin, deviceId);
+  await coalescedBatch(standin, deviceId);
+
+  await stopDevice(device);
+  await standin.close();
+  console.log(failures === 0 ? 'Cloud sync batches OK' : 'Cloud sync batches FAILED');
+  process.exitCode = failures === 0 ? 0 : 1;
+}
+
+main().catch((err) => {
+  console.error(err.message);
+  process.exit(1);
+});
@@ -0,0 +1,172 @@
+// End-to-end cloud command pipeline benchmark against the local RTDB stand-in.
+//
+// Starts tools/rtdb-standin.mjs in-process, waits for the device to sign in
+// and publish its status, then queues a mix of commands at a fixed interval
+// and reports command-to-ACK latency, bytes per command and requests per hour
+// for the poll, status and schedule workload. After the last command it waits
+// up to a minute for the outstanding ACKs, and exits non-zero if any is missing.
+//
+// Usage:
+//   node tools/cloud-sync-bench.mjs [--port 9000] [--duration 900] [--interval 30]
+//                                   [--mix relay,shabbat,schedule] [--json out.json]
+//                                   [--device "<command>"]
+//
+// The device is either firmware with FIREBASE_DATABASE_URL / FIREBASE_AUTH_URL
+// pointed at this host (see firebase_config.example.h), or, with --device, a
+// host build the bench starts with --url <stand-in> and stops at the end:
+// tools/host-tests/cloud-sync-device (make cloud-sync-bench there).
+
+import fs from 'node:fs';
+import { spawn } from 'node:child_process';
+import { createStandin } from './rtdb-standin.mjs';
+
+const RELAY_MODES = ['on', 'off', 'auto'];
+const SHABBAT_MODES = ['shabbat', 'week'];
+const DRAIN_LIMIT_MS = 60000;
+
+function parseArgs(argv) {
+  const options = {
+    port: 9000,
+    host: '0.0.0.0',
+    durationS: 900,
+    intervalS: 30,
+    mix: ['relay', 'shabbat', 'schedule'],
+    json: null,
+    device: null,
+  };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    const next = () => {
+      if (i + 1 >= argv.length) throw new Error(`Missing value for ${arg}`);
+      return argv[++i];
+    };
+    if (arg === '--port') options.port = Number(next());
+    else if (arg === '--host') options.host = next();
+    else if (arg === '--duration') options.durationS = Number(next());
+    else if (arg === '--interval') options.intervalS = Number(next());
+    else if (arg === '--mix') options.mix = next().split(',').filter(Boolean);
+    else if (arg === '--json') options.json = next();
+    else if (arg === '--device') options.device = next();
+    else throw new Error(`Unknown argument ${arg}`);
+  }
+  return options;
+}
+
+function sleep(ms) {
+  return new Promise((resolve) => setTimeout(resolve, ms));
+}
+
+async function waitForDevice(standin) {
+  console.log('Waiting for a device to publish its status...');
+  for (;;) {
+    const deviceId = standin.devices().find((id) => standin.readNode(['devices', id, 'state', 'status']));
+    if (deviceId) return deviceId;
+    await sleep(500);
+  }
+}
+
+// Start the host device against the stand-in; the bench fails if it exits
+// before stopDevice().
+function startDevice(commandLine, url) {
+  const [command, ...args] = commandLine.split(' ').filter(Boolean);
+  const device = spawn(command, [...args, '--url', url], { stdio: ['ignore', 'inherit', 'inherit'] });
+  device.on('exit', (code, signal) => {
+    if (device.stopping) return;
+    console.error(`Device exited early (${signal || code})`);
+    process.exit(1);
+  });
+  return device;
+}
+
+function stopDevice(device) {
+  if (!device) return Promise.resolve();
+  device.stopping = true;
+  return new Promise((resolve) => {
+    device.once('exit', resolve);
+    device.kill('SIGTERM');
+  });
+}
+
+async function drainAcks(standin) {
+  const limit = Date.now() + DRAIN_LIMIT_MS;
+  for (;;) {
+    const { queued, acked } = standin.summarize().commands;
+    if (acked >= queued || Date.now() >= limit) return queued - acked;
+    await sleep(500);
+  }
+}
+
+function normalizeEvents(events) {
+  if (!events) return [];
+  return (Array.isArray(events) ? events : Object.values(events)).filter(Boolean);
+}
+
+// Flip the state of the first published event (or add one) so the replace
+// produces a real schedule change on the device.
+function nextSchedulePayload(standin, deviceId) {
+  const schedule = standin.readNode(['devices', deviceId, 'state', 'schedule']) || {};
+  const events = normalizeEvents(schedule.events).map((e) => ({ ...e }));
+  if (events.length === 0) events.push({ day: 0, hour: 8, minute: 0, state: 'on' });
+  else events[0].state = events[0].state === 'on' ? 'off' : 'on';
+  return { baseScheduleRevision: Number(schedule.revision || 0), events };
+}
+
+function nextCommand(kind, index, standin, deviceId) {
+  if (kind === 'relay') return { type: 'relay_mode', payload: { mode: RELAY_MODES[index % RELAY_MODES.length] } };
+  if (kind === 'shabbat') return { type: 'shabbat_mode', payload: { mode: SHABBAT_MODES[index % SHABBAT_MODES.length] } };
+  if (kind === 'schedule') return { type: 'replace_schedule', payload: nextSchedulePayload(standin, deviceId) };
+  throw new Error(`Unknown command kind ${kind}`);
+}
+
+function printReport(report) {
+  console.log('');
+  console.log(`Run: ${report.elapsedS}s, ${report.commands.acked}/${report.commands.queued} commands acknowledged`);
+  console.log(`ACK latency ms: p50 ${report.commands.ackLatencyMs.p50}, p90 ${report.commands.ackLatencyMs.p90}, max ${report.commands.ackLatencyMs.max}`);
+  console.log(`Bytes per command: ${report.commands.bytesPerCommand}`);
+  console.log(`Total bytes per hour: ${report.bytesPerHour}`);
+  console.log('');
+  console.log('category   requests/h  failures  bytes in  bytes out');
+  for (const [name, c] of Object.entries(report.categories)) {
+    if (c.requests === 0) continue;
+    console.log(`${name.padEnd(10)} ${String(c.perHour).padStart(10)}  ${String(c.failures).padStart(8)}  ${String(c.bytesIn).padStart(8)}  ${String(c.bytesOut).padStart(9)}`);
+  }
+}
+
+async function main() {
+  const options = parseArgs(process.argv.slice(2));
+  const standin = createStandin();
+  const address = await standin.listen(options.port, options.host);
+  console.log(`RTDB stand-in listening on http://${address.address}:${address.port}`);
+  const deviceHost = options.host === '0.0.0.0' ? '127.0.0.1' : options.host;
+  const device = options.device ? startDevice(options.device, `http://${deviceHost}:${address.port}`) : null;
+
+  const deviceId = await waitForDevice(standin);
+  console.log(`Device ${deviceId} online. Running ${options.durationS}s workload, one command every ${options.intervalS}s.`);
+
+  const deadline = Date.now() + options.durationS * 1000;
+  let index = 0;
+  while (Date.now() < deadline) {
+    const kind = options.mix[index % options.mix.length];
+    const { type, payload } = nextCommand(kind, Math.floor(index / options.mix.length), standin, deviceId);
+    const [created] = standin.queueCommand(type, payload);
+    console.log(`Queued ${created.commandId} ${type}`);
+    index++;
+    await sleep(Math.min(options.intervalS * 1000, Math.max(0, deadline - Date.now())));
+  }
+
+  const missing = await drainAcks(standin);
+  const report = standin.summarize();
+  printReport(report);
+  if (options.json) fs.writeFileSync(options.json, JSON.stringify(report, null, 2));
+  await stopDevice(device);
+  await standin.close();
+  if (missing > 0) {
+    console.error(`${missing} command(s) never acknowledged`);
+    process.exitCode = 1;
+  }
+}
+
+main().catch((err) => {
+  console.error(err.message);
+  process.exit(1);
+});
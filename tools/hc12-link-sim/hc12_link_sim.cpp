@@ -0,0 +1,503 @@
+// HC-12 link simulator: the clock's real HC-12 engine (hc12_comm.cpp and
+// the Hc12Frame library) built for Linux, with HC12 on a pty and simulated
+// remote units on the other end, so radio-path changes can be measured
+// without two radios.
+//
+// The radio model sits on the pty's far end and paces both directions at
+// 9600 baud 8N1 (10 bits per byte). Bytes written back to back form one
+// on-air packet, which gets the module latency plus jitter, is lost with
+// probability --drop, and has every bit flipped with probability --ber.
+// Replies that overlap on the air (no carrier sense) are both lost. The
+// remotes answer like Remote_Unit.ino, after --turnaround ms and, for a
+// broadcast, their reply slot; keep in step.
+//
+// Each scenario runs in its own process (fresh engine state and link
+// statistics): one transaction at a time, unicast PINGs round-robin over
+// the units or SET_MODE broadcasts to all of them. Reports the share of
+// transactions and of unit replies that made it, latency percentiles
+// (submit to callback), transactions per second, frames the clock sent per
+// transaction, CRC errors seen by the clock and unit 1's final timeout.
+//
+// --fanout measures a Shabbat mode change to every unit instead, for 1 to
+// 16 units on the selected scenario's link (default four-units): SET_MODE
+// unicast to each unit in turn, as before broadcasts, against one
+// broadcast. A row's transaction is then one mode change, timed until every
+// unit is done.
+//
+// Usage (build with make in this directory):
+//   ./hc12-link-sim [--scenario NAME] [--count 40] [--seed 1] [--min-success PCT] [--verbose]
+//                   [--units N] [--broadcast] [--latency MS] [--jitter MS] [--ber X] [--drop P]
+//                   [--turnaround MS] [--fanout]
+// The link options override the selected scenarios (default: all). Exits
+// non-zero when a scenario's unit reply share is below --min-success.
+
+#include <HardwareSerial.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hc12_comm.h"
+#include "host_loop.h"
+
+HardwareSerial HC12(1);
+
+struct Scenario {
+  const char* name;
+  uint8_t units;
+  bool broadcast;
+  uint32_t latencyMs;     // module latency per packet
+  uint32_t jitterMs;      // plus up to this much
+  double ber;             // bit error rate, both directions
+  double drop;            // packet loss, each direction
+  uint32_t turnaroundMs;  // remote processing before it replies
+};
+
+static const Scenario SCENARIOS[] = {
+  {"clean", 1, false, 10, 0, 0, 0, 5},
+  {"slow-link", 1, false, 80, 40, 0, 0, 5},
+  {"bit-errors", 1, false, 10, 5, 5e-4, 0, 5},
+  {"drops", 1, false, 10, 5, 0, 0.1, 5},
+  {"four-units", 4, false, 10, 5, 0, 0.05, 5},
+  {"broadcast-8", 8, true, 10, 5, 0, 0.05, 5},
+};
+static const size_t SCENARIO_COUNT = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+static const uint8_t FANOUT_UNITS[] = {1, 2, 4, 8, 16};
+
+static const uint64_t BYTE_US = 1042;  // 9600 baud, 8N1
+static const unsigned long TRANSACTION_LIMIT_MS = 30000;
+
+struct Options {
+  const char* scenario = nullptr;
+  uint32_t count = 40;
+  uint32_t seed = 1;
+  double minSuccessPct = 0;
+  bool verbose = false;
+  bool fanout = false;
+  // Overrides, negative = keep the scenario's value.
+  int units = -1;
+  int broadcast = -1;
+  long latencyMs = -1;
+  long jitterMs = -1;
+  double ber = -1;
+  double drop = -1;
+  long turnaroundMs = -1;
+};
+
+static uint64_t nowUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+// mulberry32, seeded apart from the engine's esp_random().
+struct Random {
+  uint32_t state;
+  double next() {
+    state += 0x6d2b79f5;
+    uint32_t t = state;
+    t = (t ^ (t >> 15)) * (t | 1);
+    t ^= t + (t ^ (t >> 7)) * (t | 61);
+    return (t ^ (t >> 14)) / 4294967296.0;
+  }
+};
+
+// ---------------------- Radio Model ----------------------
+// Runs on its own thread on the remote end of the pty.
+
+class Radio {
+ public:
+  Radio(const Scenario& scenario, int fd, uint32_t seed) : scenario(scenario), fd(fd) {
+    random.state = seed;
+    for (uint8_t unit = 1; unit <= scenario.units; unit++) remotes.push_back(Remote{unit, Hc12FrameDecoder(), 0});
+  }
+
+  void run() {
+    while (!stopping.load()) {
+      uint64_t now = nowUs();
+      while (!events.empty() && events.top().atUs <= now) {
+        AirByte byte = events.top();
+        events.pop();
+        if (*byte.lost) continue;
+        if (byte.toRemotes) {
+          for (Remote& remote : remotes) receive(remote, byte.value, byte.atUs);
+        } else {
+          ssize_t written = ::write(fd, &byte.value, 1);
+          (void)written;
+        }
+      }
+      uint64_t waitUs = 20000;
+      if (!events.empty()) waitUs = std::min<uint64_t>(waitUs, events.top().atUs > now ? events.top().atUs - now : 0);
+      struct pollfd p = {fd, POLLIN, 0};
+      struct timespec timeout = {(time_t)(waitUs / 1000000), (long)(waitUs % 1000000) * 1000};
+      if (ppoll(&p, 1, &timeout, nullptr) <= 0 || !(p.revents & POLLIN)) continue;
+      uint8_t buffer[64];
+      ssize_t n = ::read(fd, buffer, sizeof(buffer));
+      now = nowUs();
+      for (ssize_t i = 0; i < n; i++) transmitDown(buffer[i], now);
+    }
+  }
+
+  std::atomic<bool> stopping{false};
+  uint32_t downFrames = 0;  // packets the clock sent
+  uint32_t collisions = 0;
+
+ private:
+  struct AirByte {
+    uint64_t atUs;  // delivery time at the far end
+    uint64_t order;
+    uint8_t value;
+    bool toRemotes;
+    std::shared_ptr<bool> lost;  // the whole packet
+    bool operator>(const AirByte& other) const {
+      return atUs != other.atUs ? atUs > other.atUs : order > other.order;
+    }
+  };
+
+  struct Remote {
+    uint8_t unit;
+    Hc12FrameDecoder decoder;
+    uint8_t mode;
+  };
+
+  uint8_t corrupt(uint8_t value) {
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      if (random.next() < scenario.ber) value ^= 1 << bit;
+    }
+    return value;
+  }
+
+  uint64_t packetLatencyUs() {
+    return (scenario.latencyMs + random.next() * scenario.jitterMs) * 1000;
+  }
+
+  void push(uint64_t atUs, uint8_t value, bool toRemotes, const std::shared_ptr<bool>& lost) {
+    events.push(AirByte{atUs, nextOrder++, value, toRemotes, lost});
+  }
+
+  // A byte from the clock's UART; a gap of two byte times starts a new packet.
+  void transmitDown(uint8_t value, uint64_t now) {
+    if (now > downAirEndUs + 2 * BYTE_US) {
+      downLost = std::make_shared<bool>(random.next() < scenario.drop);
+      downLatencyUs = packetLatencyUs();
+      downFrames++;
+    }
+    downAirEndUs = std::max(now, downAirEndUs) + BYTE_US;
+    downDeliverUs = std::max(downAirEndUs + downLatencyUs, downDeliverUs);
+    push(downDeliverUs, corrupt(value), true, downLost);
+  }
+
+  void transmitUp(const uint8_t* wire, size_t length, uint64_t startUs) {
+    auto lost = std::make_shared<bool>(random.next() < scenario.drop);
+    if (startUs < upAirEndUs && upLast) {
+      *lost = true;
+      *upLast = true;
+      collisions++;
+    }
+    upAirEndUs = std::max(upAirEndUs, startUs + length * BYTE_US);
+    upLast = lost;
+    uint64_t latencyUs = packetLatencyUs();
+    for (size_t i = 0; i < length; i++) {
+      upDeliverUs = std::max(startUs + (i + 1) * BYTE_US + latencyUs, upDeliverUs);
+      push(upDeliverUs, corrupt(wire[i]), false, lost);
+    }
+  }
+
+  void receive(Remote& remote, uint8_t value, uint64_t atUs) {
+    Hc12Frame request;
+    for (bool got = remote.decoder.push(value, request); got; got = remote.decoder.next(request)) {
+      answer(remote, request, atUs);
+    }
+  }
+
+  void answer(Remote& remote, const Hc12Frame& request, uint64_t atUs) {
+    if (request.opcode & HC12_OP_REPLY) return;
+    int8_t slot = 0;
+    const uint8_t* payload = request.payload;
+    uint8_t length = request.length;
+    if (request.unit == HC12_UNIT_BROADCAST) {
+      uint32_t targets;
+      if (!hc12BroadcastTargets(request, targets)) return;
+      slot = hc12ReplySlot(targets, remote.unit);
+      if (slot < 0) return;
+      payload += HC12_TARGETS_SIZE;
+      length -= HC12_TARGETS_SIZE;
+    } else if (request.unit != remote.unit) {
+      return;
+    }
+    if (request.opcode == HC12_OP_TIME_BEACON) return;
+
+    Hc12Status status = HC12_STATUS_OK;
+    switch (request.opcode) {
+      case HC12_OP_PING:
+        break;
+      case HC12_OP_SET_MODE:
+        if (length != 1 || payload[0] > 1) status = HC12_STATUS_BAD_PAYLOAD;
+        else remote.mode = payload[0];
+        break;
+      default:
+        status = HC12_STATUS_UNSUPPORTED;
+        break;
+    }
+    Hc12Frame reply = hc12MakeReply(request, remote.unit, status, &remote.mode, 1);
+    uint8_t wire[HC12_MAX_FRAME];
+    size_t wireLength = hc12EncodeFrame(reply, wire);
+    transmitUp(wire, wireLength, atUs + scenario.turnaroundMs * 1000ULL + slot * HC12_REPLY_SLOT_MS * 1000ULL);
+  }
+
+  const Scenario& scenario;
+  int fd;
+  Random random;
+  std::vector<Remote> remotes;
+  std::priority_queue<AirByte, std::vector<AirByte>, std::greater<AirByte>> events;
+  uint64_t nextOrder = 0;
+  uint64_t downAirEndUs = 0;
+  uint64_t downDeliverUs = 0;
+  uint64_t downLatencyUs = 0;
+  std::shared_ptr<bool> downLost;
+  uint64_t upAirEndUs = 0;
+  uint64_t upDeliverUs = 0;
+  std::shared_ptr<bool> upLast;
+};
+
+// ---------------------- Workload ----------------------
+
+struct Transaction {
+  bool done;
+  bool acked;          // every addressed unit replied with OK
+  uint8_t unitsAcked;
+};
+
+static Transaction current;
+
+static void onUnicastDone(bool acked, uint8_t status, const Hc12Frame*, void*) {
+  current.done = true;
+  current.acked = acked && status == HC12_STATUS_OK;
+  current.unitsAcked = current.acked ? 1 : 0;
+}
+
+static void onBroadcastDone(const Hc12BroadcastResult& result, void*) {
+  current.done = true;
+  current.unitsAcked = 0;
+  for (uint8_t i = 0; i < HC12_MAX_BROADCAST_UNIT; i++) {
+    if ((result.acked & (1UL << i)) && result.status[i] == HC12_STATUS_OK) current.unitsAcked++;
+  }
+  current.acked = (result.acked == result.targets);
+}
+
+// Loop thread: wait for RX or the next task deadline, like schedulerIdle().
+static void pumpLoop(int fd) {
+  long waitMs = hostMsUntilDue();
+  if (waitMs < 0 || waitMs > 100) waitMs = 100;
+  struct pollfd p = {fd, POLLIN, 0};
+  if (poll(&p, 1, (int)waitMs) > 0 && (p.revents & POLLIN)) HC12.pollReceive();
+  hostRunDue();
+}
+
+// Captures hc12WritePrometheus() to read the CRC error counter.
+class TextPrint : public Print {
+ public:
+  size_t write(const uint8_t* buffer, size_t size) override {
+    text.append((const char*)buffer, size);
+    return size;
+  }
+  std::string text;
+};
+
+static unsigned long crcErrors() {
+  TextPrint metrics;
+  hc12WritePrometheus(metrics);
+  const char* name = "\nshabbat_hc12_crc_errors_total ";
+  size_t at = metrics.text.find(name);
+  return at == std::string::npos ? 0 : strtoul(metrics.text.c_str() + at + strlen(name), nullptr, 10);
+}
+
+static double percentile(std::vector<double> sorted, double percent) {
+  if (sorted.empty()) return 0;
+  return sorted[(size_t)((sorted.size() - 1) * percent / 100)];
+}
+
+// Child process: one scenario, one result row. Returns the exit status.
+static int runScenario(const Scenario& scenario, const Options& options) {
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+    perror("posix_openpt");
+    return 2;
+  }
+  int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+  struct termios raw;
+  if (slave < 0 || tcgetattr(slave, &raw) != 0) {
+    perror("pty");
+    return 2;
+  }
+  cfmakeraw(&raw);
+  tcsetattr(slave, TCSANOW, &raw);
+  fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+  fcntl(slave, F_SETFL, fcntl(slave, F_GETFL) | O_NONBLOCK);
+  if (options.verbose) fprintf(stderr, "[%s] HC12 on pty %s\n", scenario.name, ptsname(master));
+
+  Serial.enabled = options.verbose;
+  hostSeedRandom(options.seed);
+  HC12.attach(master);
+  initHc12(-1, -1);
+  Radio radio(scenario, slave, options.seed + 1);
+  std::thread radioThread(&Radio::run, &radio);
+
+  std::vector<double> latenciesMs;
+  uint32_t acked = 0;
+  uint32_t unitsAcked = 0;
+  uint32_t unitsAsked = 0;
+  uint32_t targets = scenario.units >= 32 ? 0xFFFFFFFFUL : (1UL << scenario.units) - 1;
+  bool stuck = false;
+  uint64_t startUs = nowUs();
+  // A unicast fan-out sends one SET_MODE per unit, each after the last.
+  uint8_t sends = options.fanout && !scenario.broadcast ? scenario.units : 1;
+  for (uint32_t i = 0; i < options.count && !stuck; i++) {
+    uint8_t mode = i & 1;
+    bool allAcked = true;
+    uint64_t submittedUs = nowUs();
+    for (uint8_t send = 0; send < sends && !stuck; send++) {
+      current = Transaction{false, false, 0};
+      bool queued;
+      if (scenario.broadcast) queued = hc12SubmitBroadcast(targets, HC12_OP_SET_MODE, &mode, 1, onBroadcastDone, nullptr);
+      else if (options.fanout) queued = hc12Submit(1 + send, HC12_OP_SET_MODE, &mode, 1, onUnicastDone, nullptr);
+      else queued = hc12Submit(1 + i % scenario.units, HC12_OP_PING, nullptr, 0, onUnicastDone, nullptr);
+      if (!queued) {
+        fprintf(stderr, "[%s] submit rejected\n", scenario.name);
+        stuck = true;
+        break;
+      }
+      uint64_t sentUs = nowUs();
+      while (!current.done) {
+        pumpLoop(master);
+        if (nowUs() - sentUs > TRANSACTION_LIMIT_MS * 1000ULL) {
+          fprintf(stderr, "[%s] transaction %u never completed\n", scenario.name, i);
+          stuck = true;
+          break;
+        }
+      }
+      allAcked = allAcked && current.acked;
+      unitsAcked += current.unitsAcked;
+    }
+    latenciesMs.push_back((nowUs() - submittedUs) / 1000.0);
+    if (allAcked) acked++;
+    unitsAsked += scenario.broadcast || options.fanout ? scenario.units : 1;
+  }
+  double elapsedS = (nowUs() - startUs) / 1e6;
+  radio.stopping.store(true);
+  radioThread.join();
+
+  std::sort(latenciesMs.begin(), latenciesMs.end());
+  uint32_t completed = latenciesMs.size();
+  Hc12LinkSummary link = {};
+  hc12LinkSummary(1, link);
+  double okPct = completed ? 100.0 * acked / completed : 0;
+  double unitPct = unitsAsked ? 100.0 * unitsAcked / unitsAsked : 0;
+  printf("%-12s %5u %5s %4u %6.1f %7.1f %7.1f %7.1f %7.1f %6.2f %6.2f %5lu %5u %5u\n", scenario.name,
+         scenario.units, scenario.broadcast ? "bcast" : "uni", completed, okPct, unitPct, percentile(latenciesMs, 50),
+         percentile(latenciesMs, 95), percentile(latenciesMs, 99), completed / elapsedS,
+         completed ? (double)radio.downFrames / completed : 0, crcErrors(), radio.collisions, link.rtoMs);
+  fflush(stdout);
+  if (stuck) return 2;
+  return unitPct < options.minSuccessPct ? 1 : 0;
+}
+
+// ---------------------- Main ----------------------
+
+static void usage() {
+  fprintf(stderr,
+          "usage: hc12-link-sim [--scenario NAME] [--count N] [--seed S] [--min-success PCT] [--verbose]\n"
+          "                     [--units N] [--broadcast] [--latency MS] [--jitter MS] [--ber X] [--drop P]\n"
+          "                     [--turnaround MS] [--fanout]\nscenarios:");
+  for (size_t i = 0; i < SCENARIO_COUNT; i++) fprintf(stderr, " %s", SCENARIOS[i].name);
+  fprintf(stderr, "\n");
+  exit(2);
+}
+
+static Options parseArgs(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    auto next = [&]() -> const char* {
+      if (i + 1 >= argc) usage();
+      return argv[++i];
+    };
+    if (arg == "--scenario") options.scenario = next();
+    else if (arg == "--count") options.count = strtoul(next(), nullptr, 10);
+    else if (arg == "--seed") options.seed = strtoul(next(), nullptr, 10);
+    else if (arg == "--min-success") options.minSuccessPct = atof(next());
+    else if (arg == "--verbose") options.verbose = true;
+    else if (arg == "--units") options.units = atoi(next());
+    else if (arg == "--broadcast") options.broadcast = 1;
+    else if (arg == "--latency") options.latencyMs = atol(next());
+    else if (arg == "--jitter") options.jitterMs = atol(next());
+    else if (arg == "--ber") options.ber = atof(next());
+    else if (arg == "--drop") options.drop = atof(next());
+    else if (arg == "--turnaround") options.turnaroundMs = atol(next());
+    else if (arg == "--fanout") options.fanout = true;
+    else usage();
+  }
+  if (options.units == 0 || options.units > HC12_MAX_BROADCAST_UNIT || options.count == 0) usage();
+  return options;
+}
+
+static Scenario applyOverrides(Scenario scenario, const Options& options) {
+  if (options.units > 0) scenario.units = options.units;
+  if (options.broadcast >= 0) scenario.broadcast = true;
+  if (options.latencyMs >= 0) scenario.latencyMs = options.latencyMs;
+  if (options.jitterMs >= 0) scenario.jitterMs = options.jitterMs;
+  if (options.ber >= 0) scenario.ber = options.ber;
+  if (options.drop >= 0) scenario.drop = options.drop;
+  if (options.turnaroundMs >= 0) scenario.turnaroundMs = options.turnaroundMs;
+  return scenario;
+}
+
+// Runs one scenario in a child process; returns its exit status.
+static int runIsolated(const Scenario& scenario, const Options& options) {
+  pid_t pid = fork();
+  if (pid == 0) _exit(runScenario(scenario, options));
+  int status = 0;
+  if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status)) return 2;
+  return WEXITSTATUS(status);
+}
+
+int main(int argc, char** argv) {
+  Options options = parseArgs(argc, argv);
+  bool found = false;
+  int result = 0;
+  printf("HC-12 link simulation: %u %s per scenario, seed %u\n\n", options.count,
+         options.fanout ? "mode changes to every unit" : "transactions", options.seed);
+  printf("scenario     units  mode   tx   ok %% units %%  p50 ms  p95 ms  p99 ms   tx/s frm/tx   crc  coll rtoms\n");
+  fflush(stdout);
+  const char* fanoutLink = options.scenario ? options.scenario : "four-units";
+  for (size_t i = 0; i < SCENARIO_COUNT; i++) {
+    if (options.fanout ? strcmp(fanoutLink, SCENARIOS[i].name) != 0
+                       : options.scenario && strcmp(options.scenario, SCENARIOS[i].name) != 0) {
+      continue;
+    }
+    found = true;
+    Scenario scenario = applyOverrides(SCENARIOS[i], options);
+    if (!options.fanout) {
+      result = std::max(result, runIsolated(scenario, options));
+      continue;
+    }
+    for (uint8_t units : FANOUT_UNITS) {
+      for (bool broadcast : {false, true}) {
+        scenario.units = units;
+        scenario.broadcast = broadcast;
+        result = std::max(result, runIsolated(scenario, options));
+      }
+    }
+  }
+  if (!found) usage();
+  return result;
+}
@@ -0,0 +1,76 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Linux stand-in for the few Arduino-ESP32 APIs the host builds use (the
+// HC-12 engine here, tools/host-tests); defined in arduino_host.cpp or by
+// the harness itself.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <WString.h>
+
+typedef uint8_t byte;
+
+// The binary literals of Arduino's binary.h that LCD glyphs use.
+#define B00000 0
+#define B00100 4
+#define B01010 10
+#define B01110 14
+#define B10001 17
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+uint32_t esp_random();
+long random(long howBig);
+long random(long howSmall, long howBig);
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+  size_t print(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+  size_t println(const char* text) { return print(text) + print("\r\n"); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+// Log output of the firmware code: stderr with --verbose, else discarded.
+class HostSerial : public Print {
+ public:
+  void begin(unsigned long baud) { (void)baud; }
+  explicit operator bool() const { return true; }
+  size_t write(const uint8_t* buffer, size_t size) override;
+  bool enabled = false;
+};
+extern HostSerial Serial;
+
+// The FreeRTOS semaphore calls Arduino-ESP32's Arduino.h brings in; one
+// tick is a millisecond.
+typedef void* SemaphoreHandle_t;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portYIELD_FROM_ISR(woken) ((void)(woken))
+SemaphoreHandle_t xSemaphoreCreateBinary();
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex();
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t mutex, TickType_t ticks);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t mutex);
+
+class HostEsp {
+ public:
+  uint32_t getCycleCount();
+  uint32_t getFreeHeap() { return 0; }
+  uint32_t getMinFreeHeap() { return 0; }
+};
+extern HostEsp ESP;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,37 @@
+#ifndef HOST_HARDWARE_SERIAL_H
+#define HOST_HARDWARE_SERIAL_H
+
+// HardwareSerial on a file descriptor (the clock's end of the simulator's
+// pty). The harness calls pollReceive() when the descriptor is readable,
+// which runs the onReceive() callback like the ESP32 serial driver task.
+
+#include <Arduino.h>
+
+static const uint32_t SERIAL_8N1 = 0x800001c;
+
+typedef void (*OnReceiveCb)();
+
+class HardwareSerial : public Print {
+ public:
+  explicit HardwareSerial(int uartNumber) { (void)uartNumber; }
+
+  void begin(unsigned long baud, uint32_t config, int8_t rxPin, int8_t txPin);
+  void onReceive(OnReceiveCb callback, bool onlyOnTimeout);
+  int available();
+  int read();
+  size_t write(const uint8_t* buffer, size_t size) override;
+  void flush() {}
+
+  // Host side.
+  void attach(int fd) { this->fd = fd; }
+  void pollReceive();
+
+ private:
+  int fd = -1;
+  OnReceiveCb receiveCallback = nullptr;
+  uint8_t buffer[256];
+  size_t bufferStart = 0;
+  size_t bufferEnd = 0;
+};
+
+#endif // HOST_HARDWARE_SERIAL_H
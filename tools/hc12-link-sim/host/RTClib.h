@@ -0,0 +1,39 @@
+#ifndef HOST_RTCLIB_H
+#define HOST_RTCLIB_H
+
+// Just enough of RTClib for time_utils.h and the display code.
+
+#include <stdint.h>
+
+class DateTime {
+ public:
+  explicit DateTime(uint32_t t = 0) : t(t) {}
+  DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour = 0, uint8_t minute = 0, uint8_t second = 0)
+      : t(daysFromCivil(year, month, day) * 86400UL + hour * 3600UL + minute * 60UL + second) {}
+  uint32_t unixtime() const { return t; }
+  uint8_t hour() const { return t / 3600 % 24; }
+  uint8_t minute() const { return t / 60 % 60; }
+  uint8_t second() const { return t % 60; }
+  // 0 = Sunday; 1970-01-01 was a Thursday.
+  uint8_t dayOfTheWeek() const { return (t / 86400 + 4) % 7; }
+
+ private:
+  // Days since 1970-01-01 of a proleptic Gregorian date.
+  static uint32_t daysFromCivil(int year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int era = year / 400;
+    unsigned yearOfEra = year - era * 400;
+    unsigned dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+  }
+
+  uint32_t t;
+};
+
+class RTC_DS3231 {
+ public:
+  bool begin() { return true; }
+};
+
+#endif // HOST_RTCLIB_H
@@ -0,0 +1,145 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+// Arduino's String on std::string: the constructors, concatenation,
+// comparison and search calls the firmware makes, with Arduino's semantics
+// (numbers only convert explicitly, indexOf() returns -1, substring() and
+// remove() clamp to the length).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <utility>
+
+#define DEC 10
+#define HEX 16
+
+class String {
+ public:
+  String(const char* text = "") : value(text ? text : "") {}
+  String(const String& other) = default;
+  String(String&& other) = default;
+  explicit String(char c) : value(1, c) {}
+  explicit String(unsigned char number, unsigned char base = DEC) : String((unsigned long)number, base) {}
+  explicit String(int number, unsigned char base = DEC) : String((long)number, base) {}
+  explicit String(unsigned int number, unsigned char base = DEC) : String((unsigned long)number, base) {}
+  explicit String(long number, unsigned char base = DEC) {
+    if (base == DEC || number >= 0) value = format(base == DEC ? "%ld" : base == HEX ? "%lx" : "%lo", number);
+    else value = String((unsigned long)number, base).value;
+  }
+  explicit String(unsigned long number, unsigned char base = DEC)
+      : value(format(base == HEX ? "%lx" : base == 8 ? "%lo" : "%lu", number)) {}
+  explicit String(float number, unsigned char decimals = 2) : String((double)number, decimals) {}
+  explicit String(double number, unsigned char decimals = 2) {
+    char text[40];
+    snprintf(text, sizeof(text), "%.*f", (int)decimals, number);
+    value = text;
+  }
+
+  String& operator=(const String& other) = default;
+  String& operator=(String&& other) = default;
+  String& operator=(const char* text) {
+    value = text ? text : "";
+    return *this;
+  }
+
+  unsigned int length() const { return value.size(); }
+  const char* c_str() const { return value.c_str(); }
+  bool reserve(unsigned int size) {
+    value.reserve(size);
+    return true;
+  }
+
+  bool concat(const String& other) {
+    value += other.value;
+    return true;
+  }
+  bool concat(const char* text) {
+    if (text) value += text;
+    return true;
+  }
+  bool concat(char c) {
+    value += c;
+    return true;
+  }
+  bool concat(unsigned char number) { return concat(String(number)); }
+  bool concat(int number) { return concat(String(number)); }
+  bool concat(unsigned int number) { return concat(String(number)); }
+  bool concat(long number) { return concat(String(number)); }
+  bool concat(unsigned long number) { return concat(String(number)); }
+  bool concat(double number) { return concat(String(number)); }
+  template <typename T>
+  String& operator+=(const T& other) {
+    concat(other);
+    return *this;
+  }
+
+  char operator[](unsigned int index) const { return index < value.size() ? value[index] : 0; }
+  char& operator[](unsigned int index) { return value[index]; }
+  char charAt(unsigned int index) const { return (*this)[index]; }
+
+  bool equals(const String& other) const { return value == other.value; }
+  bool equals(const char* text) const { return value == (text ? text : ""); }
+  bool operator==(const String& other) const { return equals(other); }
+  bool operator==(const char* text) const { return equals(text); }
+  bool operator!=(const String& other) const { return !equals(other); }
+  bool operator!=(const char* text) const { return !equals(text); }
+  bool operator<(const String& other) const { return value < other.value; }
+  bool startsWith(const String& prefix) const { return value.compare(0, prefix.value.size(), prefix.value) == 0; }
+  bool endsWith(const String& suffix) const {
+    return value.size() >= suffix.value.size() &&
+           value.compare(value.size() - suffix.value.size(), suffix.value.size(), suffix.value) == 0;
+  }
+
+  int indexOf(char c, unsigned int from = 0) const { return found(value.find(c, from)); }
+  int indexOf(const String& text, unsigned int from = 0) const { return found(value.find(text.value, from)); }
+  int lastIndexOf(char c) const { return found(value.rfind(c)); }
+
+  String substring(unsigned int from) const { return substring(from, value.size()); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= value.size()) return String();
+    return String(value.substr(from, to - from).c_str());
+  }
+  void remove(unsigned int index) { remove(index, (unsigned int)-1); }
+  void remove(unsigned int index, unsigned int count) {
+    if (index < value.size()) value.erase(index, count);
+  }
+  void trim() {
+    size_t start = value.find_first_not_of(" \t\r\n");
+    size_t end = value.find_last_not_of(" \t\r\n");
+    value = start == std::string::npos ? "" : value.substr(start, end - start + 1);
+  }
+  long toInt() const { return atol(value.c_str()); }
+
+  friend String operator+(const String& a, const String& b) {
+    String sum(a);
+    sum.concat(b);
+    return sum;
+  }
+  friend String operator+(const String& a, const char* b) {
+    String sum(a);
+    sum.concat(b);
+    return sum;
+  }
+  friend String operator+(const char* a, const String& b) { return String(a) + b; }
+  friend String operator+(const String& a, char b) {
+    String sum(a);
+    sum.concat(b);
+    return sum;
+  }
+
+ private:
+  template <typename T>
+  static std::string format(const char* pattern, T number) {
+    char text[40];
+    snprintf(text, sizeof(text), pattern, number);
+    return text;
+  }
+  static int found(size_t position) { return position == std::string::npos ? -1 : (int)position; }
+
+  std::string value;
+};
+
+#endif // HOST_WSTRING_H
@@ -0,0 +1,175 @@
+#include <HardwareSerial.h>
+#include <esp_timer.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include "host_loop.h"
+
+// ---------------------- Time / Random ----------------------
+
+static uint64_t monotonicUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static const uint64_t startUs = monotonicUs();
+
+unsigned long millis() {
+  return (unsigned long)((monotonicUs() - startUs) / 1000);
+}
+
+unsigned long micros() {
+  return (unsigned long)(monotonicUs() - startUs);
+}
+
+int64_t esp_timer_get_time() {
+  return (int64_t)(monotonicUs() - startUs);
+}
+
+void delay(unsigned long ms) {
+  usleep(ms * 1000);
+}
+
+static uint32_t randomState = 1;
+
+void hostSeedRandom(uint32_t seed) {
+  randomState = seed;
+}
+
+// mulberry32, as in the Node tools, so runs with one seed are comparable.
+uint32_t esp_random() {
+  randomState += 0x6d2b79f5;
+  uint32_t t = randomState;
+  t = (t ^ (t >> 15)) * (t | 1);
+  t ^= t + (t ^ (t >> 7)) * (t | 61);
+  return t ^ (t >> 14);
+}
+
+long random(long howBig) {
+  return howBig > 0 ? (long)(esp_random() % (uint32_t)howBig) : 0;
+}
+
+long random(long howSmall, long howBig) {
+  return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+HostEsp ESP;
+
+uint32_t HostEsp::getCycleCount() {
+  return (uint32_t)(micros() * 240);
+}
+
+// ---------------------- Print / Serial ----------------------
+
+size_t Print::printf(const char* format, ...) {
+  char line[256];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+  if (length < 0) return 0;
+  if ((size_t)length >= sizeof(line)) length = sizeof(line) - 1;
+  return write((const uint8_t*)line, length);
+}
+
+HostSerial Serial;
+
+size_t HostSerial::write(const uint8_t* buffer, size_t size) {
+  if (enabled) fwrite(buffer, 1, size, stderr);
+  return size;
+}
+
+void HardwareSerial::begin(unsigned long, uint32_t, int8_t, int8_t) {}
+
+void HardwareSerial::onReceive(OnReceiveCb callback, bool) {
+  receiveCallback = callback;
+}
+
+int HardwareSerial::available() {
+  if (bufferStart == bufferEnd && fd >= 0) {
+    ssize_t n = ::read(fd, buffer, sizeof(buffer));
+    bufferStart = 0;
+    bufferEnd = n > 0 ? (size_t)n : 0;
+  }
+  return (int)(bufferEnd - bufferStart);
+}
+
+int HardwareSerial::read() {
+  if (available() == 0) return -1;
+  return buffer[bufferStart++];
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t size) {
+  size_t written = 0;
+  while (written < size) {
+    ssize_t n = ::write(fd, data + written, size - written);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) break;
+    written += n;
+  }
+  return written;
+}
+
+void HardwareSerial::pollReceive() {
+  if (receiveCallback && available() > 0) receiveCallback();
+}
+
+// ---------------------- FreeRTOS ----------------------
+// Real-time semaphores for builds with more than one thread (the web
+// server's next to the loop); loop-schedule brings its own on simulated time.
+
+struct HostBinarySemaphore {
+  std::mutex lock;
+  std::condition_variable given;
+  bool full = false;
+};
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return new HostBinarySemaphore();
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t handle) {
+  HostBinarySemaphore* semaphore = static_cast<HostBinarySemaphore*>(handle);
+  {
+    std::lock_guard<std::mutex> guard(semaphore->lock);
+    if (semaphore->full) return pdFALSE;
+    semaphore->full = true;
+  }
+  semaphore->given.notify_one();
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t handle, BaseType_t* woken) {
+  if (woken) *woken = pdFALSE;
+  return xSemaphoreGive(handle);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t ticks) {
+  HostBinarySemaphore* semaphore = static_cast<HostBinarySemaphore*>(handle);
+  std::unique_lock<std::mutex> guard(semaphore->lock);
+  auto full = [semaphore]() { return semaphore->full; };
+  if (ticks == portMAX_DELAY) semaphore->given.wait(guard, full);
+  else if (!semaphore->given.wait_for(guard, std::chrono::milliseconds(ticks), full)) return pdFALSE;
+  semaphore->full = false;
+  return pdTRUE;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+  return new std::recursive_timed_mutex();
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t handle, TickType_t ticks) {
+  std::recursive_timed_mutex* mutex = static_cast<std::recursive_timed_mutex*>(handle);
+  if (ticks != portMAX_DELAY) return mutex->try_lock_for(std::chrono::milliseconds(ticks)) ? pdTRUE : pdFALSE;
+  mutex->lock();
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t handle) {
+  static_cast<std::recursive_timed_mutex*>(handle)->unlock();
+  return pdTRUE;
+}
@@ -0,0 +1,70 @@
+#include <time.h>
+#include "host_loop.h"
+#include "metrics.h"
+#include "power_manager.h"
+#include "task_scheduler.h"
+#include "time_utils.h"
+
+// ---------------------- Loop Task Scheduler ----------------------
+
+static const uint8_t HOST_MAX_TASKS = 4;
+
+struct HostTask {
+  TaskFn fn;
+  bool armed;
+  unsigned long dueMs;
+};
+
+static HostTask tasks[HOST_MAX_TASKS];
+static uint8_t taskCount = 0;
+
+TaskId schedulerAddOneShot(const char*, TaskFn fn, unsigned long delayMs) {
+  if (taskCount >= HOST_MAX_TASKS) return NO_TASK;
+  TaskId id = taskCount++;
+  tasks[id] = {fn, delayMs != NOT_SCHEDULED, millis() + delayMs};
+  return id;
+}
+
+void schedulerDelay(TaskId id, unsigned long delayMs) {
+  if (id >= taskCount) return;
+  tasks[id].armed = true;
+  tasks[id].dueMs = millis() + delayMs;
+}
+
+void schedulerNotify(TaskId id) {
+  schedulerDelay(id, 0);
+}
+
+void hostRunDue() {
+  unsigned long nowMs = millis();
+  for (uint8_t id = 0; id < taskCount; id++) {
+    HostTask& task = tasks[id];
+    if (!task.armed || (long)(task.dueMs - nowMs) > 0) continue;
+    task.armed = false;  // one-shot: the task re-arms itself if needed
+    task.fn();
+  }
+}
+
+long hostMsUntilDue() {
+  long wait = -1;
+  unsigned long nowMs = millis();
+  for (uint8_t id = 0; id < taskCount; id++) {
+    if (!tasks[id].armed) continue;
+    long until = (long)(tasks[id].dueMs - nowMs);
+    if (until < 0) until = 0;
+    if (wait < 0 || until < wait) wait = until;
+  }
+  return wait;
+}
+
+// ---------------------- Firmware Stubs ----------------------
+
+bool timeValid = false;
+
+DateTime getCurrentDateTime() {
+  return DateTime((uint32_t)time(nullptr));
+}
+
+void metricsRecordUs(MetricTimer, uint32_t) {}
+
+void powerHoldAwake(bool) {}
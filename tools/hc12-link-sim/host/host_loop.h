@@ -0,0 +1,17 @@
+#ifndef HOST_LOOP_H
+#define HOST_LOOP_H
+
+// Harness side of the host stand-ins: the loop task scheduler in
+// host_loop.cpp (one-shot tasks only, which is all the HC-12 engine
+// registers; builds that run the real task_scheduler.cpp leave this file
+// out) and the esp_random() seed in arduino_host.cpp.
+
+#include <stdint.h>
+
+void hostSeedRandom(uint32_t seed);
+// Run the tasks that are due or notified, like schedulerRunDue().
+void hostRunDue();
+// Milliseconds until the next task is due: 0 if one is due now, -1 if none.
+long hostMsUntilDue();
+
+#endif // HOST_LOOP_H
@@ -0,0 +1,171 @@
+// The clock's cloud side on the host: the real cloud_sync.cpp, with the
+// command actions, schedule and write-behind persistence it drives
+// (control_actions.cpp, schedule.cpp, persistence.cpp) on the NVS model,
+// talking plain HTTP to tools/rtdb-standin.mjs. cloudTask runs every
+// CLOUD_TASK_PERIOD as in the sketch. The HC-12 radio is a stand-in: a
+// Shabbat mode broadcast is applied by every unit after --radio-ms (default
+// the link simulator's one-unit broadcast median).
+//   ./cloud-sync-device --url http://127.0.0.1:9000 [--radio-ms 55] [--verbose]
+// Runs until SIGINT/SIGTERM. tools/cloud-sync-bench.mjs --device starts it
+// against its stand-in; see make cloud-sync-bench.
+
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <Preferences.h>
+#include "cloud_sync.h"
+#include "control_actions.h"
+#include "firebase_config.h"
+#include "hc12_comm.h"
+#include "host_loop.h"
+#include "metrics.h"
+#include "persistence.h"
+#include "schedule.h"
+#include "time_utils.h"
+
+// Smart_Shabbat_Clock.ino, without power save.
+static const unsigned long CLOUD_TASK_PERIOD = 500;
+static const unsigned long IDLE_SLEEP_US = 10000;
+
+// ---------------------- Firmware Globals ----------------------
+
+Preferences prefs;
+bool relay_state = false;
+bool shabbatMode = false;
+uint8_t relayMode = 2;
+
+void setLocalRelayState(bool on) {
+  if (relay_state == on) return;
+  relay_state = on;
+  persistRelayState(on);
+}
+
+void saveRelayMode(uint8_t mode) {
+  persistRelayMode(mode);
+}
+
+void saveShabbatMode(bool mode) {
+  persistShabbatMode(mode);
+}
+
+void metricsRecord(MetricTimer, uint32_t) {}
+void metricsCount(MetricCounter, uint32_t) {}
+
+static String databaseUrl;
+static String authUrl;
+
+const char* hostDatabaseUrl() {
+  return databaseUrl.c_str();
+}
+
+const char* hostAuthUrl() {
+  return authUrl.c_str();
+}
+
+// ---------------------- Radio Stand-in ----------------------
+// One broadcast in flight at a time, like the HC-12 queue's head; every
+// target applies the mode.
+
+struct PendingBroadcast {
+  bool active;
+  unsigned long dueMs;
+  uint32_t targets;
+  Hc12BroadcastCallback done;
+  void* context;
+};
+
+static PendingBroadcast pendingBroadcast = {};
+static unsigned long radioMs = 55;
+static uint32_t linkRevision = 0;
+static uint32_t lastReplyAt = 0;
+
+bool hc12SubmitBroadcast(uint32_t targets, uint8_t, const uint8_t*, uint8_t, Hc12BroadcastCallback done,
+                         void* context) {
+  if (pendingBroadcast.active) return false;
+  pendingBroadcast = {true, millis() + radioMs, targets, done, context};
+  return true;
+}
+
+bool hc12LinkSummary(uint8_t unit, Hc12LinkSummary& out) {
+  if (lastReplyAt == 0 || (HC12_SHABBAT_UNITS & (1UL << (unit - 1))) == 0) return false;
+  out = {};
+  out.ok = true;
+  out.successPct = 100;
+  out.rttP50Ms = out.rttP90Ms = out.srttMs = (uint16_t)radioMs;
+  out.lastSeen = lastReplyAt;
+  return true;
+}
+
+uint32_t hc12LinkRevision() {
+  return linkRevision;
+}
+
+static void tickRadio() {
+  if (!pendingBroadcast.active || (long)(millis() - pendingBroadcast.dueMs) < 0) return;
+  PendingBroadcast broadcast = pendingBroadcast;
+  pendingBroadcast.active = false;
+  Hc12BroadcastResult result = {};
+  result.targets = broadcast.targets;
+  result.acked = broadcast.targets;
+  lastReplyAt = getCurrentDateTime().unixtime();
+  linkRevision++;
+  broadcast.done(result, broadcast.context);
+}
+
+// ---------------------- Main ----------------------
+
+static volatile sig_atomic_t stopping = 0;
+
+static void stop(int) {
+  stopping = 1;
+}
+
+static void usage() {
+  fprintf(stderr, "usage: cloud-sync-device --url http://HOST:PORT [--radio-ms MS] [--seed N] [--verbose]\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  uint32_t seed = 1;
+  for (int i = 1; i < argc; i++) {
+    String arg = argv[i];
+    if (arg == "--verbose") {
+      Serial.enabled = true;
+      continue;
+    }
+    if (i + 1 >= argc) usage();
+    if (arg == "--url") databaseUrl = argv[++i];
+    else if (arg == "--radio-ms") radioMs = strtoul(argv[++i], nullptr, 10);
+    else if (arg == "--seed") seed = strtoul(argv[++i], nullptr, 10);
+    else usage();
+  }
+  while (databaseUrl.endsWith("/")) databaseUrl.remove(databaseUrl.length() - 1);
+  if (!databaseUrl.startsWith("http://")) usage();
+  authUrl = databaseUrl + "/v1/accounts:signInWithPassword";
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+  hostSeedRandom(seed);
+  timeValid = true;
+
+  // setup(): modes, schedule, then cloud sync.
+  persistInit();
+  relayMode = persistedRelayMode(relayMode);
+  shabbatMode = persistedShabbatMode(shabbatMode);
+  loadSchedule();
+  initCloudSync();
+  fprintf(stderr, "cloud-sync-device: %s as %s\n", hostDatabaseUrl(), FIREBASE_DEVICE_ID);
+
+  unsigned long lastCloudMs = millis() - CLOUD_TASK_PERIOD;
+  while (!stopping) {
+    if (millis() - lastCloudMs >= CLOUD_TASK_PERIOD) {
+      lastCloudMs = millis();
+      tickCloudSync();
+    }
+    tickRadio();
+    hostRunDue();
+    usleep(IDLE_SLEEP_US);
+  }
+  persistFlush();
+  return 0;
+}
@@ -0,0 +1,241 @@
+#ifndef HOST_ESP_ASYNC_WEB_SERVER_H
+#define HOST_ESP_ASYNC_WEB_SERVER_H
+
+// ESPAsyncWebServer on POSIX sockets (async_web_server.cpp), for host builds
+// of web_api.cpp. Like AsyncTCP, one server thread accepts, parses and runs
+// the handlers; send() may be called from any thread and hands the response
+// to that thread. A request is deleted once its response is out or its
+// client leaves, after its onDisconnect handler ran. Every response closes
+// the connection. Only the calls the firmware makes are here.
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <Arduino.h>
+
+enum WebRequestMethod : uint8_t {
+  HTTP_GET = 1,
+  HTTP_POST = 2,
+};
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServer;
+class AsyncWebServerRequest;
+class AsyncEventSourceClient;
+struct HostConnection;
+
+typedef std::function<void(AsyncWebServerRequest*)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest*, const String&, size_t, uint8_t*, size_t, bool)>
+    ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest*, uint8_t*, size_t, size_t, size_t)> ArBodyHandlerFunction;
+typedef std::function<void()> ArDisconnectHandler;
+typedef std::function<void(AsyncEventSourceClient*)> ArEventHandlerFunction;
+typedef std::function<bool(AsyncWebServerRequest*)> ArAuthorizeConnectHandler;
+
+class AsyncWebParameter {
+ public:
+  AsyncWebParameter(const String& name, const String& value) : paramName(name), paramValue(value) {}
+  const String& name() const { return paramName; }
+  const String& value() const { return paramValue; }
+
+ private:
+  String paramName;
+  String paramValue;
+};
+
+typedef AsyncWebParameter AsyncWebHeader;
+
+class AsyncWebServerResponse {
+ public:
+  AsyncWebServerResponse(int code, const char* contentType, const std::string& body)
+      : code(code), contentType(contentType ? contentType : ""), body(body) {}
+  virtual ~AsyncWebServerResponse() {}
+  void addHeader(const String& name, const String& value) { headers += name + ": " + value + "\r\n"; }
+
+  // Status line, headers and body as they go on the wire.
+  std::string serialize() const;
+
+ protected:
+  int code;
+  String contentType;
+  std::string body;
+  String headers;
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+ public:
+  AsyncResponseStream(const char* contentType, size_t bufferSize) : AsyncWebServerResponse(200, contentType, "") {
+    body.reserve(bufferSize);
+  }
+  size_t write(const uint8_t* buffer, size_t size) override {
+    body.append((const char*)buffer, size);
+    return size;
+  }
+};
+
+class AsyncWebServerRequest {
+ public:
+  // Owned by the request and released with free(), as in the library.
+  void* _tempObject = nullptr;
+
+  ~AsyncWebServerRequest() { free(_tempObject); }
+
+  WebRequestMethodComposite method() const { return requestMethod; }
+  const String& url() const { return path; }
+  size_t contentLength() const { return bodyLength; }
+
+  // Query parameters, URL-decoded; headers match case-insensitively.
+  bool hasParam(const char* name) const { return getParam(name) != nullptr; }
+  const AsyncWebParameter* getParam(const char* name) const;
+  const AsyncWebHeader* getHeader(const char* name) const;
+
+  void send(int code, const char* contentType = nullptr, const String& body = String());
+  void send(AsyncWebServerResponse* response);
+  AsyncWebServerResponse* beginResponse(int code, const char* contentType = nullptr,
+                                        const String& body = String());
+  AsyncWebServerResponse* beginResponse_P(int code, const char* contentType, const uint8_t* data, size_t len);
+  AsyncResponseStream* beginResponseStream(const char* contentType, size_t bufferSize = 1460);
+
+  // Runs on the server thread when the connection ends; replaces any
+  // earlier handler.
+  void onDisconnect(ArDisconnectHandler handler) { disconnectHandler = handler; }
+
+ private:
+  friend class AsyncWebServer;
+  friend class AsyncEventSource;
+
+  AsyncWebServer* server = nullptr;
+  HostConnection* connection = nullptr;
+  WebRequestMethodComposite requestMethod = 0;
+  String path;
+  size_t bodyLength = 0;
+  std::vector<AsyncWebParameter> params;
+  std::vector<AsyncWebHeader> headers;
+  ArDisconnectHandler disconnectHandler;
+};
+
+class AsyncWebHandler {
+ public:
+  virtual ~AsyncWebHandler() {}
+  virtual bool canHandle(AsyncWebServerRequest* request) = 0;
+  // Body chunks arrive before handleRequest(); this server passes the whole
+  // body as one chunk.
+  virtual void handleBody(AsyncWebServerRequest*, uint8_t*, size_t, size_t, size_t) {}
+  virtual void handleRequest(AsyncWebServerRequest* request) = 0;
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler {
+ public:
+  AsyncCallbackWebHandler(const char* url, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                          ArBodyHandlerFunction onBody)
+      : url(url), method(method), onRequest(onRequest), onBody(onBody) {}
+  bool canHandle(AsyncWebServerRequest* request) override {
+    return (request->method() & method) != 0 && request->url() == url;
+  }
+  void handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) override {
+    if (onBody) onBody(request, data, len, index, total);
+  }
+  void handleRequest(AsyncWebServerRequest* request) override {
+    if (onRequest) onRequest(request);
+  }
+
+ private:
+  String url;
+  WebRequestMethodComposite method;
+  ArRequestHandlerFunction onRequest;
+  ArBodyHandlerFunction onBody;
+};
+
+class AsyncEventSource;
+
+class AsyncEventSourceClient {
+ public:
+  void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+
+ private:
+  friend class AsyncEventSource;
+  friend class AsyncWebServer;
+
+  AsyncEventSource* source = nullptr;
+  HostConnection* connection = nullptr;
+};
+
+// Server-Sent Events on GET url. count() and send() may be called from any
+// thread.
+class AsyncEventSource : public AsyncWebHandler {
+ public:
+  explicit AsyncEventSource(const char* url) : url(url) {}
+
+  void onConnect(ArEventHandlerFunction handler) { connectHandler = handler; }
+  // A refused connection gets a 403.
+  void authorizeConnect(ArAuthorizeConnectHandler handler) { authorizeHandler = handler; }
+  void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+  size_t count() const;
+
+  bool canHandle(AsyncWebServerRequest* request) override {
+    return request->method() == HTTP_GET && request->url() == url;
+  }
+  void handleRequest(AsyncWebServerRequest* request) override;
+
+ private:
+  friend class AsyncWebServer;
+  friend class AsyncEventSourceClient;
+
+  void removeClient(HostConnection* connection);
+
+  String url;
+  AsyncWebServer* server = nullptr;
+  ArEventHandlerFunction connectHandler;
+  ArAuthorizeConnectHandler authorizeHandler;
+  mutable std::mutex clientsLock;
+  std::vector<AsyncEventSourceClient*> clients;
+};
+
+class AsyncWebServer {
+ public:
+  explicit AsyncWebServer(uint16_t port) : listenPort(port) {}
+
+  AsyncCallbackWebHandler& on(const char* url, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                              ArUploadHandlerFunction onUpload = nullptr, ArBodyHandlerFunction onBody = nullptr);
+  AsyncWebHandler& addHandler(AsyncWebHandler* handler);
+  void onNotFound(ArRequestHandlerFunction handler) { notFoundHandler = handler; }
+  // Listens on 127.0.0.1 and starts the server thread; exits the process if
+  // the port can't be bound.
+  void begin();
+  // Host only: the port to listen on, set before begin() (0 picks one),
+  // and the port bound.
+  void setPort(uint16_t port) { listenPort = port; }
+  uint16_t port() const { return listenPort; }
+
+ private:
+  friend class AsyncWebServerRequest;
+  friend class AsyncEventSource;
+  friend class AsyncEventSourceClient;
+
+  // Queue bytes for a connection from any thread; last closes it once sent.
+  void post(HostConnection* connection, std::string bytes, bool last);
+  void run();
+  void accept();
+  void receive(HostConnection* connection);
+  void dispatch(HostConnection* connection, const std::string& head, const std::string& body);
+  void takeMailbox();
+  void disconnect(HostConnection* connection);
+
+  struct Outgoing {
+    HostConnection* connection;
+    std::string bytes;
+    bool last;
+  };
+
+  uint16_t listenPort;
+  int listenFd = -1;
+  int wakeFds[2] = {-1, -1};
+  std::vector<AsyncWebHandler*> handlers;
+  ArRequestHandlerFunction notFoundHandler;
+  std::vector<HostConnection*> connections;  // server thread only
+  std::mutex mailboxLock;
+  std::vector<Outgoing> mailbox;
+};
+
+#endif // HOST_ESP_ASYNC_WEB_SERVER_H
@@ -0,0 +1,135 @@
+#ifndef HOST_HTTP_CLIENT_H
+#define HOST_HTTP_CLIENT_H
+
+// Arduino-ESP32 HTTPClient over a blocking POSIX socket: one HTTP/1.1
+// request per connection (Connection: close), http:// only, the response
+// read up to Content-Length or the close. Errors are the library's
+// negative codes.
+
+#include <ctype.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+static const int HTTPC_ERROR_CONNECTION_REFUSED = -1;
+static const int HTTPC_ERROR_SEND_PAYLOAD_FAILED = -3;
+static const int HTTPC_ERROR_NOT_CONNECTED = -4;
+static const int HTTPC_ERROR_READ_TIMEOUT = -11;
+
+class HTTPClient {
+ public:
+  ~HTTPClient() { end(); }
+
+  void setTimeout(uint16_t timeoutMs) { this->timeoutMs = timeoutMs; }
+
+  bool begin(WiFiClient& client, const String& url) {
+    if (client.secure() || !url.startsWith("http://")) return false;
+    int hostStart = 7;
+    int pathStart = url.indexOf('/', hostStart);
+    String authority = pathStart < 0 ? url.substring(hostStart) : url.substring(hostStart, pathStart);
+    path = pathStart < 0 ? String("/") : url.substring(pathStart);
+    int colon = authority.indexOf(':');
+    host = colon < 0 ? authority : authority.substring(0, colon);
+    port = colon < 0 ? String("80") : authority.substring(colon + 1);
+    headers = "";
+    return host.length() > 0;
+  }
+
+  void addHeader(const String& name, const String& value) { headers += name + ": " + value + "\r\n"; }
+
+  int GET() { return sendRequest("GET", ""); }
+  int POST(const String& body) { return sendRequest("POST", body); }
+  int PUT(const String& body) { return sendRequest("PUT", body); }
+  String getString() { return body; }
+
+  void end() {
+    if (fd >= 0) close(fd);
+    fd = -1;
+  }
+
+ private:
+  int sendRequest(const char* method, const String& payload) {
+    body = "";
+    end();
+    if (!connectTo()) return HTTPC_ERROR_CONNECTION_REFUSED;
+
+    String request = String(method) + " " + path + " HTTP/1.1\r\nHost: " + host + ":" + port + "\r\n" + headers +
+                     "Content-Length: " + String(payload.length()) + "\r\nConnection: close\r\n\r\n" + payload;
+    if (!sendAll(request)) return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+    return readResponse();
+  }
+
+  bool connectTo() {
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) return false;
+    for (addrinfo* address = addresses; address && fd < 0; address = address->ai_next) {
+      fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+      if (fd < 0) continue;
+      timeval timeout = {(time_t)(timeoutMs / 1000), (suseconds_t)(timeoutMs % 1000 * 1000)};
+      setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+      setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+      if (connect(fd, address->ai_addr, address->ai_addrlen) != 0) end();
+    }
+    freeaddrinfo(addresses);
+    return fd >= 0;
+  }
+
+  bool sendAll(const String& data) {
+    size_t sent = 0;
+    while (sent < data.length()) {
+      ssize_t n = send(fd, data.c_str() + sent, data.length() - sent, MSG_NOSIGNAL);
+      if (n <= 0) return false;
+      sent += n;
+    }
+    return true;
+  }
+
+  int readResponse() {
+    std::string response;
+    char buffer[1024];
+    size_t headerEnd = std::string::npos;
+    long contentLength = -1;
+    for (;;) {
+      if (headerEnd != std::string::npos && contentLength >= 0 &&
+          response.size() >= headerEnd + 4 + (size_t)contentLength) {
+        break;
+      }
+      ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+      if (n < 0) return HTTPC_ERROR_READ_TIMEOUT;
+      if (n == 0) break;
+      response.append(buffer, n);
+      if (headerEnd == std::string::npos && (headerEnd = response.find("\r\n\r\n")) != std::string::npos) {
+        size_t field = lowercase(response.substr(0, headerEnd)).find("\r\ncontent-length:");
+        if (field != std::string::npos) contentLength = atol(response.c_str() + field + 17);
+      }
+    }
+    end();
+    int status = 0;
+    if (headerEnd == std::string::npos || sscanf(response.c_str(), "HTTP/%*s %d", &status) != 1) {
+      return HTTPC_ERROR_NOT_CONNECTED;
+    }
+    body = response.substr(headerEnd + 4).c_str();
+    return status;
+  }
+
+  static std::string lowercase(std::string text) {
+    for (char& c : text) c = tolower(c);
+    return text;
+  }
+
+  String host;
+  String port;
+  String path;
+  String headers;
+  String body;
+  uint16_t timeoutMs = 5000;
+  int fd = -1;
+};
+
+#endif // HOST_HTTP_CLIENT_H
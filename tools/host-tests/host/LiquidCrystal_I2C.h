@@ -0,0 +1,73 @@
+#ifndef HOST_LIQUID_CRYSTAL_I2C_H
+#define HOST_LIQUID_CRYSTAL_I2C_H
+
+// Model of a HD44780 LCD behind a PCF8574 expander, driven the way the
+// LiquidCrystal_I2C library drives it: every command or character byte is
+// two nibbles, each one expander write plus two for the enable pulse, and
+// every expander write is its own I2C transaction. Counts those writes and
+// keeps the characters shown, so a harness can check both.
+
+#include <Arduino.h>
+
+class LiquidCrystal_I2C : public Print {
+ public:
+  static const uint8_t WRITES_PER_BYTE = 6;
+
+  LiquidCrystal_I2C(uint8_t address, uint8_t cols, uint8_t rows) : cols(cols), rows(rows) {
+    (void)address;
+    clearCells();
+  }
+
+  // Library init: backlight write, four 4-bit setup nibbles, then function
+  // set, display on, clear, entry mode and home.
+  void init() {
+    expanderWrites += 1 + 4 * 3;
+    for (uint8_t i = 0; i < 5; i++) send();
+    clearCells();
+  }
+  void backlight() { expanderWrites++; }
+  void clear() {
+    send();
+    clearCells();
+  }
+  void setCursor(uint8_t col, uint8_t row) {
+    send();
+    cursorCol = col;
+    cursorRow = row;
+  }
+  void createChar(uint8_t location, uint8_t* glyph) {
+    (void)location;
+    (void)glyph;
+    for (uint8_t i = 0; i < 9; i++) send();
+  }
+  size_t write(uint8_t value) {
+    send();
+    if (cursorRow < rows && cursorCol < cols) cells[cursorRow][cursorCol] = (char)value;
+    cursorCol++;
+    return 1;
+  }
+  size_t write(const uint8_t* buffer, size_t size) override {
+    for (size_t i = 0; i < size; i++) write(buffer[i]);
+    return size;
+  }
+
+  // Host side.
+  char cell(uint8_t row, uint8_t col) const { return cells[row][col]; }
+  unsigned long expanderWrites = 0;
+
+ private:
+  void send() { expanderWrites += WRITES_PER_BYTE; }
+  void clearCells() {
+    memset(cells, ' ', sizeof(cells));
+    cursorCol = 0;
+    cursorRow = 0;
+  }
+
+  uint8_t cols;
+  uint8_t rows;
+  uint8_t cursorCol = 0;
+  uint8_t cursorRow = 0;
+  char cells[4][20];
+};
+
+#endif // HOST_LIQUID_CRYSTAL_I2C_H
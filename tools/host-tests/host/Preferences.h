@@ -0,0 +1,124 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+// Model of the Arduino-ESP32 Preferences API over NVS, in memory. Keeps
+// one key/value map per namespace and counts reads, writes and the 32-byte
+// NVS entries each write takes (ESP-IDF format: one for an integer, a blob
+// index, a chunk header and the data for a blob). A harness can cut the
+// power: after cutAfterWrites(n), the (n+1)th write and every one after it
+// is dropped, as if the device lost power mid-sequence, until powerOn().
+
+#include <map>
+#include <string>
+#include <vector>
+#include <Arduino.h>
+
+class Preferences {
+ public:
+  bool begin(const char* name, bool readOnly = false) {
+    current = &spaces[name];
+    this->readOnly = readOnly;
+    return true;
+  }
+  void end() { current = nullptr; }
+
+  bool clear() {
+    if (!writable()) return false;
+    current->clear();
+    return true;
+  }
+  bool remove(const char* key) {
+    if (!writable()) return false;
+    return current->erase(key) > 0;
+  }
+
+  size_t putBool(const char* key, bool value) { return putUChar(key, value ? 1 : 0); }
+  size_t putUChar(const char* key, uint8_t value) { return put(key, &value, sizeof(value), 1); }
+  size_t putUInt(const char* key, uint32_t value) { return put(key, &value, sizeof(value), 1); }
+  size_t putBytes(const char* key, const void* value, size_t length) {
+    return put(key, value, length, 2 + (length + ENTRY_SIZE - 1) / ENTRY_SIZE);
+  }
+  // Stored with its terminator, in a header entry plus the data entries.
+  size_t putString(const char* key, const String& value) {
+    size_t length = value.length() + 1;
+    return put(key, value.c_str(), length, 1 + (length + ENTRY_SIZE - 1) / ENTRY_SIZE) ? value.length() : 0;
+  }
+
+  uint8_t getUChar(const char* key, uint8_t defaultValue = 0) {
+    uint8_t value = defaultValue;
+    get(key, &value, sizeof(value), true);
+    return value;
+  }
+  uint32_t getUInt(const char* key, uint32_t defaultValue = 0) {
+    uint32_t value = defaultValue;
+    get(key, &value, sizeof(value), true);
+    return value;
+  }
+  String getString(const char* key, const String& defaultValue = String()) {
+    char value[4000];
+    return get(key, value, sizeof(value), false) ? String(value) : defaultValue;
+  }
+  bool isKey(const char* key) { return current && current->count(key) > 0; }
+  // Like NVS: 0 if the key is missing or the blob does not fit.
+  size_t getBytes(const char* key, void* buffer, size_t maxLength) { return get(key, buffer, maxLength, false); }
+
+  // Host side.
+  static const size_t ENTRY_SIZE = 32;
+  unsigned long reads = 0;
+  unsigned long writes = 0;
+  unsigned long bytesWritten = 0;
+  unsigned long entriesWritten = 0;
+
+  void cutAfterWrites(unsigned long count) {
+    powered = true;
+    writesLeft = count;
+    cutArmed = true;
+  }
+  void powerOn() {
+    powered = true;
+    cutArmed = false;
+  }
+  bool poweredOff() const { return !powered; }
+
+ private:
+  typedef std::map<std::string, std::vector<uint8_t>> Space;
+
+  bool writable() {
+    if (!current || readOnly || !powered) return false;
+    if (cutArmed && writesLeft-- == 0) {
+      powered = false;
+      return false;
+    }
+    writes++;
+    return true;
+  }
+
+  size_t put(const char* key, const void* value, size_t length, unsigned long entries) {
+    if (!writable()) return 0;
+    const uint8_t* bytes = (const uint8_t*)value;
+    (*current)[key].assign(bytes, bytes + length);
+    bytesWritten += length;
+    entriesWritten += entries;
+    return length;
+  }
+
+  size_t get(const char* key, void* buffer, size_t length, bool exact) {
+    if (!current) return 0;
+    reads++;
+    Space::const_iterator it = current->find(key);
+    if (it == current->end()) return 0;
+    size_t stored = it->second.size();
+    if (exact ? stored != length : stored > length) return 0;
+    memcpy(buffer, it->second.data(), stored);
+    return stored;
+  }
+
+  std::map<std::string, Space> spaces;
+  Space* current = nullptr;
+  bool readOnly = false;
+  bool powered = true;
+  bool cutArmed = false;
+  unsigned long writesLeft = 0;
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,32 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+// Wi-Fi whose link state the harness sets.
+
+#include <stdint.h>
+
+static const int WL_CONNECTED = 3;
+static const int WL_DISCONNECTED = 6;
+
+class IPAddress {
+ public:
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+  uint8_t operator[](int index) const { return bytes[index]; }
+
+ private:
+  uint8_t bytes[4];
+};
+
+class HostWiFi {
+ public:
+  void begin(const char* ssid, const char* password) { (void)ssid; (void)password; }
+  int status() const { return connected ? WL_CONNECTED : WL_DISCONNECTED; }
+  IPAddress localIP() const { return IPAddress(192, 168, 1, 42); }
+
+  // Host side.
+  bool connected = true;
+};
+
+inline HostWiFi WiFi;
+
+#endif // HOST_WIFI_H
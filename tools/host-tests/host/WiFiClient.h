@@ -0,0 +1,13 @@
+#ifndef HOST_WIFI_CLIENT_H
+#define HOST_WIFI_CLIENT_H
+
+// The client HTTPClient (host/HTTPClient.h) runs over. On the host that is
+// a plain socket it opens itself, so this only says whether TLS was asked.
+
+class WiFiClient {
+ public:
+  virtual ~WiFiClient() {}
+  virtual bool secure() const { return false; }
+};
+
+#endif // HOST_WIFI_CLIENT_H
@@ -0,0 +1,15 @@
+#ifndef HOST_WIFI_CLIENT_SECURE_H
+#define HOST_WIFI_CLIENT_SECURE_H
+
+// TLS client. The host has no TLS: HTTPClient refuses https:// URLs, so
+// host builds talk plain HTTP to a local stand-in.
+
+#include <WiFiClient.h>
+
+class WiFiClientSecure : public WiFiClient {
+ public:
+  void setInsecure() {}
+  bool secure() const override { return true; }
+};
+
+#endif // HOST_WIFI_CLIENT_SECURE_H
@@ -0,0 +1,399 @@
+#include <ESPAsyncWebServer.h>
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <thread>
+
+// CHANGE HERE: largest request head accepted (bytes) and listen backlog.
+static const size_t MAX_REQUEST_HEAD = 8192;
+static const int LISTEN_BACKLOG = 64;
+
+// One client socket, owned by the server thread. finished is guarded by
+// the mailbox lock: once the last bytes are queued, later posts are dropped.
+struct HostConnection {
+  int fd;
+  std::string in;
+  std::string out;
+  bool closeWhenSent = false;
+  bool finished = false;
+  AsyncWebServerRequest* request = nullptr;
+  AsyncEventSourceClient* events = nullptr;
+};
+
+// ---------------------- Responses ----------------------
+
+static const char* reasonPhrase(int code) {
+  switch (code) {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 409: return "Conflict";
+    case 413: return "Payload Too Large";
+    case 431: return "Request Header Fields Too Large";
+    case 502: return "Bad Gateway";
+    case 503: return "Service Unavailable";
+    case 504: return "Gateway Timeout";
+    default: return "";
+  }
+}
+
+std::string AsyncWebServerResponse::serialize() const {
+  bool hasBody = code != 204 && code != 304;
+  char status[64];
+  snprintf(status, sizeof(status), "HTTP/1.1 %d %s\r\n", code, reasonPhrase(code));
+  std::string out = status;
+  if (hasBody && contentType.length() > 0) out += std::string("Content-Type: ") + contentType.c_str() + "\r\n";
+  out += headers.c_str();
+  if (hasBody) out += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+  out += "Connection: close\r\n\r\n";
+  if (hasBody) out += body;
+  return out;
+}
+
+// ---------------------- Requests ----------------------
+
+const AsyncWebParameter* AsyncWebServerRequest::getParam(const char* name) const {
+  for (const AsyncWebParameter& param : params) {
+    if (param.name() == name) return &param;
+  }
+  return nullptr;
+}
+
+const AsyncWebHeader* AsyncWebServerRequest::getHeader(const char* name) const {
+  for (const AsyncWebHeader& header : headers) {
+    if (strcasecmp(header.name().c_str(), name) == 0) return &header;
+  }
+  return nullptr;
+}
+
+void AsyncWebServerRequest::send(int code, const char* contentType, const String& body) {
+  send(beginResponse(code, contentType, body));
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse* response) {
+  server->post(connection, response->serialize(), true);
+  delete response;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(int code, const char* contentType, const String& body) {
+  return new AsyncWebServerResponse(code, contentType, std::string(body.c_str(), body.length()));
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse_P(int code, const char* contentType,
+                                                               const uint8_t* data, size_t len) {
+  return new AsyncWebServerResponse(code, contentType, std::string((const char*)data, len));
+}
+
+AsyncResponseStream* AsyncWebServerRequest::beginResponseStream(const char* contentType, size_t bufferSize) {
+  return new AsyncResponseStream(contentType, bufferSize);
+}
+
+// ---------------------- Server-Sent Events ----------------------
+
+static std::string eventText(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+  std::string text;
+  if (reconnect) text += "retry: " + std::to_string(reconnect) + "\n";
+  if (id) text += "id: " + std::to_string(id) + "\n";
+  if (event) text += std::string("event: ") + event + "\n";
+  const char* line = message;
+  for (;;) {
+    const char* end = strchr(line, '\n');
+    text += "data: " + (end ? std::string(line, end - line) : std::string(line)) + "\n";
+    if (!end) break;
+    line = end + 1;
+  }
+  return text + "\n";
+}
+
+void AsyncEventSourceClient::send(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+  source->server->post(connection, eventText(message, event, id, reconnect), false);
+}
+
+void AsyncEventSource::send(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+  std::string text = eventText(message, event, id, reconnect);
+  std::lock_guard<std::mutex> guard(clientsLock);
+  for (AsyncEventSourceClient* client : clients) server->post(client->connection, text, false);
+}
+
+size_t AsyncEventSource::count() const {
+  std::lock_guard<std::mutex> guard(clientsLock);
+  return clients.size();
+}
+
+// Server thread. The stream headers are queued before the client is listed,
+// so no event can overtake them.
+void AsyncEventSource::handleRequest(AsyncWebServerRequest* request) {
+  if (authorizeHandler && !authorizeHandler(request)) {
+    request->send(403, "text/plain", "Forbidden");
+    return;
+  }
+  server = request->server;
+  AsyncEventSourceClient* client = new AsyncEventSourceClient();
+  client->source = this;
+  client->connection = request->connection;
+  request->connection->events = client;
+  server->post(client->connection,
+               "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n"
+               "Connection: keep-alive\r\n\r\n",
+               false);
+  {
+    std::lock_guard<std::mutex> guard(clientsLock);
+    clients.push_back(client);
+  }
+  if (connectHandler) connectHandler(client);
+}
+
+void AsyncEventSource::removeClient(HostConnection* connection) {
+  std::lock_guard<std::mutex> guard(clientsLock);
+  for (size_t i = 0; i < clients.size(); i++) {
+    if (clients[i]->connection != connection) continue;
+    delete clients[i];
+    clients.erase(clients.begin() + i);
+    return;
+  }
+}
+
+// ---------------------- Server ----------------------
+
+AsyncCallbackWebHandler& AsyncWebServer::on(const char* url, WebRequestMethodComposite method,
+                                            ArRequestHandlerFunction onRequest, ArUploadHandlerFunction,
+                                            ArBodyHandlerFunction onBody) {
+  AsyncCallbackWebHandler* handler = new AsyncCallbackWebHandler(url, method, onRequest, onBody);
+  handlers.push_back(handler);
+  return *handler;
+}
+
+AsyncWebHandler& AsyncWebServer::addHandler(AsyncWebHandler* handler) {
+  handlers.push_back(handler);
+  return *handler;
+}
+
+void AsyncWebServer::begin() {
+  listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  int reuse = 1;
+  setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(listenPort);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t length = sizeof(address);
+  if (listenFd < 0 || bind(listenFd, (sockaddr*)&address, sizeof(address)) != 0 ||
+      listen(listenFd, LISTEN_BACKLOG) != 0 || getsockname(listenFd, (sockaddr*)&address, &length) != 0 ||
+      pipe2(wakeFds, O_NONBLOCK) != 0) {
+    perror("AsyncWebServer");
+    exit(1);
+  }
+  listenPort = ntohs(address.sin_port);
+  std::thread([this]() { run(); }).detach();
+}
+
+void AsyncWebServer::post(HostConnection* connection, std::string bytes, bool last) {
+  {
+    std::lock_guard<std::mutex> guard(mailboxLock);
+    if (connection->finished) return;
+    connection->finished = last;
+    mailbox.push_back({connection, std::move(bytes), last});
+  }
+  char wake = 0;
+  (void)!write(wakeFds[1], &wake, 1);
+}
+
+void AsyncWebServer::takeMailbox() {
+  std::vector<Outgoing> taken;
+  {
+    std::lock_guard<std::mutex> guard(mailboxLock);
+    taken.swap(mailbox);
+  }
+  for (Outgoing& outgoing : taken) {
+    outgoing.connection->out += outgoing.bytes;
+    if (outgoing.last) outgoing.connection->closeWhenSent = true;
+  }
+}
+
+// Read, poll every socket and the wake pipe, hand out queued bytes, write.
+void AsyncWebServer::run() {
+  std::vector<pollfd> fds;
+  for (;;) {
+    std::vector<HostConnection*> polled = connections;
+    fds.assign({{wakeFds[0], POLLIN, 0}, {listenFd, POLLIN, 0}});
+    for (HostConnection* connection : polled) {
+      fds.push_back({connection->fd, (short)(POLLIN | (connection->out.empty() ? 0 : POLLOUT)), 0});
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) continue;
+      perror("AsyncWebServer poll");
+      exit(1);
+    }
+
+    char drain[64];
+    while (read(wakeFds[0], drain, sizeof(drain)) > 0) {}
+    for (size_t i = 0; i < polled.size(); i++) {
+      if (fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR)) receive(polled[i]);
+    }
+    takeMailbox();
+
+    std::vector<HostConnection*> open = connections;
+    for (HostConnection* connection : open) {
+      while (!connection->out.empty()) {
+        ssize_t sent = ::send(connection->fd, connection->out.data(), connection->out.size(), MSG_NOSIGNAL);
+        if (sent <= 0) break;
+        connection->out.erase(0, sent);
+      }
+      if (connection->out.empty() && connection->closeWhenSent) disconnect(connection);
+    }
+    if (fds[1].revents & POLLIN) accept();
+  }
+}
+
+void AsyncWebServer::accept() {
+  for (;;) {
+    int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+    if (fd < 0) return;
+    HostConnection* connection = new HostConnection();
+    connection->fd = fd;
+    connections.push_back(connection);
+  }
+}
+
+// Collect one request; input after it is ignored. A read of 0 or an error
+// means the client left.
+void AsyncWebServer::receive(HostConnection* connection) {
+  char buffer[2048];
+  ssize_t n = recv(connection->fd, buffer, sizeof(buffer), 0);
+  if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+    disconnect(connection);
+    return;
+  }
+  if (n < 0 || connection->request || connection->events || connection->closeWhenSent) return;
+
+  connection->in.append(buffer, n);
+  size_t headEnd = connection->in.find("\r\n\r\n");
+  if (headEnd == std::string::npos) {
+    if (connection->in.size() > MAX_REQUEST_HEAD) {
+      post(connection, AsyncWebServerResponse(431, "text/plain", "").serialize(), true);
+    }
+    return;
+  }
+  std::string head = connection->in.substr(0, headEnd);
+  size_t length = 0;
+  for (size_t line = head.find("\r\n"); line != std::string::npos; line = head.find("\r\n", line + 2)) {
+    if (strncasecmp(head.c_str() + line + 2, "Content-Length:", 15) == 0) {
+      length = strtoul(head.c_str() + line + 17, nullptr, 10);
+    }
+  }
+  if (connection->in.size() < headEnd + 4 + length) return;
+  dispatch(connection, head, connection->in.substr(headEnd + 4, length));
+  connection->in.clear();
+}
+
+static String urlDecode(const std::string& text) {
+  std::string decoded;
+  for (size_t i = 0; i < text.size(); i++) {
+    if (text[i] == '+') {
+      decoded += ' ';
+    } else if (text[i] == '%' && i + 2 < text.size() && isxdigit(text[i + 1]) && isxdigit(text[i + 2])) {
+      decoded += (char)strtol(text.substr(i + 1, 2).c_str(), nullptr, 16);
+      i += 2;
+    } else {
+      decoded += text[i];
+    }
+  }
+  return String(decoded.c_str());
+}
+
+void AsyncWebServer::dispatch(HostConnection* connection, const std::string& head, const std::string& body) {
+  AsyncWebServerRequest* request = new AsyncWebServerRequest();
+  request->server = this;
+  request->connection = connection;
+  connection->request = request;
+
+  size_t lineEnd = head.find("\r\n");
+  std::string requestLine = head.substr(0, lineEnd);
+  size_t methodEnd = requestLine.find(' ');
+  size_t targetEnd = requestLine.find(' ', methodEnd + 1);
+  std::string method = requestLine.substr(0, methodEnd);
+  std::string target = methodEnd == std::string::npos ? "" : requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+  request->requestMethod = method == "GET" ? HTTP_GET : method == "POST" ? HTTP_POST : 0;
+
+  size_t queryStart = target.find('?');
+  request->path = urlDecode(target.substr(0, queryStart));
+  if (queryStart != std::string::npos) {
+    std::string query = target.substr(queryStart + 1);
+    for (size_t start = 0; start <= query.size();) {
+      size_t end = std::min(query.find('&', start), query.size());
+      std::string pair = query.substr(start, end - start);
+      size_t equals = pair.find('=');
+      if (!pair.empty()) {
+        request->params.emplace_back(urlDecode(pair.substr(0, equals)),
+                                     equals == std::string::npos ? String() : urlDecode(pair.substr(equals + 1)));
+      }
+      start = end + 1;
+    }
+  }
+  while (lineEnd != std::string::npos) {
+    size_t start = lineEnd + 2;
+    lineEnd = head.find("\r\n", start);
+    std::string line = head.substr(start, lineEnd == std::string::npos ? std::string::npos : lineEnd - start);
+    size_t colon = line.find(':');
+    if (colon == std::string::npos) continue;
+    size_t value = line.find_first_not_of(' ', colon + 1);
+    request->headers.emplace_back(String(line.substr(0, colon).c_str()),
+                                  String(value == std::string::npos ? "" : line.substr(value).c_str()));
+  }
+  request->bodyLength = body.size();
+
+  AsyncWebHandler* handler = nullptr;
+  for (AsyncWebHandler* candidate : handlers) {
+    if (candidate->canHandle(request)) {
+      handler = candidate;
+      break;
+    }
+  }
+  if (!handler) {
+    if (notFoundHandler) notFoundHandler(request);
+    else request->send(404);
+    return;
+  }
+  if (!body.empty()) {
+    std::vector<uint8_t> data(body.begin(), body.end());
+    handler->handleBody(request, data.data(), data.size(), 0, data.size());
+  }
+  handler->handleRequest(request);
+
+  // An event stream outlives its request, as in the library.
+  if (connection->events) {
+    connection->request = nullptr;
+    delete request;
+  }
+}
+
+// Server thread, with no lock held while the disconnect handler runs; it
+// may wait for a sender that still holds the request. Anything queued for
+// the connection after that is dropped.
+void AsyncWebServer::disconnect(HostConnection* connection) {
+  connections.erase(std::find(connections.begin(), connections.end(), connection));
+  close(connection->fd);
+  if (connection->request && connection->request->disconnectHandler) connection->request->disconnectHandler();
+  if (connection->events) connection->events->source->removeClient(connection);
+  {
+    std::lock_guard<std::mutex> guard(mailboxLock);
+    mailbox.erase(std::remove_if(mailbox.begin(), mailbox.end(),
+                                 [connection](const Outgoing& outgoing) { return outgoing.connection == connection; }),
+                  mailbox.end());
+  }
+  delete connection->request;
+  delete connection;
+}
@@ -0,0 +1,18 @@
+#ifndef FIREBASE_CONFIG_H
+#define FIREBASE_CONFIG_H
+
+// Host build of cloud_sync.cpp (tools/host-tests/cloud-sync-device): plain
+// HTTP to the local RTDB stand-in, whose address comes from --url.
+
+const char* hostDatabaseUrl();
+const char* hostAuthUrl();
+
+#define FIREBASE_API_KEY "host"
+#define FIREBASE_DATABASE_URL hostDatabaseUrl()
+#define FIREBASE_AUTH_URL hostAuthUrl()
+#define FIREBASE_DEVICE_EMAIL "host-device@example.com"
+#define FIREBASE_DEVICE_PASSWORD "host"
+#define FIREBASE_DEVICE_ID "host-device"
+#define FIREBASE_PUBLISH_METRICS 0
+
+#endif // FIREBASE_CONFIG_H
@@ -0,0 +1,7 @@
+#ifndef HOST_PGMSPACE_H
+#define HOST_PGMSPACE_H
+
+// Flash and RAM share one address space on the host.
+#define PROGMEM
+
+#endif // HOST_PGMSPACE_H
@@ -0,0 +1,15 @@
+#ifndef HOST_SKETCH_PRELUDE_H
+#define HOST_SKETCH_PRELUDE_H
+
+// Force-included (-include) into web_api.cpp for what it gets without
+// including it: settimeofday(), which the ESP32 toolchain's <time.h>
+// declares, and the two timezone helpers it calls, which no header in the
+// sketch declares.
+
+#include <sys/time.h>
+#include <time.h>
+
+void ensureLocalTimezoneConfigured();
+void updateRtcDstStateFromLocalTime(const struct tm& localTime);
+
+#endif // HOST_SKETCH_PRELUDE_H
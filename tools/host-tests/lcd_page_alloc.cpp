@@ -0,0 +1,154 @@
+// LcdPage on the host: fills 16x2 and 20x4 pages through printLine(),
+// setLine() and clear() and checks the rows (clipping, padding, the Wi-Fi
+// cell, generation bumps) with every heap entry point counted. Any
+// allocation while a page is being written fails the run.
+
+#include <new>
+#include "peripherals.h"
+
+// ---------------------- Allocation Counter ----------------------
+// Replaces the C and C++ allocators for the whole process (glibc's own
+// vsnprintf included); only calls made while counting is set are counted.
+
+static bool counting = false;
+static unsigned long allocations = 0;
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+extern "C" void __libc_free(void* ptr);
+
+extern "C" void* malloc(size_t size) {
+  if (counting) allocations++;
+  return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+  if (counting) allocations++;
+  return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) {
+  if (counting) allocations++;
+  return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void* ptr) {
+  __libc_free(ptr);
+}
+
+void* operator new(size_t size) {
+  if (counting) allocations++;
+  void* ptr = __libc_malloc(size ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept { __libc_free(ptr); }
+void operator delete[](void* ptr) noexcept { __libc_free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { __libc_free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { __libc_free(ptr); }
+
+// ---------------------- Checks ----------------------
+
+static unsigned failures = 0;
+
+static void check(const char* name, bool ok) {
+  printf("%s %s\n", ok ? "PASS" : "FAIL", name);
+  if (!ok) failures++;
+}
+
+template <uint8_t COLS, uint8_t ROWS>
+static bool rowIs(const LcdPage<COLS, ROWS>& page, uint8_t row, const char* text) {
+  return strcmp(page.lines[row], text) == 0;
+}
+
+template <uint8_t COLS, uint8_t ROWS>
+static bool allBlank(const LcdPage<COLS, ROWS>& page) {
+  for (uint8_t r = 0; r < ROWS; r++) {
+    uint8_t width = r == 0 ? COLS - 1 : COLS;
+    if (strlen(page.lines[r]) != width || strspn(page.lines[r], " ") != width) return false;
+  }
+  return true;
+}
+
+// The updateDisplay() formats, plus the clipping and unchanged-text cases.
+template <uint8_t COLS, uint8_t ROWS>
+static void exercise(const char* size, LcdPage<COLS, ROWS>& page) {
+  char name[64];
+  page.init(5000);
+  snprintf(name, sizeof(name), "%s init blanks every row", size);
+  check(name, allBlank(page) && page.intervalMs == 5000);
+
+  uint32_t generation = page.generation;
+  page.printLine(0, "%s   %02d:%02d", "FRI", 9, 5);
+  page.printLine(ROWS - 1, "IP:%u.%u.%u.%u", 192U, 168U, 1U, 42U);
+  page.setLine(1, "Clock Status: ON");
+  page.printLine(ROWS, "%s", "out of range");
+  snprintf(name, sizeof(name), "%s generation counts changed rows", size);
+  check(name, page.generation == generation + 3);
+
+  char expected[COLS + 1];
+  snprintf(expected, sizeof(expected), "%-*s", COLS - 1, "FRI   09:05");
+  snprintf(name, sizeof(name), "%s row 0 padded, Wi-Fi cell left out", size);
+  check(name, rowIs(page, 0, expected));
+
+  snprintf(expected, sizeof(expected), "%-*.*s", COLS, COLS, "Clock Status: ON");
+  snprintf(name, sizeof(name), "%s setLine fills the row", size);
+  check(name, rowIs(page, 1, expected));
+
+  generation = page.generation;
+  page.setLine(1, "Clock Status: ON");
+  page.printLine(0, "%s   %02d:%02d", "FRI", 9, 5);
+  snprintf(name, sizeof(name), "%s same text keeps the generation", size);
+  check(name, page.generation == generation);
+
+  page.printLine(0, "%s", "a row far longer than any LCD line");
+  snprintf(expected, sizeof(expected), "%.*s", COLS - 1, "a row far longer than any LCD line");
+  snprintf(name, sizeof(name), "%s long text clipped", size);
+  check(name, rowIs(page, 0, expected));
+
+  page.clear();
+  snprintf(name, sizeof(name), "%s clear blanks every row", size);
+  check(name, allBlank(page));
+}
+
+int main() {
+  // Built outside the counted window: the pages and stdout's buffer.
+  static LcdPage<16, 2> small;
+  static LcdPage<20, 4> large;
+  printf("LcdPage allocation check\n");
+  fflush(stdout);
+
+  // The counter itself: one new[] and one malloc() must both show up.
+  static char* volatile probe;
+  counting = true;
+  probe = new char[8];
+  delete[] probe;
+  probe = (char*)malloc(8);
+  free(probe);
+  counting = false;
+  check("counter sees new[] and malloc", allocations == 2);
+
+  char name[64];
+  counting = true;
+  allocations = 0;
+  exercise("16x2", small);
+  unsigned long smallAllocations = allocations;
+  allocations = 0;
+  exercise("20x4", large);
+  unsigned long largeAllocations = allocations;
+  counting = false;
+
+  snprintf(name, sizeof(name), "16x2 no heap allocations (%lu)", smallAllocations);
+  check(name, smallAllocations == 0);
+  snprintf(name, sizeof(name), "20x4 no heap allocations (%lu)", largeAllocations);
+  check(name, largeAllocations == 0);
+
+  printf(failures == 0 ? "LcdPage OK\n" : "LcdPage FAILED\n");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// LCD bus traffic of the clock's display code: runs the real updateDisplay()
+// (peripherals.cpp) every DISPLAY_TASK_PERIOD on a simulated clock and
+// counts the expander writes the LCD model (host/LiquidCrystal_I2C.h) sees.
+// For comparison the same frames are replayed the way the old render() sent
+// them: every cell of the page plus the Wi-Fi icon on every update.
+//   ./lcd-traffic [--minutes N]
+
+#include <stdlib.h>
+#include <LiquidCrystal_I2C.h>
+#include <RTClib.h>
+#include <WiFi.h>
+#include "i2c_bus.h"
+#include "metrics.h"
+#include "peripherals.h"
+
+// ---------------------- Firmware Globals ----------------------
+
+const char* ssid = "host";
+const char* password = "";
+const uint8_t SDA_PIN = 6;
+const uint8_t SCL_PIN = 7;
+bool relay_state = false;
+bool shabbatMode = false;
+bool timeValid = true;
+bool lcdAvailable = false;
+bool rtcAvailable = false;
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+RTC_DS3231 rtc;
+
+// ---------------------- Simulated Time ----------------------
+
+// Friday 2024-01-05 09:00:00, local.
+static const uint32_t START_TIME = 1704445200UL;
+static unsigned long nowMs = 0;
+
+unsigned long millis() { return nowMs; }
+unsigned long micros() { return nowMs * 1000UL; }
+void delay(unsigned long ms) { nowMs += ms; }
+int64_t esp_timer_get_time() { return (int64_t)nowMs * 1000; }
+uint32_t esp_random() { return 4; }
+
+DateTime getCurrentDateTime() {
+  return DateTime(START_TIME + nowMs / 1000);
+}
+
+// ---------------------- Stand-ins ----------------------
+
+size_t Print::printf(const char* format, ...) {
+  char line[256];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+  if (length < 0) return 0;
+  if ((size_t)length >= sizeof(line)) length = sizeof(line) - 1;
+  return write((const uint8_t*)line, length);
+}
+
+HostSerial Serial;
+
+size_t HostSerial::write(const uint8_t*, size_t size) {
+  return size;
+}
+
+// The bus manager never starts, so frames are drawn on the caller's thread.
+void i2cRegisterDevice(I2cDevice, const I2cDeviceConfig&, bool) {}
+void initI2cBus() {}
+bool i2cBusStarted() { return false; }
+bool i2cSubmit(I2cDevice, I2cJobFn, const void*, uint8_t) { return false; }
+
+static uint32_t counters[METRIC_COUNTER_COUNT];
+
+void metricsCount(MetricCounter counter, uint32_t amount) {
+  counters[counter] += amount;
+}
+
+// ---------------------- Harness ----------------------
+
+// Smart_Shabbat_Clock.ino, without POWER_SAVE_MODE.
+static const unsigned long DISPLAY_TASK_PERIOD = 500;
+// One expander write on the bus: address and data byte, each 8 bits plus
+// ACK, plus start and stop, at 100 kHz.
+static const uint8_t BYTES_PER_WRITE = 2;
+static const uint32_t BUS_US_PER_WRITE = 200;
+
+static unsigned failures = 0;
+
+static void check(const char* name, bool ok) {
+  printf("%s %s\n", ok ? "PASS" : "FAIL", name);
+  if (!ok) failures++;
+}
+
+// What the old render() sent for the page now on the LCD.
+static void replayFullRender(LiquidCrystal_I2C& model) {
+  for (uint8_t r = 0; r < LCD_ROWS; r++) {
+    model.setCursor(0, r);
+    uint8_t width = r == 0 ? LCD_COLS - 1 : LCD_COLS;
+    for (uint8_t c = 0; c < width; c++) model.write((uint8_t)lcd.cell(r, c));
+  }
+  model.setCursor(LCD_COLS - 1, 0);
+  model.write((uint8_t)lcd.cell(0, LCD_COLS - 1));
+}
+
+static void report(const char* name, unsigned long writes, unsigned minutes) {
+  unsigned long perMinute = writes / minutes;
+  printf("  %-24s %7lu writes/min  %7lu B/min  %5.1f ms bus/min\n", name, perMinute,
+         perMinute * BYTES_PER_WRITE, perMinute * BUS_US_PER_WRITE / 1000.0);
+}
+
+int main(int argc, char** argv) {
+  unsigned minutes = 10;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--minutes") == 0 && i + 1 < argc) minutes = atoi(argv[++i]);
+  }
+  if (minutes == 0) minutes = 1;
+
+  initLcdSafely();
+  initPeripheralBus();
+  updateDisplay();
+
+  LiquidCrystal_I2C fullRender(0x27, LCD_COLS, LCD_ROWS);
+  unsigned long startWrites = lcd.expanderWrites;
+  uint32_t startCounter = counters[COUNTER_I2C_LCD_WRITES];
+  unsigned long updates = 0;
+  unsigned long endMs = (unsigned long)minutes * 60000UL;
+  for (nowMs = 0; nowMs < endMs; nowMs += DISPLAY_TASK_PERIOD) {
+    // A relay switch and a Wi-Fi drop partway through.
+    relay_state = nowMs >= endMs / 3;
+    WiFi.connected = !(nowMs >= endMs / 2 && nowMs < endMs / 2 + 30000);
+    updateDisplay();
+    replayFullRender(fullRender);
+    updates++;
+  }
+  unsigned long shadowWrites = lcd.expanderWrites - startWrites;
+
+  printf("LCD traffic, %ux%u, %lu updates over %u min (Wi-Fi down 30 s, one relay switch)\n", LCD_COLS, LCD_ROWS,
+         updates, minutes);
+  report("changed cells (now)", shadowWrites, minutes);
+  report("full page per update", fullRender.expanderWrites, minutes);
+
+  check("i2c_lcd_writes counter matches the bus", counters[COUNTER_I2C_LCD_WRITES] - startCounter == shadowWrites);
+  check("fewer writes than a full redraw", shadowWrites * 4 < fullRender.expanderWrites);
+
+  // The last update must have left the whole page on the LCD.
+  nowMs -= DISPLAY_TASK_PERIOD;
+  DateTime now = getCurrentDateTime();
+  const char* dayNames[] = {"SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT"};
+  char clockRow[LCD_COLS + 1];
+  char modeRow[LCD_COLS + 1];
+  snprintf(clockRow, sizeof(clockRow), "%s   %02d:%02d", dayNames[now.dayOfTheWeek()], now.hour(), now.minute());
+  snprintf(modeRow, sizeof(modeRow), "Mode: %s", shabbatMode ? "Shabbat" : "Week");
+  char shown[LCD_COLS + 1] = {};
+  for (uint8_t c = 0; c < LCD_COLS - 1; c++) shown[c] = lcd.cell(0, c);
+  bool clockPage = strncmp(shown, clockRow, strlen(clockRow)) == 0;
+  bool modePage = strncmp(shown, modeRow, strlen(modeRow)) == 0;
+  check("LCD shows the current page", clockPage || modePage);
+
+  printf(failures == 0 ? "LCD traffic OK\n" : "LCD traffic FAILED\n");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,384 @@
+// Loop activity per hour, before and after the task scheduler: the real
+// task_scheduler.cpp running the clock's loop tasks on a simulated clock,
+// against the old loop() (every subsystem called on every pass, never
+// blocking) replayed on the same clock.
+//
+// Each subsystem call costs a fixed loop time (a tick that finds nothing to
+// do; the same before and after), one row per cost. External events arrive on
+// a fixed timeline: --tabs UI tabs polling /status every 10 s (the async
+// server notifies "web") and --presses button presses (the button task
+// notifies "button", which arms a write-behind flush). Reports loop passes
+// and loop busy share per hour, and the worst delay from an event to the
+// task handling it. The millis() wrap is not covered: unsigned long is 64
+// bits here, so deadlines past it never wrap as they do on the ESP32.
+//   ./loop-schedule [--tabs 3] [--presses 6]
+// Exits non-zero if a task misses its cadence, an event waits longer than
+// a pass, or the scheduler's accounting disagrees with the simulated clock.
+
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "task_scheduler.h"
+
+// ---------------------- Simulated Time ----------------------
+
+static const uint64_t HOUR_US = 3600000000ULL;
+static uint64_t nowUs = 0;
+
+unsigned long millis() { return (unsigned long)(nowUs / 1000); }
+unsigned long micros() { return (unsigned long)nowUs; }
+
+static uint64_t callUs = 20;
+
+// One subsystem call: loop time passes.
+static void spend() {
+  nowUs += callUs;
+}
+
+// ---------------------- Events ----------------------
+// Status polls and button presses on a fixed timeline, delivered when the
+// loop blocks (waking it) or between passes.
+
+enum EventKind : uint8_t { EVENT_WEB, EVENT_BUTTON };
+
+struct Event {
+  uint64_t atUs;
+  EventKind kind;
+};
+
+static std::vector<Event> events;
+static size_t nextEvent = 0;
+static uint64_t pendingSince[2];  // oldest unhandled event per kind, 0 = none
+static uint64_t maxLatencyUs[2];
+
+static void buildTimeline(unsigned tabs, unsigned presses) {
+  events.clear();
+  for (unsigned tab = 0; tab < tabs; tab++) {
+    for (uint64_t at = 1000 + tab * 3331000ULL; at < HOUR_US; at += 10000000ULL) events.push_back({at, EVENT_WEB});
+  }
+  for (unsigned i = 0; i < presses; i++) events.push_back({HOUR_US / (presses + 1) * (i + 1) + 777, EVENT_BUTTON});
+  std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.atUs < b.atUs; });
+}
+
+static void handled(EventKind kind) {
+  if (pendingSince[kind] == 0) return;
+  uint64_t latency = nowUs - pendingSince[kind];
+  if (latency > maxLatencyUs[kind]) maxLatencyUs[kind] = latency;
+  pendingSince[kind] = 0;
+}
+
+static void (*deliver)(EventKind kind);
+
+static void deliverDue() {
+  while (nextEvent < events.size() && events[nextEvent].atUs <= nowUs) {
+    Event& event = events[nextEvent++];
+    if (pendingSince[event.kind] == 0) pendingSince[event.kind] = event.atUs;
+    deliver(event.kind);
+  }
+}
+
+// ---------------------- FreeRTOS / Arduino Stand-ins ----------------------
+
+static bool semaphoreGiven = false;
+
+SemaphoreHandle_t xSemaphoreCreateBinary() { return &semaphoreGiven; }
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t) {
+  semaphoreGiven = true;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken) {
+  if (woken) *woken = pdTRUE;
+  return xSemaphoreGive(semaphore);
+}
+
+// Block until given or the timeout; events due meanwhile wake it.
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t ticks) {
+  uint64_t timeoutUs = nowUs + (uint64_t)ticks * 1000;
+  while (!semaphoreGiven) {
+    if (nextEvent >= events.size() || events[nextEvent].atUs > timeoutUs) {
+      nowUs = timeoutUs;
+      return pdFALSE;
+    }
+    if (events[nextEvent].atUs > nowUs) nowUs = events[nextEvent].atUs;
+    deliverDue();
+  }
+  semaphoreGiven = false;
+  return pdTRUE;
+}
+
+size_t Print::printf(const char* format, ...) {
+  char line[256];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+  if (length < 0) return 0;
+  if ((size_t)length >= sizeof(line)) length = sizeof(line) - 1;
+  return write((const uint8_t*)line, length);
+}
+
+HostSerial Serial;
+
+size_t HostSerial::write(const uint8_t*, size_t size) {
+  return size;
+}
+
+class StringPrint : public Print {
+ public:
+  size_t write(const uint8_t* buffer, size_t size) override {
+    text.append((const char*)buffer, size);
+    return size;
+  }
+  std::string text;
+};
+
+// ---------------------- Firmware Loop Tasks ----------------------
+// Smart_Shabbat_Clock.ino (without POWER_SAVE_MODE), web_api.cpp,
+// remote_sync.cpp, persistence.cpp and the notify-only one-shots.
+
+static const unsigned long OTA_TASK_PERIOD = 100;
+static const unsigned long DISPLAY_TASK_PERIOD = 500;
+static const unsigned long HOUSEKEEPING_TASK_PERIOD = 1000;
+static const unsigned long CLOUD_TASK_PERIOD = 500;
+static const unsigned long SCHEDULE_TASK_MARGIN = 100;
+static const unsigned long STATUS_REFRESH_INTERVAL = 1000;
+static const unsigned long REMOTE_SYNC_TASK_PERIOD = 5000;
+static const unsigned long PERSIST_DEBOUNCE_MS = 5000;
+
+static TaskId scheduleTaskId = NO_TASK;
+static TaskId webTaskId = NO_TASK;
+static TaskId buttonTaskId = NO_TASK;
+static TaskId persistTaskId = NO_TASK;
+
+static void otaTask() { spend(); }
+static void displayTask() { spend(); }
+static void housekeepingTask() { spend(); spend(); spend(); spend(); }  // Wi-Fi, NTP, compaction, boot record
+static void cloudTask() { spend(); }
+static void remotesTask() { spend(); }
+static void persistTask() { spend(); }
+static void hc12Task() { spend(); }
+static void i2cTask() { spend(); }
+
+static void scheduleTask() {
+  spend();  // DST check
+  spend();  // applyScheduleLogic()
+  uint32_t second = (uint32_t)(nowUs / 1000000) % 60;
+  schedulerDelay(scheduleTaskId, (60 - second) * 1000UL + SCHEDULE_TASK_MARGIN);
+}
+
+static void webTask() {
+  spend();
+  handled(EVENT_WEB);
+}
+
+static void buttonTask() {
+  spend();
+  handled(EVENT_BUTTON);
+  schedulerDelay(persistTaskId, PERSIST_DEBOUNCE_MS);
+}
+
+static void registerTasks() {
+  schedulerAddPeriodic("ota", otaTask, OTA_TASK_PERIOD);
+  schedulerAddPeriodic("display", displayTask, DISPLAY_TASK_PERIOD);
+  scheduleTaskId = schedulerAddOneShot("schedule", scheduleTask, 0);
+  schedulerAddPeriodic("housekeeping", housekeepingTask, HOUSEKEEPING_TASK_PERIOD);
+  schedulerAddPeriodic("cloud", cloudTask, CLOUD_TASK_PERIOD);
+  webTaskId = schedulerAddPeriodic("web", webTask, STATUS_REFRESH_INTERVAL);
+  schedulerAddPeriodic("remotes", remotesTask, REMOTE_SYNC_TASK_PERIOD);
+  buttonTaskId = schedulerAddOneShot("button", buttonTask, NOT_SCHEDULED);
+  persistTaskId = schedulerAddOneShot("persist", persistTask, NOT_SCHEDULED);
+  schedulerAddOneShot("hc12", hc12Task, NOT_SCHEDULED);
+  schedulerAddOneShot("i2c", i2cTask, NOT_SCHEDULED);
+}
+
+// ---------------------- Runs ----------------------
+
+struct Result {
+  uint64_t passes;
+  uint64_t busyUs;
+  uint64_t maxLatencyUs[2];
+  // After mode: from the scheduler's own /metrics export.
+  uint64_t exportedPasses;
+  uint64_t exportedIdleUs;
+  uint32_t runs[6];  // ota, display, schedule, housekeeping, cloud, remotes
+  uint32_t maxLateMs;
+};
+
+static const char* const PERIODIC[] = {"ota", "display", "schedule", "housekeeping", "cloud", "remotes"};
+
+static uint64_t metricValue(const std::string& text, const std::string& name) {
+  size_t at = text.find("\n" + name + " ");
+  return at == std::string::npos ? 0 : strtoull(text.c_str() + at + name.size() + 2, nullptr, 10);
+}
+
+// The loop() before the scheduler: every tick on every pass; the display
+// only every 500 ms; the button read and the web queue checked each pass.
+static bool oldWebQueued = false;
+static bool oldButtonPressed = false;
+
+static void deliverOld(EventKind kind) {
+  if (kind == EVENT_WEB) oldWebQueued = true;
+  else oldButtonPressed = true;
+}
+
+static Result runOldLoop() {
+  Result result = {};
+  deliver = deliverOld;
+  unsigned long lastDisplayUpdate = 0;
+  while (nowUs < HOUR_US) {
+    deliverDue();
+    uint64_t passStart = nowUs;
+    spend();  // ArduinoOTA.handle()
+    spend();  // tickWebApi()
+    if (oldWebQueued) {
+      handled(EVENT_WEB);
+      oldWebQueued = false;
+    }
+    if (millis() - lastDisplayUpdate > 500) {
+      spend();  // updateDisplay()
+      lastDisplayUpdate = millis();
+    }
+    spend();  // tickRtcDstCorrection()
+    spend();  // applyScheduleLogic()
+    spend();  // handleWiFiReconnect()
+    spend();  // button read
+    if (oldButtonPressed) {
+      handled(EVENT_BUTTON);
+      oldButtonPressed = false;
+    }
+    spend();  // tickTimeSync()
+    spend();  // tickPersistence()
+    spend();  // tickScheduleCompaction()
+    spend();  // tickBootRecord()
+    spend();  // tickCloudSync()
+    result.passes++;
+    result.busyUs += nowUs - passStart;
+  }
+  memcpy(result.maxLatencyUs, maxLatencyUs, sizeof(maxLatencyUs));
+  return result;
+}
+
+static void deliverScheduled(EventKind kind) {
+  if (kind == EVENT_WEB) schedulerNotify(webTaskId);
+  else schedulerNotifyFromISR(buttonTaskId);
+}
+
+static Result runScheduler() {
+  Result result = {};
+  deliver = deliverScheduled;
+  registerTasks();
+  while (nowUs < HOUR_US) {
+    deliverDue();
+    uint64_t passStart = nowUs;
+    schedulerRunDue();
+    result.passes++;
+    result.busyUs += nowUs - passStart;
+    schedulerIdle();
+  }
+  memcpy(result.maxLatencyUs, maxLatencyUs, sizeof(maxLatencyUs));
+
+  StringPrint metrics;
+  metrics.text = "\n";
+  schedulerWritePrometheus(metrics);
+  result.exportedPasses = metricValue(metrics.text, "shabbat_scheduler_wakeups_total");
+  result.exportedIdleUs = metricValue(metrics.text, "shabbat_scheduler_idle_us_total");
+  for (size_t i = 0; i < sizeof(PERIODIC) / sizeof(PERIODIC[0]); i++) {
+    std::string task = std::string("{task=\"") + PERIODIC[i] + "\"}";
+    result.runs[i] = metricValue(metrics.text, "shabbat_task_runs_total" + task);
+    uint32_t lateMs = metricValue(metrics.text, "shabbat_task_max_late_ms" + task);
+    if (lateMs > result.maxLateMs) result.maxLateMs = lateMs;
+  }
+  return result;
+}
+
+// The scheduler keeps its tasks in static tables, so every run gets a
+// fresh process.
+static Result runIsolated(bool scheduler) {
+  int fds[2];
+  Result result = {};
+  if (pipe(fds) != 0) return result;
+  pid_t pid = fork();
+  if (pid == 0) {
+    Result child = scheduler ? runScheduler() : runOldLoop();
+    ssize_t written = write(fds[1], &child, sizeof(child));
+    _exit(written == (ssize_t)sizeof(child) ? 0 : 1);
+  }
+  close(fds[1]);
+  ssize_t got = read(fds[0], &result, sizeof(result));
+  close(fds[0]);
+  int status = 0;
+  waitpid(pid, &status, 0);
+  if (got != (ssize_t)sizeof(result)) memset(&result, 0, sizeof(result));
+  return result;
+}
+
+// ---------------------- Report ----------------------
+
+static unsigned failures = 0;
+
+static void check(const char* name, bool ok) {
+  printf("%s %s\n", ok ? "PASS" : "FAIL", name);
+  if (!ok) failures++;
+}
+
+static double percent(uint64_t us) {
+  return 100.0 * us / HOUR_US;
+}
+
+static bool cadenceHolds(const Result& r) {
+  static const unsigned long PERIODS[] = {OTA_TASK_PERIOD, DISPLAY_TASK_PERIOD, 60000, HOUSEKEEPING_TASK_PERIOD,
+                                          CLOUD_TASK_PERIOD, REMOTE_SYNC_TASK_PERIOD};
+  for (size_t i = 0; i < sizeof(PERIODS) / sizeof(PERIODS[0]); i++) {
+    long expected = 3600000L / PERIODS[i];
+    if (labs((long)r.runs[i] - expected) > 1) {
+      printf("  %s ran %u times, expected %ld\n", PERIODIC[i], r.runs[i], expected);
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  unsigned tabs = 3;
+  unsigned presses = 6;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--tabs") == 0 && i + 1 < argc) tabs = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--presses") == 0 && i + 1 < argc) presses = atoi(argv[++i]);
+  }
+  buildTimeline(tabs, presses);
+
+  printf("Loop activity per hour: %u tabs polling /status every 10 s, %u button presses\n\n", tabs, presses);
+  printf("call us | before: passes/h  busy %%  worst web/button ms | after: passes/h  busy %%  worst web/button ms\n");
+  static const uint64_t CALL_US[] = {5, 20, 100};
+  Result reference = {};
+  for (size_t i = 0; i < sizeof(CALL_US) / sizeof(CALL_US[0]); i++) {
+    callUs = CALL_US[i];
+    Result before = runIsolated(false);
+    Result after = runIsolated(true);
+    printf("%7llu | %15llu %7.2f %9.2f / %6.2f | %14llu %7.3f %9.2f / %6.2f\n", (unsigned long long)callUs,
+           (unsigned long long)before.passes, percent(before.busyUs), before.maxLatencyUs[EVENT_WEB] / 1000.0,
+           before.maxLatencyUs[EVENT_BUTTON] / 1000.0, (unsigned long long)after.passes, percent(after.busyUs),
+           after.maxLatencyUs[EVENT_WEB] / 1000.0, after.maxLatencyUs[EVENT_BUTTON] / 1000.0);
+    if (callUs == 20) reference = after;
+  }
+  printf("\n");
+
+  callUs = 20;
+  check("every periodic task keeps its cadence", cadenceHolds(reference));
+  check("no task starts late", reference.maxLateMs <= 1);
+  check("events handled within a pass", reference.maxLatencyUs[EVENT_WEB] < 2000 &&
+                                            reference.maxLatencyUs[EVENT_BUTTON] < 2000);
+  check("exported passes match the loop", reference.exportedPasses == reference.passes);
+  uint64_t idleGap = reference.exportedIdleUs + reference.busyUs > HOUR_US
+                         ? reference.exportedIdleUs + reference.busyUs - HOUR_US
+                         : HOUR_US - reference.exportedIdleUs - reference.busyUs;
+  check("exported idle time plus busy time is the hour", idleGap < 1000000);
+
+  printf(failures == 0 ? "Loop schedule OK\n" : "Loop schedule FAILED\n");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,11 @@
+// The Hc12Frame library's Loopback example on the host: the sketch as is,
+// with its Serial output on stderr. Fails if any of its checks fails.
+
+#include <Arduino.h>
+#include "Loopback.ino"
+
+int main() {
+  Serial.enabled = true;
+  setup();
+  return failures == 0 ? 0 : 1;
+}
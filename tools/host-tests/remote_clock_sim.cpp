@@ -0,0 +1,246 @@
+// Remote clock simulation: a remote unit running the schedule on its own
+// clock, built from the Hc12Frame library code Remote_Unit.ino runs
+// (Hc12ScheduleAssembler, Hc12RemoteClock, the beacon and schedule
+// payloads), replayed against the clock's time beacons second by second.
+//
+// The schedule reaches the remote as encoded SET_SCHEDULE chunks. The
+// remote's millis() is a wrapping uint32_t that runs fast or slow by the
+// scenario's drift; beacons go out every REMOTE_BEACON_INTERVAL_MS (and
+// right after a time step on the clock, like remote_sync.cpp), are stamped
+// with the clock's whole-second local time when sent, arrive one frame's
+// airtime later, and are lost with the scenario's probability or during its
+// radio outage. The remote checks the schedule once a second.
+//
+// For every switch the remote makes, reports how far it was from the
+// clock's own transition (mean / max seconds, switches a minute or more
+// off), and beacons per day. For comparison, a dumb receiver that needs a
+// live exchange at each transition misses every transition in the outage.
+//
+//   ./remote-clock-sim [--scenario NAME] [--days 14] [--seed 1]
+// Exits non-zero if any switch in a scenario is a minute or more off.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <hc12_schedule.h>
+#include "remote_sync.h"
+
+// Remote_Unit.ino.
+static const uint8_t SCHEDULE_CAPACITY = 32;
+// Broadcast beacon frame: overhead, target mask, beacon; 10 bits a byte at
+// 9600 baud.
+static const double BEACON_AIRTIME_S = (HC12_FRAME_OVERHEAD + 4 + HC12_BEACON_SIZE) * 10 / 9600.0;
+// Sunday 2024-01-07 00:00, local.
+static const uint32_t START_TIME = 1704585600UL;
+
+struct Scenario {
+  const char* name;
+  int32_t driftPpm;      // remote oscillator error (positive = fast)
+  double loss;           // beacon loss
+  uint32_t outageStartH; // radio outage, no beacons at all
+  uint32_t outageHours;
+  uint32_t stepAtH;      // the clock's time steps by stepS here (DST, manual set)
+  int32_t stepS;
+  uint32_t bootMs;       // remote millis() at the start
+};
+
+static const Scenario SCENARIOS[] = {
+  {"nominal", 500, 0.1, 72, 24, 0, 0, 123456},
+  {"slow-lossy", -2000, 0.5, 96, 48, 0, 0, 123456},
+  {"dst-forward", 500, 0.1, 0, 0, 30, 3600, 123456},
+  {"dst-back", -500, 0.1, 0, 0, 30, -3600, 123456},
+  {"millis-wrap", 1000, 0.1, 72, 24, 0, 0, 0xFFFFFFFFUL - 3 * 86400000UL},
+};
+static const size_t SCENARIO_COUNT = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+// Example schedule: 06:30 ON and 22:00 OFF every day, plus Friday 17:45 ON
+// and Saturday 13:00 OFF.
+static uint8_t makeSchedule(Hc12ScheduleEvent* events) {
+  uint8_t count = 0;
+  for (uint8_t day = 0; day < 7; day++) {
+    events[count++] = hc12MakeScheduleEvent(day, 6, 30, true);
+    if (day == 5) events[count++] = hc12MakeScheduleEvent(day, 17, 45, true);
+    if (day == 6) events[count++] = hc12MakeScheduleEvent(day, 13, 0, false);
+    events[count++] = hc12MakeScheduleEvent(day, 22, 0, false);
+  }
+  return count;
+}
+
+// mulberry32, as in the other host tools.
+static uint32_t randomState = 1;
+
+static double randomUnit() {
+  randomState += 0x6d2b79f5;
+  uint32_t t = randomState;
+  t = (t ^ (t >> 15)) * (t | 1);
+  t ^= t + (t ^ (t >> 7)) * (t | 61);
+  return (t ^ (t >> 14)) / 4294967296.0;
+}
+
+struct Transition {
+  double atS;
+  bool state;
+};
+
+struct Result {
+  unsigned switches = 0;
+  double sumErrorS = 0;
+  double maxErrorS = 0;
+  unsigned offByMinute = 0;
+  unsigned beacons = 0;
+  unsigned missedByDumbReceiver = 0;
+  unsigned clockTransitions = 0;
+  bool scheduleLoaded = false;
+};
+
+class Simulation {
+ public:
+  Simulation(const Scenario& scenario, uint32_t days) : scenario(scenario), days(days) {}
+
+  Result run() {
+    Result result;
+    Hc12ScheduleEvent events[SCHEDULE_CAPACITY];
+    uint8_t count = makeSchedule(events);
+    pushSchedule(events, count);
+    result.scheduleLoaded = schedule.valid && schedule.count == count;
+
+    double durationS = days * 86400.0;
+    double intervalS = REMOTE_BEACON_INTERVAL_MS / 1000.0;
+    double nextBeaconS = randomUnit() * intervalS;
+    double stepAtS = scenario.stepS != 0 ? scenario.stepAtH * 3600.0 : -1;
+    bool haveRemoteState = false;
+    bool remoteState = false;
+    bool haveClockState = false;
+    bool clockState = false;
+    std::vector<Transition> clockTransitions;
+    std::vector<Transition> remoteSwitches;
+
+    for (uint32_t t = 0; t < durationS; t++) {
+      while (nextBeaconS <= t) {
+        sendBeacon(nextBeaconS, result);
+        nextBeaconS += intervalS;
+      }
+      if (stepAtS >= 0 && t == (uint32_t)stepAtS) sendBeacon(t, result);
+
+      bool state;
+      if (hc12ScheduleStateAt(events, count, hc12MinuteOfWeek(clockTime(t)), state)) {
+        if (haveClockState && state != clockState) {
+          clockTransitions.push_back({(double)t, state});
+          if (inOutage(t)) result.missedByDumbReceiver++;
+        }
+        haveClockState = true;
+        clockState = state;
+      }
+
+      if (!remoteClock.valid()) continue;
+      uint16_t minute = hc12MinuteOfWeek(remoteClock.now(remoteMs(t)));
+      if (!hc12ScheduleStateAt(schedule.events, schedule.count, minute, state)) continue;
+      if (haveRemoteState && state != remoteState) remoteSwitches.push_back({(double)t, state});
+      haveRemoteState = true;
+      remoteState = state;
+    }
+
+    result.clockTransitions = clockTransitions.size();
+    for (const Transition& remote : remoteSwitches) {
+      double errorS = nearestTransitionError(clockTransitions, remote);
+      result.switches++;
+      result.sumErrorS += errorS;
+      if (errorS > result.maxErrorS) result.maxErrorS = errorS;
+      if (errorS >= 60) result.offByMinute++;
+    }
+    return result;
+  }
+
+ private:
+  // The clock's local (RTC) time at true second t.
+  uint32_t clockTime(double t) const {
+    double stepped = (scenario.stepS != 0 && t >= scenario.stepAtH * 3600.0) ? scenario.stepS : 0;
+    return START_TIME + (uint32_t)floor(t + stepped);
+  }
+
+  uint32_t remoteMs(double t) const {
+    return scenario.bootMs + (uint32_t)llround(t * 1000.0 * (1.0 + scenario.driftPpm / 1e6));
+  }
+
+  bool inOutage(double t) const {
+    double start = scenario.outageStartH * 3600.0;
+    return scenario.outageHours > 0 && t >= start && t < start + scenario.outageHours * 3600.0;
+  }
+
+  void pushSchedule(const Hc12ScheduleEvent* events, uint8_t count) {
+    uint8_t payload[HC12_MAX_PAYLOAD];
+    for (uint8_t chunk = 0; chunk < hc12ScheduleChunkCount(count); chunk++) {
+      uint8_t length = hc12EncodeScheduleChunk(1, events, count, chunk, payload);
+      schedule.push(payload, length);
+    }
+  }
+
+  void sendBeacon(double atS, Result& result) {
+    result.beacons++;
+    uint8_t payload[HC12_BEACON_SIZE];
+    uint8_t length = hc12EncodeBeacon({clockTime(atS), 2, false}, payload);
+    if (inOutage(atS) || randomUnit() < scenario.loss) return;
+    Hc12Beacon beacon;
+    if (hc12DecodeBeacon(payload, length, beacon)) remoteClock.onBeacon(beacon.localTime, remoteMs(atS + BEACON_AIRTIME_S));
+  }
+
+  static double nearestTransitionError(const std::vector<Transition>& transitions, const Transition& remote) {
+    double best = INFINITY;
+    for (const Transition& transition : transitions) {
+      if (transition.state != remote.state) continue;
+      double errorS = fabs(remote.atS - transition.atS);
+      if (errorS < best) best = errorS;
+    }
+    return best;
+  }
+
+  const Scenario& scenario;
+  uint32_t days;
+  Hc12ScheduleAssembler<SCHEDULE_CAPACITY> schedule;
+  Hc12RemoteClock remoteClock;
+};
+
+static void usage() {
+  fprintf(stderr, "usage: remote-clock-sim [--scenario NAME] [--days N] [--seed N]\nscenarios:");
+  for (size_t i = 0; i < SCENARIO_COUNT; i++) fprintf(stderr, " %s", SCENARIOS[i].name);
+  fprintf(stderr, "\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  const char* only = nullptr;
+  uint32_t days = 14;
+  uint32_t seed = 1;
+  for (int i = 1; i < argc; i++) {
+    if (i + 1 >= argc) usage();
+    if (strcmp(argv[i], "--scenario") == 0) only = argv[++i];
+    else if (strcmp(argv[i], "--days") == 0) days = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--seed") == 0) seed = atoi(argv[++i]);
+    else usage();
+  }
+  if (days == 0) usage();
+
+  printf("Remote clock simulation: %u days per scenario, beacon every %lu s, seed %u\n\n", days,
+         (unsigned long)(REMOTE_BEACON_INTERVAL_MS / 1000), seed);
+  printf("scenario       drift ppm  loss  outage h  switches  mean s  max s  >=60 s  beacons/day  dumb missed\n");
+  bool found = false;
+  int result = 0;
+  for (size_t i = 0; i < SCENARIO_COUNT; i++) {
+    const Scenario& scenario = SCENARIOS[i];
+    if (only && strcmp(only, scenario.name) != 0) continue;
+    found = true;
+    randomState = seed;
+    Result r = Simulation(scenario, days).run();
+    printf("%-14s %9ld %5.2f %9u %9u %7.1f %6.0f %7u %12.0f %6u/%u\n", scenario.name, (long)scenario.driftPpm,
+           scenario.loss, scenario.outageHours, r.switches, r.switches ? r.sumErrorS / r.switches : 0.0, r.maxErrorS,
+           r.offByMinute, (double)r.beacons / days, r.missedByDumbReceiver, r.clockTransitions);
+    if (!r.scheduleLoaded || r.switches == 0 || r.offByMinute > 0) {
+      printf("FAIL %s: %s\n", scenario.name, r.scheduleLoaded ? "switches off by a minute or more" : "schedule not loaded");
+      result = 1;
+    }
+  }
+  if (!found) usage();
+  return result;
+}
@@ -0,0 +1,120 @@
+// Hc12ScheduleAssembler on the host, at Remote_Unit.ino's capacity: round
+// trips of every table size through hc12EncodeScheduleChunk(), and the
+// transfers a remote must refuse (skipped, repeated or foreign chunks,
+// bad lengths and minutes, over capacity) without touching the table it
+// runs from.
+
+#include <stdio.h>
+#include <string.h>
+#include <hc12_schedule.h>
+
+// Remote_Unit.ino.
+static const uint8_t SCHEDULE_CAPACITY = 32;
+typedef Hc12ScheduleAssembler<SCHEDULE_CAPACITY> Assembler;
+
+static unsigned failures = 0;
+
+static void check(const char* name, bool ok) {
+  printf("%s %s\n", ok ? "PASS" : "FAIL", name);
+  if (!ok) failures++;
+}
+
+// count events spread over the week, sorted, alternating ON/OFF.
+static void makeEvents(Hc12ScheduleEvent* events, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    uint16_t minute = (uint16_t)((uint32_t)i * HC12_WEEK_MINUTES / (count ? count : 1));
+    events[i] = hc12MakeScheduleEvent(minute / 1440, minute / 60 % 24, minute % 60, i % 2 == 0);
+  }
+}
+
+// Push every chunk in order; true if all were accepted.
+static bool sendAll(Assembler& assembler, uint16_t version, const Hc12ScheduleEvent* events, uint8_t count) {
+  uint8_t payload[HC12_MAX_PAYLOAD];
+  for (uint8_t chunk = 0; chunk < hc12ScheduleChunkCount(count); chunk++) {
+    uint8_t length = hc12EncodeScheduleChunk(version, events, count, chunk, payload);
+    if (assembler.push(payload, length) != HC12_STATUS_OK) return false;
+  }
+  return true;
+}
+
+static bool holds(const Assembler& assembler, uint16_t version, const Hc12ScheduleEvent* events, uint8_t count) {
+  return assembler.valid && assembler.version == version && assembler.count == count &&
+         memcmp(assembler.events, events, count * sizeof(Hc12ScheduleEvent)) == 0;
+}
+
+int main() {
+  printf("Schedule assembler check (capacity %u)\n", SCHEDULE_CAPACITY);
+  Hc12ScheduleEvent events[SCHEDULE_CAPACITY + HC12_SCHEDULE_CHUNK_EVENTS];
+  uint8_t payload[HC12_MAX_PAYLOAD];
+
+  bool roundTrips = true;
+  for (uint8_t count = 0; count <= SCHEDULE_CAPACITY; count++) {
+    Assembler assembler;
+    makeEvents(events, count);
+    roundTrips = roundTrips && sendAll(assembler, 100 + count, events, count) &&
+                 holds(assembler, 100 + count, events, count);
+  }
+  check("every size 0..capacity round trips", roundTrips);
+  check("chunk payload fits a frame",
+        HC12_SCHEDULE_HEADER_SIZE + 2 * HC12_SCHEDULE_CHUNK_EVENTS <= HC12_MAX_PAYLOAD &&
+            hc12ScheduleChunkCount(SCHEDULE_CAPACITY) <= HC12_SCHEDULE_MAX_CHUNKS);
+
+  Assembler empty;
+  check("empty schedule is one chunk", hc12ScheduleChunkCount(0) == 1 && sendAll(empty, 7, events, 0) &&
+                                           empty.valid && empty.count == 0);
+
+  // A table the remote runs from, then a transfer of a new one.
+  Assembler assembler;
+  Hc12ScheduleEvent current[12];
+  makeEvents(current, 12);
+  sendAll(assembler, 1, current, 12);
+  makeEvents(events, 20);
+
+  uint8_t length = hc12EncodeScheduleChunk(2, events, 20, 0, payload);
+  check("chunk 0 accepted", assembler.push(payload, length) == HC12_STATUS_OK);
+  check("table unchanged mid-transfer", holds(assembler, 1, current, 12));
+  length = hc12EncodeScheduleChunk(2, events, 20, 1, payload);
+  check("chunk 1 accepted", assembler.push(payload, length) == HC12_STATUS_OK);
+  check("repeated chunk rejected", assembler.push(payload, length) == HC12_STATUS_BAD_PAYLOAD);
+  length = hc12EncodeScheduleChunk(2, events, 20, 3, payload);
+  check("skipped chunk rejected", assembler.push(payload, length) == HC12_STATUS_BAD_PAYLOAD);
+  length = hc12EncodeScheduleChunk(3, events, 20, 1, payload);
+  check("chunk of another version rejected", assembler.push(payload, length) == HC12_STATUS_BAD_PAYLOAD);
+  check("table unchanged after rejects", holds(assembler, 1, current, 12));
+
+  // The clock restarts at chunk 0, repeated or not; a new version's chunk 0
+  // restarts too.
+  check("restart from chunk 0", sendAll(assembler, 2, events, 20) && holds(assembler, 2, events, 20));
+  length = hc12EncodeScheduleChunk(3, current, 12, 0, payload);
+  assembler.push(payload, length);
+  assembler.push(payload, length);
+  check("new version restarts the transfer", sendAll(assembler, 4, current, 12) && holds(assembler, 4, current, 12));
+
+  // Malformed chunks.
+  uint8_t odd[] = {0, 5, 0x01, 0x00};
+  check("odd event bytes rejected", assembler.push(odd, sizeof(odd)) == HC12_STATUS_BAD_PAYLOAD);
+  uint8_t shortHeader[] = {0, 5};
+  check("short header rejected", assembler.push(shortHeader, sizeof(shortHeader)) == HC12_STATUS_BAD_PAYLOAD);
+  uint8_t noChunks[] = {0, 5, 0x00};
+  check("zero chunk count rejected", assembler.push(noChunks, sizeof(noChunks)) == HC12_STATUS_BAD_PAYLOAD);
+  uint8_t pastLast[] = {0, 5, 0x22};
+  check("index past the count rejected", assembler.push(pastLast, sizeof(pastLast)) == HC12_STATUS_BAD_PAYLOAD);
+  Hc12ScheduleEvent badMinute = (Hc12ScheduleEvent)(HC12_WEEK_MINUTES << 1);
+  length = hc12EncodeScheduleChunk(5, &badMinute, 1, 0, payload);
+  check("minute past the week rejected", assembler.push(payload, length) == HC12_STATUS_BAD_PAYLOAD);
+
+  // More events than the remote holds: every chunk up to the limit goes
+  // in, the one that overflows is refused.
+  uint8_t over = SCHEDULE_CAPACITY + HC12_SCHEDULE_CHUNK_EVENTS;
+  makeEvents(events, over);
+  bool refused = false;
+  for (uint8_t chunk = 0; chunk < hc12ScheduleChunkCount(over) && !refused; chunk++) {
+    length = hc12EncodeScheduleChunk(6, events, over, chunk, payload);
+    refused = assembler.push(payload, length) == HC12_STATUS_BAD_PAYLOAD;
+  }
+  check("over capacity refused", refused);
+  check("table unchanged after malformed chunks", holds(assembler, 4, current, 12));
+
+  printf(failures == 0 ? "Schedule assembler OK\n" : "Schedule assembler FAILED\n");
+  return failures == 0 ? 0 : 1;
+}
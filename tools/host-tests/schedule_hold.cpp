@@ -0,0 +1,129 @@
+// AUTO mode on the host: the real applyScheduleLogic() (schedule.cpp), run
+// the way the sketch's schedule task runs it, once just after each minute
+// starts, on a simulated clock (time() is interposed).
+//
+// - Events switch the relay in the minute they start.
+// - A manual tap holds until the next event, not until the next check.
+// - A check that comes late still applies the event it skipped over.
+// - A clock stepped back, or leaving and re-entering AUTO, applies nothing.
+//   ./schedule-hold
+
+#include <time.h>
+#include <Preferences.h>
+#include "metrics.h"
+#include "schedule.h"
+#include "time_utils.h"
+
+// ---------------------- Firmware Globals ----------------------
+
+Preferences prefs;
+uint8_t relayMode = 2;
+bool relay_state = false;
+
+void setLocalRelayState(bool on) {
+  relay_state = on;
+}
+
+void metricsRecord(MetricTimer, uint32_t) {}
+
+// ---------------------- Clock ----------------------
+
+static time_t clockNow = 0;
+
+time_t time(time_t* out) noexcept {
+  if (out) *out = clockNow;
+  return clockNow;
+}
+
+// Sunday 2026-10-18 at hour:minute, plus days.
+static void setClock(uint8_t days, uint8_t hour, uint8_t minute) {
+  clockNow = DateTime(2026, 10, 18, hour, minute, 0).unixtime() + days * 86400L;
+}
+
+// The schedule task: one check per minute for minutes minutes.
+static void runMinutes(unsigned minutes) {
+  for (unsigned i = 0; i < minutes; i++) {
+    clockNow += 60;
+    applyScheduleLogic();
+  }
+}
+
+// ---------------------- Checks ----------------------
+
+static unsigned failures = 0;
+
+static void check(const char* name, bool ok) {
+  printf("%s %s\n", ok ? "PASS" : "FAIL", name);
+  if (!ok) failures++;
+}
+
+// ON at 08:00 and OFF at 20:00 every day; the first check at 07:00 Sunday.
+static void startDay() {
+  scheduleCount = 0;
+  for (uint8_t day = 0; day < 7; day++) {
+    schedule[scheduleCount++] = ScheduleEntry{8, 0, true, day};
+    schedule[scheduleCount++] = ScheduleEntry{20, 0, false, day};
+  }
+  sortSchedule();
+  relayMode = 2;
+  relay_state = false;
+  setClock(0, 7, 0);
+  applyScheduleLogic();
+}
+
+int main() {
+  timeValid = true;
+  printf("Schedule hold check\n");
+
+  startDay();
+  check("first check applies nothing", !relay_state);
+  runMinutes(59);
+  check("relay off before the ON event", !relay_state);
+  runMinutes(1);
+  check("ON event applied in its minute", relay_state);
+
+  relay_state = false;  // manual tap at 08:00
+  runMinutes(12 * 60 - 1);
+  check("tap holds until the next event", !relay_state);
+  relay_state = true;   // tap back at 19:59
+  runMinutes(1);
+  check("OFF event applied after a tap", !relay_state);
+
+  startDay();
+  runMinutes(58);
+  clockNow += 3 * 60;   // the check comes three minutes late, at 08:01
+  applyScheduleLogic();
+  check("late check applies the skipped event", relay_state);
+
+  startDay();
+  runMinutes(65);
+  relay_state = false;  // tap at 08:05, then the clock is stepped back
+  clockNow -= 10 * 60;
+  applyScheduleLogic();
+  check("clock stepped back applies nothing", !relay_state);
+  runMinutes(4);
+  check("tap holds after the step", !relay_state);
+
+  startDay();
+  relayMode = 0;
+  runMinutes(60);
+  check("forced mode ignores events", !relay_state);
+  relayMode = 2;
+  runMinutes(1);
+  check("events passed in a forced mode are not applied back in AUTO", !relay_state);
+
+  startDay();
+  setClock(6, 19, 59);  // Saturday
+  applyScheduleLogic();
+  relay_state = true;
+  runMinutes(1);
+  check("Saturday OFF event", !relay_state);
+  runMinutes(4 * 60);
+  setClock(7, 7, 59);   // next Sunday, continuing the week
+  applyScheduleLogic();
+  runMinutes(1);
+  check("event after the week wraps", relay_state);
+
+  printf(failures == 0 ? "Schedule hold OK\n" : "Schedule hold FAILED\n");
+  return failures == 0 ? 0 : 1;
+}
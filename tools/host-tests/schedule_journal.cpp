@@ -0,0 +1,328 @@
+// Schedule journal on the host: the real schedule.cpp persistence against
+// the NVS model (host/Preferences.h).
+//
+// - Random edits the way web_api.cpp and control_actions.cpp make them
+//   (add, update, delete, journaled batches, batches too large to journal,
+//   replace-all), with and without compaction after each, each followed by
+//   a reboot that must load exactly the table and revision the device had.
+// - A power cut at every write of a journaled edit and of a compaction: the
+//   reboot must load the table before or after it, and the next edit must
+//   survive the reboot after that.
+// - Boot load time (host) and NVS reads against journal length, and the
+//   bytes and NVS entries an edit writes as a journal record vs. a snapshot.
+//   ./schedule-journal [--edits 400] [--seed 1]
+
+#include <functional>
+#include <stdlib.h>
+#include <Preferences.h>
+#include "metrics.h"
+#include "schedule.h"
+
+// ---------------------- Firmware Globals ----------------------
+
+Preferences prefs;
+uint8_t relayMode = 0;
+
+void setLocalRelayState(bool) {}
+void metricsRecord(MetricTimer, uint32_t) {}
+
+// ---------------------- Edits ----------------------
+// The live paths: edit schedule[], sort, normalize, note, save.
+
+void hostSeedRandom(uint32_t seed);
+
+static uint32_t randomBelow(uint32_t n) {
+  return esp_random() % n;
+}
+
+static ScheduleEntry randomEntry() {
+  // A small grid so edits hit existing events often.
+  return ScheduleEntry{(uint8_t)(6 + randomBelow(4) * 4), (uint8_t)(randomBelow(2) * 30), randomBelow(2) == 1,
+                       (uint8_t)randomBelow(7)};
+}
+
+static int findEntry(const ScheduleEntry& key) {
+  for (int i = 0; i < scheduleCount; i++) {
+    if (schedule[i].day == key.day && schedule[i].hour == key.hour && schedule[i].minute == key.minute) return i;
+  }
+  return -1;
+}
+
+// web_api.cpp runScheduleAdd().
+static void addEvent(const ScheduleEntry& entry) {
+  int idx = findEntry(entry);
+  if (idx >= 0) {
+    if (schedule[idx].state == entry.state) return;
+    schedule[idx].state = entry.state;
+  } else {
+    if (scheduleCount >= MAX_EVENTS) return;
+    schedule[scheduleCount++] = entry;
+  }
+  sortSchedule();
+  normalizeSchedule();
+  noteScheduleEdit(SCHEDULE_JOURNAL_UPSERT, entry);
+  saveSchedule();
+}
+
+// web_api.cpp runScheduleDelete().
+static void deleteEvent(uint8_t idx) {
+  noteScheduleEdit(SCHEDULE_JOURNAL_DELETE, schedule[idx]);
+  for (int j = idx + 1; j < scheduleCount; j++) schedule[j - 1] = schedule[j];
+  scheduleCount--;
+  sortSchedule();
+  normalizeSchedule();
+  saveSchedule();
+}
+
+// control_actions.cpp applyScheduleBatchAction() without CLEAR: upserts
+// and deletes of existing events, each noted.
+static void batchEdit(uint8_t ops) {
+  for (uint8_t i = 0; i < ops; i++) {
+    ScheduleEntry entry = randomEntry();
+    int idx = findEntry(entry);
+    if (idx >= 0 && randomBelow(2) == 0) {
+      noteScheduleEdit(SCHEDULE_JOURNAL_DELETE, schedule[idx]);
+      for (int j = idx + 1; j < scheduleCount; j++) schedule[j - 1] = schedule[j];
+      scheduleCount--;
+    } else if (idx >= 0) {
+      schedule[idx].state = entry.state;
+      noteScheduleEdit(SCHEDULE_JOURNAL_UPSERT, entry);
+    } else if (scheduleCount < MAX_EVENTS) {
+      schedule[scheduleCount++] = entry;
+      noteScheduleEdit(SCHEDULE_JOURNAL_UPSERT, entry);
+    }
+  }
+  sortSchedule();
+  normalizeSchedule();
+  saveSchedule();
+}
+
+// control_actions.cpp applyScheduleAction(): replace-all, nothing noted.
+// One event per (day, time), as the UI sends it.
+static void replaceAll(uint8_t count) {
+  scheduleCount = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    ScheduleEntry entry = randomEntry();
+    if (findEntry(entry) < 0) schedule[scheduleCount++] = entry;
+  }
+  sortSchedule();
+  normalizeSchedule();
+  saveSchedule();
+}
+
+static void randomEdit() {
+  uint32_t kind = randomBelow(20);
+  if (kind < 9) addEvent(randomEntry());
+  else if (kind < 14 && scheduleCount > 0) deleteEvent(randomBelow(scheduleCount));
+  else if (kind < 18) batchEdit(2 + randomBelow(4));
+  else if (kind < 19) batchEdit(12);
+  else replaceAll(4 + randomBelow(12));
+}
+
+// ---------------------- Device State ----------------------
+
+struct Table {
+  ScheduleEntry entries[MAX_EVENTS];
+  uint8_t count;
+  uint32_t revision;
+};
+
+static Table liveTable() {
+  Table table;
+  memcpy(table.entries, schedule, sizeof(schedule));
+  table.count = scheduleCount;
+  table.revision = scheduleRevision;
+  return table;
+}
+
+static bool sameTable(const Table& a, const Table& b) {
+  return a.count == b.count && a.revision == b.revision &&
+         memcmp(a.entries, b.entries, a.count * sizeof(ScheduleEntry)) == 0;
+}
+
+// RAM is lost; the table comes back from NVS.
+static Table reboot() {
+  memset(schedule, 0, sizeof(schedule));
+  scheduleCount = 0;
+  scheduleRevision = 0;
+  loadSchedule();
+  return liveTable();
+}
+
+// ---------------------- Checks ----------------------
+
+// schedule.cpp.
+static const uint8_t JOURNAL_COMPACT_AT = 16;
+
+static unsigned failures = 0;
+
+static void check(const char* name, bool ok) {
+  printf("%s %s\n", ok ? "PASS" : "FAIL", name);
+  if (!ok) failures++;
+}
+
+// Random edits, a reboot after each; compacting after each edit like
+// loop() does, or letting the journal run into its hard cap.
+static bool editsSurviveReboots(unsigned edits, bool compact) {
+  clearScheduleStorage();
+  for (unsigned i = 0; i < edits; i++) {
+    randomEdit();
+    if (compact) tickScheduleCompaction();
+    Table live = liveTable();
+    if (!sameTable(reboot(), live)) {
+      printf("  edit %u: reboot loaded rev %lu (%u events), device had rev %lu (%u events)\n", i,
+             (unsigned long)scheduleRevision, scheduleCount, (unsigned long)live.revision, live.count);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Cut the power at every write of `step`, starting each time from the same
+// NVS, table and random draws. The reboot must load the table from before
+// or after the step, and an edit made after that reboot must survive the
+// next one.
+static bool survivesPowerCuts(const char* name, std::function<void()> prepare, std::function<void()> step) {
+  static const uint32_t STEP_SEED = 7;
+  clearScheduleStorage();
+  prepare();
+  Preferences before = prefs;
+  Table beforeTable = reboot();
+
+  unsigned long startWrites = prefs.writes;
+  hostSeedRandom(STEP_SEED);
+  step();
+  Table afterTable = liveTable();
+  unsigned long stepWrites = prefs.writes - startWrites;
+
+  bool ok = true;
+  for (unsigned long cut = 0; cut < stepWrites; cut++) {
+    prefs = before;
+    reboot();
+    prefs.cutAfterWrites(cut);
+    hostSeedRandom(STEP_SEED);
+    step();
+    prefs.powerOn();
+    Table loaded = reboot();
+    bool whole = sameTable(loaded, beforeTable) || sameTable(loaded, afterTable);
+    addEvent(ScheduleEntry{23, 59, true, 6});
+    Table next = liveTable();
+    bool nextSurvives = sameTable(reboot(), next);
+    if (!whole || !nextSurvives) {
+      printf("  %s, cut after %lu of %lu writes: %s\n", name, cut, stepWrites,
+             !whole ? "torn table" : "next edit lost");
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+static void fillJournal(uint8_t records) {
+  for (uint8_t i = 0; i < records; i++) {
+    addEvent(ScheduleEntry{(uint8_t)(i % 24), (uint8_t)(i * 7 % 60), i % 2 == 0, (uint8_t)(i % 7)});
+  }
+}
+
+// A table saved by firmware before the "snap" blob: it loads, journaled
+// edits replay on top of it, and the first snapshot replaces its keys.
+static bool legacySnapshotMigrates() {
+  static const ScheduleEntry LEGACY[] = {{7, 0, true, 1}, {22, 0, false, 1}, {8, 30, true, 5}};
+  static const uint8_t LEGACY_COUNT = sizeof(LEGACY) / sizeof(LEGACY[0]);
+  prefs.begin("sched", false);
+  prefs.clear();
+  prefs.putUChar("count", LEGACY_COUNT);
+  prefs.putUInt("revision", 41);
+  prefs.putBytes("table", LEGACY, sizeof(LEGACY));
+  prefs.end();
+
+  Table loaded = reboot();
+  bool ok = loaded.count == LEGACY_COUNT && loaded.revision == 41 && memcmp(loaded.entries, LEGACY, sizeof(LEGACY)) == 0;
+  fillJournal(JOURNAL_COMPACT_AT);
+  Table live = liveTable();
+  ok = ok && sameTable(reboot(), live);
+  tickScheduleCompaction();
+  prefs.begin("sched", true);
+  bool replaced = prefs.isKey("snap") && !prefs.isKey("count") && !prefs.isKey("revision") && !prefs.isKey("table");
+  prefs.end();
+  return ok && replaced && sameTable(reboot(), live);
+}
+
+// ---------------------- Benchmark ----------------------
+
+// Records in the journal, counted in NVS.
+static uint8_t journalRecords() {
+  char key[6];
+  uint8_t records = 0;
+  prefs.begin("sched", true);
+  for (uint8_t i = 0; i < 255; i++) {
+    snprintf(key, sizeof(key), "j%u", i);
+    if (!prefs.isKey(key)) break;
+    records++;
+  }
+  prefs.end();
+  return records;
+}
+
+static void benchmarkReplay() {
+  static const uint8_t EDITS[] = {0, 4, 8, 16, 32, 48};
+  static const unsigned LOADS = 2000;
+  printf("\nBoot load vs. journal length (%u loads each)\n", LOADS);
+  printf("  snapshot events  records  NVS reads  host us/load\n");
+  for (uint8_t l = 0; l < sizeof(EDITS); l++) {
+    clearScheduleStorage();
+    hostSeedRandom(l + 1);
+    replaceAll(MAX_EVENTS / 2);
+    uint8_t snapshotEvents = scheduleCount;
+    fillJournal(EDITS[l]);
+    unsigned long startReads = prefs.reads;
+    reboot();
+    unsigned long reads = prefs.reads - startReads;
+    unsigned long startUs = micros();
+    for (unsigned i = 0; i < LOADS; i++) reboot();
+    double us = (double)(micros() - startUs) / LOADS;
+    printf("  %15u %8u %10lu %13.2f\n", snapshotEvents, journalRecords(), reads, us);
+  }
+
+  clearScheduleStorage();
+  replaceAll(MAX_EVENTS / 2);
+  printf("\nNVS writes per single-event edit (%u events in the table)\n", scheduleCount);
+  printf("  %-10s %6s %8s\n", "", "bytes", "entries");
+  unsigned long bytes = prefs.bytesWritten;
+  unsigned long entries = prefs.entriesWritten;
+  addEvent(ScheduleEntry{23, 45, true, 3});
+  printf("  %-10s %6lu %8lu\n", "journal", prefs.bytesWritten - bytes, prefs.entriesWritten - entries);
+  bytes = prefs.bytesWritten;
+  entries = prefs.entriesWritten;
+  saveSchedule();  // nothing noted: the same table as a snapshot
+  printf("  %-10s %6lu %8lu\n", "snapshot", prefs.bytesWritten - bytes, prefs.entriesWritten - entries);
+}
+
+int main(int argc, char** argv) {
+  unsigned edits = 400;
+  uint32_t seed = 1;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--edits") == 0 && i + 1 < argc) edits = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = atoi(argv[++i]);
+  }
+  hostSeedRandom(seed);
+  printf("Schedule journal check (%u edits, seed %u)\n", edits, seed);
+
+  check("edits survive reboots, compacting", editsSurviveReboots(edits, true));
+  check("edits survive reboots, journal to its cap", editsSurviveReboots(edits, false));
+
+  check("power cut in a single-event edit", survivesPowerCuts(
+            "add", [] { replaceAll(8); fillJournal(3); }, [] { addEvent(ScheduleEntry{12, 30, true, 2}); }));
+  check("power cut in a batch edit", survivesPowerCuts(
+            "batch", [] { replaceAll(8); fillJournal(3); }, [] { batchEdit(5); }));
+  check("power cut in a snapshot edit", survivesPowerCuts(
+            "replace", [] { replaceAll(8); fillJournal(3); }, [] { replaceAll(10); }));
+  check("power cut in a compaction", survivesPowerCuts(
+            "compaction", [] { replaceAll(8); fillJournal(20); }, [] { tickScheduleCompaction(); }));
+
+  check("snapshot of older firmware loads and is replaced", legacySnapshotMigrates());
+
+  benchmarkReplay();
+
+  printf(failures == 0 ? "Schedule journal OK\n" : "Schedule journal FAILED\n");
+  return failures == 0 ? 0 : 1;
+}
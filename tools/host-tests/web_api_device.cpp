@@ -0,0 +1,185 @@
+// The clock's local web API on the host: the real web_api.cpp on the
+// ESPAsyncWebServer shim (host/async_web_server.cpp), with the loop task
+// scheduler, metrics, command actions, schedule and write-behind
+// persistence it drives (task_scheduler.cpp, metrics.cpp,
+// control_actions.cpp, schedule.cpp, persistence.cpp) on the NVS model.
+// Requests are parsed on the server thread and the deferred ones run on the
+// loop thread, as on the device. A "control" task at the sketch's shortest
+// period stands in for the other loop tasks, so /metrics shows what the web
+// server costs them (shabbat_task_max_late_ms). The HC-12 radio is a
+// stand-in: a Shabbat mode broadcast is applied by every unit after
+// --radio-ms (default the link simulator's one-unit broadcast median).
+//   ./web-api-device [--port 0] [--radio-ms 55] [--verbose]
+// Listens on 127.0.0.1 (port 0 picks one and prints it) until SIGINT/SIGTERM.
+// tools/web-load-test.mjs --device starts it; see make web-load-test.
+
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <Preferences.h>
+#include "control_actions.h"
+#include "hc12_comm.h"
+#include "host_loop.h"
+#include "i2c_bus.h"
+#include "metrics.h"
+#include "persistence.h"
+#include "power_manager.h"
+#include "schedule.h"
+#include "task_scheduler.h"
+#include "time_utils.h"
+#include "web_api.h"
+
+// Smart_Shabbat_Clock.ino's OTA_TASK_PERIOD, without power save.
+static const unsigned long CONTROL_TASK_PERIOD = 100;
+
+// ---------------------- Firmware Globals ----------------------
+
+AsyncWebServer server(0);
+Preferences prefs;
+bool relay_state = false;
+bool shabbatMode = false;
+uint8_t relayMode = 2;
+bool timeValid = false;
+bool rtcAvailable = false;
+
+void setLocalRelayState(bool on) {
+  if (relay_state == on) return;
+  relay_state = on;
+  persistRelayState(on);
+}
+
+void saveRelayMode(uint8_t mode) {
+  persistRelayMode(mode);
+}
+
+void saveShabbatMode(bool mode) {
+  persistShabbatMode(mode);
+}
+
+// No power manager, I2C bus or RTC on the host.
+void powerWritePrometheus(Print&) {}
+void i2cWritePrometheus(Print&) {}
+void rtcSetTime(const DateTime&) {}
+void ensureLocalTimezoneConfigured() {}
+void updateRtcDstStateFromLocalTime(const struct tm&) {}
+
+// ---------------------- Clock ----------------------
+// /set_time moves the device's clock, not the host's: settimeofday() is
+// interposed and only records the offset.
+
+static time_t clockOffset = 0;
+
+int settimeofday(const struct timeval* now, const struct timezone*) noexcept {
+  if (now) clockOffset = now->tv_sec - time(nullptr);
+  return 0;
+}
+
+DateTime getCurrentDateTime() {
+  return DateTime((uint32_t)(time(nullptr) + clockOffset));
+}
+
+// ---------------------- Radio Stand-in ----------------------
+// One broadcast in flight at a time, like the HC-12 queue's head; every
+// target applies the mode. It completes on the loop thread from the "hc12"
+// task, as in hc12_comm.cpp.
+
+struct PendingBroadcast {
+  bool active;
+  uint32_t targets;
+  Hc12BroadcastCallback done;
+  void* context;
+};
+
+static PendingBroadcast pendingBroadcast = {};
+static unsigned long radioMs = 55;
+static TaskId radioTask = NO_TASK;
+static uint32_t lastReplyAt = 0;
+
+bool hc12SubmitBroadcast(uint32_t targets, uint8_t, const uint8_t*, uint8_t, Hc12BroadcastCallback done,
+                         void* context) {
+  if (pendingBroadcast.active) return false;
+  pendingBroadcast = {true, targets, done, context};
+  schedulerDelay(radioTask, radioMs);
+  return true;
+}
+
+bool hc12LinkSummary(uint8_t unit, Hc12LinkSummary& out) {
+  if (lastReplyAt == 0 || (HC12_SHABBAT_UNITS & (1UL << (unit - 1))) == 0) return false;
+  out = {};
+  out.ok = true;
+  out.successPct = 100;
+  out.rttP50Ms = out.rttP90Ms = out.srttMs = (uint16_t)radioMs;
+  out.lastSeen = lastReplyAt;
+  return true;
+}
+
+void hc12WritePrometheus(Print&) {}
+
+static void finishBroadcast() {
+  if (!pendingBroadcast.active) return;
+  PendingBroadcast broadcast = pendingBroadcast;
+  pendingBroadcast.active = false;
+  Hc12BroadcastResult result = {};
+  result.targets = broadcast.targets;
+  result.acked = broadcast.targets;
+  lastReplyAt = getCurrentDateTime().unixtime();
+  broadcast.done(result, broadcast.context);
+}
+
+// ---------------------- Main ----------------------
+
+static volatile sig_atomic_t stopping = 0;
+
+static void stop(int) {
+  stopping = 1;
+}
+
+static void controlTask() {}
+
+static void usage() {
+  fprintf(stderr, "usage: web-api-device [--port N] [--radio-ms MS] [--seed N] [--verbose]\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  uint16_t port = 0;
+  uint32_t seed = 1;
+  for (int i = 1; i < argc; i++) {
+    String arg = argv[i];
+    if (arg == "--verbose") {
+      Serial.enabled = true;
+      continue;
+    }
+    if (i + 1 >= argc) usage();
+    if (arg == "--port") port = strtoul(argv[++i], nullptr, 10);
+    else if (arg == "--radio-ms") radioMs = strtoul(argv[++i], nullptr, 10);
+    else if (arg == "--seed") seed = strtoul(argv[++i], nullptr, 10);
+    else usage();
+  }
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+  hostSeedRandom(seed);
+  timeValid = true;
+
+  // setup(): modes, schedule, loop tasks, then the web server.
+  persistInit();
+  relayMode = persistedRelayMode(relayMode);
+  shabbatMode = persistedShabbatMode(shabbatMode);
+  loadSchedule();
+  schedulerAddPeriodic("control", controlTask, CONTROL_TASK_PERIOD);
+  radioTask = schedulerAddOneShot("hc12", finishBroadcast, NOT_SCHEDULED);
+  server.setPort(port);
+  initWebServer();
+  server.begin();
+  fprintf(stderr, "web-api-device: listening on http://127.0.0.1:%u\n", server.port());
+
+  while (!stopping) {
+    schedulerRunDue();
+    schedulerIdle();
+  }
+  persistFlush();
+  // The server thread is still running: leave without static destructors.
+  _exit(0);
+}
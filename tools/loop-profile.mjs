@@ -0,0 +1,91 @@
+// Loop activity profile from the device's /metrics.
+//
+// Scrapes /metrics at the start and end of a window and reports, scaled to
+// one hour: loop passes, loop busy time (CPU share of the loop thread) and,
+// on firmware with the task scheduler, runs and run time per loop task.
+// Loop passes come from shabbat_duration_us{subsystem="loop"}, which older
+// firmware (free-running loop) also exports, so the same command gives the
+// before/after comparison.
+//
+// Usage:
+//   node tools/loop-profile.mjs --host 192.168.1.50 [--duration 300]
+
+function parseArgs(argv) {
+  const options = { host: null, durationS: 300, timeoutMs: 5000 };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    const next = () => {
+      if (i + 1 >= argv.length) throw new Error(`Missing value for ${arg}`);
+      return argv[++i];
+    };
+    if (arg === '--host') options.host = next();
+    else if (arg === '--duration') options.durationS = Number(next());
+    else if (arg === '--timeout') options.timeoutMs = Number(next());
+    else throw new Error(`Unknown argument ${arg}`);
+  }
+  if (!options.host) throw new Error('Missing --host');
+  return options;
+}
+
+function sleep(ms) {
+  return new Promise((resolve) => setTimeout(resolve, ms));
+}
+
+// Map of "name{labels}" -> value for every sample line.
+async function scrape(options) {
+  const res = await fetch(`http://${options.host}/metrics`, { cache: 'no-store', signal: AbortSignal.timeout(options.timeoutMs) });
+  if (!res.ok) throw new Error(`/metrics: HTTP ${res.status}`);
+  const samples = new Map();
+  for (const line of (await res.text()).split('\n')) {
+    if (!line || line.startsWith('#')) continue;
+    const space = line.lastIndexOf(' ');
+    samples.set(line.slice(0, space), Number(line.slice(space + 1)));
+  }
+  return { at: Date.now(), samples };
+}
+
+function delta(before, after, key) {
+  if (!after.samples.has(key)) return null;
+  return after.samples.get(key) - (before.samples.get(key) || 0);
+}
+
+async function main() {
+  const options = parseArgs(process.argv.slice(2));
+  console.log(`Loop profile: ${options.durationS}s window against http://${options.host}`);
+  const before = await scrape(options);
+  await sleep(options.durationS * 1000);
+  const after = await scrape(options);
+
+  const elapsedS = (after.at - before.at) / 1000;
+  const perHour = (v) => (v * 3600) / elapsedS;
+  const loopPasses = delta(before, after, 'shabbat_duration_us_count{subsystem="loop"}');
+  const loopBusyUs = delta(before, after, 'shabbat_duration_us_sum{subsystem="loop"}');
+  if (loopPasses === null) throw new Error('No loop timer in /metrics (firmware too old?)');
+
+  console.log('');
+  console.log(`loop passes/hour   ${Math.round(perHour(loopPasses))}`);
+  console.log(`loop busy          ${((loopBusyUs / 1e6 / elapsedS) * 100).toFixed(2)}% of one core`);
+  const idleUs = delta(before, after, 'shabbat_scheduler_idle_us_total');
+  if (idleUs !== null) console.log(`loop idle          ${((idleUs / 1e6 / elapsedS) * 100).toFixed(2)}%`);
+
+  const tasks = [...after.samples.keys()]
+    .map((key) => /^shabbat_task_runs_total\{task="([^"]+)"\}$/.exec(key))
+    .filter(Boolean)
+    .map((match) => match[1]);
+  if (tasks.length === 0) return;
+
+  console.log('');
+  console.log('task           runs/hour   busy ms/hour   avg us   max us  max late ms');
+  for (const task of tasks) {
+    const runs = delta(before, after, `shabbat_task_runs_total{task="${task}"}`);
+    const runUs = delta(before, after, `shabbat_task_run_us_total{task="${task}"}`);
+    const maxUs = after.samples.get(`shabbat_task_max_run_us{task="${task}"}`) || 0;
+    const lateMs = after.samples.get(`shabbat_task_max_late_ms{task="${task}"}`) || 0;
+    console.log(`${task.padEnd(14)} ${String(Math.round(perHour(runs))).padStart(9)} ${(perHour(runUs) / 1000).toFixed(1).padStart(14)} ${String(Math.round(runUs / Math.max(1, runs))).padStart(8)} ${String(maxUs).padStart(8)} ${String(lateMs).padStart(12)}`);
+  }
+}
+
+main().catch((err) => {
+  console.error(err.message);
+  process.exit(1);
+});
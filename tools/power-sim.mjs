@@ -0,0 +1,140 @@
+// Host simulation of the loop's wakeup pattern, for the power-save estimate.
+//
+// Replays one hour of the firmware's loop tasks (periods as in
+// Smart_Shabbat_Clock.ino / web_api.cpp) through the same earliest-deadline
+// rule as task_scheduler.cpp: every wakeup runs all tasks that are due, then
+// the loop idles until the next deadline. Reports wakeups, idle fraction,
+// estimated supply current (same figures as power_manager.cpp) and how late
+// the minute-aligned schedule task starts, for the normal and power-save
+// task periods (the latter with and without light sleep).
+//
+// Task run times default to typical values; --host takes the averages from a
+// device's /metrics (shabbat_task_run_us_total / shabbat_task_runs_total).
+//
+// Usage:
+//   node tools/power-sim.mjs [--host 192.168.1.50] [--web-requests 60] [--hours 1]
+
+const PROFILES = {
+  normal: { ota: 100, display: 500, housekeeping: 1000, cloud: 500, web: 1000, lightSleep: false },
+  'power-save': { ota: 1000, display: 1000, housekeeping: 5000, cloud: 2000, web: 1000, lightSleep: true },
+  // Stock Arduino-ESP32 cores lack tickless idle: the same periods, no light sleep.
+  'ps-stock-core': { ota: 1000, display: 1000, housekeeping: 5000, cloud: 2000, web: 1000, lightSleep: false },
+};
+
+// Typical run times (us) when no device is given.
+const DEFAULT_RUN_US = { ota: 40, display: 3500, housekeeping: 120, cloud: 300, web: 250, schedule: 900 };
+
+// Keep in step with power_manager.cpp.
+const CURRENT_BUSY_MA = 95.0;
+const CURRENT_IDLE_AWAKE_MA = 25.0;
+const CURRENT_IDLE_LIGHT_SLEEP_MA = 3.0;
+// Light-sleep entry + exit cost per wakeup (us), counted as busy time.
+const LIGHT_SLEEP_TRANSITION_US = 600;
+const SCHEDULE_TASK_MARGIN_MS = 100;
+
+function parseArgs(argv) {
+  const options = { host: null, webRequestsPerHour: 60, hours: 1, timeoutMs: 5000 };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    const next = () => {
+      if (i + 1 >= argv.length) throw new Error(`Missing value for ${arg}`);
+      return argv[++i];
+    };
+    if (arg === '--host') options.host = next();
+    else if (arg === '--web-requests') options.webRequestsPerHour = Number(next());
+    else if (arg === '--hours') options.hours = Number(next());
+    else throw new Error(`Unknown argument ${arg}`);
+  }
+  return options;
+}
+
+async function runTimesFromDevice(options) {
+  const res = await fetch(`http://${options.host}/metrics`, { cache: 'no-store', signal: AbortSignal.timeout(options.timeoutMs) });
+  if (!res.ok) throw new Error(`/metrics: HTTP ${res.status}`);
+  const runs = {};
+  const totals = {};
+  for (const line of (await res.text()).split('\n')) {
+    const match = /^shabbat_task_(runs_total|run_us_total)\{task="([^"]+)"\} (\d+)/.exec(line);
+    if (!match) continue;
+    (match[1] === 'runs_total' ? runs : totals)[match[2]] = Number(match[3]);
+  }
+  const runUs = { ...DEFAULT_RUN_US };
+  for (const task of Object.keys(runs)) {
+    if (runs[task] > 0) runUs[task] = totals[task] / runs[task];
+  }
+  return runUs;
+}
+
+function simulate(profile, runUs, options) {
+  const durationMs = options.hours * 3600 * 1000;
+  const tasks = ['ota', 'display', 'housekeeping', 'cloud', 'web'].map((name) => ({ name, period: profile[name], due: 0 }));
+  // Minute-aligned schedule task; start mid-minute like a real boot.
+  const schedule = { name: 'schedule', due: 0, minuteOffsetMs: 23456, runs: 0 };
+  // Web requests notify the web task; spread evenly.
+  const webEveryMs = options.webRequestsPerHour > 0 ? 3600000 / options.webRequestsPerHour : Infinity;
+  let nextWebMs = webEveryMs / 2;
+
+  let nowMs = 0;
+  let busyUs = 0;
+  let wakeups = 0;
+  let maxScheduleLateMs = 0;
+  while (nowMs < durationMs) {
+    const nextDue = Math.min(schedule.due, nextWebMs, ...tasks.map((t) => t.due));
+    nowMs = Math.max(nowMs, nextDue);
+    if (nowMs >= durationMs) break;
+    wakeups++;
+    let passUs = profile.lightSleep ? LIGHT_SLEEP_TRANSITION_US : 0;
+
+    if (nextWebMs <= nowMs) {
+      passUs += runUs.web;
+      nextWebMs += webEveryMs;
+    }
+    for (const task of tasks) {
+      if (task.due > nowMs) continue;
+      passUs += runUs[task.name] ?? 0;
+      task.due += task.period;
+      if (task.due <= nowMs) task.due = nowMs + task.period;
+    }
+    if (schedule.due <= nowMs) {
+      const startMs = nowMs + passUs / 1000;
+      const sinceMinuteMs = (startMs + schedule.minuteOffsetMs) % 60000;
+      // The first run is the boot-time check, not a minute start.
+      if (schedule.runs++ > 0 && sinceMinuteMs < 60000 - SCHEDULE_TASK_MARGIN_MS * 2) maxScheduleLateMs = Math.max(maxScheduleLateMs, sinceMinuteMs);
+      passUs += runUs.schedule;
+      schedule.due = startMs + (60000 - sinceMinuteMs) + SCHEDULE_TASK_MARGIN_MS;
+    }
+
+    busyUs += passUs;
+    nowMs += passUs / 1000;
+  }
+
+  const busy = busyUs / 1000 / durationMs;
+  const idle = 1 - busy;
+  const idleMa = profile.lightSleep ? CURRENT_IDLE_LIGHT_SLEEP_MA : CURRENT_IDLE_AWAKE_MA;
+  return {
+    wakeupsPerHour: wakeups / options.hours,
+    idle,
+    currentMa: idle * idleMa + busy * CURRENT_BUSY_MA,
+    maxScheduleLateMs,
+  };
+}
+
+async function main() {
+  const options = parseArgs(process.argv.slice(2));
+  const runUs = options.host ? await runTimesFromDevice(options) : DEFAULT_RUN_US;
+  console.log(`Loop wakeup simulation: ${options.hours} h, ${options.webRequestsPerHour} web requests/h, run times ${options.host ? `from ${options.host}` : 'default'}`);
+  console.log('');
+  console.log('profile        wakeups/h   idle %   est. mA   schedule late ms');
+  for (const [name, profile] of Object.entries(PROFILES)) {
+    const r = simulate(profile, runUs, options);
+    console.log(`${name.padEnd(14)} ${String(Math.round(r.wakeupsPerHour)).padStart(9)} ${(r.idle * 100).toFixed(3).padStart(8)} ${r.currentMa.toFixed(1).padStart(9)} ${r.maxScheduleLateMs.toFixed(1).padStart(18)}`);
+  }
+  console.log('');
+  console.log('power-save assumes automatic light sleep, which needs a core built with CONFIG_PM_ENABLE and');
+  console.log('CONFIG_FREERTOS_USE_TICKLESS_IDLE; stock Arduino-ESP32 cores get the ps-stock-core figure.');
+}
+
+main().catch((err) => {
+  console.error(err.message);
+  process.exit(1);
+});
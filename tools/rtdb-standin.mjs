@@ -0,0 +1,386 @@
+// Local stand-in for the Firebase REST endpoints used by the firmware
+// (cloud_sync.cpp), with optional outage injection.
+//
+// Usage:
+//   node tools/rtdb-standin.mjs [--port 9000] [--outage <startS>:<durationS>:<mode>]...
+//                               [--fail-rate 0.2] [--token-ttl 3600] [--report 60]
+//
+// Outage modes:
+//   hang    accept the request and never answer (device waits for its timeout)
+//   reset   close the socket immediately
+//   error   answer HTTP 503
+//
+// Point the device at it from firebase_config.h:
+//   #define FIREBASE_DATABASE_URL "http://<host>:9000"
+//   #define FIREBASE_AUTH_URL "http://<host>:9000/v1/accounts:signInWithPassword"
+//
+// Supported REST surface: signInWithPassword, GET (with orderBy/startAt/
+// limitToFirst on a child key) and PUT on any path, and {".sv":"timestamp"}.
+// Security rules are not evaluated; any token issued by the stand-in is valid
+// until it expires.
+//
+// Admin helpers (not part of the Firebase API):
+//   GET  /_admin/command?type=relay_mode&mode=on   queue a command for every device seen
+//   POST /_admin/command {"type":..., "payload":{...}}
+//   GET  /_admin/stats                             request/command/outage statistics as JSON
+
+import http from 'node:http';
+import crypto from 'node:crypto';
+import { pathToFileURL } from 'node:url';
+
+const HANG_LIMIT_MS = 120000;
+const CATEGORIES = ['auth', 'probe', 'commands', 'acks', 'status', 'schedule', 'other'];
+
+function parseArgs(argv) {
+  const options = { port: 9000, host: '0.0.0.0', outages: [], failRate: 0, tokenTtlS: 3600, reportS: 60 };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    const next = () => {
+      if (i + 1 >= argv.length) throw new Error(`Missing value for ${arg}`);
+      return argv[++i];
+    };
+    if (arg === '--port') options.port = Number(next());
+    else if (arg === '--host') options.host = next();
+    else if (arg === '--fail-rate') options.failRate = Number(next());
+    else if (arg === '--token-ttl') options.tokenTtlS = Number(next());
+    else if (arg === '--report') options.reportS = Number(next());
+    else if (arg === '--outage') options.outages.push(parseOutage(next()));
+    else throw new Error(`Unknown argument ${arg}`);
+  }
+  return options;
+}
+
+function parseOutage(spec) {
+  const [start, duration, mode = 'hang'] = spec.split(':');
+  if (!['hang', 'reset', 'error'].includes(mode)) throw new Error(`Unknown outage mode ${mode}`);
+  return { startMs: Number(start) * 1000, durationMs: Number(duration) * 1000, mode };
+}
+
+function categorize(pathName) {
+  if (pathName.includes('accounts:signInWithPassword')) return 'auth';
+  if (/\/control\/nextSeq\.json$/.test(pathName)) return 'probe';
+  if (/\/commands(\/|\.json)/.test(pathName)) return 'commands';
+  if (/\/acks\//.test(pathName)) return 'acks';
+  if (/\/state\/status\.json$/.test(pathName)) return 'status';
+  if (/\/state\/schedule\.json$/.test(pathName)) return 'schedule';
+  return 'other';
+}
+
+function splitPath(pathName) {
+  return pathName.replace(/\.json$/, '').split('/').filter(Boolean).map(decodeURIComponent);
+}
+
+function percentile(sorted, p) {
+  if (sorted.length === 0) return 0;
+  const index = Math.min(sorted.length - 1, Math.ceil((p / 100) * sorted.length) - 1);
+  return sorted[Math.max(0, index)];
+}
+
+function resolveServerValues(value, now) {
+  if (value === null || typeof value !== 'object') return value;
+  if (Array.isArray(value)) return value.map((item) => resolveServerValues(item, now));
+  const keys = Object.keys(value);
+  if (keys.length === 1 && keys[0] === '.sv' && value['.sv'] === 'timestamp') return now;
+  const out = {};
+  for (const key of keys) out[key] = resolveServerValues(value[key], now);
+  return out;
+}
+
+export function createStandin(options = {}) {
+  const opts = { outages: [], failRate: 0, tokenTtlS: 3600, ...options };
+  const root = {};
+  const tokens = new Map();
+  const devices = new Set();
+  const commands = new Map();
+  const startedAt = Date.now();
+  const stats = {
+    startedAt,
+    byCategory: Object.fromEntries(CATEGORIES.map((name) => [name, {
+      requests: 0, failures: 0, injected: 0, bytesIn: 0, bytesOut: 0,
+    }])),
+    outage: { attempts: 0, heldMs: 0 },
+  };
+  const listeners = [];
+
+  function readNode(segments) {
+    let node = root;
+    for (const segment of segments) {
+      if (node === null || typeof node !== 'object' || !(segment in node)) return null;
+      node = node[segment];
+    }
+    return node;
+  }
+
+  function writeNode(segments, value) {
+    if (segments.length === 0) throw new Error('Refusing to overwrite the root');
+    let node = root;
+    for (const segment of segments.slice(0, -1)) {
+      if (node[segment] === null || typeof node[segment] !== 'object') node[segment] = {};
+      node = node[segment];
+    }
+    const last = segments[segments.length - 1];
+    if (value === null) delete node[last];
+    else node[last] = value;
+  }
+
+  function activeOutage(nowMs) {
+    const elapsed = nowMs - startedAt;
+    return opts.outages.find((o) => elapsed >= o.startMs && elapsed < o.startMs + o.durationMs) || null;
+  }
+
+  function queryChildren(node, params) {
+    if (node === null || typeof node !== 'object') return node;
+    const orderBy = params.get('orderBy');
+    if (!orderBy) return node;
+
+    const field = JSON.parse(orderBy);
+    const startAt = params.has('startAt') ? JSON.parse(params.get('startAt')) : undefined;
+    const limit = params.has('limitToFirst') ? Number(params.get('limitToFirst')) : Infinity;
+    const entries = Object.entries(node)
+      .filter(([, child]) => child && typeof child === 'object' && field in child)
+      .filter(([, child]) => startAt === undefined || child[field] >= startAt)
+      .sort((a, b) => a[1][field] - b[1][field])
+      .slice(0, limit);
+    return Object.fromEntries(entries);
+  }
+
+  function queueCommand(type, payload) {
+    const created = [];
+    for (const deviceId of devices) {
+      const seq = Number(readNode(['devices', deviceId, 'control', 'nextSeq']) || 0) + 1;
+      const commandId = `c${String(seq).padStart(9, '0')}`;
+      writeNode(['devices', deviceId, 'control', 'nextSeq'], seq);
+      const createdAt = Date.now();
+      writeNode(['devices', deviceId, 'commands', commandId], {
+        seq, type, payload, createdBy: 'standin', createdAt,
+      });
+      commands.set(`${deviceId}/${commandId}`, { type, createdAt, ackedAt: 0, ack: null });
+      created.push({ deviceId, commandId, seq });
+    }
+    return created;
+  }
+
+  function send(res, ctx, status, body) {
+    const text = body === undefined ? '' : JSON.stringify(body);
+    ctx.bytesOut = Buffer.byteLength(text);
+    res.writeHead(status, { 'Content-Type': 'application/json', 'Content-Length': ctx.bytesOut });
+    res.end(text);
+    ctx.status = status;
+  }
+
+  function finish(ctx) {
+    const bucket = stats.byCategory[ctx.category];
+    bucket.requests++;
+    bucket.bytesIn += ctx.bytesIn;
+    bucket.bytesOut += ctx.bytesOut;
+    if (!(ctx.status >= 200 && ctx.status < 300)) bucket.failures++;
+    if (ctx.injected) bucket.injected++;
+    for (const listener of listeners) listener(ctx);
+  }
+
+  function recordAck(segments, value, nowMs) {
+    // devices/<id>/acks/<commandId>
+    if (segments.length !== 4 || segments[0] !== 'devices' || segments[2] !== 'acks') return;
+    const entry = commands.get(`${segments[1]}/${segments[3]}`);
+    if (!entry || entry.ackedAt) return;
+    entry.ackedAt = nowMs;
+    entry.ack = value;
+  }
+
+  function handleAdmin(url, res, ctx, rawBody) {
+    if (url.pathname === '/_admin/stats') return send(res, ctx, 200, summarize());
+    if (url.pathname === '/_admin/command') {
+      let type = url.searchParams.get('type');
+      let payload = { mode: url.searchParams.get('mode') };
+      if (rawBody.length > 0) {
+        try {
+          ({ type, payload } = JSON.parse(rawBody.toString('utf8')));
+        } catch {
+          return send(res, ctx, 400, { error: 'invalid JSON body' });
+        }
+      }
+      if (!type || !payload || (payload.mode === null && !payload.events)) {
+        return send(res, ctx, 400, { error: 'type and payload are required' });
+      }
+      return send(res, ctx, 200, queueCommand(type, payload));
+    }
+    return send(res, ctx, 404, { error: 'unknown admin route' });
+  }
+
+  function handleRequest(req, res, rawBody) {
+    const url = new URL(req.url, 'http://standin');
+    const nowMs = Date.now();
+    const ctx = {
+      method: req.method,
+      path: url.pathname,
+      category: categorize(url.pathname),
+      bytesIn: Buffer.byteLength(req.url) + rawBody.length,
+      bytesOut: 0,
+      status: 0,
+      injected: false,
+      startedMs: nowMs,
+    };
+
+    if (url.pathname.startsWith('/_admin/')) {
+      handleAdmin(url, res, ctx, rawBody);
+      return;
+    }
+
+    const reply = (status, body) => {
+      send(res, ctx, status, body);
+      finish(ctx);
+    };
+
+    const outage = activeOutage(nowMs) || (Math.random() < opts.failRate ? { mode: 'error' } : null);
+    if (outage) {
+      ctx.injected = true;
+      stats.outage.attempts++;
+      if (outage.mode === 'error') {
+        reply(503, { error: 'injected outage' });
+      } else if (outage.mode === 'reset') {
+        req.socket.destroy();
+        ctx.status = -1;
+        finish(ctx);
+      } else {
+        // hang: keep the socket open until the device gives up.
+        const timer = setTimeout(() => req.socket.destroy(), HANG_LIMIT_MS);
+        req.socket.once('close', () => {
+          clearTimeout(timer);
+          stats.outage.heldMs += Date.now() - nowMs;
+          ctx.status = -1;
+          finish(ctx);
+        });
+      }
+      return;
+    }
+
+    if (ctx.category === 'auth') {
+      if (req.method !== 'POST') return reply(405, { error: 'method not allowed' });
+      let body = {};
+      try {
+        body = JSON.parse(rawBody.toString('utf8') || '{}');
+      } catch {
+        body = {};
+      }
+      if (!body.email || !body.password) return reply(400, { error: { message: 'MISSING_CREDENTIALS' } });
+      const idToken = crypto.randomBytes(24).toString('hex');
+      tokens.set(idToken, nowMs + opts.tokenTtlS * 1000);
+      return reply(200, { idToken, expiresIn: String(opts.tokenTtlS), localId: `standin-${body.email}` });
+    }
+
+    if (!url.pathname.endsWith('.json')) return reply(404, { error: 'Not found' });
+    const tokenExpiresAt = tokens.get(url.searchParams.get('auth'));
+    if (!tokenExpiresAt) return reply(401, { error: 'Permission denied' });
+    if (tokenExpiresAt <= nowMs) return reply(401, { error: 'Auth token is expired' });
+
+    const segments = splitPath(url.pathname);
+    if (segments[0] === 'devices' && segments[1]) devices.add(segments[1]);
+
+    if (req.method === 'GET') return reply(200, queryChildren(readNode(segments), url.searchParams));
+    if (req.method !== 'PUT') return reply(405, { error: 'method not allowed' });
+
+    let value;
+    try {
+      value = JSON.parse(rawBody.toString('utf8'));
+    } catch {
+      return reply(400, { error: 'Invalid data; couldn\'t parse JSON object.' });
+    }
+    value = resolveServerValues(value, nowMs);
+    writeNode(segments, value);
+    recordAck(segments, value, nowMs);
+    return reply(200, value);
+  }
+
+  function summarize() {
+    const elapsedMs = Date.now() - startedAt;
+    const outageMs = opts.outages.reduce((sum, o) => {
+      const overlap = Math.min(elapsedMs, o.startMs + o.durationMs) - o.startMs;
+      return sum + Math.max(0, overlap);
+    }, 0);
+    const hours = elapsedMs / 3600000;
+    const entries = [...commands.values()];
+    const acked = entries.filter((c) => c.ackedAt);
+    const latencies = acked.map((c) => c.ackedAt - c.createdAt).sort((a, b) => a - b);
+    const commandBytes = ['probe', 'commands', 'acks'].reduce((sum, name) =>
+      sum + stats.byCategory[name].bytesIn + stats.byCategory[name].bytesOut, 0);
+    const totalBytes = Object.values(stats.byCategory).reduce((sum, c) => sum + c.bytesIn + c.bytesOut, 0);
+    return {
+      elapsedS: Math.round(elapsedMs / 1000),
+      categories: Object.fromEntries(Object.entries(stats.byCategory).map(([name, c]) => [name, {
+        ...c,
+        perHour: hours > 0 ? Math.round(c.requests / hours) : 0,
+      }])),
+      bytesPerHour: hours > 0 ? Math.round(totalBytes / hours) : 0,
+      commands: {
+        queued: entries.length,
+        acked: acked.length,
+        ackLatencyMs: {
+          p50: percentile(latencies, 50),
+          p90: percentile(latencies, 90),
+          max: latencies.length ? latencies[latencies.length - 1] : 0,
+        },
+        // Probe, command poll and ACK traffic (both directions) per acknowledged command.
+        bytesPerCommand: acked.length ? Math.round(commandBytes / acked.length) : 0,
+      },
+      outage: {
+        windowS: Math.round(outageMs / 1000),
+        attempts: stats.outage.attempts,
+        attemptsPerMin: outageMs > 0 ? +(stats.outage.attempts / (outageMs / 60000)).toFixed(2) : 0,
+        heldMs: stats.outage.heldMs,
+        // Share of the outage the device spent blocked on hung requests.
+        blockedFraction: outageMs > 0 ? +(stats.outage.heldMs / outageMs).toFixed(3) : 0,
+      },
+    };
+  }
+
+  const server = http.createServer((req, res) => {
+    const chunks = [];
+    req.on('data', (chunk) => chunks.push(chunk));
+    req.on('end', () => handleRequest(req, res, Buffer.concat(chunks)));
+  });
+
+  return {
+    server,
+    root,
+    readNode,
+    writeNode,
+    queueCommand,
+    devices: () => [...devices],
+    summarize,
+    onRequest: (listener) => listeners.push(listener),
+    listen: (port, host) => new Promise((resolve) => server.listen(port, host, () => resolve(server.address()))),
+    close: () => new Promise((resolve) => {
+      server.closeAllConnections?.();
+      server.close(() => resolve());
+    }),
+  };
+}
+
+async function main() {
+  const options = parseArgs(process.argv.slice(2));
+  const standin = createStandin(options);
+  const address = await standin.listen(options.port, options.host);
+  console.log(`RTDB stand-in listening on http://${address.address}:${address.port}`);
+  for (const o of options.outages) {
+    console.log(`Outage: ${o.mode} from ${o.startMs / 1000}s for ${o.durationMs / 1000}s`);
+  }
+
+  standin.onRequest((ctx) => {
+    const tag = ctx.injected ? ' [injected]' : '';
+    console.log(`${new Date().toISOString()} ${ctx.method} ${ctx.category} ${ctx.status} ${Date.now() - ctx.startedMs}ms${tag}`);
+  });
+
+  const report = () => console.log(JSON.stringify(standin.summarize(), null, 2));
+  if (options.reportS > 0) setInterval(report, options.reportS * 1000).unref();
+  process.on('SIGINT', () => {
+    report();
+    process.exit(0);
+  });
+}
+
+if (import.meta.url === pathToFileURL(process.argv[1]).href) {
+  main().catch((err) => {
+    console.error(err.message);
+    process.exit(1);
+  });
+}
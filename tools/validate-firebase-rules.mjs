@@ -116,7 +116,7 @@ function statusPayload(lastProcessedSeq) {
     shabbat: false,
     time: '00:00',
     timeValid: true,
-    hc12Ok: false,
+    hc12: { unit1: { ok: true, successPct: 100, rttP50Ms: 40, rttP90Ms: 55, lastSeen: 0 } },
     lastSeen: serverTimestamp(),
     lastProcessedSeq,
     scheduleRevision: 0,
@@ -0,0 +1,161 @@
+// Concurrent-client load test for the device's local web API.
+//
+// Runs N clients in parallel, each requesting the given paths back to back
+// (optionally with a pause between requests, like UI tabs polling), and
+// reports throughput, latency percentiles and errors per path.
+//
+// Usage:
+//   node tools/web-load-test.mjs --host 192.168.1.50 [--clients 8] [--duration 30]
+//                                [--paths /status,/schedule_list] [--think 0] [--conditional]
+//                                [--device "<command>"]
+//
+// --conditional replays each path's last ETag as If-None-Match, like a
+// polling dashboard on /state; 304s count as successes.
+//
+// With --device instead of --host, the test starts a host build with
+// --port 0 on the port it prints, reports how late its loop tasks ran
+// under the load from its /metrics, and stops it at the end:
+// tools/host-tests/web-api-device (make web-load-test there).
+//
+// Only read-only routes should be used here; /cmd and /schedule change state.
+
+import { spawn } from 'node:child_process';
+
+function parseArgs(argv) {
+  const options = { host: null, clients: 8, durationS: 30, paths: ['/status', '/schedule_list'], thinkMs: 0, timeoutMs: 5000, conditional: false, device: null };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    const next = () => {
+      if (i + 1 >= argv.length) throw new Error(`Missing value for ${arg}`);
+      return argv[++i];
+    };
+    if (arg === '--host') options.host = next();
+    else if (arg === '--clients') options.clients = Number(next());
+    else if (arg === '--duration') options.durationS = Number(next());
+    else if (arg === '--paths') options.paths = next().split(',').filter(Boolean);
+    else if (arg === '--think') options.thinkMs = Number(next());
+    else if (arg === '--timeout') options.timeoutMs = Number(next());
+    else if (arg === '--conditional') options.conditional = true;
+    else if (arg === '--device') options.device = next();
+    else throw new Error(`Unknown argument ${arg}`);
+  }
+  if (!options.host && !options.device) throw new Error('Missing --host or --device');
+  return options;
+}
+
+function percentile(sorted, p) {
+  if (sorted.length === 0) return 0;
+  const index = Math.min(sorted.length - 1, Math.ceil((p / 100) * sorted.length) - 1);
+  return sorted[Math.max(0, index)];
+}
+
+function sleep(ms) {
+  return new Promise((resolve) => setTimeout(resolve, ms));
+}
+
+async function runClient(id, options, deadline, results) {
+  let index = id;
+  const etags = new Map();
+  while (Date.now() < deadline) {
+    const path = options.paths[index++ % options.paths.length];
+    const entry = results.get(path);
+    const started = performance.now();
+    try {
+      const res = await fetch(`http://${options.host}${path}`, {
+        cache: 'no-store',
+        headers: options.conditional && etags.has(path) ? { 'If-None-Match': etags.get(path) } : {},
+        signal: AbortSignal.timeout(options.timeoutMs),
+      });
+      const body = await res.arrayBuffer();
+      entry.bytes += body.byteLength;
+      if (res.status === 304) entry.notModified++;
+      if (res.headers.get('etag')) etags.set(path, res.headers.get('etag'));
+      if (res.ok || res.status === 304) entry.latencies.push(performance.now() - started);
+      else entry.errors.push(`HTTP ${res.status}`);
+    } catch (err) {
+      entry.errors.push(err.name === 'TimeoutError' ? 'timeout' : err.message);
+    }
+    if (options.thinkMs > 0) await sleep(options.thinkMs);
+  }
+}
+
+// Start the host device on a free port and resolve with its host:port once
+// it listens; the test fails if it exits before stopDevice().
+function startDevice(commandLine) {
+  const [command, ...args] = commandLine.split(' ').filter(Boolean);
+  const device = spawn(command, [...args, '--port', '0'], { stdio: ['ignore', 'inherit', 'pipe'] });
+  device.on('exit', (code, signal) => {
+    if (device.stopping) return;
+    console.error(`Device exited early (${signal || code})`);
+    process.exit(1);
+  });
+  return new Promise((resolve) => {
+    let output = '';
+    device.stderr.on('data', (chunk) => {
+      process.stderr.write(chunk);
+      if (device.host) return;
+      output += chunk;
+      const match = output.match(/listening on http:\/\/(\S+)/);
+      if (match) {
+        device.host = match[1];
+        resolve(device);
+      }
+    });
+  });
+}
+
+function stopDevice(device) {
+  if (!device) return Promise.resolve();
+  device.stopping = true;
+  return new Promise((resolve) => {
+    device.once('exit', resolve);
+    device.kill('SIGTERM');
+  });
+}
+
+// Worst lateness per loop task and the deferred request timing, from the
+// device's /metrics after the run.
+async function printLoopImpact(host) {
+  const text = await (await fetch(`http://${host}/metrics`)).text();
+  const value = (pattern) => Number((text.match(pattern) || [])[1] || 0);
+  console.log('');
+  console.log('loop task        max late ms');
+  for (const [, task, late] of text.matchAll(/^shabbat_task_max_late_ms\{task="([^"]+)"\} (\d+)/gm)) {
+    console.log(`${task.padEnd(16)} ${late.padStart(11)}`);
+  }
+  const deferred = value(/^shabbat_duration_us_count\{subsystem="http_deferred"\} (\d+)/m);
+  const deferredUs = value(/^shabbat_duration_us_sum\{subsystem="http_deferred"\} (\d+)/m);
+  console.log(`deferred requests ${deferred}, mean queued -> sent ${(deferredUs / Math.max(1, deferred) / 1000).toFixed(2)} ms`);
+}
+
+async function main() {
+  const options = parseArgs(process.argv.slice(2));
+  const device = options.device ? await startDevice(options.device) : null;
+  if (device) options.host = device.host;
+  const results = new Map(options.paths.map((path) => [path, { latencies: [], errors: [], bytes: 0, notModified: 0 }]));
+  console.log(`Load test: ${options.clients} clients for ${options.durationS}s against http://${options.host}`);
+
+  const started = Date.now();
+  const deadline = started + options.durationS * 1000;
+  await Promise.all(Array.from({ length: options.clients }, (_, id) => runClient(id, options, deadline, results)));
+  const elapsedS = (Date.now() - started) / 1000;
+
+  console.log('');
+  console.log('path              req/s    p50 ms   p90 ms   p99 ms   max ms  errors     304  bytes/req');
+  for (const [path, entry] of results) {
+    const sorted = entry.latencies.sort((a, b) => a - b);
+    const fmt = (v) => v.toFixed(1).padStart(8);
+    console.log(`${path.padEnd(16)} ${(sorted.length / elapsedS).toFixed(1).padStart(6)} ${fmt(percentile(sorted, 50))} ${fmt(percentile(sorted, 90))} ${fmt(percentile(sorted, 99))} ${fmt(sorted[sorted.length - 1] || 0)}  ${String(entry.errors.length).padStart(6)}  ${String(entry.notModified).padStart(6)}  ${String(Math.round(entry.bytes / Math.max(1, sorted.length))).padStart(9)}`);
+    const reasons = [...new Set(entry.errors)];
+    if (reasons.length) console.log(`  errors: ${reasons.slice(0, 5).join(', ')}`);
+  }
+  if (device) {
+    await printLoopImpact(options.host);
+    await stopDevice(device);
+  }
+}
+
+main().catch((err) => {
+  console.error(err.message);
+  process.exit(1);
+});
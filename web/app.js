@@ -76,6 +76,18 @@ function formatTimestamp(value) {
   return new Date(value).toLocaleString();
 }
 
+// One entry per remote unit: "1: OK 98% 42/60 ms" (success rate, RTT p50/p90).
+function formatHc12Links(links) {
+  if (!links) return '--';
+  const parts = Object.keys(links)
+    .sort((a, b) => Number(a.replace('unit', '')) - Number(b.replace('unit', '')))
+    .map((key) => {
+      const link = links[key];
+      return `${key.replace('unit', '')}: ${link.ok ? 'OK' : 'No reply'} ${link.successPct}% ${link.rttP50Ms}/${link.rttP90Ms} ms`;
+    });
+  return parts.length > 0 ? parts.join(', ') : '--';
+}
+
 function normalizeEvents(events) {
   if (!events) return [];
   if (Array.isArray(events)) return events.filter(Boolean);
@@ -92,7 +104,7 @@ function renderStatus(status) {
   fields.shabbat.textContent = formatBool(data.shabbat);
   fields.time.textContent = data.time || '--';
   fields.timeValid.textContent = formatBool(data.timeValid);
-  fields.hc12.textContent = formatBool(data.hc12Ok);
+  fields.hc12.textContent = formatHc12Links(data.hc12);
   fields.lastSeq.textContent = Number.isFinite(data.lastProcessedSeq) ? data.lastProcessedSeq : '--';
   fields.scheduleRevision.textContent = Number.isFinite(data.scheduleRevision) ? data.scheduleRevision : '--';
   fields.lastSeen.textContent = formatTimestamp(data.lastSeen);